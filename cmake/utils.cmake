@@ -32,6 +32,12 @@ function(libavc_add_compile_options)
 
 endfunction()
 
+# Builds the given AVX2 kernels with AVX2 enabled. The rest of the library is
+# built without it, the kernels are selected at run time on CPUs with AVX2
+function(libavc_set_avx2_compile_options)
+  set_source_files_properties(${ARGN} PROPERTIES COMPILE_OPTIONS "-mavx2")
+endfunction()
+
 # Adds defintions for all targets
 function(libavc_add_definitions)
   if("${SYSTEM_NAME}" STREQUAL "Darwin")
@@ -45,8 +51,7 @@ function(libavc_add_definitions)
   elseif("${SYSTEM_PROCESSOR}" STREQUAL "aarch32")
     add_definitions(-DARMV7 -DDEFAULT_ARCH=D_ARCH_ARM_A9Q)
   else()
-    add_definitions(-DX86 -DX86_LINUX=1 -DDISABLE_AVX2
-                    -DDEFAULT_ARCH=D_ARCH_X86_SSE42)
+    add_definitions(-DX86 -DX86_LINUX=1 -DDEFAULT_ARCH=D_ARCH_X86_AVX2)
   endif()
 endfunction()
 
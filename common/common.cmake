@@ -96,10 +96,13 @@ else()
     APPEND
     LIBAVC_COMMON_SRCS
     "${AVC_ROOT}/common/x86/ih264_chroma_intra_pred_filters_ssse3.c"
+    "${AVC_ROOT}/common/x86/ih264_cpu_features.c"
     "${AVC_ROOT}/common/x86/ih264_deblk_chroma_ssse3.c"
+    "${AVC_ROOT}/common/x86/ih264_deblk_luma_avx2.c"
     "${AVC_ROOT}/common/x86/ih264_deblk_luma_ssse3.c"
     "${AVC_ROOT}/common/x86/ih264_ihadamard_scaling_sse42.c"
     "${AVC_ROOT}/common/x86/ih264_ihadamard_scaling_ssse3.c"
+    "${AVC_ROOT}/common/x86/ih264_inter_pred_filters_avx2.c"
     "${AVC_ROOT}/common/x86/ih264_inter_pred_filters_ssse3.c"
     "${AVC_ROOT}/common/x86/ih264_iquant_itrans_recon_dc_ssse3.c"
     "${AVC_ROOT}/common/x86/ih264_iquant_itrans_recon_sse42.c"
@@ -109,6 +112,9 @@ else()
     "${AVC_ROOT}/common/x86/ih264_padding_ssse3.c"
     "${AVC_ROOT}/common/x86/ih264_resi_trans_quant_sse42.c"
     "${AVC_ROOT}/common/x86/ih264_weighted_pred_sse42.c")
+  libavc_set_avx2_compile_options(
+    "${AVC_ROOT}/common/x86/ih264_deblk_luma_avx2.c"
+    "${AVC_ROOT}/common/x86/ih264_inter_pred_filters_avx2.c")
 
   include_directories(${AVC_ROOT}/common/x86)
 endif()
@@ -48,6 +48,8 @@
 *  - ih264_deblk_chroma_horz_bslt4
 *  - ih264_deblk_chroma_vert_bs4_mbaff
 *  - ih264_deblk_chroma_vert_bslt4_mbaff
+*  - ih264_deblk_luma_vert_inner_bslt4
+*  - ih264_deblk_luma_horz_inner_bslt4
 *
 * @remarks
 *  none
@@ -2092,3 +2094,118 @@ void ih264_deblk_chroma_vert_bslt4_mbaff(UWORD8 *pu1_src,
         }
     }
 }
+
+/**
+*******************************************************************************
+*
+* @brief luma inner vertical edges deblock @ bs < 4
+*
+* @par Description
+*  This function filters the three inner vertical luma edges of a macroblock
+*  (at columns 4, 8 and 12) in order. Edges with a zero boundary strength are
+*  skipped. The edges depend on each other through p2 / q2, so they are
+*  filtered one after the other with the given single edge function.
+*
+* @param[in] pu1_src
+*  pointer to the top left sample of the macroblock
+*
+* @param[in] src_strd
+*  source stride
+*
+* @param[in] alpha
+*  alpha value for the inner edges
+*
+* @param[in] beta
+*  beta value for the inner edges
+*
+* @param[in] pu4_bs
+*  packed boundary strengths of the edges 1, 2 and 3
+*
+* @param[in] pu1_cliptab
+*  tc0_table
+*
+* @param[in] pf_deblk_edge
+*  function filtering a single vertical luma edge with bs < 4
+*
+* @returns none
+*
+* @remarks none
+*
+******************************************************************************
+*/
+void ih264_deblk_luma_vert_inner_bslt4(UWORD8 *pu1_src,
+                                       WORD32 src_strd,
+                                       WORD32 alpha,
+                                       WORD32 beta,
+                                       const UWORD32 *pu4_bs,
+                                       const UWORD8 *pu1_cliptab,
+                                       ih264_deblk_edge_bslt4_ft *pf_deblk_edge)
+{
+    WORD32 edge;
+
+    for(edge = 0; edge < 3; edge++)
+    {
+        if(pu4_bs[edge])
+        {
+            pf_deblk_edge(pu1_src + ((edge + 1) << 2), src_strd, alpha, beta,
+                          pu4_bs[edge], pu1_cliptab);
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief luma inner horizontal edges deblock @ bs < 4
+*
+* @par Description
+*  This function filters the three inner horizontal luma edges of a
+*  macroblock (at rows 4, 8 and 12) in order. Edges with a zero boundary
+*  strength are skipped.
+*
+* @param[in] pu1_src
+*  pointer to the top left sample of the macroblock
+*
+* @param[in] src_strd
+*  source stride
+*
+* @param[in] alpha
+*  alpha value for the inner edges
+*
+* @param[in] beta
+*  beta value for the inner edges
+*
+* @param[in] pu4_bs
+*  packed boundary strengths of the edges 1, 2 and 3
+*
+* @param[in] pu1_cliptab
+*  tc0_table
+*
+* @param[in] pf_deblk_edge
+*  function filtering a single horizontal luma edge with bs < 4
+*
+* @returns none
+*
+* @remarks none
+*
+******************************************************************************
+*/
+void ih264_deblk_luma_horz_inner_bslt4(UWORD8 *pu1_src,
+                                       WORD32 src_strd,
+                                       WORD32 alpha,
+                                       WORD32 beta,
+                                       const UWORD32 *pu4_bs,
+                                       const UWORD8 *pu1_cliptab,
+                                       ih264_deblk_edge_bslt4_ft *pf_deblk_edge)
+{
+    WORD32 edge;
+
+    for(edge = 0; edge < 3; edge++)
+    {
+        if(pu4_bs[edge])
+        {
+            pf_deblk_edge(pu1_src + (((edge + 1) * src_strd) << 2), src_strd,
+                          alpha, beta, pu4_bs[edge], pu1_cliptab);
+        }
+    }
+}
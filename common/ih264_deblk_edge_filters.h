@@ -71,6 +71,14 @@ typedef void ih264_deblk_chroma_edge_bs4_ft(UWORD8 *pu1_src,
                                             WORD32 alpha_cr,
                                             WORD32 beta_cr);
 
+typedef void ih264_deblk_luma_inner_bslt4_ft(UWORD8 *pu1_src,
+                                             WORD32 src_strd,
+                                             WORD32 alpha,
+                                             WORD32 beta,
+                                             const UWORD32 *pu4_bs,
+                                             const UWORD8 *pu1_cliptab,
+                                             ih264_deblk_edge_bslt4_ft *pf_deblk_edge);
+
 /* C Declarations */
 ih264_deblk_edge_bs4_ft ih264_deblk_luma_horz_bs4;
 ih264_deblk_edge_bs4_ft ih264_deblk_luma_vert_bs4;
@@ -92,6 +100,8 @@ ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_vert_bslt4;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_vert_bslt4_mbaff;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_mbaff;
+ih264_deblk_luma_inner_bslt4_ft ih264_deblk_luma_vert_inner_bslt4;
+ih264_deblk_luma_inner_bslt4_ft ih264_deblk_luma_horz_inner_bslt4;
 
 /* A9 Declarations */
 ih264_deblk_edge_bs4_ft ih264_deblk_luma_horz_bs4_a9;
@@ -159,4 +169,8 @@ ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_ssse3;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_vert_bslt4_mbaff_ssse3;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_mbaff_ssse3;
 
+/* AVX2 Declarations */
+ih264_deblk_luma_inner_bslt4_ft ih264_deblk_luma_vert_inner_bslt4_avx2;
+ih264_deblk_luma_inner_bslt4_ft ih264_deblk_luma_horz_inner_bslt4_avx2;
+
 #endif /* _IH264_DEBLK_EDGE_FILTERS_H_ */
@@ -58,6 +58,7 @@
 #include <sched.h>
 #include <semaphore.h>
 #include <unistd.h>
+#include <time.h>
 #ifdef PTHREAD_AFFINITY
 #include <sys/prctl.h>
 #endif
@@ -131,6 +132,14 @@ void ithread_usleep(UWORD32 u4_time_us)
     usleep(u4_time_us);
 }
 
+UWORD32 ithread_get_time_us(void)
+{
+    struct timespec s_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &s_time);
+    return ((UWORD32)s_time.tv_sec * 1000000) + (UWORD32)(s_time.tv_nsec / 1000);
+}
+
 UWORD32 ithread_get_sem_struct_size(void)
 {
     return(sizeof(sem_t));
@@ -71,6 +71,8 @@ void    ithread_msleep(UWORD32 u4_time_ms);
 
 void    ithread_usleep(UWORD32 u4_time_us);
 
+UWORD32 ithread_get_time_us(void);
+
 UWORD32 ithread_get_sem_struct_size(void);
 
 WORD32  ithread_sem_init(void *sem,WORD32 pshared,UWORD32 value);
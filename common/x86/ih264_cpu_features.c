@@ -0,0 +1,106 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264_cpu_features.c
+*
+* @brief
+*  Contains the x86 CPU feature detection shared by the decoder and the
+*  encoder function selectors
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - ih264_get_x86_cpu_level
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <cpuid.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_cpu_features.h"
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief Returns the highest x86 SIMD level the CPU and the build support
+*
+* @par Description: Reads the SSSE3, SSE4.2 and AVX2 feature bits using cpuid.
+* AVX2 also needs the OS to save the AVX registers on context switch, which is
+* read from XCR0 using xgetbv. Builds that define DISABLE_AVX2 do not have the
+* AVX2 kernels and stop at SSE4.2
+*
+* @returns  SIMD level
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+X86_CPU_LEVEL_T ih264_get_x86_cpu_level(void)
+{
+    UWORD32 u4_eax, u4_ebx, u4_ecx, u4_edx;
+
+    if(!__get_cpuid(1, &u4_eax, &u4_ebx, &u4_ecx, &u4_edx))
+        return X86_CPU_GENERIC;
+    if(!(u4_ecx & bit_SSSE3))
+        return X86_CPU_GENERIC;
+    if(!(u4_ecx & bit_SSE4_2))
+        return X86_CPU_SSSE3;
+
+#ifndef DISABLE_AVX2
+    if((u4_ecx & bit_OSXSAVE) && (u4_ecx & bit_AVX))
+    {
+        UWORD32 u4_xcr0_lo, u4_xcr0_hi;
+
+        __asm__ __volatile__("xgetbv"
+                        : "=a"(u4_xcr0_lo), "=d"(u4_xcr0_hi)
+                        : "c"(0));
+        UNUSED(u4_xcr0_hi);
+
+        /* XMM and YMM state are both enabled */
+        if(((u4_xcr0_lo & 0x6) == 0x6)
+                        && __get_cpuid_count(7, 0, &u4_eax, &u4_ebx, &u4_ecx,
+                                             &u4_edx)
+                        && (u4_ebx & bit_AVX2))
+        {
+            return X86_CPU_AVX2;
+        }
+    }
+#endif
+
+    return X86_CPU_SSE42;
+}
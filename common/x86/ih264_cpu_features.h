@@ -0,0 +1,60 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264_cpu_features.h
+*
+* @brief
+*  Declarations of the x86 CPU feature detection shared by the decoder and
+*  the encoder function selectors
+*
+* @author
+*  ittiam
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+#ifndef _IH264_CPU_FEATURES_H_
+#define _IH264_CPU_FEATURES_H_
+
+/*****************************************************************************/
+/* Enums                                                                     */
+/*****************************************************************************/
+
+/** x86 SIMD levels the kernels are written for, each includes the previous */
+typedef enum
+{
+    X86_CPU_GENERIC = 0,
+    X86_CPU_SSSE3,
+    X86_CPU_SSE42,
+    X86_CPU_AVX2
+}X86_CPU_LEVEL_T;
+
+/*****************************************************************************/
+/* Function Declarations                                                     */
+/*****************************************************************************/
+
+X86_CPU_LEVEL_T ih264_get_x86_cpu_level(void);
+
+#endif /* _IH264_CPU_FEATURES_H_ */
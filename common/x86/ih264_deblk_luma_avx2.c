@@ -0,0 +1,422 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264_deblk_luma_avx2.c                              */
+/*                                                                           */
+/*  Description       : Contains function definitions for deblocking the     */
+/*                      inner luma edges of a macroblock in x86 avx2         */
+/*                      intrinsics                                           */
+/*                                                                           */
+/*  List of Functions : ih264_deblk_luma_vert_inner_bslt4_avx2()             */
+/*                      ih264_deblk_luma_horz_inner_bslt4_avx2()             */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*  Revision History  :                                                      */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <immintrin.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_deblk_edge_filters.h"
+
+/*****************************************************************************/
+/*  Function definitions .                                                   */
+/*****************************************************************************/
+/*  The inner edges of a macroblock depend on each other through p2 and q2,  */
+/*  so they are filtered one after the other. The 16 samples across an edge  */
+/*  are kept as 16 bit values in one 256 bit register, and the macroblock is */
+/*  loaded (and for vertical edges transposed) only once for all the three   */
+/*  edges. The outputs are bit exact with the C functions                    */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_transpose_16x16_avx2                         */
+/*                                                                           */
+/*  Description   : Transposes a 16x16 block of bytes held in 16 registers.  */
+/*                  Each pass interleaves rows i and i + 8, and four passes  */
+/*                  move every byte to its transposed position               */
+/*                                                                           */
+/*  Inputs        : px_16x8b - the 16 rows, replaced with the 16 columns     */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264_deblk_transpose_16x16_avx2(__m128i *px_16x8b)
+{
+    __m128i tmp_16x8b[16];
+    WORD32 pass, i;
+
+    for(pass = 0; pass < 4; pass++)
+    {
+        for(i = 0; i < 8; i++)
+        {
+            tmp_16x8b[2 * i] = _mm_unpacklo_epi8(px_16x8b[i], px_16x8b[i + 8]);
+            tmp_16x8b[2 * i + 1] = _mm_unpackhi_epi8(px_16x8b[i], px_16x8b[i + 8]);
+        }
+        for(i = 0; i < 16; i++)
+        {
+            px_16x8b[i] = tmp_16x8b[i];
+        }
+    }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_tc0_avx2                                */
+/*                                                                           */
+/*  Description   : Expands the packed boundary strength of an edge to the   */
+/*                  16 samples along it, four samples per bs value           */
+/*                                                                           */
+/*  Inputs        : u4_bs       - packed boundary strength of the edge       */
+/*                  pu1_cliptab - tc0_table                                  */
+/*                  pbs_16x16b  - set to all ones where bs is not 0          */
+/*                                                                           */
+/*  Returns       : tc0 of each sample                                       */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m256i ih264_deblk_luma_tc0_avx2(UWORD32 u4_bs,
+                                                  const UWORD8 *pu1_cliptab,
+                                                  __m256i *pbs_16x16b)
+{
+    WORD64 ai8_tc0[4], ai8_bs[4];
+    WORD32 i;
+
+    for(i = 0; i < 4; i++)
+    {
+        UWORD8 u1_bs = (u4_bs >> ((3 - i) << 3)) & 0xff;
+
+        ai8_tc0[i] = (WORD64)(pu1_cliptab[u1_bs] * 0x0001000100010001ULL);
+        ai8_bs[i] = u1_bs ? -1 : 0;
+    }
+
+    *pbs_16x16b = _mm256_setr_epi64x(ai8_bs[0], ai8_bs[1], ai8_bs[2], ai8_bs[3]);
+    return _mm256_setr_epi64x(ai8_tc0[0], ai8_tc0[1], ai8_tc0[2], ai8_tc0[3]);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_bslt4_16x16b_avx2                       */
+/*                                                                           */
+/*  Description   : Filters 16 samples across a luma edge with bs < 4, as    */
+/*                  described in Sec. 8.7.2.3 of ITU T Rec H.264             */
+/*                                                                           */
+/*  Inputs        : pp1_16x16b .. pq1_16x16b - p1, p0, q0 and q1, updated    */
+/*                                             in place                      */
+/*                  p2_16x16b, q2_16x16b     - p2 and q2                     */
+/*                  alpha, beta              - thresholds of the edge        */
+/*                  tc0_16x16b               - tc0 of each sample            */
+/*                  flag_16x16b              - samples with bs not 0         */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264_deblk_luma_bslt4_16x16b_avx2(__m256i *pp1_16x16b,
+                                                        __m256i *pp0_16x16b,
+                                                        __m256i *pq0_16x16b,
+                                                        __m256i *pq1_16x16b,
+                                                        __m256i p2_16x16b,
+                                                        __m256i q2_16x16b,
+                                                        WORD32 alpha,
+                                                        WORD32 beta,
+                                                        __m256i tc0_16x16b,
+                                                        __m256i flag_16x16b)
+{
+    __m256i p1_16x16b, p0_16x16b, q0_16x16b, q1_16x16b;
+    __m256i alpha_16x16b, beta_16x16b, zero_16x16b, max_16x16b;
+    __m256i ap_16x16b, aq_16x16b, tc_16x16b, delta_16x16b, avg_16x16b;
+    __m256i temp1_16x16b, temp2_16x16b;
+
+    p1_16x16b = *pp1_16x16b;
+    p0_16x16b = *pp0_16x16b;
+    q0_16x16b = *pq0_16x16b;
+    q1_16x16b = *pq1_16x16b;
+
+    alpha_16x16b = _mm256_set1_epi16(alpha);
+    beta_16x16b = _mm256_set1_epi16(beta);
+    zero_16x16b = _mm256_setzero_si256();
+    max_16x16b = _mm256_set1_epi16(255);
+
+    /* Filter decision */
+    temp1_16x16b = _mm256_abs_epi16(_mm256_sub_epi16(p0_16x16b, q0_16x16b));
+    temp1_16x16b = _mm256_cmpgt_epi16(alpha_16x16b, temp1_16x16b);
+    flag_16x16b = _mm256_and_si256(flag_16x16b, temp1_16x16b);
+    temp1_16x16b = _mm256_abs_epi16(_mm256_sub_epi16(q1_16x16b, q0_16x16b));
+    temp1_16x16b = _mm256_cmpgt_epi16(beta_16x16b, temp1_16x16b);
+    flag_16x16b = _mm256_and_si256(flag_16x16b, temp1_16x16b);
+    temp1_16x16b = _mm256_abs_epi16(_mm256_sub_epi16(p1_16x16b, p0_16x16b));
+    temp1_16x16b = _mm256_cmpgt_epi16(beta_16x16b, temp1_16x16b);
+    flag_16x16b = _mm256_and_si256(flag_16x16b, temp1_16x16b);
+
+    /* a_p < beta and a_q < beta, as all ones masks */
+    temp1_16x16b = _mm256_abs_epi16(_mm256_sub_epi16(p2_16x16b, p0_16x16b));
+    ap_16x16b = _mm256_cmpgt_epi16(beta_16x16b, temp1_16x16b);
+    temp1_16x16b = _mm256_abs_epi16(_mm256_sub_epi16(q2_16x16b, q0_16x16b));
+    aq_16x16b = _mm256_cmpgt_epi16(beta_16x16b, temp1_16x16b);
+
+    /* tc = tc0 + (a_p < beta) + (a_q < beta) */
+    tc_16x16b = _mm256_sub_epi16(tc0_16x16b, ap_16x16b);
+    tc_16x16b = _mm256_sub_epi16(tc_16x16b, aq_16x16b);
+
+    /* delta = CLIP3(-tc, tc, ((((q0 - p0) << 2) + (p1 - q1) + 4) >> 3)) */
+    delta_16x16b = _mm256_slli_epi16(_mm256_sub_epi16(q0_16x16b, p0_16x16b), 2);
+    delta_16x16b = _mm256_add_epi16(delta_16x16b,
+                                    _mm256_sub_epi16(p1_16x16b, q1_16x16b));
+    delta_16x16b = _mm256_add_epi16(delta_16x16b, _mm256_set1_epi16(4));
+    delta_16x16b = _mm256_srai_epi16(delta_16x16b, 3);
+    delta_16x16b = _mm256_min_epi16(delta_16x16b, tc_16x16b);
+    delta_16x16b = _mm256_max_epi16(delta_16x16b,
+                                    _mm256_sub_epi16(zero_16x16b, tc_16x16b));
+
+    /* p1' and q1' use the unfiltered p0 and q0 */
+    avg_16x16b = _mm256_avg_epu16(p0_16x16b, q0_16x16b);
+
+    temp1_16x16b = _mm256_add_epi16(p2_16x16b, avg_16x16b);
+    temp1_16x16b = _mm256_sub_epi16(temp1_16x16b, _mm256_slli_epi16(p1_16x16b, 1));
+    temp1_16x16b = _mm256_srai_epi16(temp1_16x16b, 1);
+    temp1_16x16b = _mm256_min_epi16(temp1_16x16b, tc0_16x16b);
+    temp1_16x16b = _mm256_max_epi16(temp1_16x16b,
+                                    _mm256_sub_epi16(zero_16x16b, tc0_16x16b));
+    temp1_16x16b = _mm256_add_epi16(p1_16x16b, temp1_16x16b);
+
+    temp2_16x16b = _mm256_add_epi16(q2_16x16b, avg_16x16b);
+    temp2_16x16b = _mm256_sub_epi16(temp2_16x16b, _mm256_slli_epi16(q1_16x16b, 1));
+    temp2_16x16b = _mm256_srai_epi16(temp2_16x16b, 1);
+    temp2_16x16b = _mm256_min_epi16(temp2_16x16b, tc0_16x16b);
+    temp2_16x16b = _mm256_max_epi16(temp2_16x16b,
+                                    _mm256_sub_epi16(zero_16x16b, tc0_16x16b));
+    temp2_16x16b = _mm256_add_epi16(q1_16x16b, temp2_16x16b);
+
+    ap_16x16b = _mm256_and_si256(ap_16x16b, flag_16x16b);
+    aq_16x16b = _mm256_and_si256(aq_16x16b, flag_16x16b);
+    *pp1_16x16b = _mm256_blendv_epi8(p1_16x16b, temp1_16x16b, ap_16x16b);
+    *pq1_16x16b = _mm256_blendv_epi8(q1_16x16b, temp2_16x16b, aq_16x16b);
+
+    /* p0' and q0' */
+    temp1_16x16b = _mm256_add_epi16(p0_16x16b, delta_16x16b);
+    temp1_16x16b = _mm256_min_epi16(_mm256_max_epi16(temp1_16x16b, zero_16x16b),
+                                    max_16x16b);
+    temp2_16x16b = _mm256_sub_epi16(q0_16x16b, delta_16x16b);
+    temp2_16x16b = _mm256_min_epi16(_mm256_max_epi16(temp2_16x16b, zero_16x16b),
+                                    max_16x16b);
+
+    *pp0_16x16b = _mm256_blendv_epi8(p0_16x16b, temp1_16x16b, flag_16x16b);
+    *pq0_16x16b = _mm256_blendv_epi8(q0_16x16b, temp2_16x16b, flag_16x16b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_vert_inner_bslt4_avx2()                 */
+/*                                                                           */
+/*  Description   : This function filters the three inner vertical luma      */
+/*                  edges of a macroblock when the boundary strength is      */
+/*                  less than 4. The macroblock is transposed once, the      */
+/*                  edges are filtered on its columns and the result is      */
+/*                  transposed back                                          */
+/*                                                                           */
+/*  Inputs        : pu1_src       - pointer to the top left sample of the MB */
+/*                  src_strd      - source stride                            */
+/*                  alpha         - alpha value for the inner edges          */
+/*                  beta          - beta value for the inner edges           */
+/*                  pu4_bs        - packed bs of the edges 1, 2 and 3        */
+/*                  pu1_cliptab   - tc0_table                                */
+/*                  pf_deblk_edge - unused                                   */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_luma_vert_inner_bslt4_avx2(UWORD8 *pu1_src,
+                                            WORD32 src_strd,
+                                            WORD32 alpha,
+                                            WORD32 beta,
+                                            const UWORD32 *pu4_bs,
+                                            const UWORD8 *pu1_cliptab,
+                                            ih264_deblk_edge_bslt4_ft *pf_deblk_edge)
+{
+    __m128i x_16x8b[16];
+    __m256i col_16x16b[16];
+    WORD32 i, edge;
+
+    UNUSED(pf_deblk_edge);
+
+    if(!(pu4_bs[0] | pu4_bs[1] | pu4_bs[2]))
+        return;
+
+    for(i = 0; i < 16; i++)
+    {
+        x_16x8b[i] = _mm_loadu_si128((__m128i *)(pu1_src + i * src_strd));
+    }
+    ih264_deblk_transpose_16x16_avx2(x_16x8b);
+
+    for(i = 0; i < 16; i++)
+    {
+        col_16x16b[i] = _mm256_cvtepu8_epi16(x_16x8b[i]);
+    }
+
+    for(edge = 0; edge < 3; edge++)
+    {
+        __m256i tc0_16x16b, bs_16x16b;
+        /* column of p0 */
+        WORD32 p0 = (edge << 2) + 3;
+
+        if(!pu4_bs[edge])
+            continue;
+
+        tc0_16x16b = ih264_deblk_luma_tc0_avx2(pu4_bs[edge], pu1_cliptab,
+                                               &bs_16x16b);
+        ih264_deblk_luma_bslt4_16x16b_avx2(&col_16x16b[p0 - 1],
+                                           &col_16x16b[p0],
+                                           &col_16x16b[p0 + 1],
+                                           &col_16x16b[p0 + 2],
+                                           col_16x16b[p0 - 2],
+                                           col_16x16b[p0 + 3],
+                                           alpha, beta, tc0_16x16b, bs_16x16b);
+    }
+
+    for(i = 0; i < 16; i += 2)
+    {
+        __m256i res_32x8b;
+
+        res_32x8b = _mm256_packus_epi16(col_16x16b[i], col_16x16b[i + 1]);
+        res_32x8b = _mm256_permute4x64_epi64(res_32x8b, 0xD8);
+        x_16x8b[i] = _mm256_castsi256_si128(res_32x8b);
+        x_16x8b[i + 1] = _mm256_extracti128_si256(res_32x8b, 1);
+    }
+    ih264_deblk_transpose_16x16_avx2(x_16x8b);
+
+    for(i = 0; i < 16; i++)
+    {
+        _mm_storeu_si128((__m128i *)(pu1_src + i * src_strd), x_16x8b[i]);
+    }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_horz_inner_bslt4_avx2()                 */
+/*                                                                           */
+/*  Description   : This function filters the three inner horizontal luma    */
+/*                  edges of a macroblock when the boundary strength is      */
+/*                  less than 4. The rows 1 to 14 of the macroblock are      */
+/*                  loaded once and kept in registers across the edges       */
+/*                                                                           */
+/*  Inputs        : pu1_src       - pointer to the top left sample of the MB */
+/*                  src_strd      - source stride                            */
+/*                  alpha         - alpha value for the inner edges          */
+/*                  beta          - beta value for the inner edges           */
+/*                  pu4_bs        - packed bs of the edges 1, 2 and 3        */
+/*                  pu1_cliptab   - tc0_table                                */
+/*                  pf_deblk_edge - unused                                   */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_luma_horz_inner_bslt4_avx2(UWORD8 *pu1_src,
+                                            WORD32 src_strd,
+                                            WORD32 alpha,
+                                            WORD32 beta,
+                                            const UWORD32 *pu4_bs,
+                                            const UWORD8 *pu1_cliptab,
+                                            ih264_deblk_edge_bslt4_ft *pf_deblk_edge)
+{
+    __m256i row_16x16b[15];
+    WORD32 i, edge;
+
+    UNUSED(pf_deblk_edge);
+
+    if(!(pu4_bs[0] | pu4_bs[1] | pu4_bs[2]))
+        return;
+
+    for(i = 1; i < 15; i++)
+    {
+        __m128i src_16x8b = _mm_loadu_si128((__m128i *)(pu1_src + i * src_strd));
+
+        row_16x16b[i] = _mm256_cvtepu8_epi16(src_16x8b);
+    }
+
+    /* The rows modified by an edge are not modified by the other edges */
+    for(edge = 0; edge < 3; edge++)
+    {
+        __m256i tc0_16x16b, bs_16x16b;
+        /* row of p0 */
+        WORD32 p0 = (edge << 2) + 3;
+
+        if(!pu4_bs[edge])
+            continue;
+
+        tc0_16x16b = ih264_deblk_luma_tc0_avx2(pu4_bs[edge], pu1_cliptab,
+                                               &bs_16x16b);
+        ih264_deblk_luma_bslt4_16x16b_avx2(&row_16x16b[p0 - 1],
+                                           &row_16x16b[p0],
+                                           &row_16x16b[p0 + 1],
+                                           &row_16x16b[p0 + 2],
+                                           row_16x16b[p0 - 2],
+                                           row_16x16b[p0 + 3],
+                                           alpha, beta, tc0_16x16b, bs_16x16b);
+
+        for(i = p0 - 1; i < p0 + 3; i += 2)
+        {
+            __m256i res_32x8b;
+
+            res_32x8b = _mm256_packus_epi16(row_16x16b[i], row_16x16b[i + 1]);
+            res_32x8b = _mm256_permute4x64_epi64(res_32x8b, 0xD8);
+            _mm_storeu_si128((__m128i *)(pu1_src + i * src_strd),
+                             _mm256_castsi256_si128(res_32x8b));
+            _mm_storeu_si128((__m128i *)(pu1_src + (i + 1) * src_strd),
+                             _mm256_extracti128_si256(res_32x8b, 1));
+        }
+    }
+}
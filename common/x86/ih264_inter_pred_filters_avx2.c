@@ -0,0 +1,924 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264_inter_pred_filters_avx2.c                      */
+/*                                                                           */
+/*  Description       : Contains function definitions for luma inter         */
+/*                      prediction functions in x86 avx2 intrinsics          */
+/*                                                                           */
+/*  List of Functions : ih264_inter_pred_luma_horz_avx2()                    */
+/*                      ih264_inter_pred_luma_vert_avx2()                    */
+/*                      ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2()     */
+/*                      ih264_inter_pred_luma_horz_qpel_avx2()               */
+/*                      ih264_inter_pred_luma_vert_qpel_avx2()               */
+/*                      ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2()     */
+/*                      ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2()     */
+/*                      ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2()     */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*  Revision History  :                                                      */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes                              */
+/*         13 02 2015   Kaushik         Initial version                      */
+/*                      Senthoor                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+#include <immintrin.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_inter_pred_filters.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+
+/* Stride of the 16 bit intermediate buffer of the 2D filters. A row holds */
+/* the columns -2 to 21, of which -2 to 18 are needed for 16 output pixels */
+#define HV_TMP_STRD 24
+
+/*****************************************************************************/
+/*  Function definitions .                                                   */
+/*****************************************************************************/
+/*  All the functions below work on 16 pixel wide blocks, two rows at a time */
+/*  in the two 128 bit lanes. 4 and 8 pixel wide blocks are passed on to the */
+/*  ssse3 functions. The outputs are bit exact with the C functions          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_horz_hpel_16x2_avx2                           */
+/*                                                                           */
+/*  Description   : Applies the horizontal 6-tap filter on two rows of 16    */
+/*                  pixels and returns the clipped results, row 0 in the     */
+/*                  lower lane and row 1 in the upper lane                   */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to the first pixel of row 0           */
+/*                  src_strd - stride for source                             */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m256i ih264_luma_horz_hpel_16x2_avx2(UWORD8 *pu1_src,
+                                                       WORD32 src_strd)
+{
+    __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+    __m256i shuf0_1_32x8b, shuf2_3_32x8b, shuf4_5_32x8b;
+    __m256i const_val16_16x16b;
+    __m256i src_r0_32x8b, src_r1_32x8b;
+    __m256i res_r0_16x16b, res_r1_16x16b, res_t_16x16b;
+
+    coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 = c5 = 1, c1 = c4 = -5
+    coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 = c3 = 20
+    coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB);
+    const_val16_16x16b = _mm256_set1_epi16(16);
+
+    /* Pairs of pixels (x[n], x[n + 1]) for the taps c0 c1, c2 c3 and c4 c5 */
+    shuf0_1_32x8b = _mm256_setr_epi8(0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+                                     0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8);
+    shuf2_3_32x8b = _mm256_add_epi8(shuf0_1_32x8b, _mm256_set1_epi8(2));
+    shuf4_5_32x8b = _mm256_add_epi8(shuf0_1_32x8b, _mm256_set1_epi8(4));
+
+    pu1_src -= 2;
+
+    /* Lower lane holds x[-2] to x[13] for the columns 0 to 7, upper lane */
+    /* holds x[6] to x[21] for the columns 8 to 15                        */
+    src_r0_32x8b = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src));
+    src_r0_32x8b = _mm256_inserti128_si256(src_r0_32x8b,
+                        _mm_loadu_si128((__m128i *)(pu1_src + 8)), 1);
+    src_r1_32x8b = _mm256_castsi128_si256(
+                        _mm_loadu_si128((__m128i *)(pu1_src + src_strd)));
+    src_r1_32x8b = _mm256_inserti128_si256(src_r1_32x8b,
+                        _mm_loadu_si128((__m128i *)(pu1_src + src_strd + 8)), 1);
+
+    res_r0_16x16b = _mm256_maddubs_epi16(
+                        _mm256_shuffle_epi8(src_r0_32x8b, shuf0_1_32x8b), coeff0_1_32x8b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_shuffle_epi8(src_r0_32x8b, shuf2_3_32x8b), coeff2_3_32x8b);
+    res_r0_16x16b = _mm256_add_epi16(res_r0_16x16b, res_t_16x16b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_shuffle_epi8(src_r0_32x8b, shuf4_5_32x8b), coeff4_5_32x8b);
+    res_t_16x16b = _mm256_add_epi16(res_t_16x16b, const_val16_16x16b);
+    res_r0_16x16b = _mm256_add_epi16(res_r0_16x16b, res_t_16x16b);
+
+    res_r1_16x16b = _mm256_maddubs_epi16(
+                        _mm256_shuffle_epi8(src_r1_32x8b, shuf0_1_32x8b), coeff0_1_32x8b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_shuffle_epi8(src_r1_32x8b, shuf2_3_32x8b), coeff2_3_32x8b);
+    res_r1_16x16b = _mm256_add_epi16(res_r1_16x16b, res_t_16x16b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_shuffle_epi8(src_r1_32x8b, shuf4_5_32x8b), coeff4_5_32x8b);
+    res_t_16x16b = _mm256_add_epi16(res_t_16x16b, const_val16_16x16b);
+    res_r1_16x16b = _mm256_add_epi16(res_r1_16x16b, res_t_16x16b);
+
+    res_r0_16x16b = _mm256_srai_epi16(res_r0_16x16b, 5);
+    res_r1_16x16b = _mm256_srai_epi16(res_r1_16x16b, 5);
+
+    /* r0 c0-7, r1 c0-7 | r0 c8-15, r1 c8-15 to r0 c0-15 | r1 c0-15 */
+    res_r0_16x16b = _mm256_packus_epi16(res_r0_16x16b, res_r1_16x16b);
+    return _mm256_permute4x64_epi64(res_r0_16x16b, 0xD8);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_vert_hpel_16x2_avx2                           */
+/*                                                                           */
+/*  Description   : Applies the vertical 6-tap filter on two rows of 16      */
+/*                  pixels and returns the clipped results, row 0 in the     */
+/*                  lower lane and row 1 in the upper lane                   */
+/*                                                                           */
+/*  Inputs        : src_rNrM_32x8b - source rows N and M relative to row 0  */
+/*                  in the lower and the upper lane, for rows -2 to 4        */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m256i ih264_luma_vert_hpel_16x2_avx2(__m256i src_rm2rm1_32x8b,
+                                                       __m256i src_rm1r0_32x8b,
+                                                       __m256i src_r0r1_32x8b,
+                                                       __m256i src_r1r2_32x8b,
+                                                       __m256i src_r2r3_32x8b,
+                                                       __m256i src_r3r4_32x8b)
+{
+    __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+    __m256i const_val16_16x16b;
+    __m256i res_lo_16x16b, res_hi_16x16b, res_t_16x16b;
+
+    coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 = c5 = 1, c1 = c4 = -5
+    coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 = c3 = 20
+    coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB);
+    const_val16_16x16b = _mm256_set1_epi16(16);
+
+    /* Columns 0 to 7 of both the rows */
+    res_lo_16x16b = _mm256_maddubs_epi16(
+                        _mm256_unpacklo_epi8(src_rm2rm1_32x8b, src_rm1r0_32x8b), coeff0_1_32x8b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_unpacklo_epi8(src_r0r1_32x8b, src_r1r2_32x8b), coeff2_3_32x8b);
+    res_lo_16x16b = _mm256_add_epi16(res_lo_16x16b, res_t_16x16b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_unpacklo_epi8(src_r2r3_32x8b, src_r3r4_32x8b), coeff4_5_32x8b);
+    res_t_16x16b = _mm256_add_epi16(res_t_16x16b, const_val16_16x16b);
+    res_lo_16x16b = _mm256_add_epi16(res_lo_16x16b, res_t_16x16b);
+
+    /* Columns 8 to 15 of both the rows */
+    res_hi_16x16b = _mm256_maddubs_epi16(
+                        _mm256_unpackhi_epi8(src_rm2rm1_32x8b, src_rm1r0_32x8b), coeff0_1_32x8b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_unpackhi_epi8(src_r0r1_32x8b, src_r1r2_32x8b), coeff2_3_32x8b);
+    res_hi_16x16b = _mm256_add_epi16(res_hi_16x16b, res_t_16x16b);
+    res_t_16x16b = _mm256_maddubs_epi16(
+                        _mm256_unpackhi_epi8(src_r2r3_32x8b, src_r3r4_32x8b), coeff4_5_32x8b);
+    res_t_16x16b = _mm256_add_epi16(res_t_16x16b, const_val16_16x16b);
+    res_hi_16x16b = _mm256_add_epi16(res_hi_16x16b, res_t_16x16b);
+
+    res_lo_16x16b = _mm256_srai_epi16(res_lo_16x16b, 5);
+    res_hi_16x16b = _mm256_srai_epi16(res_hi_16x16b, 5);
+
+    return _mm256_packus_epi16(res_lo_16x16b, res_hi_16x16b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_load_16x2_avx2                                */
+/*                                                                           */
+/*  Description   : Loads 16 pixels of two rows, row 0 in the lower lane and */
+/*                  row 1 in the upper lane                                  */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m256i ih264_luma_load_16x2_avx2(UWORD8 *pu1_src,
+                                                  WORD32 src_strd)
+{
+    __m256i src_32x8b;
+
+    src_32x8b = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src));
+    return _mm256_inserti128_si256(src_32x8b,
+                        _mm_loadu_si128((__m128i *)(pu1_src + src_strd)), 1);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_store_16x2_avx2                               */
+/*                                                                           */
+/*  Description   : Stores 16 pixels of two rows from the lower and the      */
+/*                  upper lane                                               */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264_luma_store_16x2_avx2(UWORD8 *pu1_dst,
+                                                WORD32 dst_strd,
+                                                __m256i res_32x8b)
+{
+    _mm_storeu_si128((__m128i *)pu1_dst, _mm256_castsi256_si128(res_32x8b));
+    _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd),
+                     _mm256_extracti128_si256(res_32x8b, 1));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_hv_first_pass_avx2                            */
+/*                                                                           */
+/*  Description   : First stage of the 2D filters. Applies the vertical      */
+/*                  6-tap filter on the columns -2 to 21 of ht rows and      */
+/*                  stores the unclipped 16 bit results, HV_TMP_STRD per row */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to the first pixel of row 0           */
+/*                  src_strd - stride for source                             */
+/*                  ht       - number of rows                                */
+/*                  pi2_tmp  - intermediate buffer, pi2_tmp[0] is column -2  */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264_luma_hv_first_pass_avx2(UWORD8 *pu1_src,
+                                          WORD32 src_strd,
+                                          WORD32 ht,
+                                          WORD16 *pi2_tmp)
+{
+    __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+    __m256i src_r0_32x8b, src_r1_32x8b, src_r2_32x8b, src_r3_32x8b;
+    __m256i src_r4_32x8b, src_r5_32x8b;
+    __m256i res_lo_16x16b, res_hi_16x16b, res_t_16x16b;
+
+    coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 = c5 = 1, c1 = c4 = -5
+    coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 = c3 = 20
+    coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB);
+
+    /* Each row holds x[-2] to x[13] in the lower lane and x[6] to x[21] */
+    /* in the upper lane                                                 */
+    pu1_src -= (src_strd << 1) + 2;
+
+    src_r0_32x8b = ih264_luma_load_16x2_avx2(pu1_src, 8);
+    pu1_src += src_strd;
+    src_r1_32x8b = ih264_luma_load_16x2_avx2(pu1_src, 8);
+    pu1_src += src_strd;
+    src_r2_32x8b = ih264_luma_load_16x2_avx2(pu1_src, 8);
+    pu1_src += src_strd;
+    src_r3_32x8b = ih264_luma_load_16x2_avx2(pu1_src, 8);
+    pu1_src += src_strd;
+    src_r4_32x8b = ih264_luma_load_16x2_avx2(pu1_src, 8);
+    pu1_src += src_strd;
+
+    do
+    {
+        src_r5_32x8b = ih264_luma_load_16x2_avx2(pu1_src, 8);
+
+        /* Columns -2 to 5 | 6 to 13 */
+        res_lo_16x16b = _mm256_maddubs_epi16(
+                            _mm256_unpacklo_epi8(src_r0_32x8b, src_r1_32x8b), coeff0_1_32x8b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_unpacklo_epi8(src_r2_32x8b, src_r3_32x8b), coeff2_3_32x8b);
+        res_lo_16x16b = _mm256_add_epi16(res_lo_16x16b, res_t_16x16b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_unpacklo_epi8(src_r4_32x8b, src_r5_32x8b), coeff4_5_32x8b);
+        res_lo_16x16b = _mm256_add_epi16(res_lo_16x16b, res_t_16x16b);
+
+        /* Columns 6 to 13 | 14 to 21 */
+        res_hi_16x16b = _mm256_maddubs_epi16(
+                            _mm256_unpackhi_epi8(src_r0_32x8b, src_r1_32x8b), coeff0_1_32x8b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_unpackhi_epi8(src_r2_32x8b, src_r3_32x8b), coeff2_3_32x8b);
+        res_hi_16x16b = _mm256_add_epi16(res_hi_16x16b, res_t_16x16b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_unpackhi_epi8(src_r4_32x8b, src_r5_32x8b), coeff4_5_32x8b);
+        res_hi_16x16b = _mm256_add_epi16(res_hi_16x16b, res_t_16x16b);
+
+        _mm256_storeu_si256((__m256i *)pi2_tmp, res_lo_16x16b);
+        _mm256_storeu_si256((__m256i *)(pi2_tmp + 8), res_hi_16x16b);
+
+        src_r0_32x8b = src_r1_32x8b;
+        src_r1_32x8b = src_r2_32x8b;
+        src_r2_32x8b = src_r3_32x8b;
+        src_r3_32x8b = src_r4_32x8b;
+        src_r4_32x8b = src_r5_32x8b;
+
+        ht--;
+        pu1_src += src_strd;
+        pi2_tmp += HV_TMP_STRD;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_hv_second_pass_16x1_avx2                      */
+/*                                                                           */
+/*  Description   : Second stage of the 2D filters. Applies the horizontal   */
+/*                  6-tap filter on a row of the first stage output and      */
+/*                  returns the rounded 16 bit results of the columns 0 to 7 */
+/*                  in the lower lane and 8 to 15 in the upper lane          */
+/*                                                                           */
+/*  Inputs        : pi2_tmp - first stage output of the row                  */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m256i ih264_luma_hv_second_pass_16x1_avx2(WORD16 *pi2_tmp)
+{
+    __m256i coeff0_1_16x16b, coeff2_3_16x16b, coeff4_5_16x16b;
+    __m256i const_val512_8x32b;
+    __m256i res_even_8x32b, res_odd_8x32b;
+
+    coeff0_1_16x16b = _mm256_set1_epi32(0xFFFB0001); //c0 = c5 = 1, c1 = c4 = -5
+    coeff2_3_16x16b = _mm256_set1_epi32(0x00140014); //c2 = c3 = 20
+    coeff4_5_16x16b = _mm256_set1_epi32(0x0001FFFB);
+    const_val512_8x32b = _mm256_set1_epi32(512);
+
+    /* The pairs starting at even offsets give the even columns and the */
+    /* pairs starting at odd offsets give the odd columns               */
+    res_even_8x32b = _mm256_madd_epi16(
+                        _mm256_loadu_si256((__m256i *)pi2_tmp), coeff0_1_16x16b);
+    res_even_8x32b = _mm256_add_epi32(res_even_8x32b, _mm256_madd_epi16(
+                        _mm256_loadu_si256((__m256i *)(pi2_tmp + 2)), coeff2_3_16x16b));
+    res_even_8x32b = _mm256_add_epi32(res_even_8x32b, _mm256_madd_epi16(
+                        _mm256_loadu_si256((__m256i *)(pi2_tmp + 4)), coeff4_5_16x16b));
+
+    res_odd_8x32b = _mm256_madd_epi16(
+                        _mm256_loadu_si256((__m256i *)(pi2_tmp + 1)), coeff0_1_16x16b);
+    res_odd_8x32b = _mm256_add_epi32(res_odd_8x32b, _mm256_madd_epi16(
+                        _mm256_loadu_si256((__m256i *)(pi2_tmp + 3)), coeff2_3_16x16b));
+    res_odd_8x32b = _mm256_add_epi32(res_odd_8x32b, _mm256_madd_epi16(
+                        _mm256_loadu_si256((__m256i *)(pi2_tmp + 5)), coeff4_5_16x16b));
+
+    res_even_8x32b = _mm256_add_epi32(res_even_8x32b, const_val512_8x32b);
+    res_odd_8x32b = _mm256_add_epi32(res_odd_8x32b, const_val512_8x32b);
+    res_even_8x32b = _mm256_srai_epi32(res_even_8x32b, 10);
+    res_odd_8x32b = _mm256_srai_epi32(res_odd_8x32b, 10);
+
+    /* The results fit in 16 bits, interleave them to c0 to c15 */
+    return _mm256_blend_epi16(res_even_8x32b,
+                              _mm256_slli_epi32(res_odd_8x32b, 16), 0xAA);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_hv_second_pass_16x2_avx2                      */
+/*                                                                           */
+/*  Description   : Applies the second stage of the 2D filters on two rows   */
+/*                  and returns the clipped results, row 0 in the lower lane */
+/*                  and row 1 in the upper lane                              */
+/*                                                                           */
+/*  Inputs        : pi2_tmp - first stage output of row 0                    */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m256i ih264_luma_hv_second_pass_16x2_avx2(WORD16 *pi2_tmp)
+{
+    __m256i res_r0_16x16b, res_r1_16x16b;
+
+    res_r0_16x16b = ih264_luma_hv_second_pass_16x1_avx2(pi2_tmp);
+    res_r1_16x16b = ih264_luma_hv_second_pass_16x1_avx2(pi2_tmp + HV_TMP_STRD);
+
+    res_r0_16x16b = _mm256_packus_epi16(res_r0_16x16b, res_r1_16x16b);
+    return _mm256_permute4x64_epi64(res_r0_16x16b, 0xD8);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_luma_hv_vert_hpel_16x2_avx2                        */
+/*                                                                           */
+/*  Description   : Rounds and clips two rows of the first stage output of   */
+/*                  the 2D filters to the vertical hpel pixels, row 0 in the */
+/*                  lower lane and row 1 in the upper lane                   */
+/*                                                                           */
+/*  Inputs        : pi2_tmp - first stage output of row 0 at the first       */
+/*                  column                                                   */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m256i ih264_luma_hv_vert_hpel_16x2_avx2(WORD16 *pi2_tmp)
+{
+    __m256i const_val16_16x16b;
+    __m256i res_r0_16x16b, res_r1_16x16b;
+
+    const_val16_16x16b = _mm256_set1_epi16(16);
+
+    res_r0_16x16b = _mm256_loadu_si256((__m256i *)pi2_tmp);
+    res_r1_16x16b = _mm256_loadu_si256((__m256i *)(pi2_tmp + HV_TMP_STRD));
+    res_r0_16x16b = _mm256_srai_epi16(
+                        _mm256_add_epi16(res_r0_16x16b, const_val16_16x16b), 5);
+    res_r1_16x16b = _mm256_srai_epi16(
+                        _mm256_add_epi16(res_r1_16x16b, const_val16_16x16b), 5);
+
+    res_r0_16x16b = _mm256_packus_epi16(res_r0_16x16b, res_r1_16x16b);
+    return _mm256_permute4x64_epi64(res_r0_16x16b, 0xD8);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_avx2                          */
+/*                                                                           */
+/*  Description   : This function applies a horizontal 6-tap filter on       */
+/*                  ht x wd block as mentioned in sec. 8.4.2.2.1 titled      */
+/*                  "Luma sample interpolation process". (ht,wd) can be      */
+/*                  (4,4), (8,4), (4,8), (8,8), (16,8), (8,16) or (16,16).   */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_avx2(UWORD8 *pu1_src,
+                                     UWORD8 *pu1_dst,
+                                     WORD32 src_strd,
+                                     WORD32 dst_strd,
+                                     WORD32 ht,
+                                     WORD32 wd,
+                                     UWORD8* pu1_tmp,
+                                     WORD32 dydx)
+{
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_horz_ssse3(pu1_src, pu1_dst, src_strd, dst_strd,
+                                         ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    do
+    {
+        __m256i res_32x8b;
+
+        res_32x8b = ih264_luma_horz_hpel_16x2_avx2(pu1_src, src_strd);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_32x8b);
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_vert_avx2                          */
+/*                                                                           */
+/*  Description   : This function applies a vertical 6-tap filter on         */
+/*                  ht x wd block as mentioned in sec. 8.4.2.2.1 titled      */
+/*                  "Luma sample interpolation process". (ht,wd) can be      */
+/*                  (4,4), (8,4), (4,8), (8,8), (16,8), (8,16) or (16,16).   */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_vert_avx2(UWORD8 *pu1_src,
+                                     UWORD8 *pu1_dst,
+                                     WORD32 src_strd,
+                                     WORD32 dst_strd,
+                                     WORD32 ht,
+                                     WORD32 wd,
+                                     UWORD8* pu1_tmp,
+                                     WORD32 dydx)
+{
+    __m256i src_r0r1_32x8b, src_r1r2_32x8b, src_r2r3_32x8b, src_r3r4_32x8b;
+    __m256i src_r4r5_32x8b, src_r5r6_32x8b;
+
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_vert_ssse3(pu1_src, pu1_dst, src_strd, dst_strd,
+                                         ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    pu1_src -= src_strd << 1; // the filter input starts from x[-2] (till x[3])
+
+    src_r0r1_32x8b = ih264_luma_load_16x2_avx2(pu1_src, src_strd);
+    src_r1r2_32x8b = ih264_luma_load_16x2_avx2(pu1_src + src_strd, src_strd);
+    src_r2r3_32x8b = ih264_luma_load_16x2_avx2(pu1_src + 2 * src_strd, src_strd);
+    src_r3r4_32x8b = ih264_luma_load_16x2_avx2(pu1_src + 3 * src_strd, src_strd);
+    pu1_src += src_strd << 2;
+
+    do
+    {
+        __m256i res_32x8b;
+
+        src_r4r5_32x8b = ih264_luma_load_16x2_avx2(pu1_src, src_strd);
+        src_r5r6_32x8b = ih264_luma_load_16x2_avx2(pu1_src + src_strd, src_strd);
+
+        res_32x8b = ih264_luma_vert_hpel_16x2_avx2(src_r0r1_32x8b, src_r1r2_32x8b,
+                                                   src_r2r3_32x8b, src_r3r4_32x8b,
+                                                   src_r4r5_32x8b, src_r5r6_32x8b);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_32x8b);
+
+        src_r0r1_32x8b = src_r2r3_32x8b;
+        src_r1r2_32x8b = src_r3r4_32x8b;
+        src_r2r3_32x8b = src_r4r5_32x8b;
+        src_r3r4_32x8b = src_r5r6_32x8b;
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2           */
+/*                                                                           */
+/*  Description   : This function implements a two stage cascaded six tap    */
+/*                  filter, vertical followed by horizontal, to obtain the   */
+/*                  pixel at (1/2,1/2) of ht x wd block as mentioned in sec. */
+/*                  8.4.2.2.1 titled "Luma sample interpolation process".    */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - temporary buffer (used by the ssse3 function) */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2(UWORD8 *pu1_src,
+                                                    UWORD8 *pu1_dst,
+                                                    WORD32 src_strd,
+                                                    WORD32 dst_strd,
+                                                    WORD32 ht,
+                                                    WORD32 wd,
+                                                    UWORD8* pu1_tmp,
+                                                    WORD32 dydx)
+{
+    WORD16 ai2_tmp[16 * HV_TMP_STRD];
+    WORD16 *pi2_tmp;
+
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_horz_hpel_vert_hpel_ssse3(pu1_src, pu1_dst,
+                                                        src_strd, dst_strd,
+                                                        ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    ih264_luma_hv_first_pass_avx2(pu1_src, src_strd, ht, ai2_tmp);
+
+    pi2_tmp = ai2_tmp;
+    do
+    {
+        __m256i res_32x8b;
+
+        res_32x8b = ih264_luma_hv_second_pass_16x2_avx2(pi2_tmp);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_32x8b);
+
+        ht -= 2;
+        pi2_tmp += HV_TMP_STRD << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_avx2                     */
+/*                                                                           */
+/*  Description   : This function applies a horizontal 6-tap filter on       */
+/*                  ht x wd block and averages the result with the nearest   */
+/*                  full pel pixel to obtain the pixels at (1/4,0) and       */
+/*                  (3/4,0) as mentioned in sec. 8.4.2.2.1 titled "Luma      */
+/*                  sample interpolation process".                           */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_qpel_avx2(UWORD8 *pu1_src,
+                                          UWORD8 *pu1_dst,
+                                          WORD32 src_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 ht,
+                                          WORD32 wd,
+                                          UWORD8* pu1_tmp,
+                                          WORD32 dydx)
+{
+    UWORD8 *pu1_pred1;
+
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_horz_qpel_ssse3(pu1_src, pu1_dst, src_strd,
+                                              dst_strd, ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    pu1_pred1 = pu1_src + ((dydx & 3) >> 1);
+
+    do
+    {
+        __m256i res_32x8b, pred1_32x8b;
+
+        res_32x8b = ih264_luma_horz_hpel_16x2_avx2(pu1_src, src_strd);
+        pred1_32x8b = ih264_luma_load_16x2_avx2(pu1_pred1, src_strd);
+        res_32x8b = _mm256_avg_epu8(res_32x8b, pred1_32x8b);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_32x8b);
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_pred1 += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_vert_qpel_avx2                     */
+/*                                                                           */
+/*  Description   : This function applies a vertical 6-tap filter on         */
+/*                  ht x wd block and averages the result with the nearest   */
+/*                  full pel pixel to obtain the pixels at (0,1/4) and       */
+/*                  (0,3/4) as mentioned in sec. 8.4.2.2.1 titled "Luma      */
+/*                  sample interpolation process".                           */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_vert_qpel_avx2(UWORD8 *pu1_src,
+                                          UWORD8 *pu1_dst,
+                                          WORD32 src_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 ht,
+                                          WORD32 wd,
+                                          UWORD8* pu1_tmp,
+                                          WORD32 dydx)
+{
+    __m256i src_r0r1_32x8b, src_r1r2_32x8b, src_r2r3_32x8b, src_r3r4_32x8b;
+    __m256i src_r4r5_32x8b, src_r5r6_32x8b;
+    WORD32 y_offset = (dydx >> 2) & 3;
+
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_vert_qpel_ssse3(pu1_src, pu1_dst, src_strd,
+                                              dst_strd, ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    pu1_src -= src_strd << 1; // the filter input starts from x[-2] (till x[3])
+
+    src_r0r1_32x8b = ih264_luma_load_16x2_avx2(pu1_src, src_strd);
+    src_r1r2_32x8b = ih264_luma_load_16x2_avx2(pu1_src + src_strd, src_strd);
+    src_r2r3_32x8b = ih264_luma_load_16x2_avx2(pu1_src + 2 * src_strd, src_strd);
+    src_r3r4_32x8b = ih264_luma_load_16x2_avx2(pu1_src + 3 * src_strd, src_strd);
+    pu1_src += src_strd << 2;
+
+    do
+    {
+        __m256i res_32x8b;
+
+        src_r4r5_32x8b = ih264_luma_load_16x2_avx2(pu1_src, src_strd);
+        src_r5r6_32x8b = ih264_luma_load_16x2_avx2(pu1_src + src_strd, src_strd);
+
+        res_32x8b = ih264_luma_vert_hpel_16x2_avx2(src_r0r1_32x8b, src_r1r2_32x8b,
+                                                   src_r2r3_32x8b, src_r3r4_32x8b,
+                                                   src_r4r5_32x8b, src_r5r6_32x8b);
+
+        /* Rows 0, 1 or rows 1, 2 are the nearest full pel pixels */
+        res_32x8b = _mm256_avg_epu8(res_32x8b,
+                        (y_offset >> 1) ? src_r3r4_32x8b : src_r2r3_32x8b);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_32x8b);
+
+        src_r0r1_32x8b = src_r2r3_32x8b;
+        src_r1r2_32x8b = src_r3r4_32x8b;
+        src_r2r3_32x8b = src_r4r5_32x8b;
+        src_r3r4_32x8b = src_r5r6_32x8b;
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2           */
+/*                                                                           */
+/*  Description   : This function applies the horizontal and the vertical    */
+/*                  6-tap filters on ht x wd block and averages the two      */
+/*                  results to obtain the pixels at (1/4,1/4), (1/4,3/4),    */
+/*                  (3/4,1/4) and (3/4,3/4) as mentioned in sec. 8.4.2.2.1   */
+/*                  titled "Luma sample interpolation process".              */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2(UWORD8 *pu1_src,
+                                                    UWORD8 *pu1_dst,
+                                                    WORD32 src_strd,
+                                                    WORD32 dst_strd,
+                                                    WORD32 ht,
+                                                    WORD32 wd,
+                                                    UWORD8* pu1_tmp,
+                                                    WORD32 dydx)
+{
+    __m256i src_r0r1_32x8b, src_r1r2_32x8b, src_r2r3_32x8b, src_r3r4_32x8b;
+    __m256i src_r4r5_32x8b, src_r5r6_32x8b;
+    UWORD8 *pu1_pred_horz, *pu1_pred_vert;
+
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3(pu1_src, pu1_dst,
+                                                        src_strd, dst_strd,
+                                                        ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    pu1_pred_horz = pu1_src + (((dydx >> 2) & 3) >> 1) * src_strd;
+    pu1_pred_vert = pu1_src + ((dydx & 3) >> 1);
+
+    pu1_pred_vert -= src_strd << 1;
+
+    src_r0r1_32x8b = ih264_luma_load_16x2_avx2(pu1_pred_vert, src_strd);
+    src_r1r2_32x8b = ih264_luma_load_16x2_avx2(pu1_pred_vert + src_strd, src_strd);
+    src_r2r3_32x8b = ih264_luma_load_16x2_avx2(pu1_pred_vert + 2 * src_strd, src_strd);
+    src_r3r4_32x8b = ih264_luma_load_16x2_avx2(pu1_pred_vert + 3 * src_strd, src_strd);
+    pu1_pred_vert += src_strd << 2;
+
+    do
+    {
+        __m256i res_vert_32x8b, res_horz_32x8b;
+
+        src_r4r5_32x8b = ih264_luma_load_16x2_avx2(pu1_pred_vert, src_strd);
+        src_r5r6_32x8b = ih264_luma_load_16x2_avx2(pu1_pred_vert + src_strd, src_strd);
+
+        res_vert_32x8b = ih264_luma_vert_hpel_16x2_avx2(src_r0r1_32x8b, src_r1r2_32x8b,
+                                                        src_r2r3_32x8b, src_r3r4_32x8b,
+                                                        src_r4r5_32x8b, src_r5r6_32x8b);
+        res_horz_32x8b = ih264_luma_horz_hpel_16x2_avx2(pu1_pred_horz, src_strd);
+
+        res_vert_32x8b = _mm256_avg_epu8(res_vert_32x8b, res_horz_32x8b);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_vert_32x8b);
+
+        src_r0r1_32x8b = src_r2r3_32x8b;
+        src_r1r2_32x8b = src_r3r4_32x8b;
+        src_r2r3_32x8b = src_r4r5_32x8b;
+        src_r3r4_32x8b = src_r5r6_32x8b;
+
+        ht -= 2;
+        pu1_pred_vert += src_strd << 1;
+        pu1_pred_horz += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2           */
+/*                                                                           */
+/*  Description   : This function obtains the pixel at (1/2,1/2) of ht x wd  */
+/*                  block and averages it with the pixel at (1/2,0) or       */
+/*                  (1/2,1) to obtain the pixels at (1/2,1/4) and (1/2,3/4)  */
+/*                  as mentioned in sec. 8.4.2.2.1 titled "Luma sample       */
+/*                  interpolation process".                                  */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - temporary buffer (used by the ssse3 function) */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2(UWORD8 *pu1_src,
+                                                    UWORD8 *pu1_dst,
+                                                    WORD32 src_strd,
+                                                    WORD32 dst_strd,
+                                                    WORD32 ht,
+                                                    WORD32 wd,
+                                                    UWORD8* pu1_tmp,
+                                                    WORD32 dydx)
+{
+    WORD16 ai2_tmp[16 * HV_TMP_STRD];
+    WORD16 *pi2_tmp;
+    UWORD8 *pu1_pred_horz;
+
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3(pu1_src, pu1_dst,
+                                                        src_strd, dst_strd,
+                                                        ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    ih264_luma_hv_first_pass_avx2(pu1_src, src_strd, ht, ai2_tmp);
+
+    pu1_pred_horz = pu1_src + (((dydx >> 2) & 3) >> 1) * src_strd;
+
+    pi2_tmp = ai2_tmp;
+    do
+    {
+        __m256i res_32x8b, res_horz_32x8b;
+
+        res_32x8b = ih264_luma_hv_second_pass_16x2_avx2(pi2_tmp);
+        res_horz_32x8b = ih264_luma_horz_hpel_16x2_avx2(pu1_pred_horz, src_strd);
+
+        res_32x8b = _mm256_avg_epu8(res_32x8b, res_horz_32x8b);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_32x8b);
+
+        ht -= 2;
+        pi2_tmp += HV_TMP_STRD << 1;
+        pu1_pred_horz += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2           */
+/*                                                                           */
+/*  Description   : This function obtains the pixel at (1/2,1/2) of ht x wd  */
+/*                  block and averages it with the pixel at (0,1/2) or       */
+/*                  (1,1/2) to obtain the pixels at (1/4,1/2) and (3/4,1/2)  */
+/*                  as mentioned in sec. 8.4.2.2.1 titled "Luma sample       */
+/*                  interpolation process". The pixels at (0,1/2) and        */
+/*                  (1,1/2) are the first stage output of the 2D filter.     */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - temporary buffer (used by the ssse3 function) */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2(UWORD8 *pu1_src,
+                                                    UWORD8 *pu1_dst,
+                                                    WORD32 src_strd,
+                                                    WORD32 dst_strd,
+                                                    WORD32 ht,
+                                                    WORD32 wd,
+                                                    UWORD8* pu1_tmp,
+                                                    WORD32 dydx)
+{
+    WORD16 ai2_tmp[16 * HV_TMP_STRD];
+    WORD16 *pi2_tmp, *pi2_pred_vert;
+
+    if(wd != 16)
+    {
+        ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3(pu1_src, pu1_dst,
+                                                        src_strd, dst_strd,
+                                                        ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    ih264_luma_hv_first_pass_avx2(pu1_src, src_strd, ht, ai2_tmp);
+
+    /* ai2_tmp[0] is column -2 */
+    pi2_tmp = ai2_tmp;
+    pi2_pred_vert = ai2_tmp + 2 + ((dydx & 3) >> 1);
+    do
+    {
+        __m256i res_32x8b, res_vert_32x8b;
+
+        res_32x8b = ih264_luma_hv_second_pass_16x2_avx2(pi2_tmp);
+        res_vert_32x8b = ih264_luma_hv_vert_hpel_16x2_avx2(pi2_pred_vert);
+
+        res_32x8b = _mm256_avg_epu8(res_32x8b, res_vert_32x8b);
+        ih264_luma_store_16x2_avx2(pu1_dst, dst_strd, res_32x8b);
+
+        ht -= 2;
+        pi2_tmp += HV_TMP_STRD << 1;
+        pi2_pred_vert += HV_TMP_STRD << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
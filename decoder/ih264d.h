@@ -71,6 +71,12 @@ extern "C" {
 /*****************************************************************************/
 IV_API_CALL_STATUS_T ih264d_api_function(iv_obj_t *ps_handle, void *pv_api_ip,void *pv_api_op);
 
+/* Worker pool that can be shared by decoder instances, see
+ * IH264D_CMD_CTL_SET_THREAD_POOL. A pool is to be deleted only after all the
+ * decoders using it are deleted */
+IV_API_CALL_STATUS_T ih264d_create_thread_pool(void *pv_api_ip, void *pv_api_op);
+IV_API_CALL_STATUS_T ih264d_delete_thread_pool(void *pv_thread_pool);
+
 /*****************************************************************************/
 /* Enums                                                                     */
 /*****************************************************************************/
@@ -81,6 +87,15 @@ typedef enum {
     IH264D_VID_HDR_DEC_NUM_FRM_BUF_NOT_SUFFICIENT   = IVD_DUMMY_ELEMENT_FOR_CODEC_EXTENSIONS + 1,
     IH264D_FRAME_INFO_OP_BUF_NULL,
     IH264D_INSUFFICIENT_METADATA_BUFFER,
+    IH264D_ASYNC_QUEUE_FULL,
+    IH264D_ASYNC_QUEUE_EMPTY,
+    IH264D_ASYNC_OUTPUT_NOT_READY,
+    IH264D_ASYNC_AU_PENDING,
+    IH264D_NAL_LENGTH_SIZE_NOT_SUPPORTED,
+    IH264D_OUT_SCALE_NOT_SUPPORTED,
+    IH264D_LUMA_ONLY_NOT_SUPPORTED,
+    /* Not an error: the skip mode dropped the picture of the process call */
+    IH264D_PIC_SKIPPED,
 
 }IH264D_ERROR_CODES_T;
 
@@ -121,6 +136,19 @@ typedef struct {
      * enable_threads
      */
     UWORD32                                  u4_keep_threads_active;
+
+    /**
+     * Size in bytes of the length prefixing each NAL unit, 1, 2 or 4, as in
+     * MP4 samples. 0 for a byte stream with start codes
+     */
+    UWORD32                                  u4_nal_length_size;
+
+    /**
+     * Decode the luma only. Chroma syntax is still parsed, but chroma is not
+     * reconstructed, deblocked or written to the output buffers. Needs a YUV
+     * 420 output format
+     */
+    UWORD32                                  u4_luma_only;
 }ih264d_create_ip_t;
 
 
@@ -216,6 +244,104 @@ typedef struct{
     UWORD8                                  *pu1_8x8_blk_type_map;
 }ih264d_video_decode_op_t;
 
+/*****************************************************************************/
+/*   Queue input / Dequeue output                                            */
+/*****************************************************************************/
+
+/* IH264D_CMD_QUEUE_INPUT queues an access unit that is decoded
+ * asynchronously by a thread of the decoder, and IH264D_CMD_DEQUEUE_OUTPUT
+ * returns the results in queue order. Up to IH264D_ASYNC_QUEUE_DEPTH access
+ * units can be queued. The bitstream and output buffers of an access unit
+ * have to stay valid until it is dequeued. While access units are queued,
+ * IVD_CMD_REL_DISPLAY_FRAME and the control calls that only read the state
+ * of the decoder wait for the access unit being decoded and then run between
+ * two access units. Other commands, except delete, fail with
+ * IH264D_ASYNC_AU_PENDING */
+
+#define IH264D_ASYNC_QUEUE_DEPTH    8
+
+/* Codec specific API commands, placed after the ones of IVD_API_COMMAND_TYPE_T */
+typedef enum {
+    /** Queue an access unit to be decoded asynchronously */
+    IH264D_CMD_QUEUE_INPUT               = IV_CMD_DUMMY_ELEMENT + 0x100,
+
+    /** Get the decode results of the oldest queued access unit */
+    IH264D_CMD_DEQUEUE_OUTPUT            = IV_CMD_DUMMY_ELEMENT + 0x101
+}IH264D_API_COMMAND_TYPE_T;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * e_cmd : IH264D_CMD_QUEUE_INPUT
+     */
+    IH264D_API_COMMAND_TYPE_T               e_cmd;
+
+    /**
+     * Arguments of the decode call, e_cmd has to be IVD_CMD_VIDEO_DECODE
+     */
+    ih264d_video_decode_ip_t                s_video_decode_ip;
+}ih264d_queue_input_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * u4_error_code
+     */
+    UWORD32                                 u4_error_code;
+}ih264d_queue_input_op_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * e_cmd : IH264D_CMD_DEQUEUE_OUTPUT
+     */
+    IH264D_API_COMMAND_TYPE_T               e_cmd;
+
+    /**
+     * 1 : Wait for the oldest queued access unit to be decoded
+     * 0 : Fail with IH264D_ASYNC_OUTPUT_NOT_READY if it is not decoded yet
+     */
+    UWORD32                                 u4_blocking;
+}ih264d_dequeue_output_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * u4_error_code
+     */
+    UWORD32                                 u4_error_code;
+
+    /**
+     * Return value of the decode call
+     */
+    IV_API_CALL_STATUS_T                    e_video_decode_status;
+
+    /**
+     * Output of the decode call
+     */
+    ih264d_video_decode_op_t                s_video_decode_op;
+}ih264d_dequeue_output_op_t;
+
 
 /*****************************************************************************/
 /*   Get Display Frame                                                       */
@@ -300,7 +426,25 @@ typedef enum {
     IH264D_CMD_CTL_GET_SEI_SII_PARAMS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x305,
 
     /** Get SEI FGC parameters */
-    IH264D_CMD_CTL_GET_SEI_FGC_PARAMS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x306
+    IH264D_CMD_CTL_GET_SEI_FGC_PARAMS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x306,
+
+    /** Get wait statistics of the decoder threads */
+    IH264D_CMD_CTL_GET_THREAD_WAIT_STATS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x400,
+
+    /** Run the decoder threads as jobs of a shared worker pool */
+    IH264D_CMD_CTL_SET_THREAD_POOL       = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x401,
+
+    /** Report the MB rows of the picture being decoded as they complete */
+    IH264D_CMD_CTL_SET_ROW_CALLBACK      = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x402,
+
+    /** Downscale the output by 2, 4 or 8 in each dimension */
+    IH264D_CMD_CTL_SET_OUTPUT_SCALE      = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x403,
+
+    /** Find the access units decoding can start from in a buffer */
+    IH264D_CMD_CTL_GET_RAP_OFFSETS       = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x404,
+
+    /** Degrade decoding automatically to keep within a per frame time budget */
+    IH264D_CMD_CTL_SET_DEGRADE_DEADLINE  = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x405
 
 }IH264D_CMD_CTL_SUB_CMDS;
 /*****************************************************************************/
@@ -465,6 +609,17 @@ typedef struct{
     UWORD32                                     u4_size;
     IVD_API_COMMAND_TYPE_T                      e_cmd;
     IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Number of cores. Parse, decode (MC) and recon/bs run in at most three
+     * threads, and parse and MC are never split. A fourth core moves
+     * deblocking to its own thread that trails recon. Each further core
+     * reconstructs MB rows of non-MBAFF pictures beside the recon thread,
+     * so they only help while recon is the slowest stage; for such streams
+     * they also split picture level deblocking and the output format
+     * conversion. Recon workers are sized when the first picture's buffers
+     * are allocated. Values above 16 are rejected
+     */
     UWORD32                                     u4_num_cores;
 }ih264d_ctl_set_num_cores_ip_t;
 
@@ -1031,6 +1186,411 @@ typedef struct
     UWORD32 u4_film_grain_characteristics_repetition_period;
 } ih264d_ctl_get_sei_fgc_params_op_t;
 
+/*****************************************************************************/
+/*   Video control  Get thread wait statistics                               */
+/*****************************************************************************/
+
+/** Number of threads reported by IH264D_CMD_CTL_GET_THREAD_WAIT_STATS.
+ *  Index 0 : parse thread (the thread calling decode)
+ *  Index 1 : decode (MC) thread
+ *  Index 2 : recon / BS thread
+ *  Index 3 : deblocking thread
+ */
+#define IH264D_NUM_WAIT_STATS_THREADS   4
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * cmd
+     */
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+
+    /**
+     * sub_cmd
+     */
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Reset the statistics after they are returned
+     */
+    UWORD32                                     u4_reset;
+} ih264d_ctl_get_thread_wait_stats_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Number of times a thread had to wait for another thread's progress
+     */
+    UWORD32                                     au4_num_waits[IH264D_NUM_WAIT_STATS_THREADS];
+
+    /**
+     * Number of 128 cycle NOP loops spent spinning while waiting
+     */
+    UWORD32                                     au4_num_spins[IH264D_NUM_WAIT_STATS_THREADS];
+
+    /**
+     * Number of times a thread went to sleep (or yielded) while waiting
+     */
+    UWORD32                                     au4_num_sleeps[IH264D_NUM_WAIT_STATS_THREADS];
+
+    /**
+     * Time spent spinning and sleeping while waiting, in microseconds
+     */
+    UWORD64                                     au8_wait_time_us[IH264D_NUM_WAIT_STATS_THREADS];
+} ih264d_ctl_get_thread_wait_stats_op_t;
+
+/*****************************************************************************/
+/*   Create shared worker pool                                               */
+/*****************************************************************************/
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * Number of worker threads, typically the number of cores available to
+     * all the decoders sharing the pool
+     */
+    UWORD32                                     u4_num_threads;
+
+    /**
+     * Memory manager, used the same way as in ivd_create_ip_t
+     */
+    void                                        *(*pf_aligned_alloc)(void *pv_mem_ctxt,
+                                                                     WORD32 alignment,
+                                                                     WORD32 size);
+    void                                        (*pf_aligned_free)(void *pv_mem_ctxt,
+                                                                   void *pv_buf);
+    void                                        *pv_mem_ctxt;
+} ih264d_create_thread_pool_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Pool handle, to be passed to IH264D_CMD_CTL_SET_THREAD_POOL
+     */
+    void                                        *pv_thread_pool;
+} ih264d_create_thread_pool_op_t;
+
+/*****************************************************************************/
+/*   Video control  Set thread pool                                          */
+/*****************************************************************************/
+
+/* To be called before the first decode call. Instead of creating its own
+ * threads, the decoder then queues its per picture decode, recon and
+ * deblocking stages as jobs of the pool. A stage waiting on the progress of
+ * another one keeps its pool thread, so each picture in flight can hold up
+ * to two pool threads. Not supported together with u4_keep_threads_active */
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * cmd
+     */
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+
+    /**
+     * sub_cmd
+     */
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Pool handle returned by ih264d_create_thread_pool()
+     */
+    void                                        *pv_thread_pool;
+} ih264d_ctl_set_thread_pool_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+} ih264d_ctl_set_thread_pool_op_t;
+
+/*****************************************************************************/
+/*   Video control  Set row callback                                         */
+/*****************************************************************************/
+
+/* pf_row_done is called each time more MB rows (from the top) of the picture
+ * being decoded are final in the application's output buffer: reconstructed,
+ * deblocked and format converted. u4_ts is the timestamp of the decode call
+ * that started the picture, and u4_num_mb_rows is the picture height in MBs
+ * once the picture is complete. Rows of field and MBAFF pictures are only
+ * reported when the picture is complete.
+ *
+ * Rows are reported while decoding in two cases:
+ *  - u4_share_disp_buf is set with IV_YUV_420SP_UV output or luma only
+ *    output, as the display buffer is then the decoder's picture buffer
+ *  - 3 cores and IVD_DECODE_FRAME_OUT, for frames that are not MBAFF, as the
+ *    picture returned by the decode call is then converted into the output
+ *    buffer row by row
+ * Otherwise the output is written when the decode call returns and the
+ * callback is not called.
+ *
+ * The callback is called from the decoder's threads while decoding is in
+ * progress, so it has to return quickly and must not call the decoder */
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * cmd
+     */
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+
+    /**
+     * sub_cmd
+     */
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Callback, NULL to disable it
+     */
+    void                                        (*pf_row_done)(void *pv_cb_ctxt,
+                                                               UWORD32 u4_ts,
+                                                               UWORD32 u4_num_mb_rows);
+
+    /**
+     * Passed as is to pf_row_done
+     */
+    void                                        *pv_cb_ctxt;
+} ih264d_ctl_set_row_callback_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+} ih264d_ctl_set_row_callback_op_t;
+
+/*****************************************************************************/
+/*   Video control  Set output scale                                         */
+/*****************************************************************************/
+
+/* The display frame is downscaled by (1 << u4_scale_log2) in each dimension
+ * while it is format converted into the output buffer. Each output sample is
+ * the average of the (1 << u4_scale_log2) x (1 << u4_scale_log2) box of
+ * samples it covers. Downscaled widths and heights are rounded down to even
+ * values. They are the sizes returned in s_disp_frm_buf and used by
+ * IVD_CMD_CTL_GETBUFINFO, while u4_pic_wd and u4_pic_ht stay those of the
+ * stream.
+ *
+ * u4_scale_log2 is 0 (no downscaling) to 3. Downscaling is not supported with
+ * u4_share_disp_buf, or for IV_YUV_422ILE output. The scale applies to the
+ * frames output after the call */
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * cmd
+     */
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+
+    /**
+     * sub_cmd
+     */
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Log2 of the downscale factor
+     */
+    UWORD32                                     u4_scale_log2;
+} ih264d_ctl_set_output_scale_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+} ih264d_ctl_set_output_scale_op_t;
+
+/*****************************************************************************/
+/*   Video control  Get random access point offsets                          */
+/*****************************************************************************/
+
+/* Scans a buffer laid out as for the decode call, without decoding it, for
+ * the access units of IDR pictures and optionally of the pictures starting
+ * with an I slice. Each offset is that of the start code or length prefix of
+ * the first NAL unit of the access unit, so that decoding can be started by
+ * passing the buffer from that offset on, to a decoder in keyframe only mode
+ * (IVD_SKIP_PB) or after a reset. The decoder state is not changed.
+ *
+ * When pu4_rap_offsets fills up before the end of the buffer,
+ * u4_num_bytes_scanned is the offset of the next access unit found, and the
+ * scan can be continued from there */
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * cmd
+     */
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+
+    /**
+     * sub_cmd
+     */
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Buffer to scan, and its size in bytes
+     */
+    void                                        *pv_stream_buffer;
+    UWORD32                                     u4_num_bytes;
+
+    /**
+     * Report the pictures starting with an I slice as well as the IDR ones
+     */
+    UWORD32                                     u4_include_i_pics;
+
+    /**
+     * Array receiving the offsets, and its number of entries
+     */
+    UWORD32                                     *pu4_rap_offsets;
+    UWORD32                                     u4_max_raps;
+} ih264d_ctl_get_rap_offsets_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Number of offsets returned
+     */
+    UWORD32                                     u4_num_raps;
+
+    /**
+     * Number of bytes scanned
+     */
+    UWORD32                                     u4_num_bytes_scanned;
+} ih264d_ctl_get_rap_offsets_op_t;
+
+/*****************************************************************************/
+/*   Video control  Set degrade deadline                                     */
+/*****************************************************************************/
+
+/* Sets the time the application can spend decoding each frame. The decoder
+ * times its decode calls, and when frames repeatedly take longer than the
+ * budget it raises its degrade level by one, lowering it again once frames
+ * have been decoded well within the budget for a while. The levels add up:
+ * 1 : Deblocking disabled on non-reference pictures
+ * 2 : Integer pel luma motion compensation on non-reference pictures
+ * 3 : Non-reference B pictures are dropped
+ * 4 : Deblocking disabled on reference P and B pictures as well
+ *
+ * Only non-reference pictures are degraded up to level 3, so the errors do
+ * not propagate. At level 4 they do, until the next I picture. The automatic
+ * degrade is applied in addition to that set by IH264D_CMD_CTL_DEGRADE.
+ * A budget of 0 turns it off */
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * cmd
+     */
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+
+    /**
+     * sub_cmd
+     */
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Time budget per frame in microseconds
+     */
+    UWORD32                                     u4_frame_budget_us;
+} ih264d_ctl_set_degrade_deadline_ip_t;
+
+typedef struct
+{
+    /**
+     * u4_size
+     */
+    UWORD32                                     u4_size;
+
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Degrade level in use before the call
+     */
+    UWORD32                                     u4_degrade_level;
+} ih264d_ctl_set_degrade_deadline_op_t;
+
 #ifdef __cplusplus
 } /* closing brace for extern "C" */
 #endif
@@ -91,6 +91,7 @@
 #include "ih264d_format_conv.h"
 #include "ih264d_parse_headers.h"
 #include "ih264d_thread_compute_bs.h"
+#include "ih264d_async.h"
 #include <assert.h>
 
 
@@ -120,6 +121,7 @@
 #define MIN_OUT_BUFS_420        3
 #define MIN_OUT_BUFS_422ILE     1
 #define MIN_OUT_BUFS_RGB565     1
+#define MIN_OUT_BUFS_RGBA8888   1
 #define MIN_OUT_BUFS_420SP      2
 
 #define NUM_FRAMES_LIMIT_ENABLED 0
@@ -159,6 +161,18 @@ WORD32 ih264d_get_sei_sii_params(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_ap
 
 WORD32 ih264d_get_sei_fgc_params(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
 
+WORD32 ih264d_get_thread_wait_stats(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+WORD32 ih264d_set_thread_pool(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+WORD32 ih264d_set_row_callback(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+WORD32 ih264d_set_output_scale(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+WORD32 ih264d_get_rap_offsets(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+WORD32 ih264d_set_degrade_deadline(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
 WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
 
 WORD32 ih264d_deblock_display(dec_struct_t *ps_dec);
@@ -233,6 +247,8 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
         case IVD_CMD_VIDEO_DECODE:
         case IVD_CMD_DELETE:
         case IVD_CMD_VIDEO_CTL:
+        case IH264D_CMD_QUEUE_INPUT:
+        case IH264D_CMD_DEQUEUE_OUTPUT:
             if(ps_handle == NULL)
             {
                 *(pu4_api_op + 1) |= 1 << IVD_UNSUPPORTEDPARAM;
@@ -260,6 +276,7 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                 *(pu4_api_op + 1) |= IVD_INVALID_HANDLE_NULL;
                 return IV_FAIL;
             }
+
             break;
         default:
             *(pu4_api_op + 1) |= 1 << IVD_UNSUPPORTEDPARAM;
@@ -307,6 +324,8 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                                             != IV_YUV_422ILE)
                             && (ps_ip->s_ivd_create_ip_t.e_output_format
                                             != IV_RGB_565)
+                            && (ps_ip->s_ivd_create_ip_t.e_output_format
+                                            != IV_RGBA_8888)
                             && (ps_ip->s_ivd_create_ip_t.e_output_format
                                             != IV_YUV_420SP_UV)
                             && (ps_ip->s_ivd_create_ip_t.e_output_format
@@ -320,6 +339,39 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                 return (IV_FAIL);
             }
 
+            if((ps_ip->s_ivd_create_ip_t.u4_size
+                            > offsetof(ih264d_create_ip_t, u4_nal_length_size))
+                            && (ps_ip->u4_nal_length_size != 0)
+                            && (ps_ip->u4_nal_length_size != 1)
+                            && (ps_ip->u4_nal_length_size != 2)
+                            && (ps_ip->u4_nal_length_size != 4))
+            {
+                ps_op->s_ivd_create_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_create_op_t.u4_error_code |=
+                                IH264D_NAL_LENGTH_SIZE_NOT_SUPPORTED;
+                H264_DEC_DEBUG_PRINT("\n");
+                return (IV_FAIL);
+            }
+
+            /* Other output formats are converted from the chroma as well */
+            if((ps_ip->s_ivd_create_ip_t.u4_size
+                            > offsetof(ih264d_create_ip_t, u4_luma_only))
+                            && ps_ip->u4_luma_only
+                            && (ps_ip->s_ivd_create_ip_t.e_output_format != IV_YUV_420P)
+                            && (ps_ip->s_ivd_create_ip_t.e_output_format
+                                            != IV_YUV_420SP_UV)
+                            && (ps_ip->s_ivd_create_ip_t.e_output_format
+                                            != IV_YUV_420SP_VU))
+            {
+                ps_op->s_ivd_create_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_create_op_t.u4_error_code |=
+                                IH264D_LUMA_ONLY_NOT_SUPPORTED;
+                H264_DEC_DEBUG_PRINT("\n");
+                return (IV_FAIL);
+            }
+
         }
             break;
 
@@ -531,6 +583,75 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
         }
             break;
 
+        case IH264D_CMD_QUEUE_INPUT:
+        {
+            ih264d_queue_input_ip_t *ps_ip = (ih264d_queue_input_ip_t *)pv_api_ip;
+            ih264d_queue_input_op_t *ps_op = (ih264d_queue_input_op_t *)pv_api_op;
+            ih264d_video_decode_op_t s_video_decode_op;
+
+            ps_op->u4_error_code = 0;
+
+            if(ps_ip->u4_size != sizeof(ih264d_queue_input_ip_t))
+            {
+                ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if(ps_op->u4_size != sizeof(ih264d_queue_input_op_t))
+            {
+                ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if(ps_ip->s_video_decode_ip.s_ivd_video_decode_ip_t.e_cmd
+                            != IVD_CMD_VIDEO_DECODE)
+            {
+                ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                ps_op->u4_error_code |= IVD_INVALID_API_CMD;
+                return (IV_FAIL);
+            }
+
+            /* Decode arguments are checked when queued, as errors of the
+             * decode call itself are only known on dequeue */
+            s_video_decode_op.s_ivd_video_decode_op_t.u4_size =
+                            sizeof(ih264d_video_decode_op_t);
+            s_video_decode_op.s_ivd_video_decode_op_t.u4_error_code = 0;
+            if(IV_SUCCESS != api_check_struct_sanity(ps_handle,
+                                                     &ps_ip->s_video_decode_ip,
+                                                     &s_video_decode_op))
+            {
+                ps_op->u4_error_code =
+                                s_video_decode_op.s_ivd_video_decode_op_t.u4_error_code;
+                return (IV_FAIL);
+            }
+        }
+            break;
+
+        case IH264D_CMD_DEQUEUE_OUTPUT:
+        {
+            ih264d_dequeue_output_ip_t *ps_ip = (ih264d_dequeue_output_ip_t *)pv_api_ip;
+            ih264d_dequeue_output_op_t *ps_op = (ih264d_dequeue_output_op_t *)pv_api_op;
+
+            ps_op->u4_error_code = 0;
+
+            if(ps_ip->u4_size != sizeof(ih264d_dequeue_output_ip_t))
+            {
+                ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if(ps_op->u4_size != sizeof(ih264d_dequeue_output_op_t))
+            {
+                ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+        }
+            break;
+
         case IVD_CMD_DELETE:
         {
             ih264d_delete_ip_t *ps_ip =
@@ -998,6 +1119,165 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                     break;
                 }
 
+                case IH264D_CMD_CTL_GET_THREAD_WAIT_STATS:
+                {
+                    ih264d_ctl_get_thread_wait_stats_ip_t *ps_ip;
+                    ih264d_ctl_get_thread_wait_stats_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_get_thread_wait_stats_ip_t *) pv_api_ip;
+                    ps_op = (ih264d_ctl_get_thread_wait_stats_op_t *) pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_get_thread_wait_stats_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_get_thread_wait_stats_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264D_CMD_CTL_SET_THREAD_POOL:
+                {
+                    ih264d_ctl_set_thread_pool_ip_t *ps_ip;
+                    ih264d_ctl_set_thread_pool_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_thread_pool_ip_t *) pv_api_ip;
+                    ps_op = (ih264d_ctl_set_thread_pool_op_t *) pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_set_thread_pool_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_set_thread_pool_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264D_CMD_CTL_SET_ROW_CALLBACK:
+                {
+                    ih264d_ctl_set_row_callback_ip_t *ps_ip;
+                    ih264d_ctl_set_row_callback_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_row_callback_ip_t *) pv_api_ip;
+                    ps_op = (ih264d_ctl_set_row_callback_op_t *) pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_set_row_callback_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_set_row_callback_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264D_CMD_CTL_SET_OUTPUT_SCALE:
+                {
+                    ih264d_ctl_set_output_scale_ip_t *ps_ip;
+                    ih264d_ctl_set_output_scale_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_output_scale_ip_t *) pv_api_ip;
+                    ps_op = (ih264d_ctl_set_output_scale_op_t *) pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_set_output_scale_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_set_output_scale_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264D_CMD_CTL_GET_RAP_OFFSETS:
+                {
+                    ih264d_ctl_get_rap_offsets_ip_t *ps_ip;
+                    ih264d_ctl_get_rap_offsets_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_get_rap_offsets_ip_t *) pv_api_ip;
+                    ps_op = (ih264d_ctl_get_rap_offsets_op_t *) pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_get_rap_offsets_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_get_rap_offsets_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(((NULL == ps_ip->pv_stream_buffer) && ps_ip->u4_num_bytes)
+                                    || ((NULL == ps_ip->pu4_rap_offsets)
+                                                    && ps_ip->u4_max_raps))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_DEC_NUMBYTES_INV;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264D_CMD_CTL_SET_DEGRADE_DEADLINE:
+                {
+                    ih264d_ctl_set_degrade_deadline_ip_t *ps_ip;
+                    ih264d_ctl_set_degrade_deadline_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_degrade_deadline_ip_t *) pv_api_ip;
+                    ps_op = (ih264d_ctl_set_degrade_deadline_op_t *) pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_set_degrade_deadline_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_set_degrade_deadline_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
                 case IH264D_CMD_CTL_SET_NUM_CORES:
                 {
                     ih264d_ctl_set_num_cores_ip_t *ps_ip;
@@ -1022,9 +1302,8 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                         return IV_FAIL;
                     }
 
-                    if((ps_ip->u4_num_cores != 1) && (ps_ip->u4_num_cores != 2)
-                                    && (ps_ip->u4_num_cores != 3)
-                                    && (ps_ip->u4_num_cores != 4))
+                    if((ps_ip->u4_num_cores < 1)
+                                    || (ps_ip->u4_num_cores > H264_MAX_NUM_CORES))
                     {
                         ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
                         return IV_FAIL;
@@ -1110,6 +1389,8 @@ WORD32 ih264d_set_processor(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_codec->e_processor_soc = (IVD_SOC_T)ps_ip->u4_soc;
 
     ih264d_init_function_ptr(ps_codec);
+    if(ps_codec->u4_luma_only)
+        ih264d_init_function_ptr_luma_only(ps_codec);
 
     ps_op->u4_error_code = 0;
     return IV_SUCCESS;
@@ -1215,6 +1496,7 @@ void ih264d_init_decoder(void * ps_dec_params)
     ps_dec->init_done = 0;
 
     ps_dec->u4_num_cores = 1;
+    ps_dec->u4_num_aux_cores = 0;
 
     ps_dec->u2_pic_ht = ps_dec->u2_pic_wd = 0;
 
@@ -1222,6 +1504,11 @@ void ih264d_init_decoder(void * ps_dec_params)
     ps_dec->u4_app_disable_deblk_frm = 0;
     ps_dec->i4_degrade_type = 0;
     ps_dec->i4_degrade_pics = 0;
+    ps_dec->i4_mv_frac_mask = MV_FRAC_MASK_QPEL;
+    ps_dec->u4_degrade_level = 0;
+    ps_dec->u4_degrade_time_us = 0;
+    ps_dec->u4_degrade_over_cnt = 0;
+    ps_dec->u4_degrade_under_cnt = 0;
 
     memset(ps_dec->ps_pps, 0,
            ((sizeof(dec_pic_params_t)) * MAX_NUM_PIC_PARAMS));
@@ -1248,6 +1535,7 @@ void ih264d_init_decoder(void * ps_dec_params)
     ps_dec->u1_init_dec_flag = 0;
     ps_dec->u1_first_slice_in_stream = 1;
     ps_dec->u1_last_pic_not_decoded = 0;
+    ps_dec->u1_pic_skipped = 0;
     ps_dec->u4_app_disp_width = 0;
     ps_dec->i4_header_decoded = 0;
     ps_dec->u4_total_frames_decoded = 0;
@@ -1337,15 +1625,6 @@ void ih264d_init_decoder(void * ps_dec_params)
     ps_dec->pf_cavlc_parse_8x8block[3] =
                     ih264d_cavlc_parse_8x8block_both_available;
 
-    /***************************************************************************/
-    /* Initialize Bs calculation function pointers for P and B, 16x16/non16x16 */
-    /***************************************************************************/
-    ps_dec->pf_fill_bs1[0][0] = ih264d_fill_bs1_16x16mb_pslice;
-    ps_dec->pf_fill_bs1[0][1] = ih264d_fill_bs1_non16x16mb_pslice;
-
-    ps_dec->pf_fill_bs1[1][0] = ih264d_fill_bs1_16x16mb_bslice;
-    ps_dec->pf_fill_bs1[1][1] = ih264d_fill_bs1_non16x16mb_bslice;
-
     ps_dec->pf_fill_bs_xtra_left_edge[0] =
                     ih264d_fill_bs_xtra_left_edge_cur_frm;
     ps_dec->pf_fill_bs_xtra_left_edge[1] =
@@ -1385,6 +1664,8 @@ void ih264d_init_decoder(void * ps_dec_params)
 
     ih264d_init_arch(ps_dec);
     ih264d_init_function_ptr(ps_dec);
+    if(ps_dec->u4_luma_only)
+        ih264d_init_function_ptr_luma_only(ps_dec);
     ps_dec->e_frm_out_mode = IVD_DISPLAY_FRAME_OUT;
     ps_dec->init_done = 1;
 
@@ -1425,6 +1706,21 @@ WORD32 ih264d_join_threads(dec_struct_t *ps_dec)
 
             ps_dec->u4_bs_deblk_thread_created = 0;
         }
+
+        if(ps_dec->u4_deblk_thread_created)
+        {
+            ithread_mutex_lock(ps_dec->apv_proc_start_mutex[2]);
+
+            ps_dec->ai4_process_start[2] = PROC_START;
+
+            ithread_cond_signal(ps_dec->apv_proc_start_condition[2]);
+
+            ithread_mutex_unlock(ps_dec->apv_proc_start_mutex[2]);
+
+            ithread_join(ps_dec->pv_deblk_thread_handle, NULL);
+
+            ps_dec->u4_deblk_thread_created = 0;
+        }
     }
     return IV_SUCCESS;
 }
@@ -1440,17 +1736,24 @@ WORD32 ih264d_free_static_bufs(iv_obj_t *dec_hdl)
     pf_aligned_free = ps_dec->pf_aligned_free;
     pv_mem_ctxt = ps_dec->pv_mem_ctxt;
 
+    if(ps_dec->pv_async_ctxt)
+    {
+        ih264d_async_deinit((async_ctxt_t *)ps_dec->pv_async_ctxt);
+    }
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_async_ctxt);
+
     if(ps_dec->i4_threads_active)
     {
 
         ih264d_join_threads(ps_dec);
 
-        // destroy mutex and condition variable for both the threads
+        // destroy mutex and condition variable for all the threads
         // 1. ih264d_decode_picture_thread
         // 2. ih264d_recon_deblk_thread
+        // 3. ih264d_deblk_picture_thread
         {
             UWORD32 i;
-            for(i = 0; i < 2; i++)
+            for(i = 0; i < H264_MAX_PROC_THREADS; i++)
             {
                 ithread_cond_destroy(ps_dec->apv_proc_start_condition[i]);
                 ithread_cond_destroy(ps_dec->apv_proc_done_condition[i]);
@@ -1467,6 +1770,64 @@ WORD32 ih264d_free_static_bufs(iv_obj_t *dec_hdl)
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_pps);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_dec_thread_handle);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_bs_deblk_thread_handle);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_deblk_thread_handle);
+
+    if(ps_dec->s_dec_map_progress.pv_mutex)
+    {
+        ih264d_progress_deinit(&ps_dec->s_dec_map_progress);
+        ih264d_progress_deinit(&ps_dec->s_recon_map_progress);
+        ih264d_progress_deinit(&ps_dec->s_bs_progress);
+    }
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->s_dec_map_progress.pv_mutex);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->s_dec_map_progress.pv_cond);
+
+    if(ps_dec->ps_thread_pool)
+    {
+        UWORD32 i;
+        for(i = 0; i < H264_MAX_PROC_THREADS; i++)
+        {
+            ithread_cond_destroy(ps_dec->as_pool_job[i].pv_done_cond);
+        }
+    }
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->as_pool_job[0].pv_done_cond);
+
+    if(ps_dec->s_deblk_rows.pv_mutex)
+    {
+        UWORD32 i;
+        for(i = 0; i < H264_MAX_NUM_CORES; i++)
+        {
+            deblk_row_worker_t *ps_worker = &ps_dec->s_deblk_rows.as_worker[i];
+
+            ih264d_progress_deinit(&ps_worker->s_progress);
+            ithread_cond_destroy(ps_worker->s_pool_job.pv_done_cond);
+        }
+        ithread_mutex_destroy(ps_dec->s_deblk_rows.pv_mutex);
+    }
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->s_deblk_rows.pv_mutex);
+
+    if(ps_dec->s_recon_rows.pv_mutex)
+    {
+        UWORD32 i;
+        for(i = 0; i < H264_MAX_NUM_CORES; i++)
+        {
+            recon_row_worker_t *ps_worker = &ps_dec->s_recon_rows.as_worker[i];
+
+            ih264d_progress_deinit(&ps_worker->s_progress);
+            ithread_cond_destroy(ps_worker->s_pool_job.pv_done_cond);
+        }
+        ithread_mutex_destroy(ps_dec->s_recon_rows.pv_mutex);
+    }
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->s_recon_rows.pv_mutex);
+
+    if(ps_dec->as_fmt_conv_stripe[0].s_pool_job.pv_done_cond)
+    {
+        UWORD32 i;
+        for(i = 0; i < H264_MAX_NUM_CORES; i++)
+        {
+            ithread_cond_destroy(ps_dec->as_fmt_conv_stripe[i].s_pool_job.pv_done_cond);
+        }
+    }
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->as_fmt_conv_stripe[0].s_pool_job.pv_done_cond);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_dpb_mgr);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_pred);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_disp_buf_mgr);
@@ -1581,6 +1942,15 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     ps_dec->pv_mem_ctxt = pv_mem_ctxt;
     ps_dec->i4_threads_active = ps_create_ip->u4_keep_threads_active;
 
+    /* Applications built before the fields were added pass a smaller size */
+    if(ps_create_ip->s_ivd_create_ip_t.u4_size
+                    > offsetof(ih264d_create_ip_t, u4_nal_length_size))
+        ps_dec->u1_nal_length_size = ps_create_ip->u4_nal_length_size;
+
+    if(ps_create_ip->s_ivd_create_ip_t.u4_size
+                    > offsetof(ih264d_create_ip_t, u4_luma_only))
+        ps_dec->u4_luma_only = (0 != ps_create_ip->u4_luma_only);
+
 
     size = ((sizeof(dec_seq_params_t)) * MAX_NUM_SEQ_PARAMS);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
@@ -1606,19 +1976,166 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     memset(pv_buf, 0, size);
     ps_dec->pv_bs_deblk_thread_handle = pv_buf;
 
+    size = ithread_get_handle_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    memset(pv_buf, 0, size);
+    ps_dec->pv_deblk_thread_handle = pv_buf;
+
+    {
+        progress_sync_t *aps_prog[3];
+        UWORD32 i;
+        WORD32 mutex_size = ithread_get_mutex_lock_size();
+        WORD32 cond_size = ithread_get_cond_struct_size();
+        UWORD8 *pu1_mutex, *pu1_cond;
+
+        aps_prog[0] = &ps_dec->s_dec_map_progress;
+        aps_prog[1] = &ps_dec->s_recon_map_progress;
+        aps_prog[2] = &ps_dec->s_bs_progress;
+
+        /* Request memory to hold mutex and condition for each progress */
+        size = mutex_size * 3;
+        pu1_mutex = pf_aligned_alloc(pv_mem_ctxt, 8, size);
+        RETURN_IF((NULL == pu1_mutex), IV_FAIL);
+        memset(pu1_mutex, 0, size);
+
+        size = cond_size * 3;
+        pu1_cond = pf_aligned_alloc(pv_mem_ctxt, 8, size);
+        RETURN_IF((NULL == pu1_cond), IV_FAIL);
+        memset(pu1_cond, 0, size);
+
+        for(i = 0; i < 3; i++)
+        {
+            WORD32 ret;
+
+            ret = ih264d_progress_init(aps_prog[i],
+                                       pu1_mutex + i * mutex_size,
+                                       pu1_cond + i * cond_size);
+            RETURN_IF((ret != IV_SUCCESS), ret);
+        }
+    }
+
+    size = ih264d_async_get_ctxt_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ih264d_async_init((async_ctxt_t *)pv_buf, pv_buf);
+    ps_dec->pv_async_ctxt = pv_buf;
+
+    {
+        deblk_rows_ctxt_t *ps_rows = &ps_dec->s_deblk_rows;
+        WORD32 mutex_size = ALIGN8(ithread_get_mutex_lock_size());
+        WORD32 cond_size = ALIGN8(ithread_get_cond_struct_size());
+        UWORD8 *pu1_buf;
+        UWORD32 i;
+
+        /* Request memory to hold the mutex of the row parallel deblocking,
+         * and a mutex and two conditions for each worker */
+        size = mutex_size
+                        + H264_MAX_NUM_CORES * (mutex_size + 2 * cond_size);
+        pu1_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+        RETURN_IF((NULL == pu1_buf), IV_FAIL);
+        memset(pu1_buf, 0, size);
+
+        ps_rows->pv_mutex = pu1_buf;
+        pu1_buf += mutex_size;
+        ithread_mutex_init(ps_rows->pv_mutex);
+
+        for(i = 0; i < H264_MAX_NUM_CORES; i++)
+        {
+            deblk_row_worker_t *ps_worker = &ps_rows->as_worker[i];
+            WORD32 ret;
+
+            ps_worker->ps_dec = ps_dec;
+            ps_worker->u4_idx = i;
+
+            ret = ih264d_progress_init(&ps_worker->s_progress, pu1_buf,
+                                       pu1_buf + mutex_size);
+            RETURN_IF((ret != IV_SUCCESS), ret);
+            pu1_buf += mutex_size + cond_size;
+
+            ps_worker->s_pool_job.i4_state = POOL_JOB_IDLE;
+            ps_worker->s_pool_job.pv_done_cond = pu1_buf;
+            ithread_cond_init(ps_worker->s_pool_job.pv_done_cond);
+            pu1_buf += cond_size;
+        }
+    }
+
+    {
+        recon_rows_ctxt_t *ps_rows = &ps_dec->s_recon_rows;
+        WORD32 mutex_size = ALIGN8(ithread_get_mutex_lock_size());
+        WORD32 cond_size = ALIGN8(ithread_get_cond_struct_size());
+        UWORD8 *pu1_buf;
+        UWORD32 i;
+
+        /* Request memory to hold the mutex of the row parallel reconstruction,
+         * and a mutex and two conditions for each worker */
+        size = mutex_size
+                        + H264_MAX_NUM_CORES * (mutex_size + 2 * cond_size);
+        pu1_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+        RETURN_IF((NULL == pu1_buf), IV_FAIL);
+        memset(pu1_buf, 0, size);
+
+        ps_rows->pv_mutex = pu1_buf;
+        pu1_buf += mutex_size;
+        ithread_mutex_init(ps_rows->pv_mutex);
+
+        for(i = 0; i < H264_MAX_NUM_CORES; i++)
+        {
+            recon_row_worker_t *ps_worker = &ps_rows->as_worker[i];
+            WORD32 ret;
+
+            ps_worker->ps_dec = ps_dec;
+            ps_worker->u4_idx = i;
+
+            ret = ih264d_progress_init(&ps_worker->s_progress, pu1_buf,
+                                       pu1_buf + mutex_size);
+            RETURN_IF((ret != IV_SUCCESS), ret);
+            pu1_buf += mutex_size + cond_size;
+
+            ps_worker->s_pool_job.i4_state = POOL_JOB_IDLE;
+            ps_worker->s_pool_job.pv_done_cond = pu1_buf;
+            ithread_cond_init(ps_worker->s_pool_job.pv_done_cond);
+            pu1_buf += cond_size;
+        }
+    }
+
+    {
+        WORD32 cond_size = ALIGN8(ithread_get_cond_struct_size());
+        UWORD8 *pu1_buf;
+        UWORD32 i;
+
+        /* Request memory to hold a condition for the pool job of each
+         * stripe of the split format conversion */
+        size = H264_MAX_NUM_CORES * cond_size;
+        pu1_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+        RETURN_IF((NULL == pu1_buf), IV_FAIL);
+        memset(pu1_buf, 0, size);
+
+        for(i = 0; i < H264_MAX_NUM_CORES; i++)
+        {
+            fmt_conv_stripe_t *ps_stripe = &ps_dec->as_fmt_conv_stripe[i];
+
+            ps_stripe->s_pool_job.i4_state = POOL_JOB_IDLE;
+            ps_stripe->s_pool_job.pv_done_cond = pu1_buf;
+            ithread_cond_init(ps_stripe->s_pool_job.pv_done_cond);
+            pu1_buf += cond_size;
+        }
+    }
+
     if(ps_dec->i4_threads_active)
     {
         UWORD32 i;
-        /* Request memory to hold mutex (start/done) for both threads */
-        size = ithread_get_mutex_lock_size() << 2;
+        /* Request memory to hold mutex (start/done) for all threads */
+        size = ithread_get_mutex_lock_size() * 2 * H264_MAX_PROC_THREADS;
         pv_buf = pf_aligned_alloc(pv_mem_ctxt, 8, size);
         RETURN_IF((NULL == pv_buf), IV_FAIL);
         memset(pv_buf, 0, size);
 
-        // init mutex variable for both the threads
+        // init mutex variable for all the threads
         // 1. ih264d_decode_picture_thread
         // 2. ih264d_recon_deblk_thread
-        for(i = 0; i < 2; i++)
+        // 3. ih264d_deblk_picture_thread
+        for(i = 0; i < H264_MAX_PROC_THREADS; i++)
         {
             WORD32 ret;
             WORD32 mutex_size = ithread_get_mutex_lock_size();
@@ -1635,13 +2152,13 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
             RETURN_IF((ret != IV_SUCCESS), ret);
         }
 
-        size = ithread_get_cond_struct_size() << 2;
+        size = ithread_get_cond_struct_size() * 2 * H264_MAX_PROC_THREADS;
         pv_buf = pf_aligned_alloc(pv_mem_ctxt, 8, size);
         RETURN_IF((NULL == pv_buf), IV_FAIL);
         memset(pv_buf, 0, size);
 
-        // init condition variable for both the threads
-        for(i = 0; i < 2; i++)
+        // init condition variable for all the threads
+        for(i = 0; i < H264_MAX_PROC_THREADS; i++)
         {
             WORD32 ret;
             WORD32 cond_size = ithread_get_cond_struct_size();
@@ -2034,6 +2551,8 @@ UWORD32 ih264d_get_outbuf_size(WORD32 pic_wd,
         u4_min_num_out_bufs = MIN_OUT_BUFS_422ILE;
     else if(u1_chroma_format == IV_RGB_565)
         u4_min_num_out_bufs = MIN_OUT_BUFS_RGB565;
+    else if(u1_chroma_format == IV_RGBA_8888)
+        u4_min_num_out_bufs = MIN_OUT_BUFS_RGBA8888;
     else if((u1_chroma_format == IV_YUV_420SP_UV)
                     || (u1_chroma_format == IV_YUV_420SP_VU))
         u4_min_num_out_bufs = MIN_OUT_BUFS_420SP;
@@ -2054,6 +2573,11 @@ UWORD32 ih264d_get_outbuf_size(WORD32 pic_wd,
         p_buf_size[0] = (pic_wd * pic_ht) * 2;
         p_buf_size[1] = p_buf_size[2] = 0;
     }
+    else if(u1_chroma_format == IV_RGBA_8888)
+    {
+        p_buf_size[0] = (pic_wd * pic_ht) * 4;
+        p_buf_size[1] = p_buf_size[2] = 0;
+    }
     else if((u1_chroma_format == IV_YUV_420SP_UV)
                     || (u1_chroma_format == IV_YUV_420SP_VU))
     {
@@ -2061,20 +2585,24 @@ UWORD32 ih264d_get_outbuf_size(WORD32 pic_wd,
         p_buf_size[1] = (pic_wd * pic_ht) >> 1;
         p_buf_size[2] = 0;
     }
+    else
+    {
+        p_buf_size[0] = p_buf_size[1] = p_buf_size[2] = 0;
+    }
 
     return u4_min_num_out_bufs;
 }
 
 WORD32 check_app_out_buf_size(dec_struct_t *ps_dec)
 {
-    UWORD32 au4_min_out_buf_size[IVD_VIDDEC_MAX_IO_BUFFERS];
+    UWORD32 au4_min_out_buf_size[IVD_VIDDEC_MAX_IO_BUFFERS] = {0};
     UWORD32 u4_min_num_out_bufs, i;
     UWORD32 pic_wd, pic_ht;
 
     if(0 == ps_dec->u4_share_disp_buf)
     {
-        pic_wd = ps_dec->u2_disp_width;
-        pic_ht = ps_dec->u2_disp_height;
+        pic_wd = OUT_SCALED_DIM(ps_dec->u2_disp_width, ps_dec->u4_out_scale_log2);
+        pic_ht = OUT_SCALED_DIM(ps_dec->u2_disp_height, ps_dec->u4_out_scale_log2);
 
     }
     else
@@ -2163,6 +2691,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     WORD32 ret = 0,api_ret_value = IV_SUCCESS;
     WORD32 header_data_left = 0,frame_data_left = 0;
     UWORD8 *pu1_bitstrm_buf;
+    UWORD32 u4_start_time_us = 0;
     ih264d_video_decode_ip_t *ps_h264d_dec_ip;
     ih264d_video_decode_op_t *ps_h264d_dec_op;
     ivd_video_decode_ip_t *ps_dec_ip;
@@ -2191,6 +2720,11 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     /*Data memory barries instruction,so that bitstream write by the application is complete*/
     DATA_SYNC();
 
+    if(ps_dec->u4_degrade_budget_us)
+    {
+        u4_start_time_us = ithread_get_time_us();
+    }
+
     if(0 == ps_dec->u1_flushfrm)
     {
         if(ps_dec_ip->pv_stream_buffer == NULL)
@@ -2213,7 +2747,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     {
         UWORD32 i;
         ps_dec->i4_break_threads = 0;
-        for (i = 0; i < 2; i++)
+        for (i = 0; i < H264_MAX_PROC_THREADS; i++)
         {
             ret = ithread_mutex_lock(ps_dec->apv_proc_start_mutex[i]);
             RETURN_IF((ret != IV_SUCCESS), ret);
@@ -2227,6 +2761,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     else {
         ps_dec->u4_dec_thread_created = 0;
         ps_dec->u4_bs_deblk_thread_created = 0;
+        ps_dec->u4_deblk_thread_created = 0;
     }
 
     ps_dec_op->u4_num_bytes_consumed = 0;
@@ -2241,6 +2776,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_dec->u4_fmt_conv_cur_row = 0;
 
     ps_dec->u4_output_present = 0;
+    ps_dec->u4_fused_fmt_conv = 0;
     ps_dec->s_disp_op.u4_error_code = 1;
     ps_dec->u4_fmt_conv_num_rows = FMT_CONV_NUM_ROWS;
     if(0 == ps_dec->u4_share_disp_buf
@@ -2292,6 +2828,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_dec->i4_content_type = IV_CONTENTTYPE_NA;
 
     ps_dec->u4_slice_start_code_found = 0;
+    ps_dec->u1_pic_skipped = 0;
 
     /* In case the decoder is not in flush mode(in shared mode),
      then decoder has to pick up a buffer to write current frame.
@@ -2423,9 +2960,9 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
             ps_dec->u4_fmt_conv_cur_row = 0;
             ps_dec->u4_fmt_conv_num_rows = ps_dec->s_disp_frame_info.u4_y_ht;
-            ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
-                                  ps_dec->u4_fmt_conv_cur_row,
-                                  ps_dec->u4_fmt_conv_num_rows);
+            ih264d_format_convert_stripes(ps_dec, &(ps_dec->s_disp_op),
+                                          ps_dec->u4_fmt_conv_cur_row,
+                                          ps_dec->u4_fmt_conv_num_rows);
             ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
             ps_dec->u4_output_present = 1;
 
@@ -2549,9 +3086,20 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
         u4_next_is_aud = 0;
 
-        buflen = ih264d_find_start_code(pu1_buf, 0, u4_max_ofst,
-                                               &u4_length_of_start_code,
-                                               &u4_next_is_aud);
+        if(ps_dec->u1_nal_length_size)
+        {
+            buflen = ih264d_find_length_prefixed_nal(pu1_buf, u4_max_ofst,
+                                                     ps_dec->u1_nal_length_size,
+                                                     &u4_length_of_start_code,
+                                                     &u4_next_is_aud);
+        }
+        else
+        {
+            buflen = ih264d_find_start_code(pu1_buf, 0, u4_max_ofst,
+                                            &u4_length_of_start_code,
+                                            &u4_next_is_aud,
+                                            ps_dec->pf_find_zero_run);
+        }
 
         if(buflen == -1)
             buflen = 0;
@@ -2638,6 +3186,11 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             {
                 ps_dec_op->u4_num_bytes_consumed -= bytes_consumed;
                 api_ret_value = IV_FAIL;
+
+                /* The access unit of a dropped picture ends here */
+                if((ret == ERROR_INCOMPLETE_FRAME) && ps_dec->u1_pic_skipped
+                                && (ps_dec->u4_pic_buf_got == 0))
+                    api_ret_value = IV_SUCCESS;
                 break;
             }
 
@@ -2661,6 +3214,14 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     }
     while(( header_data_left == 1)||(frame_data_left == 1));
 
+    /* A picture dropped by the skip mode is reported as a status, not an error */
+    if(ps_dec->u1_pic_skipped && (ps_dec->u4_pic_buf_got == 0)
+                    && (api_ret_value == IV_SUCCESS))
+    {
+        ps_dec_op->u4_error_code = IH264D_PIC_SKIPPED;
+        ps_dec_op->u4_frame_decoded_flag = 0;
+    }
+
     if((ps_dec->u4_pic_buf_got == 1)
             && (ret != IVD_MEM_ALLOC_FAILED)
             && ps_dec->u4_total_mbs_coded < ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
@@ -2879,6 +3440,14 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             {
                 ps_dec->u4_fmt_conv_cur_row = 0;
                 ps_dec->u4_output_present = 1;
+
+                /* Rows already converted as they were deblocked */
+                if(ps_dec->u4_fused_fmt_conv
+                                && (ps_dec->s_disp_op.u4_disp_buf_id
+                                                == ps_dec->u1_pic_buf_id))
+                {
+                    ps_dec->u4_fmt_conv_cur_row = ps_dec->u4_fused_fmt_conv_row;
+                }
             }
         }
 
@@ -2891,9 +3460,9 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         {
             ps_dec->u4_fmt_conv_num_rows = ps_dec->s_disp_frame_info.u4_y_ht
                             - ps_dec->u4_fmt_conv_cur_row;
-            ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
-                                  ps_dec->u4_fmt_conv_cur_row,
-                                  ps_dec->u4_fmt_conv_num_rows);
+            ih264d_format_convert_stripes(ps_dec, &(ps_dec->s_disp_op),
+                                          ps_dec->u4_fmt_conv_cur_row,
+                                          ps_dec->u4_fmt_conv_num_rows);
             ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
         }
 
@@ -2963,6 +3532,17 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         }
     }
 
+    /* Frames are timed over all the calls decoding them, such as for fields */
+    if(ps_dec->u4_degrade_budget_us)
+    {
+        ps_dec->u4_degrade_time_us += ithread_get_time_us() - u4_start_time_us;
+        if(ps_dec_op->u4_frame_decoded_flag)
+        {
+            ih264d_update_degrade_level(ps_dec, ps_dec->u4_degrade_time_us);
+            ps_dec->u4_degrade_time_us = 0;
+        }
+    }
+
     /*Data memory barrier instruction,so that yuv write by the library is complete*/
     DATA_SYNC();
 
@@ -3227,8 +3807,10 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
         if(0 == ps_dec->u4_share_disp_buf)
         {
-            pic_wd = ps_dec->u2_disp_width;
-            pic_ht = ps_dec->u2_disp_height;
+            pic_wd = OUT_SCALED_DIM(ps_dec->u2_disp_width,
+                                    ps_dec->u4_out_scale_log2);
+            pic_ht = OUT_SCALED_DIM(ps_dec->u2_disp_height,
+                                    ps_dec->u4_out_scale_log2);
 
         }
         else
@@ -3308,6 +3890,10 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     {
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_RGB565;
     }
+    else if(ps_dec->u1_chroma_format == IV_RGBA_8888)
+    {
+        ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_RGBA8888;
+    }
     else if((ps_dec->u1_chroma_format == IV_YUV_420SP_UV)
                     || (ps_dec->u1_chroma_format == IV_YUV_420SP_VU))
     {
@@ -3349,6 +3935,13 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         ps_ctl_op->u4_min_out_buf_size[1] =
                         ps_ctl_op->u4_min_out_buf_size[2] = 0;
     }
+    else if(ps_dec->u1_chroma_format == IV_RGBA_8888)
+    {
+        ps_ctl_op->u4_min_out_buf_size[0] = (pic_wd * pic_ht)
+                        * 4;
+        ps_ctl_op->u4_min_out_buf_size[1] =
+                        ps_ctl_op->u4_min_out_buf_size[2] = 0;
+    }
     else if((ps_dec->u1_chroma_format == IV_YUV_420SP_UV)
                     || (ps_dec->u1_chroma_format == IV_YUV_420SP_VU))
     {
@@ -3391,7 +3984,7 @@ WORD32 ih264d_get_buf_info(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     UWORD16 pic_wd, pic_ht;
     ivd_ctl_getbufinfo_op_t *ps_ctl_op =
                     (ivd_ctl_getbufinfo_op_t*)pv_api_op;
-    UWORD32 au4_min_out_buf_size[IVD_VIDDEC_MAX_IO_BUFFERS];
+    UWORD32 au4_min_out_buf_size[IVD_VIDDEC_MAX_IO_BUFFERS] = {0};
     UNUSED(pv_api_ip);
 
     ps_ctl_op->u4_error_code = 0;
@@ -3428,6 +4021,11 @@ WORD32 ih264d_get_buf_info(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     {
         ps_ctl_op->u4_min_in_buf_size[i] = MAX(256000, pic_wd * pic_ht * 3 / 2);
     }
+    if(0 == ps_dec->u4_share_disp_buf)
+    {
+        pic_wd = OUT_SCALED_DIM(pic_wd, ps_dec->u4_out_scale_log2);
+        pic_ht = OUT_SCALED_DIM(pic_ht, ps_dec->u4_out_scale_log2);
+    }
     if((WORD32)ps_dec->u4_app_disp_width > pic_wd)
         pic_wd = ps_dec->u4_app_disp_width;
 
@@ -3521,7 +4119,15 @@ WORD32 ih264d_set_params(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
     ps_ctl_op->u4_error_code = 0;
 
-    if(ps_ctl_ip->e_frm_skip_mode != IVD_SKIP_NONE)
+    /* Non reference P or B pictures are skipped, and all P and B pictures */
+    /* when both are, which decodes the I pictures only                    */
+    if(ps_ctl_ip->e_frm_skip_mode == IVD_SKIP_P)
+        ps_dec->u4_skip_frm_mask = P_SLC_BIT;
+    else if(ps_ctl_ip->e_frm_skip_mode == IVD_SKIP_B)
+        ps_dec->u4_skip_frm_mask = B_SLC_BIT;
+    else if(ps_ctl_ip->e_frm_skip_mode == IVD_SKIP_PB)
+        ps_dec->u4_skip_frm_mask = P_SLC_BIT | B_SLC_BIT;
+    else if(ps_ctl_ip->e_frm_skip_mode != IVD_SKIP_NONE)
     {
         ps_ctl_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM);
         ret = IV_FAIL;
@@ -3649,6 +4255,11 @@ WORD32 ih264d_delete(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_dec = (dec_struct_t *)(dec_hdl->pv_codec_handle);
     UNUSED(ps_ip);
     ps_op->s_ivd_delete_op_t.u4_error_code = 0;
+    /* Queued access units are decoded before the buffers are freed */
+    if(ps_dec->pv_async_ctxt)
+    {
+        ih264d_async_stop((async_ctxt_t *)ps_dec->pv_async_ctxt);
+    }
     ih264d_free_dynamic_bufs(ps_dec);
     ih264d_free_static_bufs(dec_hdl);
     return IV_SUCCESS;
@@ -3806,6 +4417,30 @@ WORD32 ih264d_ctl(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             ret = ih264d_get_sei_fgc_params(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
             break;
 
+        case IH264D_CMD_CTL_GET_THREAD_WAIT_STATS:
+            ret = ih264d_get_thread_wait_stats(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+            break;
+
+        case IH264D_CMD_CTL_SET_THREAD_POOL:
+            ret = ih264d_set_thread_pool(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+            break;
+
+        case IH264D_CMD_CTL_SET_ROW_CALLBACK:
+            ret = ih264d_set_row_callback(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+            break;
+
+        case IH264D_CMD_CTL_SET_OUTPUT_SCALE:
+            ret = ih264d_set_output_scale(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+            break;
+
+        case IH264D_CMD_CTL_GET_RAP_OFFSETS:
+            ret = ih264d_get_rap_offsets(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+            break;
+
+        case IH264D_CMD_CTL_SET_DEGRADE_DEADLINE:
+            ret = ih264d_set_degrade_deadline(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+            break;
+
         case IH264D_CMD_CTL_SET_PROCESSOR:
             ret = ih264d_set_processor(dec_hdl, (void *)pv_api_ip,
                                        (void *)pv_api_op);
@@ -4521,6 +5156,285 @@ WORD32 ih264d_get_sei_fgc_params(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_ap
     return IV_SUCCESS;
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_get_thread_wait_stats                             */
+/*                                                                           */
+/*  Description   : This function returns the number of waits, spins and     */
+/*                  sleeps of each decoder thread while waiting for the      */
+/*                  progress of another thread, and the time spent in them   */
+/*  Inputs        : iv_obj_t decoder handle                                  */
+/*                : pv_api_ip pointer to input structure                     */
+/*                : pv_api_op pointer to output structure                    */
+/*  Outputs       :                                                          */
+/*  Returns       : IV_SUCCESS                                               */
+/*                                                                           */
+/*  Issues        : To be called between decode calls, when the decoder      */
+/*                  threads are idle                                         */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_get_thread_wait_stats(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_get_thread_wait_stats_ip_t *ps_ip;
+    ih264d_ctl_get_thread_wait_stats_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    WORD32 i;
+
+    ps_ip = (ih264d_ctl_get_thread_wait_stats_ip_t *) pv_api_ip;
+    ps_op = (ih264d_ctl_get_thread_wait_stats_op_t *) pv_api_op;
+
+    for(i = 0; i < IH264D_NUM_WAIT_STATS_THREADS; i++)
+    {
+        wait_stats_t *ps_stats = &ps_dec->as_wait_stats[i];
+
+        ps_op->au4_num_waits[i] = ps_stats->u4_num_waits;
+        ps_op->au4_num_spins[i] = ps_stats->u4_num_spins;
+        ps_op->au4_num_sleeps[i] = ps_stats->u4_num_sleeps;
+        ps_op->au8_wait_time_us[i] = ps_stats->u8_wait_time_us;
+    }
+
+    if(ps_ip->u4_reset)
+    {
+        memset(ps_dec->as_wait_stats, 0, sizeof(ps_dec->as_wait_stats));
+    }
+
+    ps_op->u4_error_code = 0;
+    return IV_SUCCESS;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_set_thread_pool                                   */
+/*                                                                           */
+/*  Description   : Makes the decoder run its threads as jobs of a worker    */
+/*                  pool shared with other decoder instances                 */
+/*  Inputs        : iv_obj_t decoder handle                                  */
+/*                : pv_api_ip pointer to input structure                     */
+/*                : pv_api_op pointer to output structure                    */
+/*  Outputs       :                                                          */
+/*  Returns       : IV_SUCCESS / IV_FAIL                                     */
+/*                                                                           */
+/*  Issues        : Has to be called before the first decode call, and is    */
+/*                  not supported with u4_keep_threads_active                */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_set_thread_pool(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_set_thread_pool_ip_t *ps_ip;
+    ih264d_ctl_set_thread_pool_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    WORD32 cond_size = ithread_get_cond_struct_size();
+    UWORD8 *pu1_cond;
+    UWORD32 i;
+
+    ps_ip = (ih264d_ctl_set_thread_pool_ip_t *) pv_api_ip;
+    ps_op = (ih264d_ctl_set_thread_pool_op_t *) pv_api_op;
+    ps_op->u4_error_code = 0;
+
+    /* Keep alive threads wait for the next picture, which a pool job can not.
+     * The pool can not be changed once threads may have been started either */
+    if((NULL == ps_ip->pv_thread_pool) || ps_dec->i4_threads_active
+                    || ps_dec->ps_thread_pool
+                    || ps_dec->u4_dec_thread_created
+                    || ps_dec->u4_bs_deblk_thread_created
+                    || ps_dec->u4_deblk_thread_created)
+    {
+        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+        return IV_FAIL;
+    }
+
+    pu1_cond = ps_dec->pf_aligned_alloc(ps_dec->pv_mem_ctxt, 8,
+                                        cond_size * H264_MAX_PROC_THREADS);
+    if(NULL == pu1_cond)
+    {
+        ps_op->u4_error_code = IVD_MEM_ALLOC_FAILED;
+        return IV_FAIL;
+    }
+    memset(pu1_cond, 0, cond_size * H264_MAX_PROC_THREADS);
+
+    for(i = 0; i < H264_MAX_PROC_THREADS; i++)
+    {
+        pool_job_t *ps_job = &ps_dec->as_pool_job[i];
+
+        ps_job->ps_next = NULL;
+        ps_job->i4_state = POOL_JOB_IDLE;
+        ps_job->pv_done_cond = pu1_cond + i * cond_size;
+        ithread_cond_init(ps_job->pv_done_cond);
+    }
+
+    ps_dec->ps_thread_pool = (thread_pool_t *)ps_ip->pv_thread_pool;
+    return IV_SUCCESS;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_set_row_callback                                  */
+/*                                                                           */
+/*  Description   : Sets the callback reporting the MB rows of the picture   */
+/*                  being decoded that are complete                          */
+/*  Inputs        : iv_obj_t decoder handle                                  */
+/*                : pv_api_ip pointer to input structure                     */
+/*                : pv_api_op pointer to output structure                    */
+/*  Outputs       :                                                          */
+/*  Returns       : IV_SUCCESS                                               */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_set_row_callback(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_set_row_callback_ip_t *ps_ip;
+    ih264d_ctl_set_row_callback_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+    ps_ip = (ih264d_ctl_set_row_callback_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_row_callback_op_t *)pv_api_op;
+
+    ps_dec->pf_row_done = ps_ip->pf_row_done;
+    ps_dec->pv_row_done_ctxt = ps_ip->pv_cb_ctxt;
+
+    ps_op->u4_error_code = 0;
+    return IV_SUCCESS;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_set_output_scale                                  */
+/*                                                                           */
+/*  Description   : Sets the factor the output is downscaled by              */
+/*  Inputs        : iv_obj_t decoder handle                                  */
+/*                : pv_api_ip pointer to input structure                     */
+/*                : pv_api_op pointer to output structure                    */
+/*  Outputs       :                                                          */
+/*  Returns       : IV_SUCCESS, or IV_FAIL for an unsupported scale          */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_set_output_scale(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_set_output_scale_ip_t *ps_ip;
+    ih264d_ctl_set_output_scale_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+    ps_ip = (ih264d_ctl_set_output_scale_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_output_scale_op_t *)pv_api_op;
+
+    ps_op->u4_error_code = 0;
+
+    /* The decoder writes shared display buffers directly */
+    if((ps_ip->u4_scale_log2 > MAX_OUT_SCALE_LOG2)
+                    || (ps_ip->u4_scale_log2
+                                    && (ps_dec->u4_share_disp_buf
+                                                    || (IV_YUV_422ILE
+                                                                    == ps_dec->u1_chroma_format))))
+    {
+        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+        ps_op->u4_error_code |= IH264D_OUT_SCALE_NOT_SUPPORTED;
+        return IV_FAIL;
+    }
+
+    ps_dec->u4_out_scale_log2 = ps_ip->u4_scale_log2;
+
+    return IV_SUCCESS;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_get_rap_offsets                                   */
+/*                                                                           */
+/*  Description   : Finds the access units decoding can start from in a      */
+/*                  buffer, without decoding it                              */
+/*  Inputs        : iv_obj_t decoder handle                                  */
+/*                : pv_api_ip pointer to input structure                     */
+/*                : pv_api_op pointer to output structure                    */
+/*  Outputs       :                                                          */
+/*  Returns       : IV_SUCCESS                                               */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_get_rap_offsets(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_get_rap_offsets_ip_t *ps_ip;
+    ih264d_ctl_get_rap_offsets_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+    ps_ip = (ih264d_ctl_get_rap_offsets_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_get_rap_offsets_op_t *)pv_api_op;
+
+    ps_op->u4_error_code = 0;
+    ps_op->u4_num_bytes_scanned = ih264d_find_rap_offsets(
+                    (UWORD8 *)ps_ip->pv_stream_buffer, ps_ip->u4_num_bytes,
+                    ps_dec->u1_nal_length_size, ps_ip->u4_include_i_pics,
+                    ps_ip->pu4_rap_offsets, ps_ip->u4_max_raps,
+                    &ps_op->u4_num_raps, ps_dec->pf_find_zero_run);
+
+    return IV_SUCCESS;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_set_degrade_deadline                              */
+/*                                                                           */
+/*  Description   : Sets the per frame time budget of the automatic degrade  */
+/*                  and restarts it from full quality decoding               */
+/*  Inputs        : iv_obj_t decoder handle                                  */
+/*                : pv_api_ip pointer to input structure                     */
+/*                : pv_api_op pointer to output structure                    */
+/*  Outputs       :                                                          */
+/*  Returns       : IV_SUCCESS                                               */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_set_degrade_deadline(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_set_degrade_deadline_ip_t *ps_ip;
+    ih264d_ctl_set_degrade_deadline_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+    ps_ip = (ih264d_ctl_set_degrade_deadline_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_degrade_deadline_op_t *)pv_api_op;
+
+    ps_op->u4_error_code = 0;
+    ps_op->u4_degrade_level = ps_dec->u4_degrade_level;
+
+    ps_dec->u4_degrade_budget_us = ps_ip->u4_frame_budget_us;
+    ps_dec->u4_degrade_level = 0;
+    ps_dec->u4_degrade_time_us = 0;
+    ps_dec->u4_degrade_over_cnt = 0;
+    ps_dec->u4_degrade_under_cnt = 0;
+
+    return IV_SUCCESS;
+}
+
 WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 {
     ih264d_ctl_set_num_cores_ip_t *ps_ip;
@@ -4540,9 +5454,14 @@ WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         ps_dec->u1_separate_parse = 1;
     }
 
-    /*using only upto three threads currently*/
-    if(ps_dec->u4_num_cores > 3)
-        ps_dec->u4_num_cores = 3;
+    /* Pipeline uses only upto three threads, the rest are auxiliary cores
+     * for the trailing deblocking thread and the recon row workers */
+    ps_dec->u4_num_aux_cores = 0;
+    if(ps_dec->u4_num_cores > H264_PIPELINE_CORES)
+    {
+        ps_dec->u4_num_aux_cores = ps_dec->u4_num_cores - H264_PIPELINE_CORES;
+        ps_dec->u4_num_cores = H264_PIPELINE_CORES;
+    }
 
     return IV_SUCCESS;
 }
@@ -4581,6 +5500,55 @@ void ih264d_fill_output_struct_from_context(dec_struct_t *ps_dec,
     ih264d_export_sei_params(&ps_dec_op->s_sei_decode_op, ps_dec);
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_allowed_while_au_pending                          */
+/*                                                                           */
+/*  Description   : Checks if a command can run between two access units    */
+/*                  queued with IH264D_CMD_QUEUE_INPUT. Release of display   */
+/*                  buffers and the control calls that only read the state  */
+/*                  of the decoder can, so that shared display buffers are  */
+/*                  returned while input is queued                          */
+/*                                                                           */
+/*  Inputs        : command  API command                                     */
+/*                  pv_api_ip pointer to input structure                     */
+/*  Outputs       : None                                                     */
+/*  Returns       : 1 if allowed, 0 otherwise                                */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static WORD32 ih264d_allowed_while_au_pending(UWORD32 command, void *pv_api_ip)
+{
+    UWORD32 u4_sub_cmd;
+
+    if(IVD_CMD_REL_DISPLAY_FRAME == command)
+        return 1;
+    if(IVD_CMD_VIDEO_CTL != command)
+        return 0;
+
+    u4_sub_cmd = ((ivd_ctl_set_config_ip_t *)pv_api_ip)->e_sub_cmd;
+    switch(u4_sub_cmd)
+    {
+        case IVD_CMD_CTL_GETPARAMS:
+        case IVD_CMD_CTL_GETBUFINFO:
+        case IVD_CMD_CTL_GETVERSION:
+        case IH264D_CMD_CTL_GET_BUFFER_DIMENSIONS:
+        case IH264D_CMD_CTL_GET_VUI_PARAMS:
+        case IH264D_CMD_CTL_GET_SEI_MDCV_PARAMS:
+        case IH264D_CMD_CTL_GET_SEI_CLL_PARAMS:
+        case IH264D_CMD_CTL_GET_SEI_AVE_PARAMS:
+        case IH264D_CMD_CTL_GET_SEI_CCV_PARAMS:
+        case IH264D_CMD_CTL_GET_SEI_SII_PARAMS:
+        case IH264D_CMD_CTL_GET_SEI_FGC_PARAMS:
+        case IH264D_CMD_CTL_GET_THREAD_WAIT_STATS:
+        case IH264D_CMD_CTL_GET_RAP_OFFSETS:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : ih264d_api_function                                      */
@@ -4609,6 +5577,7 @@ IV_API_CALL_STATUS_T ih264d_api_function(iv_obj_t *dec_hdl,
     UWORD32 *pu2_ptr_cmd;
     UWORD32 u4_api_ret;
     IV_API_CALL_STATUS_T e_status;
+    async_ctxt_t *ps_async_locked = NULL;
     e_status = api_check_struct_sanity(dec_hdl, pv_api_ip, pv_api_op);
 
     if(e_status != IV_SUCCESS)
@@ -4625,6 +5594,31 @@ IV_API_CALL_STATUS_T ih264d_api_function(iv_obj_t *dec_hdl,
     pu2_ptr_cmd++;
 
     command = *pu2_ptr_cmd;
+
+    /* While access units queued with IH264D_CMD_QUEUE_INPUT are pending,
+     * the async commands and delete are allowed, and the commands of
+     * ih264d_allowed_while_au_pending run between two access units */
+    if((command != IVD_CMD_CREATE) && (command != IVD_CMD_DELETE)
+                    && (command != IH264D_CMD_QUEUE_INPUT)
+                    && (command != IH264D_CMD_DEQUEUE_OUTPUT))
+    {
+        dec_struct_t *ps_dec = (dec_struct_t *)(dec_hdl->pv_codec_handle);
+        async_ctxt_t *ps_async = (async_ctxt_t *)ps_dec->pv_async_ctxt;
+
+        if(ih264d_async_pending(ps_async))
+        {
+            UWORD32 *pu4_api_op = (UWORD32 *)pv_api_op;
+
+            if(0 == ih264d_allowed_while_au_pending(command, pv_api_ip))
+            {
+                *(pu4_api_op + 1) |= 1 << IVD_UNSUPPORTEDPARAM;
+                *(pu4_api_op + 1) |= IH264D_ASYNC_AU_PENDING;
+                return IV_FAIL;
+            }
+            ih264d_async_lock_decode(ps_async);
+            ps_async_locked = ps_async;
+        }
+    }
 //    H264_DEC_DEBUG_PRINT("inside lib = %d\n",command);
     switch(command)
     {
@@ -4664,10 +5658,23 @@ IV_API_CALL_STATUS_T ih264d_api_function(iv_obj_t *dec_hdl,
             u4_api_ret = ih264d_ctl(dec_hdl, (void *)pv_api_ip,
                                     (void *)pv_api_op);
             break;
+
+        case IH264D_CMD_QUEUE_INPUT:
+            u4_api_ret = ih264d_async_queue_input(dec_hdl, (void *)pv_api_ip,
+                                                  (void *)pv_api_op);
+            break;
+
+        case IH264D_CMD_DEQUEUE_OUTPUT:
+            u4_api_ret = ih264d_async_dequeue_output(dec_hdl, (void *)pv_api_ip,
+                                                     (void *)pv_api_op);
+            break;
         default:
             u4_api_ret = IV_FAIL;
             break;
     }
 
+    if(NULL != ps_async_locked)
+        ih264d_async_unlock_decode(ps_async_locked);
+
     return u4_api_ret;
 }
@@ -36,6 +36,7 @@
 #define MIN_OUT_BUFS_420 3
 #define MIN_OUT_BUFS_422ILE 1
 #define MIN_OUT_BUFS_RGB565 1
+#define MIN_OUT_BUFS_RGBA8888 1
 #define MIN_OUT_BUFS_420SP 2
 
 extern WORD32 ih264d_create(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
@@ -0,0 +1,410 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_async.c
+ *
+ * @brief
+ *  Queue input / dequeue output API, decoding access units in a thread
+ *
+ * @par List of Functions:
+ *  - ih264d_async_get_ctxt_size()
+ *  - ih264d_async_init()
+ *  - ih264d_async_stop()
+ *  - ih264d_async_deinit()
+ *  - ih264d_async_pending()
+ *  - ih264d_async_lock_decode()
+ *  - ih264d_async_unlock_decode()
+ *  - ih264d_async_thread()
+ *  - ih264d_async_queue_input()
+ *  - ih264d_async_dequeue_output()
+ *
+ * @remarks
+ *  Access units are decoded one after the other by a single thread, with the
+ *  same decode call as IVD_CMD_VIDEO_DECODE. The output is therefore the same
+ *  as that of synchronous decoding, while the application can queue the
+ *  next access units and display the previous ones in the meantime
+ *
+ *******************************************************************************
+ */
+
+#include <string.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
+#include "ithread.h"
+#include "ih264d_structs.h"
+#include "ih264d_async.h"
+
+WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Returns the size of the async context, including its thread handle,
+ *  mutexes and conditions
+ *
+ * @returns  Size in bytes
+ *
+ *******************************************************************************
+ */
+UWORD32 ih264d_async_get_ctxt_size(void)
+{
+    return ALIGN128(sizeof(async_ctxt_t))
+                    + ALIGN128(ithread_get_handle_size())
+                    + 2 * ALIGN128(ithread_get_mutex_lock_size())
+                    + 2 * ALIGN128(ithread_get_cond_struct_size());
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Initializes the async context in a buffer of ih264d_async_get_ctxt_size()
+ *  bytes
+ *
+ * @param[in] ps_async
+ *  Async context, at the start of pu1_buf
+ *
+ * @param[in] pu1_buf
+ *  Buffer
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_async_init(async_ctxt_t *ps_async, UWORD8 *pu1_buf)
+{
+    memset(pu1_buf, 0, ih264d_async_get_ctxt_size());
+
+    pu1_buf += ALIGN128(sizeof(async_ctxt_t));
+    ps_async->pv_thread_handle = pu1_buf;
+    pu1_buf += ALIGN128(ithread_get_handle_size());
+    ps_async->pv_mutex = pu1_buf;
+    pu1_buf += ALIGN128(ithread_get_mutex_lock_size());
+    ps_async->pv_decode_mutex = pu1_buf;
+    pu1_buf += ALIGN128(ithread_get_mutex_lock_size());
+    ps_async->pv_queued_cond = pu1_buf;
+    pu1_buf += ALIGN128(ithread_get_cond_struct_size());
+    ps_async->pv_decoded_cond = pu1_buf;
+
+    ithread_mutex_init(ps_async->pv_mutex);
+    ithread_mutex_init(ps_async->pv_decode_mutex);
+    ithread_cond_init(ps_async->pv_queued_cond);
+    ithread_cond_init(ps_async->pv_decoded_cond);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Lets the thread decode the access units still queued and then stops it
+ *
+ * @param[in] ps_async
+ *  Async context
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_async_stop(async_ctxt_t *ps_async)
+{
+    if(ps_async->i4_thread_created)
+    {
+        ithread_mutex_lock(ps_async->pv_mutex);
+        ps_async->i4_exit = 1;
+        ithread_cond_signal(ps_async->pv_queued_cond);
+        ithread_mutex_unlock(ps_async->pv_mutex);
+
+        ithread_join(ps_async->pv_thread_handle, NULL);
+        ps_async->i4_thread_created = 0;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Stops the thread and destroys the mutexes and conditions
+ *
+ * @param[in] ps_async
+ *  Async context
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_async_deinit(async_ctxt_t *ps_async)
+{
+    ih264d_async_stop(ps_async);
+
+    ithread_cond_destroy(ps_async->pv_decoded_cond);
+    ithread_cond_destroy(ps_async->pv_queued_cond);
+    ithread_mutex_destroy(ps_async->pv_decode_mutex);
+    ithread_mutex_destroy(ps_async->pv_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Checks if there are access units queued and not yet dequeued
+ *
+ * @param[in] ps_async
+ *  Async context
+ *
+ * @returns  1 if access units are pending, 0 otherwise
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_async_pending(async_ctxt_t *ps_async)
+{
+    WORD32 i4_pending;
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+    i4_pending = (ps_async->u4_num_queued != ps_async->u4_num_dequeued);
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    return i4_pending;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Waits for the access unit being decoded, if any, and keeps the thread from
+ *  starting the next one until ih264d_async_unlock_decode()
+ *
+ * @param[in] ps_async
+ *  Async context
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_async_lock_decode(async_ctxt_t *ps_async)
+{
+    ithread_mutex_lock(ps_async->pv_decode_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Lets the thread decode the queued access units again
+ *
+ * @param[in] ps_async
+ *  Async context
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_async_unlock_decode(async_ctxt_t *ps_async)
+{
+    ithread_mutex_unlock(ps_async->pv_decode_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Thread decoding the queued access units in order
+ *
+ * @param[in] ps_async
+ *  Async context
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+static void ih264d_async_thread(async_ctxt_t *ps_async)
+{
+    ithread_set_name("ih264d_async_thread");
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+    while(1)
+    {
+        async_au_t *ps_au;
+
+        while((ps_async->u4_num_decoded == ps_async->u4_num_queued)
+                        && (0 == ps_async->i4_exit))
+        {
+            ithread_cond_wait(ps_async->pv_queued_cond, ps_async->pv_mutex);
+        }
+        if(ps_async->u4_num_decoded == ps_async->u4_num_queued)
+            break;
+
+        ps_au = &ps_async->as_au[ps_async->u4_num_decoded
+                        % IH264D_ASYNC_QUEUE_DEPTH];
+        ithread_mutex_unlock(ps_async->pv_mutex);
+
+        ithread_mutex_lock(ps_async->pv_decode_mutex);
+        ps_au->e_status = ih264d_video_decode(ps_async->ps_dec_hdl,
+                                              (void *)&ps_au->s_ip,
+                                              (void *)&ps_au->s_op);
+        ithread_mutex_unlock(ps_async->pv_decode_mutex);
+
+        ithread_mutex_lock(ps_async->pv_mutex);
+        ps_async->u4_num_decoded++;
+        ithread_cond_signal(ps_async->pv_decoded_cond);
+    }
+    ithread_mutex_unlock(ps_async->pv_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Queues an access unit for decoding. Starts the decoding thread on the
+ *  first call
+ *
+ * @param[in] dec_hdl
+ *  Decoder handle
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to ih264d_queue_input_ip_t
+ *
+ * @param[out] pv_api_op
+ *  Pointer to ih264d_queue_input_op_t
+ *
+ * @returns  IV_SUCCESS / IV_FAIL
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_async_queue_input(iv_obj_t *dec_hdl,
+                                void *pv_api_ip,
+                                void *pv_api_op)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+    async_ctxt_t *ps_async = (async_ctxt_t *)ps_dec->pv_async_ctxt;
+    ih264d_queue_input_ip_t *ps_ip = (ih264d_queue_input_ip_t *)pv_api_ip;
+    ih264d_queue_input_op_t *ps_op = (ih264d_queue_input_op_t *)pv_api_op;
+    async_au_t *ps_au;
+    WORD32 ret;
+
+    ps_op->u4_error_code = 0;
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    if((ps_async->u4_num_queued - ps_async->u4_num_dequeued)
+                    >= IH264D_ASYNC_QUEUE_DEPTH)
+    {
+        ithread_mutex_unlock(ps_async->pv_mutex);
+        ps_op->u4_error_code = IH264D_ASYNC_QUEUE_FULL;
+        return IV_FAIL;
+    }
+
+    if(0 == ps_async->i4_thread_created)
+    {
+        ps_async->ps_dec_hdl = dec_hdl;
+        ps_async->i4_exit = 0;
+        ret = ithread_create(ps_async->pv_thread_handle, NULL,
+                             (void *)ih264d_async_thread, (void *)ps_async);
+        if(0 != ret)
+        {
+            ithread_mutex_unlock(ps_async->pv_mutex);
+            ps_op->u4_error_code = IVD_MEM_ALLOC_FAILED;
+            return IV_FAIL;
+        }
+        ps_async->i4_thread_created = 1;
+    }
+
+    ps_au = &ps_async->as_au[ps_async->u4_num_queued % IH264D_ASYNC_QUEUE_DEPTH];
+    memset(&ps_au->s_ip, 0, sizeof(ih264d_video_decode_ip_t));
+    memcpy(&ps_au->s_ip, &ps_ip->s_video_decode_ip,
+           ps_ip->s_video_decode_ip.s_ivd_video_decode_ip_t.u4_size);
+    ps_au->s_op.s_ivd_video_decode_op_t.u4_size =
+                    sizeof(ih264d_video_decode_op_t);
+    ps_au->e_status = IV_FAIL;
+
+    ps_async->u4_num_queued++;
+    ithread_cond_signal(ps_async->pv_queued_cond);
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    return IV_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Returns the output of the oldest queued access unit
+ *
+ * @param[in] dec_hdl
+ *  Decoder handle
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to ih264d_dequeue_output_ip_t
+ *
+ * @param[out] pv_api_op
+ *  Pointer to ih264d_dequeue_output_op_t
+ *
+ * @returns  IV_SUCCESS / IV_FAIL
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_async_dequeue_output(iv_obj_t *dec_hdl,
+                                   void *pv_api_ip,
+                                   void *pv_api_op)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+    async_ctxt_t *ps_async = (async_ctxt_t *)ps_dec->pv_async_ctxt;
+    ih264d_dequeue_output_ip_t *ps_ip = (ih264d_dequeue_output_ip_t *)pv_api_ip;
+    ih264d_dequeue_output_op_t *ps_op = (ih264d_dequeue_output_op_t *)pv_api_op;
+    async_au_t *ps_au;
+
+    ps_op->u4_error_code = 0;
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    if(ps_async->u4_num_dequeued == ps_async->u4_num_queued)
+    {
+        ithread_mutex_unlock(ps_async->pv_mutex);
+        ps_op->u4_error_code = IH264D_ASYNC_QUEUE_EMPTY;
+        return IV_FAIL;
+    }
+
+    while(ps_async->u4_num_dequeued == ps_async->u4_num_decoded)
+    {
+        if(0 == ps_ip->u4_blocking)
+        {
+            ithread_mutex_unlock(ps_async->pv_mutex);
+            ps_op->u4_error_code = IH264D_ASYNC_OUTPUT_NOT_READY;
+            return IV_FAIL;
+        }
+        ithread_cond_wait(ps_async->pv_decoded_cond, ps_async->pv_mutex);
+    }
+
+    ps_au = &ps_async->as_au[ps_async->u4_num_dequeued % IH264D_ASYNC_QUEUE_DEPTH];
+    ps_op->e_video_decode_status = ps_au->e_status;
+    memcpy(&ps_op->s_video_decode_op, &ps_au->s_op,
+           sizeof(ih264d_video_decode_op_t));
+
+    ps_async->u4_num_dequeued++;
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    return IV_SUCCESS;
+}
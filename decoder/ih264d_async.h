@@ -0,0 +1,104 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_async.h
+ *
+ * @brief
+ *  Queue input / dequeue output API, decoding access units in a thread
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+
+#ifndef _IH264D_ASYNC_H_
+#define _IH264D_ASYNC_H_
+
+/** An access unit queued for decoding */
+typedef struct
+{
+    ih264d_video_decode_ip_t s_ip;
+    ih264d_video_decode_op_t s_op;
+    IV_API_CALL_STATUS_T e_status;
+}async_au_t;
+
+typedef struct
+{
+    /** Ring of queued access units */
+    async_au_t as_au[IH264D_ASYNC_QUEUE_DEPTH];
+
+    /**
+     * Number of access units queued, decoded and dequeued so far. Ring index
+     * of each is the count modulo IH264D_ASYNC_QUEUE_DEPTH
+     */
+    UWORD32 u4_num_queued;
+    UWORD32 u4_num_decoded;
+    UWORD32 u4_num_dequeued;
+
+    /** Decoder handle passed to the decode calls */
+    iv_obj_t *ps_dec_hdl;
+
+    /** Thread decoding the queued access units */
+    void *pv_thread_handle;
+    WORD32 i4_thread_created;
+    WORD32 i4_exit;
+
+    /** Protects the counters above */
+    void *pv_mutex;
+
+    /**
+     * Held by the thread while it decodes an access unit, and by the calls
+     * that are allowed while access units are pending
+     */
+    void *pv_decode_mutex;
+
+    /** Signalled when an access unit is queued, and when exiting */
+    void *pv_queued_cond;
+
+    /** Signalled when an access unit is decoded */
+    void *pv_decoded_cond;
+}async_ctxt_t;
+
+UWORD32 ih264d_async_get_ctxt_size(void);
+
+void ih264d_async_init(async_ctxt_t *ps_async, UWORD8 *pu1_buf);
+
+void ih264d_async_stop(async_ctxt_t *ps_async);
+
+void ih264d_async_deinit(async_ctxt_t *ps_async);
+
+WORD32 ih264d_async_pending(async_ctxt_t *ps_async);
+
+void ih264d_async_lock_decode(async_ctxt_t *ps_async);
+
+void ih264d_async_unlock_decode(async_ctxt_t *ps_async);
+
+WORD32 ih264d_async_queue_input(iv_obj_t *dec_hdl,
+                                void *pv_api_ip,
+                                void *pv_api_op);
+
+WORD32 ih264d_async_dequeue_output(iv_obj_t *dec_hdl,
+                                   void *pv_api_ip,
+                                   void *pv_api_op);
+
+#endif /* _IH264D_ASYNC_H_ */
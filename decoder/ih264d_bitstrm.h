@@ -115,17 +115,30 @@ UWORD8 ih264d_check_byte_aligned(dec_bit_stream_t * ps_bitstrm);
 
 
 /*****************************************************************************/
-/* Define a macro for inlining of GETBITS: u4_no_bits shall not exceed 32    */
+/* Define a macro for inlining of NEXTBITS_64: reads the 64 bits window      */
+/* starting at the word holding u4_offset, shifted to u4_offset. The top     */
+/* 33 bits at least are valid. Words are read whole and combined without a   */
+/* branch on the bit offset, the buffer being padded beyond the last word    */
 /*****************************************************************************/
-#define     GETBITS(u4_code, u4_offset, pu4_bitstream, u4_no_bits)          \
+#define     NEXTBITS_64(u8_word, u4_offset, pu4_bitstream)                  \
 {                                                                           \
     UWORD32 *pu4_buf =  (pu4_bitstream);                                    \
     UWORD32 u4_word_off = ((u4_offset) >> 5);                               \
     UWORD32 u4_bit_off = (u4_offset) & 0x1F;                                \
-    u4_code = pu4_buf[u4_word_off++] << u4_bit_off;                         \
                                                                             \
-    if(u4_bit_off)                                                          \
-        u4_code |= (pu4_buf[u4_word_off] >> (INT_IN_BITS - u4_bit_off));    \
+    u8_word = ((UWORD64)pu4_buf[u4_word_off] << INT_IN_BITS)                \
+                    | pu4_buf[u4_word_off + 1];                             \
+    u8_word = u8_word << u4_bit_off;                                        \
+}
+
+/*****************************************************************************/
+/* Define a macro for inlining of GETBITS: u4_no_bits shall not exceed 32    */
+/*****************************************************************************/
+#define     GETBITS(u4_code, u4_offset, pu4_bitstream, u4_no_bits)          \
+{                                                                           \
+    UWORD64 u8_win;                                                         \
+    NEXTBITS_64(u8_win, u4_offset, pu4_bitstream);                          \
+    u4_code = (UWORD32)(u8_win >> INT_IN_BITS);                             \
     u4_code = u4_code >> (INT_IN_BITS - u4_no_bits);                        \
     (u4_offset) += u4_no_bits;                                              \
 }                                                                           \
@@ -136,12 +149,9 @@ UWORD8 ih264d_check_byte_aligned(dec_bit_stream_t * ps_bitstrm);
 /*****************************************************************************/
 #define     NEXTBITS(u4_word, u4_offset, pu4_bitstream, u4_no_bits)         \
 {                                                                           \
-    UWORD32 *pu4_buf =  (pu4_bitstream);                                    \
-    UWORD32 u4_word_off = ((u4_offset) >> 5);                               \
-    UWORD32 u4_bit_off = (u4_offset) & 0x1F;                                \
-    u4_word = pu4_buf[u4_word_off++] << u4_bit_off;                         \
-    if(u4_bit_off)                                                          \
-        u4_word |= (pu4_buf[u4_word_off] >> (INT_IN_BITS - u4_bit_off));    \
+    UWORD64 u8_win;                                                         \
+    NEXTBITS_64(u8_win, u4_offset, pu4_bitstream);                          \
+    u4_word = (UWORD32)(u8_win >> INT_IN_BITS);                             \
     u4_word = u4_word >> (INT_IN_BITS - u4_no_bits);                        \
 }
 /*****************************************************************************/
@@ -149,15 +159,51 @@ UWORD8 ih264d_check_byte_aligned(dec_bit_stream_t * ps_bitstrm);
 /*****************************************************************************/
 #define     NEXTBITS_32(u4_word, u4_offset, pu4_bitstream)                  \
 {                                                                           \
-    UWORD32 *pu4_buf =  (pu4_bitstream);                                    \
-    UWORD32 u4_word_off = ((u4_offset) >> 5);                               \
-    UWORD32 u4_bit_off = (u4_offset) & 0x1F;                                \
+    UWORD64 u8_win;                                                         \
+    NEXTBITS_64(u8_win, u4_offset, pu4_bitstream);                          \
+    u4_word = (UWORD32)(u8_win >> INT_IN_BITS);                             \
+}
+
+/*****************************************************************************/
+/* Define a macro for inlining of UEV_64: reads an unsigned exp-Golomb code. */
+/* Codes of up to 31 bits, i.e. values below 65535, are read from a single   */
+/* 64 bits window. Longer ones read the suffix with a second GETBITS         */
+/*****************************************************************************/
+#define     UEV_64(u4_code, u4_offset, pu4_bitstream)                       \
+{                                                                           \
+    UWORD64 u8_win_m;                                                       \
+    UWORD32 u4_ldz_m, u4_len_m;                                             \
                                                                             \
-    u4_word = pu4_buf[u4_word_off++] << u4_bit_off;                         \
-    if(u4_bit_off)                                                          \
-    u4_word |= (pu4_buf[u4_word_off] >> (INT_IN_BITS - u4_bit_off));        \
+    NEXTBITS_64(u8_win_m, u4_offset, pu4_bitstream);                        \
+    u4_ldz_m = CLZ((UWORD32)(u8_win_m >> INT_IN_BITS));                     \
+    if(u4_ldz_m < 16)                                                       \
+    {                                                                       \
+        u4_len_m = (u4_ldz_m << 1) + 1;                                     \
+        u4_code = (UWORD32)(u8_win_m >> (64 - u4_len_m)) - 1;               \
+        (u4_offset) += u4_len_m;                                            \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+        (u4_offset) += (u4_ldz_m + 1);                                      \
+        GETBITS(u4_code, u4_offset, pu4_bitstream, u4_ldz_m);               \
+        u4_code = (1 << u4_ldz_m) + u4_code - 1;                            \
+    }                                                                       \
 }
 
+/*****************************************************************************/
+/* Define a macro for inlining of SEV_64: reads a signed exp-Golomb code     */
+/*****************************************************************************/
+#define     SEV_64(i4_code, u4_offset, pu4_bitstream)                       \
+{                                                                           \
+    UWORD32 u4_code_num_m, u4_abs_val_m;                                    \
+                                                                            \
+    UEV_64(u4_code_num_m, u4_offset, pu4_bitstream);                        \
+    u4_abs_val_m = (u4_code_num_m + 1) >> 1;                                \
+    if(u4_code_num_m & 0x1)                                                 \
+        i4_code = (WORD32)u4_abs_val_m;                                     \
+    else                                                                    \
+        i4_code = -(WORD32)u4_abs_val_m;                                    \
+}
 
 /*****************************************************************************/
 /* Define a macro for inlining of FIND_ONE_IN_STREAM_32                      */
@@ -266,8 +266,6 @@ UWORD32 ih264d_decode_bin(UWORD32 u4_ctx_inc,
 
     u4_symbol = ((u4_mps_state >> 6) & 0x1);
 
-    u4_mps_state = (table_lookup >> 8) & 0x7F;
-
     CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                  u4_int_range_lps, u4_mps_state, table_lookup)
 
@@ -623,48 +621,22 @@ UWORD32 ih264d_decode_bypass_bins_unary(decoding_envirnoment_t *ps_cab_env,
     UWORD32 u4_value;
     UWORD32 u4_bin;
     UWORD32 u4_code_int_val_ofst, u4_code_int_range;
+    UWORD32 u4_bins_available;
 
     UWORD32 u1_max_bins;
 
     u4_code_int_val_ofst = ps_cab_env->u4_code_int_val_ofst;
     u4_code_int_range = ps_cab_env->u4_code_int_range;
 
-    if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
-    {
-        UWORD32 *pu4_buffer, u4_offset;
-
-        pu4_buffer = ps_bitstrm->pu4_buffer;
-        u4_offset = ps_bitstrm->u4_ofst;
-
-        RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
-                            pu4_buffer)
-        ps_bitstrm->u4_ofst = u4_offset;
-    }
-
     /*as it is called only form mvd*/
     u1_max_bins = 32;
     u4_value = 0;
+    u4_bins_available = BYPASS_BINS_AVAILABLE(u4_code_int_range);
 
     do
     {
-        u4_value++;
-
-        u4_code_int_range = u4_code_int_range >> 1;
-        if(u4_code_int_val_ofst >= u4_code_int_range)
-        {
-            /* S=1 */
-            u4_bin = 1;
-            u4_code_int_val_ofst -= u4_code_int_range;
-        }
-        else
-        {
-            /* S=0 */
-            u4_bin = 0;
-        }
-
-        INC_BIN_COUNT(ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
-
-        if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
+        /* Renormalize only when the bins read ahead are used up */
+        if(0 == u4_bins_available)
         {
             UWORD32 *pu4_buffer, u4_offset;
 
@@ -673,10 +645,16 @@ UWORD32 ih264d_decode_bypass_bins_unary(decoding_envirnoment_t *ps_cab_env,
 
             RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
                                 pu4_buffer)
-
             ps_bitstrm->u4_ofst = u4_offset;
+            u4_bins_available = BYPASS_BINS_AVAILABLE(u4_code_int_range);
         }
 
+        u4_value++;
+        u4_bins_available--;
+
+        DECODE_BYPASS_BIN_MACRO(u4_bin, u4_code_int_range, u4_code_int_val_ofst)
+
+        INC_BIN_COUNT(ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
     }
     while(u4_bin && (u4_value < u1_max_bins));
 
@@ -684,7 +662,7 @@ UWORD32 ih264d_decode_bypass_bins_unary(decoding_envirnoment_t *ps_cab_env,
     ps_cab_env->u4_code_int_range = u4_code_int_range;
     u4_value = (u4_value - 1 + u4_bin);
 
-return (u4_value);
+    return (u4_value);
 }
 
 /*****************************************************************************/
@@ -715,48 +693,19 @@ UWORD32 ih264d_decode_bypass_bins(decoding_envirnoment_t *ps_cab_env,
                                   dec_bit_stream_t *ps_bitstrm)
 {
     UWORD32 u4_bins;
-    UWORD32 u4_bin;
+    UWORD32 u4_num_bins;
     UWORD32 u4_code_int_val_ofst, u4_code_int_range;
 
     u4_bins = 0;
     u4_code_int_val_ofst = ps_cab_env->u4_code_int_val_ofst;
     u4_code_int_range = ps_cab_env->u4_code_int_range;
 
-    if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
-    {
-        UWORD32 *pu4_buffer, u4_offset;
-
-        pu4_buffer = ps_bitstrm->pu4_buffer;
-        u4_offset = ps_bitstrm->u4_ofst;
-
-        RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
-                            pu4_buffer)
-        ps_bitstrm->u4_ofst = u4_offset;
-    }
-
-    do
+    /* Bins are decoded in batches, with one renormalization per batch */
+    while(u1_max_bins)
     {
+        u4_num_bins = BYPASS_BINS_AVAILABLE(u4_code_int_range);
 
-        u4_code_int_range = u4_code_int_range >> 1;
-
-        if(u4_code_int_val_ofst >= u4_code_int_range)
-        {
-            /* S=1 */
-            u4_bin = 1;
-            u4_code_int_val_ofst -= u4_code_int_range;
-        }
-        else
-        {
-            /* S=0 */
-            u4_bin = 0;
-        }
-
-        INC_BIN_COUNT(ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
-
-        u4_bins = ((u4_bins << 1) | u4_bin);
-        u1_max_bins--;
-
-        if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
+        if((u4_num_bins < u1_max_bins) && (u4_num_bins < 23))
         {
             UWORD32 *pu4_buffer, u4_offset;
 
@@ -766,10 +715,15 @@ UWORD32 ih264d_decode_bypass_bins(decoding_envirnoment_t *ps_cab_env,
             RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
                                 pu4_buffer)
             ps_bitstrm->u4_ofst = u4_offset;
+            u4_num_bins = BYPASS_BINS_AVAILABLE(u4_code_int_range);
         }
+        u4_num_bins = MIN(u4_num_bins, u1_max_bins);
+
+        DECODE_BYPASS_BINS_MACRO(u4_bins, u4_num_bins, u4_code_int_range,
+                                 u4_code_int_val_ofst)
 
+        u1_max_bins -= u4_num_bins;
     }
-    while(u1_max_bins);
 
     ps_cab_env->u4_code_int_val_ofst = u4_code_int_val_ofst;
     ps_cab_env->u4_code_int_range = u4_code_int_range;
@@ -180,16 +180,52 @@ UWORD32 ih264d_decode_bypass_bins(decoding_envirnoment_t *ps_cab_env,
 /* Defining a macro for checking if the symbol is MPS*/
 /*****************************************************************************/
 
+/* The LPS case is selected with masks rather than a branch, as the branch is
+ mispredicted for every LPS and LPS bins are frequent in residual data*/
+
 #define CHECK_IF_LPS(u4_codeIntRange_m,u4_codeIntValOffset_m,u4_symbol_m,                   \
                     u4_codeIntRangeLPS_m,u1_mps_state_m,table_lookup_m)                     \
 {                                                                                         \
-  if(u4_codeIntValOffset_m >= u4_codeIntRange_m)                                            \
-  {                                                                                         \
-      u4_symbol_m = 1 - u4_symbol_m;                                                        \
-      u4_codeIntValOffset_m -= u4_codeIntRange_m;                                           \
-      u4_codeIntRange_m = u4_codeIntRangeLPS_m;                                             \
-      u1_mps_state_m = (table_lookup_m >> 15) & 0x7F;                                       \
-  }                                                                                         \
+  UWORD32 u4_lps_m = (u4_codeIntValOffset_m >= u4_codeIntRange_m);                          \
+  UWORD32 u4_lps_mask_m = 0 - u4_lps_m;                                                     \
+                                                                                          \
+  u4_symbol_m ^= u4_lps_m;                                                                  \
+  u4_codeIntValOffset_m -= u4_codeIntRange_m & u4_lps_mask_m;                               \
+  u4_codeIntRange_m ^= (u4_codeIntRange_m ^ u4_codeIntRangeLPS_m) & u4_lps_mask_m;          \
+  u1_mps_state_m = (table_lookup_m >> (8 + 7 * u4_lps_m)) & 0x7F;                           \
+}
+
+/*****************************************************************************/
+/* Defining macros for decoding bypass bins*/
+/*****************************************************************************/
+
+/* A bypass bin halves the range without renormalizing. With the range read
+ ahead as described in ih264d_init_cabac_dec_envirnoment(), 23 - CLZ(range)
+ bypass bins can be decoded before the range has to be renormalized. The bins
+ are decoded with masks rather than a branch, as bypass bins are equiprobable*/
+
+#define BYPASS_BINS_AVAILABLE(u4_code_int_range_m)                                          \
+                    (23 - CLZ(u4_code_int_range_m))
+
+#define DECODE_BYPASS_BIN_MACRO(u4_bin_m,u4_code_int_range_m,u4_code_int_val_ofst_m)       \
+{                                                                                         \
+  u4_code_int_range_m = u4_code_int_range_m >> 1;                                         \
+  u4_bin_m = (u4_code_int_val_ofst_m >= u4_code_int_range_m);                             \
+  u4_code_int_val_ofst_m -= u4_code_int_range_m & (0 - u4_bin_m);                         \
+}
+
+/* Decodes u4_num_bins_m bins MSB first, which must not exceed
+ BYPASS_BINS_AVAILABLE()*/
+#define DECODE_BYPASS_BINS_MACRO(u4_bins_m,u4_num_bins_m,u4_code_int_range_m,              \
+                                 u4_code_int_val_ofst_m)                                  \
+{                                                                                         \
+  UWORD32 u4_bin_m, u4_i_m;                                                               \
+                                                                                          \
+  for(u4_i_m = 0; u4_i_m < (u4_num_bins_m); u4_i_m++)                                     \
+  {                                                                                       \
+      DECODE_BYPASS_BIN_MACRO(u4_bin_m, u4_code_int_range_m, u4_code_int_val_ofst_m)      \
+      u4_bins_m = (u4_bins_m << 1) | u4_bin_m;                                            \
+  }                                                                                       \
 }
 
 /*!
@@ -235,16 +271,8 @@ UWORD32 ih264d_decode_bypass_bins(decoding_envirnoment_t *ps_cab_env,
     u4_codeIntRangeLPS_m = u4_codeIntRangeLPS_m << (23 - u4_clz_m);                           \
     u4_code_int_range = u4_code_int_range - u4_codeIntRangeLPS_m;                             \
     u4_symbol = ((u1_mps_state_m>> 6) & 0x1);                                             \
-    /*if mps*/                                                                          \
-    u1_mps_state_m = (table_lookup_m >> 8) & 0x7F;                                          \
-    if(u4_code_int_val_ofst >= u4_code_int_range)                                          \
-  {                                                                                     \
-                                                                                        \
-    u4_symbol = 1 - u4_symbol;                                                          \
-    u4_code_int_val_ofst -= u4_code_int_range;                                             \
-    u4_code_int_range = u4_codeIntRangeLPS_m;                                               \
-    u1_mps_state_m = (table_lookup_m >> 15) & 0x7F;                                         \
-  }                                                                                     \
+    CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,                      \
+                 u4_codeIntRangeLPS_m, u1_mps_state_m, table_lookup_m)                    \
     if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_8)                                        \
     {                                                                                   \
         UWORD32 *pu4_buffer,u4_offset;                                                  \
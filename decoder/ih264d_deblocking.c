@@ -39,6 +39,7 @@
 #include "ih264d_format_conv.h"
 #include "ih264d_deblocking.h"
 #include "ih264d_tables.h"
+#include "ih264d_thread_compute_bs.h"
 
 /*!
  *************************************************************************
@@ -390,12 +391,28 @@ void ih264d_filter_boundary_top_nonmbaff(dec_struct_t *ps_dec,
 
 }
 
-void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
-                                tfr_ctxt_t * ps_tfr_cxt,
-                                WORD8 i1_cb_qp_idx_ofst,
-                                WORD8 i1_cr_qp_idx_ofst,
-                                WORD32 i4_strd_y,
-                                WORD32 i4_strd_uv )
+/**************************************************************************
+ *
+ *  Function Name : ih264d_filter_mb_nonmbaff
+ *
+ *  Description   : Deblocks the MB at (u4_mb_x, u4_mb_y), whose pixels are
+ *                  at ps_tfr_cxt, without updating the deblocking position
+ *                  in ps_dec
+ *
+ *  Revision History:
+ *
+ *         DD MM YYYY   Author(s)       Changes (Describe the changes made)
+ *
+ **************************************************************************/
+void ih264d_filter_mb_nonmbaff(dec_struct_t *ps_dec,
+                               tfr_ctxt_t * ps_tfr_cxt,
+                               deblk_mb_t *ps_cur_mb,
+                               UWORD32 u4_mb_x,
+                               UWORD32 u4_mb_y,
+                               WORD8 i1_cb_qp_idx_ofst,
+                               WORD8 i1_cr_qp_idx_ofst,
+                               WORD32 i4_strd_y,
+                               WORD32 i4_strd_uv)
 {
     UWORD8 *pu1_y, *pu1_u;
     UWORD32 u4_bs;
@@ -408,22 +425,18 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
 
     UWORD32 * pu4_bs_tab;
     WORD32 idx_a_y, idx_a_u, idx_a_v;
-    UWORD32 u4_deb_mode, u4_mbs_next;
+    UWORD32 u4_deb_mode;
     UWORD32 u4_image_wd_mb;
-    deblk_mb_t *ps_top_mb,*ps_left_mb,*ps_cur_mb;
-
-    PROFILE_DISABLE_DEBLK()
-    /* Return from here to switch off deblocking */
+    deblk_mb_t *ps_top_mb,*ps_left_mb;
 
     u4_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
 
-    ps_cur_mb = ps_dec->ps_cur_deblk_mb;
     pu4_bs_tab = ps_cur_mb->u4_bs_table;
     u4_deb_mode = ps_cur_mb->u1_deblocking_mode;
      if(!(u4_deb_mode & MB_DISABLE_FILTERING))
      {
 
-         if(ps_dec->u4_deblk_mb_x)
+         if(u4_mb_x)
          {
              ps_left_mb = ps_cur_mb - 1;
 
@@ -433,7 +446,7 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
              ps_left_mb = NULL;
 
          }
-         if(ps_dec->u4_deblk_mb_y != 0)
+         if(u4_mb_y != 0)
          {
              ps_top_mb = ps_cur_mb - (u4_image_wd_mb);
          }
@@ -499,41 +512,27 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
         pu1_cliptab_u = (UWORD8 *)&gau1_ih264d_clip_table[12 + idx_a_u]; //this for chroma
         pu1_cliptab_v = (UWORD8 *)&gau1_ih264d_clip_table[12 + idx_a_v]; //this for chroma
 
-        //edge=1
-
-
-        u4_bs = pu4_bs_tab[5];
         pu1_y = ps_tfr_cxt->pu1_mb_y;
         pu1_u = ps_tfr_cxt->pu1_mb_u;
 
-        if(u4_bs)
+        //edge=1,2,3
+        if(pu4_bs_tab[5] | pu4_bs_tab[6] | pu4_bs_tab[7])
         {
-
-            ps_dec->pf_deblk_luma_vert_bslt4(pu1_y + 4, i4_strd_y, alpha, beta,
-                                             u4_bs, pu1_cliptab_y);
-
+            ps_dec->pf_deblk_luma_vert_inner_bslt4(pu1_y, i4_strd_y, alpha,
+                                                   beta, &pu4_bs_tab[5],
+                                                   pu1_cliptab_y,
+                                                   ps_dec->pf_deblk_luma_vert_bslt4);
         }
-        //edge=2
 
+        //edge=2 chroma
         u4_bs = pu4_bs_tab[6];
         if(u4_bs)
         {
-            ps_dec->pf_deblk_luma_vert_bslt4(pu1_y + 8, i4_strd_y, alpha, beta,
-                                             u4_bs, pu1_cliptab_y);
             ps_dec->pf_deblk_chroma_vert_bslt4(pu1_u + 4 * YUV420SP_FACTOR,
                                                i4_strd_uv, alpha_u, beta_u,
                                                alpha_v, beta_v, u4_bs,
                                                pu1_cliptab_u, pu1_cliptab_v);
 
-        }
-        //edge=3
-
-        u4_bs = pu4_bs_tab[7];
-        if(u4_bs)
-        {
-            ps_dec->pf_deblk_luma_vert_bslt4(pu1_y + 12, i4_strd_y, alpha, beta,
-                                             u4_bs, pu1_cliptab_y);
-
         }
 
         /*--------------------------------------------------------------------*/
@@ -560,39 +559,48 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
         /* Filter wrt Other Horizontal Edges                                  */
         /*--------------------------------------------------------------------*/
 
-        //edge1
-        u4_bs = pu4_bs_tab[1];
-
-        if(u4_bs)
+        //edge1,2,3
+        if(pu4_bs_tab[1] | pu4_bs_tab[2] | pu4_bs_tab[3])
         {
-            ps_dec->pf_deblk_luma_horz_bslt4(pu1_y + (i4_strd_y << 2), i4_strd_y,
-                                             alpha, beta, u4_bs, pu1_cliptab_y);
-
+            ps_dec->pf_deblk_luma_horz_inner_bslt4(pu1_y, i4_strd_y, alpha,
+                                                   beta, &pu4_bs_tab[1],
+                                                   pu1_cliptab_y,
+                                                   ps_dec->pf_deblk_luma_horz_bslt4);
         }
-        //edge2
+
+        //edge2 chroma
         u4_bs = pu4_bs_tab[2];
 
         if(u4_bs)
         {
-
-            ps_dec->pf_deblk_luma_horz_bslt4(pu1_y + (i4_strd_y << 3), i4_strd_y,
-                                             alpha, beta, u4_bs, pu1_cliptab_y);
             ps_dec->pf_deblk_chroma_horz_bslt4(pu1_u + (i4_strd_uv << 2),
                                                i4_strd_uv, alpha_u, beta_u,
                                                alpha_v, beta_v, u4_bs,
                                                pu1_cliptab_u, pu1_cliptab_v);
 
         }
-        //edge3
-        u4_bs = pu4_bs_tab[3];
-        if(u4_bs)
-        {
-            ps_dec->pf_deblk_luma_horz_bslt4(
-                            (pu1_y + (i4_strd_y << 3) + (i4_strd_y << 2)),
-                            i4_strd_y, alpha, beta, u4_bs, pu1_cliptab_y);
-
-        }
      }
+}
+
+void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
+                                tfr_ctxt_t * ps_tfr_cxt,
+                                WORD8 i1_cb_qp_idx_ofst,
+                                WORD8 i1_cr_qp_idx_ofst,
+                                WORD32 i4_strd_y,
+                                WORD32 i4_strd_uv )
+{
+    UWORD32 u4_mbs_next;
+    UWORD32 u4_image_wd_mb;
+
+    PROFILE_DISABLE_DEBLK()
+    /* Return from here to switch off deblocking */
+
+    u4_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
+
+    ih264d_filter_mb_nonmbaff(ps_dec, ps_tfr_cxt, ps_dec->ps_cur_deblk_mb,
+                              ps_dec->u4_deblk_mb_x, ps_dec->u4_deblk_mb_y,
+                              i1_cb_qp_idx_ofst, i1_cr_qp_idx_ofst,
+                              i4_strd_y, i4_strd_uv);
 
      ps_dec->u4_deblk_mb_x++;
      ps_dec->ps_cur_deblk_mb++;
@@ -610,10 +618,64 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
          ps_tfr_cxt->pu1_mb_v += ps_tfr_cxt->u4_uv_inc;
          ps_dec->u4_deblk_mb_y++;
          ps_dec->u4_deblk_mb_x = 0;
+
+         /* Top edge filtering of this row was the last write to the row above */
+         if(!ps_dec->ps_cur_slice->u1_field_pic_flag)
+             ih264d_publish_rows_done(ps_dec, ps_dec->u4_deblk_mb_y - 1);
      }
 
 }
 
+/**************************************************************************
+ *
+ *  Function Name : ih264d_publish_rows_done
+ *
+ *  Description   : Publishes the number of MB rows of the current picture
+ *                  that are final. Called by the thread deblocking the
+ *                  picture. The rows are reported to the application
+ *                  only when the picture buffer is its output, i.e. shared
+ *                  display buffers that need no chroma conversion.
+ *                  Otherwise ih264d_fused_fmt_conv_rows() reports them once
+ *                  they are format converted
+ *
+ *  Revision History:
+ *
+ *         DD MM YYYY   Author(s)       Changes (Describe the changes made)
+ *
+ **************************************************************************/
+void ih264d_publish_rows_done(dec_struct_t *ps_dec, WORD32 i4_rows_done)
+{
+    if((1 == ps_dec->u4_share_disp_buf)
+                    && ((IV_YUV_420SP_UV == ps_dec->u1_chroma_format)
+                                    || ps_dec->u4_luma_only))
+    {
+        ih264d_report_rows_done(ps_dec, i4_rows_done);
+    }
+}
+
+/**************************************************************************
+ *
+ *  Function Name : ih264d_report_rows_done
+ *
+ *  Description   : Reports the number of MB rows of the current picture
+ *                  that are final in the application's output to the row
+ *                  callback, if one is set
+ *
+ *  Revision History:
+ *
+ *         DD MM YYYY   Author(s)       Changes (Describe the changes made)
+ *
+ **************************************************************************/
+void ih264d_report_rows_done(dec_struct_t *ps_dec, WORD32 i4_rows_done)
+{
+    if((NULL != ps_dec->pf_row_done) && (i4_rows_done > 0))
+    {
+        ps_dec->pf_row_done(ps_dec->pv_row_done_ctxt,
+                            ps_dec->ps_cur_pic->u4_ts,
+                            (UWORD32)i4_rows_done);
+    }
+}
+
 /**************************************************************************
  *
  *  Function Name : ih264d_init_deblk_tfr_ctxt
@@ -674,6 +736,161 @@ void ih264d_init_deblk_tfr_ctxt(dec_struct_t * ps_dec,
     }
 }
 
+/**************************************************************************
+ *
+ *  Function Name : ih264d_filter_mb_pair_mbaff
+ *
+ *  Description   : Deblocks the MB pair at column u4_mb_x of an MBAFF
+ *                  picture, whose pixels are at ps_tfr_cxt. ps_cur_mb is the
+ *                  top MB of the pair. u1_first_row is set for the pairs of
+ *                  the top row
+ *
+ *  Revision History:
+ *
+ *         DD MM YYYY   Author(s)       Changes (Describe the changes made)
+ *
+ **************************************************************************/
+void ih264d_filter_mb_pair_mbaff(dec_struct_t *ps_dec,
+                                 tfr_ctxt_t *ps_tfr_cxt,
+                                 deblk_mb_t *ps_cur_mb,
+                                 UWORD32 u4_mb_x,
+                                 UWORD8 u1_first_row,
+                                 WORD8 i1_cb_qp_idx_ofst,
+                                 WORD8 i1_cr_qp_idx_ofst,
+                                 WORD32 i4_wd_y,
+                                 WORD32 i4_wd_uv)
+{
+    deblk_mb_t *ps_top_mb;
+    deblk_mb_t *ps_left_mb;
+    UWORD8 u1_cur_fld, u1_top_fld, u1_left_fld;
+    UWORD8 u1_deb_mode, u1_extra_top_edge;
+    UWORD16 u2_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
+    UWORD8 *pu1_deb_y = ps_tfr_cxt->pu1_mb_y;
+    UWORD8 *pu1_deb_u = ps_tfr_cxt->pu1_mb_u;
+    UWORD8 *pu1_deb_v = ps_tfr_cxt->pu1_mb_v;
+
+    u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
+    if(!(u1_deb_mode & MB_DISABLE_FILTERING))
+    {
+        ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
+        ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
+        ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
+
+        u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
+        u1_cur_fld &= 1;
+        if(u4_mb_x)
+        {
+            ps_left_mb = ps_cur_mb - 2;
+        }
+        else
+        {
+            ps_left_mb = NULL;
+        }
+        if(!u1_first_row)
+        {
+            ps_top_mb = ps_cur_mb - (u2_image_wd_mb << 1) + 1;
+            u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB)
+                            >> 7;
+        }
+        else
+        {
+            ps_top_mb = NULL;
+            u1_top_fld = 0;
+        }
+
+        if((!u1_first_row) & u1_top_fld & u1_cur_fld)
+            ps_top_mb--;
+
+        /********************************************************/
+        /* if top MB and MB AFF and cur MB is frame and top is  */
+        /* field, then one extra top edge needs to be deblocked */
+        /********************************************************/
+        u1_extra_top_edge = (!u1_cur_fld) & u1_top_fld;
+
+        if(u1_deb_mode & MB_DISABLE_LEFT_EDGE)
+            ps_left_mb = NULL;
+        if(u1_deb_mode & MB_DISABLE_TOP_EDGE)
+            ps_top_mb = NULL;
+
+        ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt,
+                                i1_cb_qp_idx_ofst,
+                                i1_cr_qp_idx_ofst, ps_cur_mb,
+                                i4_wd_y, i4_wd_uv, ps_top_mb,
+                                ps_left_mb, u1_cur_fld,
+                                u1_extra_top_edge);
+    }
+
+    ps_cur_mb++;
+
+    u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
+    if(!(u1_deb_mode & MB_DISABLE_FILTERING))
+    {
+        ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
+        ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
+        ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
+
+        u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
+        u1_cur_fld &= 1;
+        if(u4_mb_x)
+        {
+            ps_left_mb = ps_cur_mb - 2;
+            u1_left_fld = (ps_left_mb->u1_mb_type & D_FLD_MB)
+                            >> 7;
+        }
+        else
+        {
+            ps_left_mb = NULL;
+            u1_left_fld = u1_cur_fld;
+        }
+        if(!u1_first_row)
+        {
+            ps_top_mb = ps_cur_mb - (u2_image_wd_mb << 1);
+        }
+        else
+        {
+            ps_top_mb = NULL;
+        }
+
+        {
+            UWORD8 u1_row_shift_y = 0, u1_row_shift_uv = 0;
+            if(!u1_cur_fld)
+            {
+                ps_top_mb = ps_cur_mb - 1;
+                u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB)
+                                >> 7;
+                u1_row_shift_y = 4;
+                u1_row_shift_uv = 3;
+            }
+            ps_tfr_cxt->pu1_mb_y += i4_wd_y << u1_row_shift_y;
+            ps_tfr_cxt->pu1_mb_u +=
+                            (i4_wd_uv << u1_row_shift_uv);
+            ps_tfr_cxt->pu1_mb_v += i4_wd_uv << u1_row_shift_uv;
+        }
+
+        /* point to A if top else A+1 */
+        if(u1_left_fld ^ u1_cur_fld)
+            ps_left_mb--;
+
+        /********************************************************/
+        /* if top MB and MB AFF and cur MB is frame and top is  */
+        /* field, then one extra top edge needs to be deblocked */
+        /********************************************************/
+        u1_extra_top_edge = 0;
+
+        if(u1_deb_mode & MB_DISABLE_LEFT_EDGE)
+            ps_left_mb = NULL;
+        if(u1_deb_mode & MB_DISABLE_TOP_EDGE)
+            ps_top_mb = NULL;
+
+        ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt,
+                                i1_cb_qp_idx_ofst,
+                                i1_cr_qp_idx_ofst, ps_cur_mb,
+                                i4_wd_y, i4_wd_uv, ps_top_mb,
+                                ps_left_mb, u1_cur_fld,
+                                u1_extra_top_edge);
+    }
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : ih264d_deblock_picture_mbaff                                     */
@@ -698,15 +915,11 @@ void ih264d_deblock_picture_mbaff(dec_struct_t * ps_dec)
 {
     WORD16 i2_mb_x, i2_mb_y;
     deblk_mb_t *ps_cur_mb;
-    deblk_mb_t *ps_top_mb;
-    deblk_mb_t *ps_left_mb;
 
     UWORD8 u1_vert_pad_top = 1;
-    UWORD8 u1_cur_fld, u1_top_fld, u1_left_fld;
     UWORD8 u1_first_row;
 
     UWORD8 * pu1_deb_y, *pu1_deb_u, *pu1_deb_v;
-    UWORD8 u1_deb_mode, u1_extra_top_edge;
     WORD32 i4_wd_y, i4_wd_uv;
 
     UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag; /*< Field u4_flag                       */
@@ -734,7 +947,6 @@ void ih264d_deblock_picture_mbaff(dec_struct_t * ps_dec)
     /* Pic level Initialisations */
     i2_mb_y = u2_image_ht_mb;
     i2_mb_x = 0;
-    u1_extra_top_edge = 0;
 
     u1_first_row = 1;
 
@@ -749,135 +961,24 @@ void ih264d_deblock_picture_mbaff(dec_struct_t * ps_dec)
 
     if(ps_dec->u4_app_disable_deblk_frm == 0)
     {
+        if(!ih264d_deblock_rows_parallel(ps_dec, ps_tfr_cxt, i1_cb_qp_idx_ofst,
+                                         i1_cr_qp_idx_ofst, i4_wd_y, i4_wd_uv,
+                                         1))
         {
 
             while(i2_mb_y > 0)
             {
                 do
                 {
-
-                    u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
-                    if(!(u1_deb_mode & MB_DISABLE_FILTERING))
-                    {
-                        ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
-                        ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
-                        ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
-
-                        u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
-                        u1_cur_fld &= 1;
-                        if(i2_mb_x)
-                        {
-                            ps_left_mb = ps_cur_mb - 2;
-                        }
-                        else
-                        {
-                            ps_left_mb = NULL;
-                        }
-                        if(!u1_first_row)
-                        {
-                            ps_top_mb = ps_cur_mb - (u2_image_wd_mb << 1) + 1;
-                            u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB)
-                                            >> 7;
-                        }
-                        else
-                        {
-                            ps_top_mb = NULL;
-                            u1_top_fld = 0;
-                        }
-
-                        if((!u1_first_row) & u1_top_fld & u1_cur_fld)
-                            ps_top_mb--;
-
-                        /********************************************************/
-                        /* if top MB and MB AFF and cur MB is frame and top is  */
-                        /* field, then one extra top edge needs to be deblocked */
-                        /********************************************************/
-                        u1_extra_top_edge = (!u1_cur_fld) & u1_top_fld;
-
-                        if(u1_deb_mode & MB_DISABLE_LEFT_EDGE)
-                            ps_left_mb = NULL;
-                        if(u1_deb_mode & MB_DISABLE_TOP_EDGE)
-                            ps_top_mb = NULL;
-
-                        ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt,
+                    ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
+                    ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
+                    ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
+                    ih264d_filter_mb_pair_mbaff(ps_dec, ps_tfr_cxt, ps_cur_mb,
+                                                i2_mb_x, u1_first_row,
                                                 i1_cb_qp_idx_ofst,
-                                                i1_cr_qp_idx_ofst, ps_cur_mb,
-                                                i4_wd_y, i4_wd_uv, ps_top_mb,
-                                                ps_left_mb, u1_cur_fld,
-                                                u1_extra_top_edge);
-                    }
-
-                    ps_cur_mb++;
-
-                    u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
-                    if(!(u1_deb_mode & MB_DISABLE_FILTERING))
-                    {
-                        ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
-                        ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
-                        ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
-
-                        u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
-                        u1_cur_fld &= 1;
-                        if(i2_mb_x)
-                        {
-                            ps_left_mb = ps_cur_mb - 2;
-                            u1_left_fld = (ps_left_mb->u1_mb_type & D_FLD_MB)
-                                            >> 7;
-                        }
-                        else
-                        {
-                            ps_left_mb = NULL;
-                            u1_left_fld = u1_cur_fld;
-                        }
-                        if(!u1_first_row)
-                        {
-                            ps_top_mb = ps_cur_mb - (u2_image_wd_mb << 1);
-                        }
-                        else
-                        {
-                            ps_top_mb = NULL;
-                        }
-
-                        {
-                            UWORD8 u1_row_shift_y = 0, u1_row_shift_uv = 0;
-                            if(!u1_cur_fld)
-                            {
-                                ps_top_mb = ps_cur_mb - 1;
-                                u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB)
-                                                >> 7;
-                                u1_row_shift_y = 4;
-                                u1_row_shift_uv = 3;
-                            }
-                            ps_tfr_cxt->pu1_mb_y += i4_wd_y << u1_row_shift_y;
-                            ps_tfr_cxt->pu1_mb_u +=
-                                            (i4_wd_uv << u1_row_shift_uv);
-                            ps_tfr_cxt->pu1_mb_v += i4_wd_uv << u1_row_shift_uv;
-                        }
-
-                        /* point to A if top else A+1 */
-                        if(u1_left_fld ^ u1_cur_fld)
-                            ps_left_mb--;
-
-                        /********************************************************/
-                        /* if top MB and MB AFF and cur MB is frame and top is  */
-                        /* field, then one extra top edge needs to be deblocked */
-                        /********************************************************/
-                        u1_extra_top_edge = 0;
-
-                        if(u1_deb_mode & MB_DISABLE_LEFT_EDGE)
-                            ps_left_mb = NULL;
-                        if(u1_deb_mode & MB_DISABLE_TOP_EDGE)
-                            ps_top_mb = NULL;
-
-                        ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt,
-                                                i1_cb_qp_idx_ofst,
-                                                i1_cr_qp_idx_ofst, ps_cur_mb,
-                                                i4_wd_y, i4_wd_uv, ps_top_mb,
-                                                ps_left_mb, u1_cur_fld,
-                                                u1_extra_top_edge);
-                    }
-
-                    ps_cur_mb++;
+                                                i1_cr_qp_idx_ofst,
+                                                i4_wd_y, i4_wd_uv);
+                    ps_cur_mb += 2;
                     i2_mb_x++;
 
                     pu1_deb_y += 16;
@@ -1024,7 +1125,11 @@ void ih264d_deblock_picture_non_mbaff(dec_struct_t * ps_dec)
 
     if(ps_dec->u4_app_disable_deblk_frm == 0)
     {
-        if(ps_dec->ps_cur_sps->u1_mb_aff_flag == 1)
+        if((ps_dec->ps_cur_sps->u1_mb_aff_flag == 1)
+                        && !ih264d_deblock_rows_parallel(ps_dec, ps_tfr_cxt,
+                                                         i1_cb_qp_idx_ofst,
+                                                         i1_cr_qp_idx_ofst,
+                                                         i4_wd_y, i4_wd_uv, 0))
         {
             while( ps_dec->u4_deblk_mb_y < u2_image_ht_mb)
             {
@@ -1138,7 +1243,11 @@ void ih264d_deblock_picture_progressive(dec_struct_t * ps_dec)
 
     if(ps_dec->u4_app_disable_deblk_frm == 0)
     {
-        if(ps_dec->ps_cur_sps->u1_mb_aff_flag == 1)
+        if((ps_dec->ps_cur_sps->u1_mb_aff_flag == 1)
+                        && !ih264d_deblock_rows_parallel(ps_dec, ps_tfr_cxt,
+                                                         i1_cb_qp_idx_ofst,
+                                                         i1_cr_qp_idx_ofst,
+                                                         i4_wd_y, i4_wd_uv, 0))
         {
             while( ps_dec->u4_deblk_mb_y < u2_image_ht_mb)
             {
@@ -142,6 +142,24 @@ void ih264d_fill_bs1_non16x16mb_bslice(mv_pred_t *ps_cur_mv_pred,
                                        void **u4_pic_addrress,
                                        WORD32 i4_ver_mvlimit);
 
+void ih264d_fill_bs1_non16x16mb_pslice_sse42(mv_pred_t *ps_cur_mv_pred,
+                                             mv_pred_t *ps_top_mv_pred,
+                                             void **ppv_map_ref_idx_to_poc,
+                                             UWORD32 *pu4_bs_table,
+                                             mv_pred_t *ps_leftmost_mv_pred,
+                                             neighbouradd_t *ps_left_addr,
+                                             void **u4_pic_addrress,
+                                             WORD32 i4_ver_mvlimit);
+
+void ih264d_fill_bs1_non16x16mb_bslice_sse42(mv_pred_t *ps_cur_mv_pred,
+                                             mv_pred_t *ps_top_mv_pred,
+                                             void **ppv_map_ref_idx_to_poc,
+                                             UWORD32 *pu4_bs_table,
+                                             mv_pred_t *ps_leftmost_mv_pred,
+                                             neighbouradd_t *ps_left_addr,
+                                             void **u4_pic_addrress,
+                                             WORD32 i4_ver_mvlimit);
+
 void ih264d_fill_bs_xtra_left_edge_cur_fld(UWORD32 *pu4_bs,
                                            WORD32 u4_left_mb_t_csbp,
                                            WORD32 u4_left_mb_b_csbp,
@@ -154,6 +172,26 @@ void ih264d_fill_bs_xtra_left_edge_cur_frm(UWORD32 *pu4_bs,
                                            WORD32 u4_cur_mb_csbp,
                                            UWORD32 u4_cur_mb_top);
 
+void ih264d_filter_mb_nonmbaff(dec_struct_t *ps_dec,
+                               tfr_ctxt_t * ps_tfr_cxt,
+                               deblk_mb_t *ps_cur_mb,
+                               UWORD32 u4_mb_x,
+                               UWORD32 u4_mb_y,
+                               WORD8 i1_cb_qp_idx_ofst,
+                               WORD8 i1_cr_qp_idx_ofst,
+                               WORD32 i4_strd_y,
+                               WORD32 i4_strd_uv);
+
+void ih264d_filter_mb_pair_mbaff(dec_struct_t *ps_dec,
+                                 tfr_ctxt_t *ps_tfr_cxt,
+                                 deblk_mb_t *ps_cur_mb,
+                                 UWORD32 u4_mb_x,
+                                 UWORD8 u1_first_row,
+                                 WORD8 i1_cb_qp_idx_ofst,
+                                 WORD8 i1_cr_qp_idx_ofst,
+                                 WORD32 i4_wd_y,
+                                 WORD32 i4_wd_uv);
+
 void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
                                 tfr_ctxt_t * const ps_tfr_cxt,
                                 const WORD8 i1_cb_qp_idx_ofst,
@@ -161,6 +199,10 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
                                 WORD32 i4_strd_y,
                                 WORD32 i4_strd_uv);
 
+void ih264d_publish_rows_done(dec_struct_t *ps_dec, WORD32 i4_rows_done);
+
+void ih264d_report_rows_done(dec_struct_t *ps_dec, WORD32 i4_rows_done);
+
 void ih264d_init_deblk_tfr_ctxt(dec_struct_t * ps_dec,
                                 pad_mgr_t *ps_pad_mgr,
                                 tfr_ctxt_t *ps_tfr_cxt,
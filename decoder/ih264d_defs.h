@@ -45,6 +45,36 @@
 
 #define FMT_CONV_NUM_ROWS       16
 
+/** Minimum number of rows of a stripe, when format conversion of a frame is
+  * split over several threads
+  */
+#define FMT_CONV_MIN_STRIPE_ROWS    128
+
+/** Largest log2 of the factor the output can be downscaled by */
+#define MAX_OUT_SCALE_LOG2          3
+
+/** Output width or height for a downscale factor of (1 << log2). Downscaled
+  * dimensions are kept even for the 420 chroma
+  */
+#define OUT_SCALED_DIM(x, log2)     ((log2) ? (((x) >> (log2)) & ~1) : (x))
+
+/** Levels of the deadline driven degrade, each including the lower ones */
+#define DEGRADE_LEVEL_NO_DEBLK_NONREF   1
+#define DEGRADE_LEVEL_FAST_MC_NONREF    2
+#define DEGRADE_LEVEL_DROP_B_NONREF     3
+#define DEGRADE_LEVEL_NO_DEBLK_REF      4
+#define DEGRADE_LEVEL_MAX               DEGRADE_LEVEL_NO_DEBLK_REF
+
+/** Number of consecutive frames over the time budget raising the degrade
+  * level, and within DEGRADE_RELAX_PCT percent of it lowering the level
+  */
+#define DEGRADE_RAISE_FRAMES        2
+#define DEGRADE_RELAX_FRAMES        16
+#define DEGRADE_RELAX_PCT           75
+
+/** Mask of the fractional bits of luma motion vectors in quarter pel */
+#define MV_FRAC_MASK_QPEL           0x3
+
 /** Decoder currently has an additional latency of 2 pictures when
   * returning output for display
   */
@@ -537,6 +567,15 @@ enum
 #define MAX_CABAC_INIT_IDC        2
 
 #define H264_DEFAULT_NUM_CORES 1
+
+/** Maximum number of cores that can be requested through set_num_cores.    */
+/** Parse, decode and bs/deblock pipeline uses at most H264_PIPELINE_CORES   */
+/** threads, remaining cores are auxiliary cores used within the picture   */
+#define H264_MAX_NUM_CORES     16
+#define H264_PIPELINE_CORES    3
+
+/** Number of processing threads: decode, recon-bs-deblk and deblk */
+#define H264_MAX_PROC_THREADS  3
 #define DEFAULT_SEPARATE_PARSE (H264_DEFAULT_NUM_CORES == 2)? 1 :0
 
 /** Maximum number of Slice groups */
@@ -47,6 +47,10 @@
 #include "ih264d_structs.h"
 #include "ih264d_format_conv.h"
 #include "ih264d_defs.h"
+#include "ih264d_utils.h"
+#include "ih264d_deblocking.h"
+#include "ih264d_thread_parse_decode.h"
+#include "ithread.h"
 
 
 
@@ -647,10 +651,228 @@ void ih264d_fmt_conv_420sp_to_420p(UWORD8 *pu1_y_src,
     return;
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Function used for downscaling a plane of a 420SP buffer
+ *
+ * @par   Description
+ * Each output sample is the rounded average of a box of
+ * (1 << scale_log2) x (1 << scale_log2) input samples
+ *
+ * @param[in] pu1_src
+ *   Input pointer
+ *
+ * @param[in] pu1_dst
+ *   Output pointer
+ *
+ * @param[in] wd
+ *   Output width in bytes
+ *
+ * @param[in] ht
+ *   Output height
+ *
+ * @param[in] src_strd
+ *   Input stride
+ *
+ * @param[in] dst_strd
+ *   Output stride
+ *
+ * @param[in] scale_log2
+ *   Log2 of the downscale factor, 1 to MAX_OUT_SCALE_LOG2
+ *
+ * @param[in] is_chroma
+ *   Flag to indicate interleaved chroma, in which wd is even and samples of
+ *   the same component are 2 bytes apart
+ *
+ * @returns none
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_downscale(UWORD8 *pu1_src,
+                               UWORD8 *pu1_dst,
+                               WORD32 wd,
+                               WORD32 ht,
+                               WORD32 src_strd,
+                               WORD32 dst_strd,
+                               WORD32 scale_log2,
+                               WORD32 is_chroma)
+{
+    WORD32 scale = 1 << scale_log2;
+    WORD32 rnd = 1 << (2 * scale_log2 - 1);
+    WORD32 step = is_chroma ? 2 : 1;
+    WORD32 i, j, k, l;
+
+    for(i = 0; i < ht; i++)
+    {
+        for(j = 0; j < wd; j++)
+        {
+            UWORD8 *pu1_box;
+            WORD32 sum = 0;
+
+            if(is_chroma)
+                pu1_box = pu1_src + (((j >> 1) << scale_log2) << 1) + (j & 1);
+            else
+                pu1_box = pu1_src + (j << scale_log2);
+
+            for(k = 0; k < scale; k++)
+            {
+                for(l = 0; l < scale; l++)
+                    sum += pu1_box[l * step];
+                pu1_box += src_strd;
+            }
+            pu1_dst[j] = (sum + rnd) >> (2 * scale_log2);
+        }
+        pu1_src += src_strd << scale_log2;
+        pu1_dst += dst_strd;
+    }
+    return;
+}
+
 /*****************************************************************************/
-/*  Function Name : ih264d_format_convert                                    */
+/*  Function Name : ih264d_format_convert_scaled                             */
 /*                                                                           */
-/*  Description   : Implements format conversion/frame copy                  */
+/*  Description   : Downscales the rows of ps_op_frm by                      */
+/*                  (1 << u4_out_scale_log2) into the output format, two     */
+/*                  output rows at a time. 420P and 420SP UV outputs are     */
+/*                  downscaled in place; the others are downscaled to        */
+/*                  pu1_scale_buf and converted from there                   */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  u4_start_y - First row, a multiple of                    */
+/*                  (2 << u4_out_scale_log2)                                 */
+/*  Globals       : None                                                     */
+/*  Processing    : None                                                     */
+/*  Outputs       : None                                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_format_convert_scaled(dec_struct_t *ps_dec,
+                                         iv_yuv_buf_t *ps_op_frm,
+                                         ivd_get_display_frame_op_t *pv_disp_op,
+                                         UWORD8 *pu1_scale_buf,
+                                         UWORD32 u4_start_y,
+                                         UWORD32 u4_num_rows_y)
+{
+    iv_yuv_buf_t *ps_dst_frm = &pv_disp_op->s_disp_frm_buf;
+    IV_COLOR_FORMAT_T e_output_format = pv_disp_op->e_output_format;
+    WORD32 scale_log2 = ps_dec->u4_out_scale_log2;
+    WORD32 wd = ps_dst_frm->u4_y_wd;
+    UWORD32 u4_row, u4_end_row;
+
+    u4_row = u4_start_y >> scale_log2;
+    u4_end_row = (u4_start_y + u4_num_rows_y) >> scale_log2;
+    u4_end_row = MIN(u4_end_row, ps_dst_frm->u4_y_ht) & ~1;
+
+    for(; u4_row < u4_end_row; u4_row += 2)
+    {
+        UWORD8 *pu1_y_src, *pu1_uv_src, *pu1_y_dst, *pu1_uv_dst;
+        WORD32 y_strd;
+
+        pu1_y_src = (UWORD8 *)ps_op_frm->pv_y_buf;
+        pu1_y_src += (u4_row << scale_log2) * ps_op_frm->u4_y_strd;
+
+        pu1_uv_src = (UWORD8 *)ps_op_frm->pv_u_buf;
+        pu1_uv_src += ((u4_row >> 1) << scale_log2) * ps_op_frm->u4_u_strd;
+
+        /* Two luma rows followed by a chroma row */
+        pu1_y_dst = pu1_scale_buf;
+        pu1_uv_dst = pu1_scale_buf + 2 * wd;
+        y_strd = wd;
+
+        if((e_output_format == IV_YUV_420P)
+                        || (e_output_format == IV_YUV_420SP_UV)
+                        || ps_dec->u4_luma_only)
+        {
+            pu1_y_dst = (UWORD8 *)ps_dst_frm->pv_y_buf;
+            pu1_y_dst += u4_row * ps_dst_frm->u4_y_strd;
+            y_strd = ps_dst_frm->u4_y_strd;
+        }
+        if(e_output_format == IV_YUV_420SP_UV)
+        {
+            pu1_uv_dst = (UWORD8 *)ps_dst_frm->pv_u_buf;
+            pu1_uv_dst += (u4_row >> 1) * ps_dst_frm->u4_u_strd;
+        }
+
+        ps_dec->pf_fmt_conv_downscale(pu1_y_src, pu1_y_dst, wd, 2,
+                                      ps_op_frm->u4_y_strd, y_strd,
+                                      scale_log2, 0);
+        if(ps_dec->u4_luma_only)
+            continue;
+
+        ps_dec->pf_fmt_conv_downscale(pu1_uv_src, pu1_uv_dst, wd, 1,
+                                      ps_op_frm->u4_u_strd, wd,
+                                      scale_log2, 1);
+
+        if(e_output_format == IV_YUV_420P)
+        {
+            UWORD8 *pu1_u_dst, *pu1_v_dst;
+
+            pu1_u_dst = (UWORD8 *)ps_dst_frm->pv_u_buf;
+            pu1_u_dst += (u4_row >> 1) * ps_dst_frm->u4_u_strd;
+
+            pu1_v_dst = (UWORD8 *)ps_dst_frm->pv_v_buf;
+            pu1_v_dst += (u4_row >> 1) * ps_dst_frm->u4_v_strd;
+
+            ps_dec->pf_fmt_conv_420sp_to_420p(pu1_y_dst, pu1_uv_dst,
+                                              pu1_y_dst, pu1_u_dst, pu1_v_dst,
+                                              wd, 2, y_strd, wd,
+                                              ps_dst_frm->u4_y_strd,
+                                              ps_dst_frm->u4_u_strd,
+                                              1, 1);
+        }
+        else if(e_output_format == IV_YUV_420SP_VU)
+        {
+            UWORD8 *pu1_y_out, *pu1_uv_out;
+
+            pu1_y_out = (UWORD8 *)ps_dst_frm->pv_y_buf;
+            pu1_y_out += u4_row * ps_dst_frm->u4_y_strd;
+
+            pu1_uv_out = (UWORD8 *)ps_dst_frm->pv_u_buf;
+            pu1_uv_out += (u4_row >> 1) * ps_dst_frm->u4_u_strd;
+
+            ps_dec->pf_fmt_conv_420sp_to_420sp_swap_uv(pu1_y_dst, pu1_uv_dst,
+                                                       pu1_y_out, pu1_uv_out,
+                                                       wd, 2, wd, wd,
+                                                       ps_dst_frm->u4_y_strd,
+                                                       ps_dst_frm->u4_u_strd);
+        }
+        else if(e_output_format == IV_RGB_565)
+        {
+            UWORD16 *pu2_rgb_dst;
+
+            pu2_rgb_dst = (UWORD16 *)ps_dst_frm->pv_y_buf;
+            pu2_rgb_dst += u4_row * ps_dst_frm->u4_y_strd;
+
+            ps_dec->pf_fmt_conv_420sp_to_rgb565(pu1_y_dst, pu1_uv_dst,
+                                                pu2_rgb_dst, wd, 2, wd, wd,
+                                                ps_dst_frm->u4_y_strd, 1);
+        }
+        else if(e_output_format == IV_RGBA_8888)
+        {
+            UWORD32 *pu4_rgba_dst;
+
+            pu4_rgba_dst = (UWORD32 *)ps_dst_frm->pv_y_buf;
+            pu4_rgba_dst += u4_row * ps_dst_frm->u4_y_strd;
+
+            ps_dec->pf_fmt_conv_420sp_to_rgba8888(pu1_y_dst, pu1_uv_dst,
+                                                  pu4_rgba_dst, wd, 2, wd, wd,
+                                                  ps_dst_frm->u4_y_strd, 1);
+        }
+    }
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert_frame                              */
+/*                                                                           */
+/*  Description   : Implements format conversion/frame copy of ps_op_frm     */
 /*  Inputs        : ps_dec - Decoder parameters                              */
 /*  Globals       : None                                                     */
 /*  Processing    : Refer bumping process in the standard                    */
@@ -665,24 +887,31 @@ void ih264d_fmt_conv_420sp_to_420p(UWORD8 *pu1_y_src,
 /*         27 04 2005   NS              Draft                                */
 /*                                                                           */
 /*****************************************************************************/
-void ih264d_format_convert(dec_struct_t *ps_dec,
-                           ivd_get_display_frame_op_t *pv_disp_op,
-                           UWORD32 u4_start_y,
-                           UWORD32 u4_num_rows_y)
+static void ih264d_format_convert_frame(dec_struct_t *ps_dec,
+                                        iv_yuv_buf_t *ps_op_frm,
+                                        ivd_get_display_frame_op_t *pv_disp_op,
+                                        UWORD8 *pu1_scale_buf,
+                                        UWORD32 u4_start_y,
+                                        UWORD32 u4_num_rows_y)
 {
     UWORD32 convert_uv_only = 0;
-    iv_yuv_buf_t *ps_op_frm;
     UWORD8 *pu1_y_src, *pu1_uv_src;
     UWORD32 start_uv = u4_start_y >> 1;
 
     if(1 == pv_disp_op->u4_error_code)
         return;
 
-    ps_op_frm = &(ps_dec->s_disp_frame_info);
+    /* Requires u4_start_y and u4_num_rows_y to be even, and multiples of
+     * (2 << u4_out_scale_log2) when downscaling */
+    if(u4_start_y & ((2 << ps_dec->u4_out_scale_log2) - 1))
+    {
+        return;
+    }
 
-    /* Requires u4_start_y and u4_num_rows_y to be even */
-    if(u4_start_y & 1)
+    if(ps_dec->u4_out_scale_log2)
     {
+        ih264d_format_convert_scaled(ps_dec, ps_op_frm, pv_disp_op,
+                                     pu1_scale_buf, u4_start_y, u4_num_rows_y);
         return;
     }
 
@@ -698,7 +927,26 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
     pu1_uv_src = (UWORD8 *)ps_op_frm->pv_u_buf;
     pu1_uv_src += start_uv * ps_op_frm->u4_u_strd;
 
-    if(pv_disp_op->e_output_format == IV_YUV_420P)
+    if(ps_dec->u4_luma_only)
+    {
+        UWORD8 *pu1_y_dst;
+        UWORD32 i;
+
+        /* Shared display buffers already hold the luma */
+        if(1 == ps_dec->u4_share_disp_buf)
+            return;
+
+        pu1_y_dst = (UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_y_buf;
+        pu1_y_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_y_strd;
+
+        for(i = 0; i < u4_num_rows_y; i++)
+        {
+            memcpy(pu1_y_dst, pu1_y_src, ps_op_frm->u4_y_wd);
+            pu1_y_src += ps_op_frm->u4_y_strd;
+            pu1_y_dst += pv_disp_op->s_disp_frm_buf.u4_y_strd;
+        }
+    }
+    else if(pv_disp_op->e_output_format == IV_YUV_420P)
     {
         UWORD8 *pu1_y_dst, *pu1_u_dst, *pu1_v_dst;
         IV_COLOR_FORMAT_T e_output_format = pv_disp_op->e_output_format;
@@ -721,19 +969,19 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
         pu1_v_dst = (UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_v_buf;
         pu1_v_dst += start_uv * pv_disp_op->s_disp_frm_buf.u4_v_strd;
 
-        ih264d_fmt_conv_420sp_to_420p(pu1_y_src,
-                                      pu1_uv_src,
-                                      pu1_y_dst,
-                                      pu1_u_dst,
-                                      pu1_v_dst,
-                                      ps_op_frm->u4_y_wd,
-                                      u4_num_rows_y,
-                                      ps_op_frm->u4_y_strd,
-                                      ps_op_frm->u4_u_strd,
-                                      pv_disp_op->s_disp_frm_buf.u4_y_strd,
-                                      pv_disp_op->s_disp_frm_buf.u4_u_strd,
-                                      1,
-                                      convert_uv_only);
+        ps_dec->pf_fmt_conv_420sp_to_420p(pu1_y_src,
+                                          pu1_uv_src,
+                                          pu1_y_dst,
+                                          pu1_u_dst,
+                                          pu1_v_dst,
+                                          ps_op_frm->u4_y_wd,
+                                          u4_num_rows_y,
+                                          ps_op_frm->u4_y_strd,
+                                          ps_op_frm->u4_u_strd,
+                                          pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                          pv_disp_op->s_disp_frm_buf.u4_u_strd,
+                                          1,
+                                          convert_uv_only);
 
     }
     else if((pv_disp_op->e_output_format == IV_YUV_420SP_UV) ||
@@ -762,16 +1010,16 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
         }
         else
         {
-            ih264d_fmt_conv_420sp_to_420sp_swap_uv(pu1_y_src,
-                                                   pu1_uv_src,
-                                                   pu1_y_dst,
-                                                   pu1_uv_dst,
-                                                   ps_op_frm->u4_y_wd,
-                                                   u4_num_rows_y,
-                                                   ps_op_frm->u4_y_strd,
-                                                   ps_op_frm->u4_u_strd,
-                                                   pv_disp_op->s_disp_frm_buf.u4_y_strd,
-                                                   pv_disp_op->s_disp_frm_buf.u4_u_strd);
+            ps_dec->pf_fmt_conv_420sp_to_420sp_swap_uv(pu1_y_src,
+                                                       pu1_uv_src,
+                                                       pu1_y_dst,
+                                                       pu1_uv_dst,
+                                                       ps_op_frm->u4_y_wd,
+                                                       u4_num_rows_y,
+                                                       ps_op_frm->u4_y_strd,
+                                                       ps_op_frm->u4_u_strd,
+                                                       pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                                       pv_disp_op->s_disp_frm_buf.u4_u_strd);
         }
     }
     else if(pv_disp_op->e_output_format == IV_RGB_565)
@@ -781,18 +1029,35 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
         pu2_rgb_dst = (UWORD16 *)pv_disp_op->s_disp_frm_buf.pv_y_buf;
         pu2_rgb_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_y_strd;
 
-        ih264d_fmt_conv_420sp_to_rgb565(pu1_y_src,
-                                        pu1_uv_src,
-                                        pu2_rgb_dst,
-                                        ps_op_frm->u4_y_wd,
-                                        u4_num_rows_y,
-                                        ps_op_frm->u4_y_strd,
-                                        ps_op_frm->u4_u_strd,
-                                        pv_disp_op->s_disp_frm_buf.u4_y_strd,
-                                        1);
+        ps_dec->pf_fmt_conv_420sp_to_rgb565(pu1_y_src,
+                                            pu1_uv_src,
+                                            pu2_rgb_dst,
+                                            ps_op_frm->u4_y_wd,
+                                            u4_num_rows_y,
+                                            ps_op_frm->u4_y_strd,
+                                            ps_op_frm->u4_u_strd,
+                                            pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                            1);
+    }
+    else if(pv_disp_op->e_output_format == IV_RGBA_8888)
+    {
+        UWORD32 *pu4_rgba_dst;
+
+        pu4_rgba_dst = (UWORD32 *)pv_disp_op->s_disp_frm_buf.pv_y_buf;
+        pu4_rgba_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_y_strd;
+
+        ps_dec->pf_fmt_conv_420sp_to_rgba8888(pu1_y_src,
+                                              pu1_uv_src,
+                                              pu4_rgba_dst,
+                                              ps_op_frm->u4_y_wd,
+                                              u4_num_rows_y,
+                                              ps_op_frm->u4_y_strd,
+                                              ps_op_frm->u4_u_strd,
+                                              pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                              1);
     }
 
-    if((u4_start_y + u4_num_rows_y) >= ps_dec->s_disp_frame_info.u4_y_ht)
+    if((u4_start_y + u4_num_rows_y) >= ps_op_frm->u4_y_ht)
     {
 
         INSERT_LOGO(pv_disp_op->s_disp_frm_buf.pv_y_buf,
@@ -808,3 +1073,278 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
 
     return;
 }
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert                                    */
+/*                                                                           */
+/*  Description   : Implements format conversion/frame copy of the display   */
+/*                  frame                                                    */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Globals       : None                                                     */
+/*  Processing    : Refer bumping process in the standard                    */
+/*  Outputs       : Assigns display sequence number.                         */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*         27 04 2005   NS              Draft                                */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_format_convert(dec_struct_t *ps_dec,
+                           ivd_get_display_frame_op_t *pv_disp_op,
+                           UWORD32 u4_start_y,
+                           UWORD32 u4_num_rows_y)
+{
+    ih264d_format_convert_frame(ps_dec, &(ps_dec->s_disp_frame_info),
+                                pv_disp_op,
+                                ps_dec->as_fmt_conv_stripe[0].pu1_scale_buf,
+                                u4_start_y, u4_num_rows_y);
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert_stripe                             */
+/*                                                                           */
+/*  Description   : Format converts the rows of one stripe                   */
+/*  Inputs        : ps_stripe - Stripe to be converted                       */
+/*  Globals       : None                                                     */
+/*  Processing    : None                                                     */
+/*  Outputs       : None                                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_format_convert_stripe(fmt_conv_stripe_t *ps_stripe)
+{
+    ih264d_format_convert_frame(ps_stripe->ps_dec,
+                                &ps_stripe->ps_dec->s_disp_frame_info,
+                                ps_stripe->ps_disp_op, ps_stripe->pu1_scale_buf,
+                                ps_stripe->u4_start_y, ps_stripe->u4_num_rows);
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert_stripes                            */
+/*                                                                           */
+/*  Description   : Format converts rows of the display frame, split into    */
+/*                  stripes over the worker pool. The calling thread         */
+/*                  converts the first stripe. Without a pool the rows are   */
+/*                  converted serially                                       */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  pv_disp_op - Display frame                               */
+/*                  u4_start_y - First row, even                             */
+/*                  u4_num_rows_y - Number of rows                           */
+/*  Globals       : None                                                     */
+/*  Processing    : Stripes are multiples of FMT_CONV_NUM_ROWS rows and at   */
+/*                  least FMT_CONV_MIN_STRIPE_ROWS rows, so that the cost of */
+/*                  starting a worker is small against its rows              */
+/*  Outputs       : None                                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_format_convert_stripes(dec_struct_t *ps_dec,
+                                   ivd_get_display_frame_op_t *pv_disp_op,
+                                   UWORD32 u4_start_y,
+                                   UWORD32 u4_num_rows_y)
+{
+    thread_pool_t *ps_pool = ih264d_get_worker_pool(ps_dec);
+    UWORD32 u4_num_workers = 0;
+    UWORD32 u4_stripe_rows, i;
+
+    if(ps_pool)
+    {
+        u4_num_workers = MIN(ps_pool->u4_num_threads + 1, H264_MAX_NUM_CORES);
+        u4_num_workers = MIN(u4_num_workers,
+                             u4_num_rows_y / FMT_CONV_MIN_STRIPE_ROWS);
+    }
+
+    /* Decoders without a pool convert serially, as do outputs shared with
+     * the decoder */
+    if((u4_num_workers < 2) || (NULL == ps_dec->as_fmt_conv_stripe[0].s_pool_job.pv_done_cond)
+                    || (u4_start_y & 1) || (1 == pv_disp_op->u4_error_code)
+                    || ((1 == ps_dec->u4_share_disp_buf)
+                                    && (pv_disp_op->e_output_format == IV_YUV_420SP_UV)))
+    {
+        ih264d_format_convert(ps_dec, pv_disp_op, u4_start_y, u4_num_rows_y);
+        return;
+    }
+
+    u4_stripe_rows = (u4_num_rows_y + u4_num_workers - 1) / u4_num_workers;
+    u4_stripe_rows = ALIGN16(u4_stripe_rows);
+
+    for(i = 0; i < u4_num_workers; i++)
+    {
+        fmt_conv_stripe_t *ps_stripe = &ps_dec->as_fmt_conv_stripe[i];
+        UWORD32 u4_offset = MIN(i * u4_stripe_rows, u4_num_rows_y);
+
+        ps_stripe->ps_dec = ps_dec;
+        ps_stripe->ps_disp_op = pv_disp_op;
+        ps_stripe->u4_start_y = u4_start_y + u4_offset;
+        ps_stripe->u4_num_rows = MIN(u4_stripe_rows, u4_num_rows_y - u4_offset);
+    }
+
+    for(i = 1; i < u4_num_workers; i++)
+    {
+        fmt_conv_stripe_t *ps_stripe = &ps_dec->as_fmt_conv_stripe[i];
+
+        if(ps_stripe->u4_num_rows)
+        {
+            ih264d_thread_pool_submit(ps_pool, &ps_stripe->s_pool_job,
+                                      (pf_pool_job_t)ih264d_format_convert_stripe,
+                                      (void *)ps_stripe);
+        }
+    }
+
+    ih264d_format_convert_stripe(&ps_dec->as_fmt_conv_stripe[0]);
+
+    for(i = 1; i < u4_num_workers; i++)
+    {
+        fmt_conv_stripe_t *ps_stripe = &ps_dec->as_fmt_conv_stripe[i];
+
+        if(ps_stripe->u4_num_rows)
+            ih264d_thread_pool_wait(ps_pool, &ps_stripe->s_pool_job);
+    }
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_fused_fmt_conv_init                               */
+/*                                                                           */
+/*  Description   : Sets up format conversion of the current picture into    */
+/*                  the output buffer as its MB rows are deblocked by the    */
+/*                  recon/deblock thread. Only done when the picture is      */
+/*                  returned by this decode call and is a frame deblocked in */
+/*                  MB row order                                             */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Globals       : None                                                     */
+/*  Processing    : None                                                     */
+/*  Outputs       : None                                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fused_fmt_conv_init(dec_struct_t *ps_dec)
+{
+    pic_buffer_t *ps_cur_pic = ps_dec->ps_cur_pic;
+    iv_yuv_buf_t *ps_op_frm = &ps_dec->s_fused_frame_info;
+    ivd_get_display_frame_op_t *ps_disp_op = &ps_dec->s_fused_disp_op;
+    ivd_out_bufdesc_t *ps_out_buffer = ps_dec->ps_out_buffer;
+
+    ps_dec->u4_fused_fmt_conv = 0;
+
+    if((IVD_DECODE_FRAME_OUT != ps_dec->e_frm_out_mode)
+                    || (0 != ps_dec->u4_share_disp_buf)
+                    || (3 != ps_dec->u4_num_cores)
+                    || (0 != ps_dec->u4_deblk_in_own_thread)
+                    || ((0 != ps_dec->u4_app_disable_deblk_frm)
+                                    && (0 == ps_dec->i1_recon_in_thread3_flag))
+                    || ps_dec->u4_output_present
+                    || ps_dec->ps_cur_slice->u1_field_pic_flag
+                    || ps_dec->ps_cur_slice->u1_mbaff_frame_flag
+                    || (NULL == ps_out_buffer) || (NULL == ps_cur_pic))
+    {
+        return;
+    }
+
+    /* Same display frame as ih264d_get_next_display_field() returns once the
+     * picture is decoded */
+    ps_op_frm->u4_y_ht = (ps_dec->u2_disp_height >> 1) << 1;
+    ps_op_frm->u4_u_ht = ps_op_frm->u4_v_ht = ps_op_frm->u4_y_ht >> 1;
+    ps_op_frm->u4_y_wd = ps_dec->u2_disp_width;
+    ps_op_frm->u4_u_wd = ps_op_frm->u4_v_wd = ps_op_frm->u4_y_wd >> 1;
+    ps_op_frm->u4_y_strd = ps_cur_pic->u2_frm_wd_y;
+    ps_op_frm->u4_u_strd = ps_op_frm->u4_v_strd = ps_cur_pic->u2_frm_wd_uv;
+    ps_op_frm->pv_y_buf = ps_cur_pic->pu1_buf1 + ps_dec->u2_crop_offset_y;
+    ps_op_frm->pv_u_buf = ps_cur_pic->pu1_buf2 + ps_dec->u2_crop_offset_uv;
+    ps_op_frm->pv_v_buf = ps_cur_pic->pu1_buf3 + ps_dec->u2_crop_offset_uv;
+
+    ps_disp_op->e_output_format = ps_dec->u1_chroma_format;
+    ps_disp_op->s_disp_frm_buf.pv_y_buf = ps_out_buffer->pu1_bufs[0];
+    ps_disp_op->s_disp_frm_buf.pv_u_buf = ps_out_buffer->pu1_bufs[1];
+    ps_disp_op->s_disp_frm_buf.pv_v_buf = ps_out_buffer->pu1_bufs[2];
+    ih264d_fill_disp_frm_buf(ps_dec, ps_cur_pic, ps_op_frm, ps_disp_op);
+
+    ps_dec->u4_fused_crop_top = ps_dec->u2_crop_offset_y / ps_cur_pic->u2_frm_wd_y;
+    ps_dec->u4_fused_fmt_conv_row = 0;
+    ps_dec->u4_fused_rows_reported = 0;
+    ps_dec->u4_fused_fmt_conv = 1;
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_fused_fmt_conv_rows                               */
+/*                                                                           */
+/*  Description   : Converts the rows of the current picture that are no     */
+/*                  longer changed by deblocking, while they are still in    */
+/*                  cache. Called by the recon/deblock thread after each     */
+/*                  group of MBs it deblocks                                 */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Globals       : None                                                     */
+/*  Processing    : Filtering of the top edge of an MB row changes up to 3   */
+/*                  luma rows and 1 chroma row of the row above, so rows     */
+/*                  down to 4 luma rows above the last fully deblocked MB    */
+/*                  row are final                                            */
+/*  Outputs       : None                                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fused_fmt_conv_rows(dec_struct_t *ps_dec)
+{
+    UWORD32 u4_mb_rows_done, u4_final_rows, u4_end_row, u4_num_rows;
+    UWORD32 u4_disp_ht = ps_dec->s_fused_frame_info.u4_y_ht;
+    UWORD32 u4_rows_converted;
+
+    if(0 == ps_dec->u4_fused_fmt_conv)
+        return;
+
+    u4_mb_rows_done = ps_dec->u4_cur_deblk_mb_num / ps_dec->u2_frm_wd_in_mbs;
+    if(u4_mb_rows_done >= ps_dec->u2_frm_ht_in_mbs)
+        u4_final_rows = u4_mb_rows_done << 4;
+    else if(u4_mb_rows_done)
+        u4_final_rows = (u4_mb_rows_done << 4) - 4;
+    else
+        return;
+
+    if(u4_final_rows <= ps_dec->u4_fused_crop_top)
+        return;
+
+    u4_end_row = MIN(u4_final_rows - ps_dec->u4_fused_crop_top, u4_disp_ht);
+    if(u4_end_row < u4_disp_ht)
+        u4_end_row &= ~((2 << ps_dec->u4_out_scale_log2) - 1);
+    if(u4_end_row <= ps_dec->u4_fused_fmt_conv_row)
+        return;
+
+    u4_num_rows = u4_end_row - ps_dec->u4_fused_fmt_conv_row;
+    if((u4_num_rows < FMT_CONV_NUM_ROWS) && (u4_end_row < u4_disp_ht))
+        return;
+
+    ih264d_format_convert_frame(ps_dec, &ps_dec->s_fused_frame_info,
+                                &ps_dec->s_fused_disp_op,
+                                ps_dec->as_fmt_conv_stripe[0].pu1_scale_buf,
+                                ps_dec->u4_fused_fmt_conv_row, u4_num_rows);
+    ps_dec->u4_fused_fmt_conv_row = u4_end_row;
+
+    /* Report the MB rows whose output rows are all converted */
+    if(u4_end_row == u4_disp_ht)
+        u4_rows_converted = ps_dec->u2_frm_ht_in_mbs;
+    else
+        u4_rows_converted = (ps_dec->u4_fused_crop_top + u4_end_row) >> 4;
+    if(u4_rows_converted > ps_dec->u4_fused_rows_reported)
+    {
+        ps_dec->u4_fused_rows_reported = u4_rows_converted;
+        ih264d_report_rows_done(ps_dec, (WORD32)u4_rows_converted);
+    }
+}
@@ -61,60 +61,102 @@
 #define COF_1U_0U          0XFFB5FFDA
 #define COF_1V_0V          0XFFA20070
 
-void ih264d_fmt_conv_420sp_to_420p(UWORD8 *pu1_y_src,
-                                   UWORD8 *pu1_uv_src,
-                                   UWORD8 *pu1_y_dst,
-                                   UWORD8 *pu1_u_dst,
-                                   UWORD8 *pu1_v_dst,
-                                   WORD32 wd,
-                                   WORD32 ht,
-                                   WORD32 src_y_strd,
-                                   WORD32 src_uv_strd,
-                                   WORD32 dst_y_strd,
-                                   WORD32 dst_uv_strd,
-                                   WORD32 is_u_first,
-                                   WORD32 disable_luma_copy);
-
-void ih264d_fmt_conv_420sp_to_420sp_swap_uv(UWORD8 *pu1_y_src,
-                                            UWORD8 *pu1_uv_src,
-                                            UWORD8 *pu1_y_dst,
-                                            UWORD8 *pu1_uv_dst,
-                                            WORD32 wd,
-                                            WORD32 ht,
-                                            WORD32 src_y_strd,
-                                            WORD32 src_uv_strd,
-                                            WORD32 dst_y_strd,
-                                            WORD32 dst_uv_strd);
-
-void ih264d_fmt_conv_420sp_to_420sp(UWORD8 *pu1_y_src,
-                                    UWORD8 *pu1_uv_src,
-                                    UWORD8 *pu1_y_dst,
-                                    UWORD8 *pu1_uv_dst,
-                                    WORD32 wd,
-                                    WORD32 ht,
-                                    WORD32 src_y_strd,
-                                    WORD32 src_uv_strd,
-                                    WORD32 dst_y_strd,
-                                    WORD32 dst_uv_strd);
-
-void ih264d_fmt_conv_420sp_to_rgb565(UWORD8 *pu1_y_src,
-                                     UWORD8 *pu1_uv_src,
-                                     UWORD16 *pu2_rgb_dst,
-                                     WORD32 wd,
-                                     WORD32 ht,
-                                     WORD32 src_y_strd,
-                                     WORD32 src_uv_strd,
-                                     WORD32 dst_strd,
-                                     WORD32 is_u_first);
+typedef void ih264d_fmt_conv_420sp_to_420p_ft(UWORD8 *pu1_y_src,
+                                              UWORD8 *pu1_uv_src,
+                                              UWORD8 *pu1_y_dst,
+                                              UWORD8 *pu1_u_dst,
+                                              UWORD8 *pu1_v_dst,
+                                              WORD32 wd,
+                                              WORD32 ht,
+                                              WORD32 src_y_strd,
+                                              WORD32 src_uv_strd,
+                                              WORD32 dst_y_strd,
+                                              WORD32 dst_uv_strd,
+                                              WORD32 is_u_first,
+                                              WORD32 disable_luma_copy);
+
+typedef void ih264d_fmt_conv_420sp_to_420sp_ft(UWORD8 *pu1_y_src,
+                                               UWORD8 *pu1_uv_src,
+                                               UWORD8 *pu1_y_dst,
+                                               UWORD8 *pu1_uv_dst,
+                                               WORD32 wd,
+                                               WORD32 ht,
+                                               WORD32 src_y_strd,
+                                               WORD32 src_uv_strd,
+                                               WORD32 dst_y_strd,
+                                               WORD32 dst_uv_strd);
+
+typedef void ih264d_fmt_conv_420sp_to_rgb565_ft(UWORD8 *pu1_y_src,
+                                                UWORD8 *pu1_uv_src,
+                                                UWORD16 *pu2_rgb_dst,
+                                                WORD32 wd,
+                                                WORD32 ht,
+                                                WORD32 src_y_strd,
+                                                WORD32 src_uv_strd,
+                                                WORD32 dst_strd,
+                                                WORD32 is_u_first);
+
+typedef void ih264d_fmt_conv_420sp_to_rgba8888_ft(UWORD8 *pu1_y_src,
+                                                  UWORD8 *pu1_uv_src,
+                                                  UWORD32 *pu4_rgba_dst,
+                                                  WORD32 wd,
+                                                  WORD32 ht,
+                                                  WORD32 src_y_strd,
+                                                  WORD32 src_uv_strd,
+                                                  WORD32 dst_strd,
+                                                  WORD32 is_u_first);
+
+typedef void ih264d_fmt_conv_downscale_ft(UWORD8 *pu1_src,
+                                          UWORD8 *pu1_dst,
+                                          WORD32 wd,
+                                          WORD32 ht,
+                                          WORD32 src_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 scale_log2,
+                                          WORD32 is_chroma);
+
+/* C function declarations */
+ih264d_fmt_conv_420sp_to_420p_ft ih264d_fmt_conv_420sp_to_420p;
+ih264d_fmt_conv_420sp_to_420sp_ft ih264d_fmt_conv_420sp_to_420sp_swap_uv;
+ih264d_fmt_conv_420sp_to_420sp_ft ih264d_fmt_conv_420sp_to_420sp;
+ih264d_fmt_conv_420sp_to_rgb565_ft ih264d_fmt_conv_420sp_to_rgb565;
+ih264d_fmt_conv_420sp_to_rgba8888_ft ih264d_fmt_conv_420sp_to_rgba8888;
+ih264d_fmt_conv_downscale_ft ih264d_fmt_conv_downscale;
+
+/* SSSE3 function declarations */
+ih264d_fmt_conv_420sp_to_420p_ft ih264d_fmt_conv_420sp_to_420p_ssse3;
+ih264d_fmt_conv_420sp_to_420sp_ft ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3;
+ih264d_fmt_conv_420sp_to_rgb565_ft ih264d_fmt_conv_420sp_to_rgb565_ssse3;
+ih264d_fmt_conv_420sp_to_rgba8888_ft ih264d_fmt_conv_420sp_to_rgba8888_ssse3;
+ih264d_fmt_conv_downscale_ft ih264d_fmt_conv_downscale_ssse3;
+
+/* AVX2 function declarations */
+ih264d_fmt_conv_420sp_to_rgb565_ft ih264d_fmt_conv_420sp_to_rgb565_avx2;
+ih264d_fmt_conv_420sp_to_rgba8888_ft ih264d_fmt_conv_420sp_to_rgba8888_avx2;
+ih264d_fmt_conv_420sp_to_420p_ft ih264d_fmt_conv_420sp_to_420p_avx2;
+ih264d_fmt_conv_420sp_to_420sp_ft ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2;
+
+/* No NEON versions yet, armv7 and armv8 use the generic conversions */
+
 #define COEFF1          13073
 #define COEFF2          -3207
 #define COEFF3          -6664
 #define COEFF4          16530
 
-void ih264d_format_convert(dec_struct_t *ps_dec,
+struct _DecStruct;
+
+void ih264d_format_convert(struct _DecStruct *ps_dec,
                            ivd_get_display_frame_op_t *pv_disp_op,
                            UWORD32 u4_start_y,
                            UWORD32 u4_num_rows_y);
 
+void ih264d_format_convert_stripes(struct _DecStruct *ps_dec,
+                                   ivd_get_display_frame_op_t *pv_disp_op,
+                                   UWORD32 u4_start_y,
+                                   UWORD32 u4_num_rows_y);
+
+void ih264d_fused_fmt_conv_init(struct _DecStruct *ps_dec);
+
+void ih264d_fused_fmt_conv_rows(struct _DecStruct *ps_dec);
 
 #endif /* _IH264D_FORMAT_CONV_H_ */
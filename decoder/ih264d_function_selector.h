@@ -59,11 +59,15 @@
 
 void ih264d_init_arch(dec_struct_t *ps_codec);
 
+IVD_ARCH_T ih264d_get_supported_arch(IVD_ARCH_T e_arch);
+
 void ih264d_init_function_ptr(dec_struct_t *ps_codec);
 
 void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec);
+void ih264d_init_function_ptr_luma_only(dec_struct_t *ps_codec);
 void ih264d_init_function_ptr_ssse3(dec_struct_t *ps_codec);
 void ih264d_init_function_ptr_sse42(dec_struct_t *ps_codec);
+void ih264d_init_function_ptr_avx2(dec_struct_t *ps_codec);
 
 void ih264d_init_function_ptr_a9q(dec_struct_t *ps_codec);
 void ih264d_init_function_ptr_av8(dec_struct_t *ps_codec);
@@ -58,6 +58,7 @@
 #include "ih264_inter_pred_filters.h"
 
 #include "ih264d_structs.h"
+#include "ih264d_deblocking.h"
 #include "ih264d_function_selector.h"
 
 /**
@@ -178,6 +179,9 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec)
     ps_codec->pf_deblk_luma_horz_bs4 = ih264_deblk_luma_horz_bs4;
     ps_codec->pf_deblk_luma_horz_bslt4 = ih264_deblk_luma_horz_bslt4;
 
+    ps_codec->pf_deblk_luma_vert_inner_bslt4 = ih264_deblk_luma_vert_inner_bslt4;
+    ps_codec->pf_deblk_luma_horz_inner_bslt4 = ih264_deblk_luma_horz_inner_bslt4;
+
     /* Init fn ptr chroma deblocking */
     ps_codec->pf_deblk_chroma_vert_bs4 = ih264_deblk_chroma_vert_bs4;
     ps_codec->pf_deblk_chroma_vert_bslt4 = ih264_deblk_chroma_vert_bslt4;
@@ -218,5 +222,139 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec)
 
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma;
 
+    ps_codec->pf_find_zero_run = ih264d_find_zero_run;
+
+    /* Init function pointers for Bs calculation, P and B, 16x16/non16x16 */
+    ps_codec->pf_fill_bs1[0][0] = ih264d_fill_bs1_16x16mb_pslice;
+    ps_codec->pf_fill_bs1[0][1] = ih264d_fill_bs1_non16x16mb_pslice;
+    ps_codec->pf_fill_bs1[1][0] = ih264d_fill_bs1_16x16mb_bslice;
+    ps_codec->pf_fill_bs1[1][1] = ih264d_fill_bs1_non16x16mb_bslice;
+
+    ps_codec->pf_fmt_conv_420sp_to_420p = ih264d_fmt_conv_420sp_to_420p;
+    ps_codec->pf_fmt_conv_420sp_to_420sp_swap_uv = ih264d_fmt_conv_420sp_to_420sp_swap_uv;
+    ps_codec->pf_fmt_conv_420sp_to_rgb565 = ih264d_fmt_conv_420sp_to_rgb565;
+    ps_codec->pf_fmt_conv_420sp_to_rgba8888 = ih264d_fmt_conv_420sp_to_rgba8888;
+    ps_codec->pf_fmt_conv_downscale = ih264d_fmt_conv_downscale;
+
+    return;
+}
+
+/* Chroma functions of the luma only mode, leaving the chroma untouched */
+static void ih264d_skip_inter_pred_chroma(UWORD8 *pu1_src,
+                                          UWORD8 *pu1_dst,
+                                          WORD32 src_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 dx,
+                                          WORD32 dy,
+                                          WORD32 ht,
+                                          WORD32 wd)
+{
+}
+
+static void ih264d_skip_default_weighted_pred_chroma(UWORD8 *puc_src1,
+                                                     UWORD8 *puc_src2,
+                                                     UWORD8 *puc_dst,
+                                                     WORD32 src_strd1,
+                                                     WORD32 src_strd2,
+                                                     WORD32 dst_strd,
+                                                     WORD32 ht,
+                                                     WORD32 wd)
+{
+}
+
+static void ih264d_skip_weighted_pred_chroma(UWORD8 *puc_src,
+                                             UWORD8 *puc_dst,
+                                             WORD32 src_strd,
+                                             WORD32 dst_strd,
+                                             WORD32 log_wd,
+                                             WORD32 wt,
+                                             WORD32 ofst,
+                                             WORD32 ht,
+                                             WORD32 wd)
+{
+}
+
+static void ih264d_skip_weighted_bi_pred_chroma(UWORD8 *puc_src1,
+                                                UWORD8 *puc_src2,
+                                                UWORD8 *puc_dst,
+                                                WORD32 src_strd1,
+                                                WORD32 src_strd2,
+                                                WORD32 dst_strd,
+                                                WORD32 log_wd,
+                                                WORD32 wt1,
+                                                WORD32 wt2,
+                                                WORD32 ofst1,
+                                                WORD32 ofst2,
+                                                WORD32 ht,
+                                                WORD32 wd)
+{
+}
+
+static void ih264d_skip_deblk_chroma_bs4(UWORD8 *pu1_src,
+                                         WORD32 src_strd,
+                                         WORD32 alpha_cb,
+                                         WORD32 beta_cb,
+                                         WORD32 alpha_cr,
+                                         WORD32 beta_cr)
+{
+}
+
+static void ih264d_skip_deblk_chroma_bslt4(UWORD8 *pu1_src,
+                                           WORD32 src_strd,
+                                           WORD32 alpha_cb,
+                                           WORD32 beta_cb,
+                                           WORD32 alpha_cr,
+                                           WORD32 beta_cr,
+                                           UWORD32 u4_bs,
+                                           const UWORD8 *pu1_cliptab_cb,
+                                           const UWORD8 *pu1_cliptab_cr)
+{
+}
+
+static void ih264d_skip_pad_chroma(UWORD8 *pu1_src,
+                                   WORD32 src_strd,
+                                   WORD32 ht,
+                                   WORD32 pad_size)
+{
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Replaces the chroma motion compensation, deblocking and padding
+ * function pointers of codec context for the luma only mode
+ *
+ * @par Description: Called after the function pointers are selected for the
+ * architecture. Chroma residuals and intra prediction are skipped where the
+ * macroblocks are reconstructed
+ *
+ * @param[in] ps_codec
+ *  Codec context pointer
+ *
+ * @returns  none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264d_init_function_ptr_luma_only(dec_struct_t *ps_codec)
+{
+    ps_codec->pf_inter_pred_chroma = ih264d_skip_inter_pred_chroma;
+
+    ps_codec->pf_default_weighted_pred_chroma =
+                    ih264d_skip_default_weighted_pred_chroma;
+    ps_codec->pf_weighted_pred_chroma = ih264d_skip_weighted_pred_chroma;
+    ps_codec->pf_weighted_bi_pred_chroma = ih264d_skip_weighted_bi_pred_chroma;
+
+    ps_codec->pf_deblk_chroma_vert_bs4 = ih264d_skip_deblk_chroma_bs4;
+    ps_codec->pf_deblk_chroma_vert_bslt4 = ih264d_skip_deblk_chroma_bslt4;
+    ps_codec->pf_deblk_chroma_vert_bs4_mbaff = ih264d_skip_deblk_chroma_bs4;
+    ps_codec->pf_deblk_chroma_vert_bslt4_mbaff = ih264d_skip_deblk_chroma_bslt4;
+    ps_codec->pf_deblk_chroma_horz_bs4 = ih264d_skip_deblk_chroma_bs4;
+    ps_codec->pf_deblk_chroma_horz_bslt4 = ih264d_skip_deblk_chroma_bslt4;
+
+    ps_codec->pf_pad_left_chroma = ih264d_skip_pad_chroma;
+    ps_codec->pf_pad_right_chroma = ih264d_skip_pad_chroma;
+
     return;
 }
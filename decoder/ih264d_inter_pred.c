@@ -238,8 +238,8 @@ WORD32 ih264d_form_mb_part_info_bp(pred_info_pkd_t *ps_pred_pkd,
         /* calculating rounded motion vectors and fractional components */
         i2_tmp_mv_x = i2_mv_x;
         i2_tmp_mv_y = i2_mv_y;
-        u1_dx = i2_tmp_mv_x & 0x3;
-        u1_dy = i2_tmp_mv_y & 0x3;
+        u1_dx = i2_tmp_mv_x & ps_dec->i4_mv_frac_mask;
+        u1_dy = i2_tmp_mv_y & ps_dec->i4_mv_frac_mask;
         i2_tmp_mv_x >>= 2;
         i2_tmp_mv_y >>= 2;
         i1_mc_wd = u1_part_wd << 2;
@@ -594,8 +594,8 @@ WORD32 ih264d_form_mb_part_info_mp(pred_info_pkd_t *ps_pred_pkd,
         i2_tmp_mv_x = i2_mv_x;
         i2_tmp_mv_y = i2_mv_y;
 
-        u1_dx = i2_tmp_mv_x & 0x3;
-        u1_dy = i2_tmp_mv_y & 0x3;
+        u1_dx = i2_tmp_mv_x & ps_dec->i4_mv_frac_mask;
+        u1_dy = i2_tmp_mv_y & ps_dec->i4_mv_frac_mask;
         i2_tmp_mv_x >>= 2;
         i2_tmp_mv_y >>= 2;
         i1_mc_wd = u1_part_wd << 2;
@@ -29,12 +29,15 @@
  *         - AI  19 11 2002  Creation
  **************************************************************************
  */
+#include <string.h>
+
 #include "ih264d_bitstrm.h"
 #include "ih264d_defs.h"
 #include "ih264_typedefs.h"
 #include "ih264_macros.h"
 #include "ih264_platform_macros.h"
 #include "ih264d_defs.h"
+#include "ih264d_nal.h"
 #define NUM_OF_ZERO_BYTES_BEFORE_START_CODE 2
 #define EMULATION_PREVENTION_BYTE           0x03
 
@@ -51,6 +54,8 @@
  * \param u4_cur_pos : Current position in the buffer.
  * \param u4_max_ofst : Number of bytes in Buffer.
  * \param pu4_length_of_start_code  : Poiter to length of Start Code.
+ * \param pf_find_zero_run : Function skipping bytes that can not begin a
+ *    start code.
  *
  * \return
  *    Returns 0 on success and -1 on error.
@@ -83,7 +88,8 @@ WORD32 ih264d_find_start_code(UWORD8 *pu1_buf,
                               UWORD32 u4_cur_pos,
                               UWORD32 u4_max_ofst,
                               UWORD32 *pu4_length_of_start_code,
-                              UWORD32 *pu4_next_is_aud)
+                              UWORD32 *pu4_next_is_aud,
+                              ih264d_find_zero_run_ft *pf_find_zero_run)
 {
     WORD32 zero_byte_cnt = 0;
     UWORD32 ui_curPosTemp;
@@ -103,7 +109,10 @@ WORD32 ih264d_find_start_code(UWORD8 *pu1_buf,
         }
         else
         {
+            /* No start code can begin before the next run of zero bytes */
             zero_byte_cnt = 0;
+            u4_cur_pos = pf_find_zero_run(pu1_buf, u4_cur_pos + 1, u4_max_ofst);
+            continue;
         }
         u4_cur_pos++;
     }
@@ -126,7 +135,10 @@ WORD32 ih264d_find_start_code(UWORD8 *pu1_buf,
         }
         else
         {
+            /* No start code can begin before the next run of zero bytes */
             zero_byte_cnt = 0;
+            u4_cur_pos = pf_find_zero_run(pu1_buf, u4_cur_pos + 1, u4_max_ofst);
+            continue;
         }
         u4_cur_pos++;
     }
@@ -134,6 +146,248 @@ WORD32 ih264d_find_start_code(UWORD8 *pu1_buf,
     return (u4_cur_pos - zero_byte_cnt - ui_curPosTemp); //(START_CODE_NOT_FOUND);
 }
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_find_length_prefixed_nal \endif
+ *
+ * \brief
+ *    This function reads the length prefix of the next NAL unit, for input
+ *    in which NAL units are prefixed by their length instead of a start
+ *    code. NAL units of length zero are skipped.
+ *
+ * \param pu1_buf : Pointer to char buffer which contains bitstream.
+ * \param u4_max_ofst : Number of bytes in Buffer.
+ * \param u4_nal_length_size : Number of bytes in the length prefix.
+ * \param pu4_length_of_prefix : Pointer to the number of bytes before the
+ *    NAL unit. Set to u4_max_ofst if there is no NAL unit.
+ * \param pu4_next_is_aud : Set to 1 if the NAL unit after this one is an
+ *    access unit delimiter.
+ *
+ * \return
+ *    Returns the length of the NAL unit, truncated to the end of the buffer.
+ *
+ **************************************************************************
+ */
+WORD32 ih264d_find_length_prefixed_nal(UWORD8 *pu1_buf,
+                                       UWORD32 u4_max_ofst,
+                                       UWORD32 u4_nal_length_size,
+                                       UWORD32 *pu4_length_of_prefix,
+                                       UWORD32 *pu4_next_is_aud)
+{
+    UWORD32 u4_cur_pos = 0;
+    UWORD32 u4_nal_length = 0;
+    UWORD32 i;
+
+    while(u4_cur_pos + u4_nal_length_size <= u4_max_ofst)
+    {
+        u4_nal_length = 0;
+        for(i = 0; i < u4_nal_length_size; i++)
+        {
+            u4_nal_length = (u4_nal_length << 8) | pu1_buf[u4_cur_pos++];
+        }
+        if(u4_nal_length)
+            break;
+    }
+
+    if(0 == u4_nal_length)
+    {
+        *pu4_length_of_prefix = u4_max_ofst;
+        return 0;
+    }
+
+    *pu4_length_of_prefix = u4_cur_pos;
+    u4_nal_length = MIN(u4_nal_length, u4_max_ofst - u4_cur_pos);
+
+    /* Header of the next NAL unit */
+    u4_cur_pos += u4_nal_length + u4_nal_length_size;
+    if(u4_cur_pos < u4_max_ofst)
+    {
+        if(NAL_UNIT_TYPE(pu1_buf[u4_cur_pos]) == ACCESS_UNIT_DELIMITER_RBSP)
+            *pu4_next_is_aud = 1;
+    }
+
+    return u4_nal_length;
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_find_zero_run \endif
+ *
+ * \brief
+ *    Skips the bytes that can not begin a start code. A start code prefix
+ *    begins with two zero bytes, so a zero byte followed by a non zero byte
+ *    is skipped as well.
+ *
+ * \param pu1_buf : Pointer to char buffer which contains bitstream.
+ * \param u4_pos : Position to start the search from.
+ * \param u4_max_ofst : Number of bytes in Buffer.
+ *
+ * \return
+ *    Returns the position of the first zero byte at or after u4_pos that is
+ *    followed by a zero byte or by the end of the buffer, u4_max_ofst if
+ *    there is none.
+ *
+ **************************************************************************
+ */
+UWORD32 ih264d_find_zero_run(UWORD8 *pu1_buf,
+                             UWORD32 u4_pos,
+                             UWORD32 u4_max_ofst)
+{
+    while(u4_pos + 1 < u4_max_ofst)
+    {
+        /* Neither this byte nor the next can begin a pair of zero bytes */
+        if(pu1_buf[u4_pos + 1])
+        {
+            u4_pos += 2;
+            continue;
+        }
+        if(0 == pu1_buf[u4_pos])
+            return u4_pos;
+        u4_pos++;
+    }
+
+    /* A zero byte at the end of the buffer is followed by the end */
+    if((u4_pos < u4_max_ofst) && (0 != pu1_buf[u4_pos]))
+        u4_pos++;
+    return u4_pos;
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_find_rap_offsets \endif
+ *
+ * \brief
+ *    Scans a buffer for the access units decoding can start from, without
+ *    decoding it. These are the access units of IDR pictures, and optionally
+ *    of the pictures whose first slice is an I slice. Only the NAL unit
+ *    headers and the first bits of the slice headers are read.
+ *
+ *    An access unit starts at the first access unit delimiter, SEI, SPS or
+ *    PPS NAL unit before its first slice, if any. The offset returned for it
+ *    is that of the start code or length prefix of that NAL unit.
+ *
+ * \param pu1_buf : Pointer to char buffer which contains bitstream.
+ * \param u4_max_ofst : Number of bytes in Buffer.
+ * \param u4_nal_length_size : Number of bytes in the length prefix of the
+ *    NAL units, 0 if they are prefixed by start codes.
+ * \param u4_include_i_pics : Report the pictures starting with an I slice
+ *    as well as the IDR ones.
+ * \param pu4_offsets : Array receiving the offsets of the access units.
+ * \param u4_max_offsets : Number of entries in pu4_offsets.
+ * \param pu4_num_offsets : Pointer to the number of offsets returned.
+ * \param pf_find_zero_run : Function skipping the bytes that can not begin
+ *    a start code.
+ *
+ * \return
+ *    Returns the number of bytes scanned. This is u4_max_ofst, unless
+ *    pu4_offsets is filled up before the end of the buffer. The scan then
+ *    stops at the next access unit decoding can start from.
+ *
+ **************************************************************************
+ */
+UWORD32 ih264d_find_rap_offsets(UWORD8 *pu1_buf,
+                                UWORD32 u4_max_ofst,
+                                UWORD32 u4_nal_length_size,
+                                UWORD32 u4_include_i_pics,
+                                UWORD32 *pu4_offsets,
+                                UWORD32 u4_max_offsets,
+                                UWORD32 *pu4_num_offsets,
+                                ih264d_find_zero_run_ft *pf_find_zero_run)
+{
+    UWORD32 u4_cur_pos = 0;
+    UWORD32 u4_au_start = u4_max_ofst;
+
+    *pu4_num_offsets = 0;
+
+    while(u4_cur_pos < u4_max_ofst)
+    {
+        UWORD32 u4_nal_start = u4_cur_pos;
+        UWORD32 u4_length_of_start_code = 0;
+        UWORD32 u4_next_is_aud = 0;
+        UWORD8 *pu1_nal;
+        WORD32 i4_nal_len;
+
+        if(u4_nal_length_size)
+        {
+            i4_nal_len = ih264d_find_length_prefixed_nal(pu1_buf + u4_cur_pos,
+                                                         u4_max_ofst - u4_cur_pos,
+                                                         u4_nal_length_size,
+                                                         &u4_length_of_start_code,
+                                                         &u4_next_is_aud);
+        }
+        else
+        {
+            i4_nal_len = ih264d_find_start_code(pu1_buf + u4_cur_pos, 0,
+                                                u4_max_ofst - u4_cur_pos,
+                                                &u4_length_of_start_code,
+                                                &u4_next_is_aud,
+                                                pf_find_zero_run);
+        }
+
+        pu1_nal = pu1_buf + u4_cur_pos + u4_length_of_start_code;
+        u4_cur_pos += u4_length_of_start_code + MAX(i4_nal_len, 0);
+        if(i4_nal_len <= 0)
+            continue;
+
+        switch(NAL_UNIT_TYPE(pu1_nal[0]))
+        {
+            case SEI_NAL:
+            case SEQ_PARAM_NAL:
+            case PIC_PARAM_NAL:
+            case ACCESS_UNIT_DELIMITER_RBSP:
+                if(u4_au_start == u4_max_ofst)
+                    u4_au_start = u4_nal_start;
+                break;
+
+            case SLICE_NAL:
+            case IDR_SLICE_NAL:
+            {
+                WORD32 i4_is_rap = 0;
+
+                /* first_mb_in_slice of zero, the first slice of a picture */
+                if((i4_nal_len > 1) && (pu1_nal[1] & 0x80))
+                {
+                    i4_is_rap = (IDR_SLICE_NAL == NAL_UNIT_TYPE(pu1_nal[0]));
+
+                    if(!i4_is_rap && u4_include_i_pics)
+                    {
+                        /* slice_type, at most 7 bits after first_mb_in_slice */
+                        UWORD32 u4_bits = (UWORD32)pu1_nal[1] << 25;
+                        UWORD32 u4_lz;
+
+                        if(i4_nal_len > 2)
+                            u4_bits |= (UWORD32)pu1_nal[2] << 17;
+                        u4_lz = u4_bits ? CLZ(u4_bits) : 32;
+                        if(u4_lz <= 3)
+                        {
+                            UWORD32 u4_slice_type = (u4_bits >> (31 - 2 * u4_lz)) - 1;
+                            i4_is_rap = ((u4_slice_type % 5) == I_SLICE);
+                        }
+                    }
+                }
+
+                if(i4_is_rap)
+                {
+                    if(u4_au_start == u4_max_ofst)
+                        u4_au_start = u4_nal_start;
+
+                    if(*pu4_num_offsets == u4_max_offsets)
+                        return u4_au_start;
+
+                    pu4_offsets[(*pu4_num_offsets)++] = u4_au_start;
+                }
+                u4_au_start = u4_max_ofst;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return u4_max_ofst;
+}
+
 /*!
  **************************************************************************
  * \if Function name : ih264d_get_next_nal_unit \endif
@@ -161,7 +415,8 @@ WORD32 ih264d_get_next_nal_unit(UWORD8 *pu1_buf,
     /* NAL Thread starts */
 
     ih264d_find_start_code(pu1_buf, u4_cur_pos, u4_max_ofst,
-                           pu4_length_of_start_code, &u4_next_is_aud);
+                           pu4_length_of_start_code, &u4_next_is_aud,
+                           ih264d_find_zero_run);
 
     return (i_length_of_nal_unit);
 }
@@ -177,6 +432,8 @@ WORD32 ih264d_get_next_nal_unit(UWORD8 *pu1_buf,
  * \param ps_bitstrm : Poiter to dec_bit_stream_t structure.
  * \param pu1_nal_unit  : Pointer to char buffer of NalUnit.
  * \param u4_numbytes_in_nal_unit : Number bytes in NalUnit buffer.
+ * \param pf_find_zero_run : Function skipping bytes that can not begin a
+ *    start code.
  *
  * \return
  *    Returns number of bytes in RBSP ps_bitstrm.
@@ -187,166 +444,93 @@ WORD32 ih264d_get_next_nal_unit(UWORD8 *pu1_buf,
  *    facilitates efficient access of bitstream. This has been done taking
  *    into account present processor architectures.
  *
+ *    An emulation prevention byte follows two zero bytes, so the bytes up to
+ *    the next pair of zero bytes are moved as a run, and are not moved at
+ *    all until the first emulation prevention byte. The buffer must have 8
+ *    bytes after the NAL unit, which are zero for NAL units shorter than 3
+ *    bytes.
+ *
  **************************************************************************
  */
 WORD32 ih264d_process_nal_unit(dec_bit_stream_t *ps_bitstrm,
                             UWORD8 *pu1_nal_unit,
-                            UWORD32 u4_numbytes_in_nal_unit)
+                            UWORD32 u4_numbytes_in_nal_unit,
+                            ih264d_find_zero_run_ft *pf_find_zero_run)
 {
-    UWORD32 u4_num_bytes_in_rbsp;
-    UWORD8 u1_cur_byte;
-    WORD32 i = 0;
-    WORD8 c_count;
-    UWORD32 ui_word;
+    UWORD32 u4_num_bytes, u4_num_words, i;
+    UWORD32 u4_scan_pos, u4_run_start, u4_dst_pos;
     UWORD32 *puc_bitstream_buffer = (UWORD32*)pu1_nal_unit;
     ps_bitstrm->pu4_buffer = puc_bitstream_buffer;
 
-    /*--------------------------------------------------------------------*/
-    /* First Byte of the NAL Unit                                         */
-    /*--------------------------------------------------------------------*/
-
-    ui_word = *pu1_nal_unit++;
+    /* The NAL unit header and the two bytes after it are always read */
+    u4_num_bytes = MAX(u4_numbytes_in_nal_unit, NAL_FIRST_BYTE_SIZE + 2);
 
     /*--------------------------------------------------------------------*/
     /* Convertion of the EBSP to RBSP                                     */
     /* ie Remove the emulation_prevention_byte [equal to 0x03]            */
     /*--------------------------------------------------------------------*/
-    u4_num_bytes_in_rbsp = 0;
-    c_count = 0;
-
-//first iteration
-
-    u1_cur_byte = *pu1_nal_unit++;
-
-    ui_word = ((ui_word << 8) | u1_cur_byte);
-
-    c_count++;
-    if(u1_cur_byte != 0x00)
-        c_count = 0;
-
-//second iteration
-
-    u1_cur_byte = *pu1_nal_unit++;
-
-    ui_word = ((ui_word << 8) | u1_cur_byte);
-    u4_num_bytes_in_rbsp = 2;
-
-    c_count++;
-    if(u1_cur_byte != 0x00)
-        c_count = 0;
-
-    if(u4_numbytes_in_nal_unit > 2)
+    u4_dst_pos = 0;
+    u4_run_start = 0;
+    u4_scan_pos = NAL_FIRST_BYTE_SIZE;
+    while(1)
     {
-        i = ((u4_numbytes_in_nal_unit - 3));
-    }
-
-    for(; i > 8; i -= 4)
-    {
-
-// loop 0
-        u1_cur_byte = *pu1_nal_unit++;
-
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
-        {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
-        }
-
-        ui_word = ((ui_word << 8) | u1_cur_byte);
-        *puc_bitstream_buffer = ui_word;
-        puc_bitstream_buffer++;
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
-
-// loop 1
-        u1_cur_byte = *pu1_nal_unit++;
-
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
-        {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
-        }
-        ui_word = ((ui_word << 8) | u1_cur_byte);
-
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
-
-// loop 2
-        u1_cur_byte = *pu1_nal_unit++;
-
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
-        {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
-        }
-
-        ui_word = ((ui_word << 8) | u1_cur_byte);
+        UWORD32 u4_zero_start, u4_zero_end;
 
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
+        u4_zero_start = pf_find_zero_run(pu1_nal_unit, u4_scan_pos,
+                                         u4_num_bytes);
+        if(u4_zero_start + NUM_OF_ZERO_BYTES_BEFORE_START_CODE >= u4_num_bytes)
+            break;
 
-// loop 3
-        u1_cur_byte = *pu1_nal_unit++;
+        u4_zero_end = u4_zero_start + NUM_OF_ZERO_BYTES_BEFORE_START_CODE;
+        while((u4_zero_end < u4_num_bytes) && (0 == pu1_nal_unit[u4_zero_end]))
+            u4_zero_end++;
+        if(u4_zero_end == u4_num_bytes)
+            break;
 
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
+        if((u4_zero_end - u4_zero_start == NUM_OF_ZERO_BYTES_BEFORE_START_CODE)
+                        && (EMULATION_PREVENTION_BYTE == pu1_nal_unit[u4_zero_end]))
         {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
+            if(u4_dst_pos != u4_run_start)
+            {
+                memmove(pu1_nal_unit + u4_dst_pos, pu1_nal_unit + u4_run_start,
+                        u4_zero_end - u4_run_start);
+            }
+            u4_dst_pos += u4_zero_end - u4_run_start;
+            u4_run_start = u4_zero_end + 1;
         }
 
-        ui_word = ((ui_word << 8) | u1_cur_byte);
-
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
-
-        u4_num_bytes_in_rbsp += 4;
-
+        /* Both a non zero byte and an emulation prevention byte end the run */
+        u4_scan_pos = u4_zero_end + 1;
     }
 
-    for(; i > 0; i--)
+    if(u4_dst_pos != u4_run_start)
     {
-        u1_cur_byte = *pu1_nal_unit++;
-
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
-        {
-            c_count = 0;
-            i--;
-            u1_cur_byte = *pu1_nal_unit++;
-        }
+        memmove(pu1_nal_unit + u4_dst_pos, pu1_nal_unit + u4_run_start,
+                u4_num_bytes - u4_run_start);
+    }
+    u4_num_bytes = u4_dst_pos + u4_num_bytes - u4_run_start;
 
-        ui_word = ((ui_word << 8) | u1_cur_byte);
-        u4_num_bytes_in_rbsp++;
+    /*--------------------------------------------------------------------*/
+    /* Pack the bytes into words, the last word padded with zeros and     */
+    /* followed by a zero word for the bits read ahead                    */
+    /*--------------------------------------------------------------------*/
+    u4_num_words = (u4_num_bytes + 3) >> 2;
+    memset(pu1_nal_unit + u4_num_bytes, 0, (u4_num_words << 2) - u4_num_bytes);
 
-        if((u4_num_bytes_in_rbsp & 0x03) == 0x03)
-        {
-            *puc_bitstream_buffer = ui_word;
-            puc_bitstream_buffer++;
-        }
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
+    for(i = 0; i < u4_num_words; i++)
+    {
+        UWORD8 *pu1_word = pu1_nal_unit + (i << 2);
 
+        puc_bitstream_buffer[i] = ((UWORD32)pu1_word[0] << 24)
+                        | ((UWORD32)pu1_word[1] << 16)
+                        | ((UWORD32)pu1_word[2] << 8) | pu1_word[3];
     }
+    puc_bitstream_buffer[u4_num_words] = 0;
 
-    *puc_bitstream_buffer = (ui_word
-                    << ((3 - (((u4_num_bytes_in_rbsp << 30) >> 30))) << 3));
     ps_bitstrm->u4_ofst = 0;
-    ps_bitstrm->u4_max_ofst = ((u4_num_bytes_in_rbsp + NAL_FIRST_BYTE_SIZE) << 3);
+    ps_bitstrm->u4_max_ofst = (u4_num_bytes << 3);
 
-    return (u4_num_bytes_in_rbsp);
+    return (u4_num_bytes - NAL_FIRST_BYTE_SIZE);
 }
 
 
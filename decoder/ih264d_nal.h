@@ -42,15 +42,44 @@
 #include "ih264_platform_macros.h"
 #include "ih264d_bitstrm.h"
 
+/**
+ * Returns the position of the first zero byte at or after u4_pos that is
+ * followed by another zero byte or by the end of the buffer, u4_max_ofst if
+ * there is none
+ */
+typedef UWORD32 ih264d_find_zero_run_ft(UWORD8 *pu1_buf,
+                                        UWORD32 u4_pos,
+                                        UWORD32 u4_max_ofst);
+
+ih264d_find_zero_run_ft ih264d_find_zero_run;
+ih264d_find_zero_run_ft ih264d_find_zero_run_sse42;
+ih264d_find_zero_run_ft ih264d_find_zero_run_avx2;
+
+WORD32 ih264d_find_length_prefixed_nal(UWORD8 *pu1_buf,
+                                       UWORD32 u4_max_ofst,
+                                       UWORD32 u4_nal_length_size,
+                                       UWORD32 *pu4_length_of_prefix,
+                                       UWORD32 *pu4_next_is_aud);
+
 WORD32 ih264d_process_nal_unit(dec_bit_stream_t *ps_bitstrm,
                             UWORD8 *pu1_nal_unit,
-                            UWORD32 u4_numbytes_in_nal_unit);
+                            UWORD32 u4_numbytes_in_nal_unit,
+                            ih264d_find_zero_run_ft *pf_find_zero_run);
 void ih264d_rbsp_to_sodb(dec_bit_stream_t *ps_bitstrm);
+UWORD32 ih264d_find_rap_offsets(UWORD8 *pu1_buf,
+                                UWORD32 u4_max_ofst,
+                                UWORD32 u4_nal_length_size,
+                                UWORD32 u4_include_i_pics,
+                                UWORD32 *pu4_offsets,
+                                UWORD32 u4_max_offsets,
+                                UWORD32 *pu4_num_offsets,
+                                ih264d_find_zero_run_ft *pf_find_zero_run);
 WORD32 ih264d_find_start_code(UWORD8 *pu1_buf,
                               UWORD32 u4_cur_pos,
                               UWORD32 u4_max_ofst,
                               UWORD32 *pu4_length_of_start_code,
-                              UWORD32 *pu4_next_is_aud);
+                              UWORD32 *pu4_next_is_aud,
+                              ih264d_find_zero_run_ft *pf_find_zero_run);
 
 
 #endif /* _IH264D_NAL_H_ */
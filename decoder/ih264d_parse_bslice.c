@@ -109,22 +109,11 @@ WORD32 ih264d_parse_bmb_non_direct_cavlc(dec_struct_t * ps_dec,
 
 //Inlined ih264d_uev
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz;
-
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
+            UWORD32 u4_word;
+
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            ui_sub_mb_mode = ((1 << u4_ldz) + u4_word - 1);
+            ui_sub_mb_mode = u4_word;
 //Inlined ih264d_uev
 
             if(ui_sub_mb_mode > 12)
@@ -308,62 +297,18 @@ WORD32 ih264d_parse_bmb_non_direct_cavlc(dec_struct_t * ps_dec,
 //inlining ih264d_sev
                         {
                             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-                            UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-                            /***************************************************************/
-                            /* Find leading zeros in next 32 bits                          */
-                            /***************************************************************/
-                            NEXTBITS_32(u4_word, u4_bitstream_offset,
-                                        pu4_bitstrm_buf);
-                            u4_ldz = CLZ(u4_word);
-
-                            /* Flush the ps_bitstrm */
-                            u4_bitstream_offset += (u4_ldz + 1);
-
-                            /* Read the suffix from the ps_bitstrm */
-                            u4_word = 0;
-                            if(u4_ldz)
-                                GETBITS(u4_word, u4_bitstream_offset,
-                                        pu4_bitstrm_buf, u4_ldz);
 
+                            SEV_64(i2_mvx, u4_bitstream_offset, pu4_bitstrm_buf);
                             *pu4_bitstrm_ofst = u4_bitstream_offset;
-                            u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-                            if(u4_word & 0x1)
-                                i2_mvx = (-(WORD32)u4_abs_val);
-                            else
-                                i2_mvx = (u4_abs_val);
                         }
 //inlinined ih264d_sev
 
 //inlining ih264d_sev
                         {
                             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-                            UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-                            /***************************************************************/
-                            /* Find leading zeros in next 32 bits                          */
-                            /***************************************************************/
-                            NEXTBITS_32(u4_word, u4_bitstream_offset,
-                                        pu4_bitstrm_buf);
-                            u4_ldz = CLZ(u4_word);
-
-                            /* Flush the ps_bitstrm */
-                            u4_bitstream_offset += (u4_ldz + 1);
-
-                            /* Read the suffix from the ps_bitstrm */
-                            u4_word = 0;
-                            if(u4_ldz)
-                                GETBITS(u4_word, u4_bitstream_offset,
-                                        pu4_bitstrm_buf, u4_ldz);
 
+                            SEV_64(i2_mvy, u4_bitstream_offset, pu4_bitstrm_buf);
                             *pu4_bitstrm_ofst = u4_bitstream_offset;
-                            u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-                            if(u4_word & 0x1)
-                                i2_mvy = (-(WORD32)u4_abs_val);
-                            else
-                                i2_mvy = (u4_abs_val);
                         }
 //inlinined ih264d_sev
 
@@ -791,21 +736,11 @@ WORD32 ih264d_parse_bmb_cavlc(dec_struct_t * ps_dec,
         const UWORD8 * puc_CbpInter = gau1_ih264d_cbp_inter;
 //Inlined ih264d_uev
         UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-        UWORD32 u4_word, u4_ldz;
-
-        /***************************************************************/
-        /* Find leading zeros in next 32 bits                          */
-        /***************************************************************/
-        NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-        u4_ldz = CLZ(u4_word);
-        /* Flush the ps_bitstrm */
-        u4_bitstream_offset += (u4_ldz + 1);
-        /* Read the suffix from the ps_bitstrm */
-        u4_word = 0;
-        if(u4_ldz)
-            GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf, u4_ldz);
+        UWORD32 u4_word;
+
+        UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
         *pu4_bitstrm_ofst = u4_bitstream_offset;
-        u4_cbp = ((1 << u4_ldz) + u4_word - 1);
+        u4_cbp = u4_word;
 //Inlined ih264d_uev
         if(u4_cbp > 47)
             return ERROR_CBP;
@@ -832,29 +767,9 @@ WORD32 ih264d_parse_bmb_cavlc(dec_struct_t * ps_dec,
 //inlining ih264d_sev
 
         UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-        UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-        /***************************************************************/
-        /* Find leading zeros in next 32 bits                          */
-        /***************************************************************/
-        NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-        u4_ldz = CLZ(u4_word);
-
-        /* Flush the ps_bitstrm */
-        u4_bitstream_offset += (u4_ldz + 1);
-
-        /* Read the suffix from the ps_bitstrm */
-        u4_word = 0;
-        if(u4_ldz)
-            GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf, u4_ldz);
 
+        SEV_64(i_temp, u4_bitstream_offset, pu4_bitstrm_buf);
         *pu4_bitstrm_ofst = u4_bitstream_offset;
-        u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-        if(u4_word & 0x1)
-            i_temp = (-(WORD32)u4_abs_val);
-        else
-            i_temp = (u4_abs_val);
 
         if(i_temp < -26 || i_temp > 25)
             return ERROR_INV_RANGE_QP_T;
@@ -111,7 +111,6 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
             u4_int_range_lps = u4_int_range_lps << (23 - u4_clz);
             u4_code_int_range = u4_code_int_range - u4_int_range_lps;
             u4_symbol = ((u1_mps_state >> 6) & 0x1);
-            u1_mps_state = (table_lookup >> 8) & 0x7F;
 
             CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                          u4_int_range_lps, u1_mps_state, table_lookup)
@@ -189,7 +188,6 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
                     u4_int_range_lps = u4_int_range_lps << (23 - u4_clz);
                     u4_code_int_range = u4_code_int_range - u4_int_range_lps;
                     u4_symbol = ((u1_mps_state >> 6) & 0x1);
-                    u1_mps_state = (table_lookup >> 8) & 0x7F;
 
                     CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst,
                                  u4_symbol, u4_int_range_lps, u1_mps_state,
@@ -255,7 +253,6 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
                         u4_code_int_range = u4_code_int_range
                                         - u4_int_range_lps;
                         u4_symbol = ((u1_mps_state >> 6) & 0x1);
-                        u1_mps_state = (table_lookup >> 8) & 0x7F;
 
                         CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst,
                                      u4_symbol, u4_int_range_lps,
@@ -356,7 +353,6 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
                                 u4_code_int_range = u4_code_int_range
                                                 - u4_int_range_lps;
                                 u4_symbol = ((u1_mps_state >> 6) & 0x1);
-                                u1_mps_state = (table_lookup >> 8) & 0x7F;
 
                                 CHECK_IF_LPS(u4_code_int_range,
                                              u4_code_int_val_ofst, u4_symbol,
@@ -420,19 +416,8 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
                             {
                                 bits_to_flush++;
 
-                                u4_code_int_range = u4_code_int_range >> 1;
-
-                                if(u4_code_int_val_ofst >= u4_code_int_range)
-                                {
-                                    /* S=1 */
-                                    uc_bin = 1;
-                                    u4_code_int_val_ofst -= u4_code_int_range;
-                                }
-                                else
-                                {
-                                    /* S=0 */
-                                    uc_bin = 0;
-                                }
+                                DECODE_BYPASS_BIN_MACRO(uc_bin, u4_code_int_range,
+                                                        u4_code_int_val_ofst)
 
                                 INC_BIN_COUNT(
                                                 ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
@@ -477,21 +462,8 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
                                 {
                                     bits_to_flush++;
 
-                                    u4_code_int_range = u4_code_int_range >> 1;
-
-                                    if(u4_code_int_val_ofst
-                                                    >= u4_code_int_range)
-                                    {
-                                        /* S=1 */
-                                        uc_bin = 1;
-                                        u4_code_int_val_ofst -=
-                                                        u4_code_int_range;
-                                    }
-                                    else
-                                    {
-                                        /* S=0 */
-                                        uc_bin = 0;
-                                    }
+                                    DECODE_BYPASS_BIN_MACRO(uc_bin, u4_code_int_range,
+                                                            u4_code_int_val_ofst)
 
                                     INC_BIN_COUNT(
                                                     ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
@@ -533,14 +505,11 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
                     /* encode coeff_sign_flag[i] */
 
                     {
-                        u4_code_int_range = u4_code_int_range >> 1;
+                        UWORD32 u4_sign;
 
-                        if(u4_code_int_val_ofst >= (u4_code_int_range))
-                        {
-                            /* S=1 */
-                            u4_code_int_val_ofst -= u4_code_int_range;
-                            i2_abs_lvl = (-i2_abs_lvl);
-                        }
+                        DECODE_BYPASS_BIN_MACRO(u4_sign, u4_code_int_range,
+                                                u4_code_int_val_ofst)
+                        i2_abs_lvl = u4_sign ? -i2_abs_lvl : i2_abs_lvl;
 
                     }
                     num_sig_coeffs--;
@@ -679,7 +648,6 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
                     u4_int_range_lps = u4_int_range_lps << (23 - u4_clz);
                     u4_code_int_range = u4_code_int_range - u4_int_range_lps;
                     u4_symbol = ((u1_mps_state >> 6) & 0x1);
-                    u1_mps_state = (table_lookup >> 8) & 0x7F;
 
                     CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst,
                                  u4_symbol, u4_int_range_lps, u1_mps_state,
@@ -740,7 +708,6 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
                         u4_code_int_range = u4_code_int_range
                                         - u4_int_range_lps;
                         u4_symbol = ((u1_mps_state >> 6) & 0x1);
-                        u1_mps_state = (table_lookup >> 8) & 0x7F;
 
                         CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst,
                                      u4_symbol, u4_int_range_lps,
@@ -829,7 +796,6 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
                                 u4_code_int_range = u4_code_int_range
                                                 - u4_int_range_lps;
                                 u4_symbol = ((u1_mps_state >> 6) & 0x1);
-                                u1_mps_state = (table_lookup >> 8) & 0x7F;
 
                                 CHECK_IF_LPS(u4_code_int_range,
                                              u4_code_int_val_ofst, u4_symbol,
@@ -887,19 +853,8 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
                             {
                                 bits_to_flush++;
 
-                                u4_code_int_range = u4_code_int_range >> 1;
-
-                                if(u4_code_int_val_ofst >= u4_code_int_range)
-                                {
-                                    /* S=1 */
-                                    uc_bin = 1;
-                                    u4_code_int_val_ofst -= u4_code_int_range;
-                                }
-                                else
-                                {
-                                    /* S=0 */
-                                    uc_bin = 0;
-                                }
+                                DECODE_BYPASS_BIN_MACRO(uc_bin, u4_code_int_range,
+                                                        u4_code_int_val_ofst)
 
                             }
                             while(uc_bin && (bits_to_flush < CABAC_BITS_TO_READ));
@@ -939,21 +894,8 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
                                 {
                                     bits_to_flush++;
 
-                                    u4_code_int_range = u4_code_int_range >> 1;
-
-                                    if(u4_code_int_val_ofst
-                                                    >= u4_code_int_range)
-                                    {
-                                        /* S=1 */
-                                        uc_bin = 1;
-                                        u4_code_int_val_ofst -=
-                                                        u4_code_int_range;
-                                    }
-                                    else
-                                    {
-                                        /* S=0 */
-                                        uc_bin = 0;
-                                    }
+                                    DECODE_BYPASS_BIN_MACRO(uc_bin, u4_code_int_range,
+                                                            u4_code_int_val_ofst)
 
                                     ui_bins = ((ui_bins << 1) | uc_bin);
 
@@ -993,14 +935,11 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
                     /* encode coeff_sign_flag[i] */
 
                     {
-                        u4_code_int_range = u4_code_int_range >> 1;
+                        UWORD32 u4_sign;
 
-                        if(u4_code_int_val_ofst >= (u4_code_int_range))
-                        {
-                            /* S=1 */
-                            u4_code_int_val_ofst -= u4_code_int_range;
-                            i2_abs_lvl = (-i2_abs_lvl);
-                        }
+                        DECODE_BYPASS_BIN_MACRO(u4_sign, u4_code_int_range,
+                                                u4_code_int_val_ofst)
+                        i2_abs_lvl = u4_sign ? -i2_abs_lvl : i2_abs_lvl;
                     }
 
                     *pi2_coeff_data++ = i2_abs_lvl;
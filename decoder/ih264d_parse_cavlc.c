@@ -77,21 +77,11 @@ void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
 UWORD32 ih264d_uev(UWORD32 *pu4_bitstrm_ofst, UWORD32 *pu4_bitstrm_buf)
 {
     UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-    UWORD32 u4_word, u4_ldz;
+    UWORD32 u4_code_num;
 
-    /***************************************************************/
-    /* Find leading zeros in next 32 bits                          */
-    /***************************************************************/
-    NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-    u4_ldz = CLZ(u4_word);
-    /* Flush the ps_bitstrm */
-    u4_bitstream_offset += (u4_ldz + 1);
-    /* Read the suffix from the ps_bitstrm */
-    u4_word = 0;
-    if(u4_ldz)
-        GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf, u4_ldz);
+    UEV_64(u4_code_num, u4_bitstream_offset, pu4_bitstrm_buf);
     *pu4_bitstrm_ofst = u4_bitstream_offset;
-    return ((1 << u4_ldz) + u4_word - 1);
+    return u4_code_num;
 }
 
 /*****************************************************************************/
@@ -122,29 +112,11 @@ UWORD32 ih264d_uev(UWORD32 *pu4_bitstrm_ofst, UWORD32 *pu4_bitstrm_buf)
 WORD32 ih264d_sev(UWORD32 *pu4_bitstrm_ofst, UWORD32 *pu4_bitstrm_buf)
 {
     UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-    UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-    /***************************************************************/
-    /* Find leading zeros in next 32 bits                          */
-    /***************************************************************/
-    NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-    u4_ldz = CLZ(u4_word);
-
-    /* Flush the ps_bitstrm */
-    u4_bitstream_offset += (u4_ldz + 1);
-
-    /* Read the suffix from the ps_bitstrm */
-    u4_word = 0;
-    if(u4_ldz)
-        GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf, u4_ldz);
+    WORD32 i4_val;
 
+    SEV_64(i4_val, u4_bitstream_offset, pu4_bitstrm_buf);
     *pu4_bitstrm_ofst = u4_bitstream_offset;
-    u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-    if(u4_word & 0x1)
-        return (-(WORD32)u4_abs_val);
-    else
-        return (u4_abs_val);
+    return i4_val;
 }
 
 /*****************************************************************************/
@@ -542,29 +514,42 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_2to10(UWORD32 u4_isdc,
         /*********************************************************/
         while(i >= 0)
         {
+            UWORD32 u4_word;
 
             /***************************************************************/
             /* Find leading zeros in next 32 bits                          */
             /***************************************************************/
-            FIND_ONE_IN_STREAM_32(u4_lev_prefix, u4_bitstream_offset,
-                                  pu4_bitstrm_buf);
-
-            u4_lev_suffix_size =
-                            (15 <= u4_lev_prefix) ?
-                                            (u4_lev_prefix - 3) : u4_suffix_len;
+            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
+            u4_lev_prefix = CLZ(u4_word);
 
             /*********************************************************/
             /* Compute level code using prefix and suffix            */
             /*********************************************************/
-            GETBITS(u4_lev_suffix, u4_bitstream_offset, pu4_bitstrm_buf,
-                    u4_lev_suffix_size);
-            u2_lev_code = (MIN(15,u4_lev_prefix) << u4_suffix_len)
-                            + u4_lev_suffix;
-
-            //HP_LEVEL_PREFIX
-            if(16 <= u4_lev_prefix)
+            if(15 > u4_lev_prefix)
             {
-                u2_lev_code += ((1 << (u4_lev_prefix - 3)) - 4096);
+                /*****************************************************/
+                /* Suffix of at most 6 bits is in the same window    */
+                /*****************************************************/
+                u4_lev_suffix = (u4_word << u4_lev_prefix << 1)
+                                >> (INT_IN_BITS - u4_suffix_len);
+                FLUSHBITS(u4_bitstream_offset,
+                          (u4_lev_prefix + 1 + u4_suffix_len));
+                u2_lev_code = (u4_lev_prefix << u4_suffix_len)
+                                + u4_lev_suffix;
+            }
+            else
+            {
+                FLUSHBITS(u4_bitstream_offset, (u4_lev_prefix + 1));
+                u4_lev_suffix_size = u4_lev_prefix - 3;
+                GETBITS(u4_lev_suffix, u4_bitstream_offset, pu4_bitstrm_buf,
+                        u4_lev_suffix_size);
+                u2_lev_code = (15 << u4_suffix_len) + u4_lev_suffix;
+
+                //HP_LEVEL_PREFIX
+                if(16 <= u4_lev_prefix)
+                {
+                    u2_lev_code += ((1 << (u4_lev_prefix - 3)) - 4096);
+                }
             }
             u2_abs_value = (u2_lev_code + 2) >> 1;
 
@@ -615,29 +600,47 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_2to10(UWORD32 u4_isdc,
         WORD32 k;
         WORD32 u4_scan_pos = u4_total_coeff + u4_total_zeroes - 1 + u4_isdc;
         WORD32 u4_zeroes_left = u4_total_zeroes;
+        UWORD32 u4_window, u4_window_used;
         k = u4_total_coeff - 1;
 
+        /**************************************************************/
+        /* The runs are decoded from a 32 bit window, which is        */
+        /* refilled only when the next code may not fit in the bits   */
+        /* left in it                                                 */
+        /**************************************************************/
+        NEXTBITS_32(u4_window, u4_bitstream_offset, pu4_bitstrm_buf);
+        u4_window_used = 0;
+
         /**************************************************************/
         /* Decoding Runs Begin for zeros left > 6                     */
         /**************************************************************/
         while((u4_zeroes_left > 6) && k)
         {
-            UWORD32 u4_code;
+            UWORD32 u4_code, u4_len;
 
-            NEXTBITS(u4_code, u4_bitstream_offset, pu4_bitstrm_buf, 3);
+            /* Codes are at most 11 bits long */
+            if(u4_window_used > (INT_IN_BITS - 11))
+            {
+                FLUSHBITS(u4_bitstream_offset, u4_window_used);
+                NEXTBITS_32(u4_window, u4_bitstream_offset, pu4_bitstrm_buf);
+                u4_window_used = 0;
+            }
+
+            u4_code = u4_window >> (INT_IN_BITS - 3);
 
             if(u4_code != 0)
             {
-                FLUSHBITS(u4_bitstream_offset, 3);
+                u4_len = 3;
                 u4_run = (7 - u4_code);
             }
             else
             {
-
-                FIND_ONE_IN_STREAM_LEN(u4_code, u4_bitstream_offset,
-                                       pu4_bitstrm_buf, 11);
+                u4_code = MIN(CLZ(u4_window), 11);
+                u4_len = (u4_code < 11) ? (u4_code + 1) : 11;
                 u4_run = (4 + u4_code);
             }
+            u4_window <<= u4_len;
+            u4_window_used += u4_len;
 
             SET_BIT(ps_tu_4x4->u2_sig_coeff_map, u4_scan_pos);
             *pi2_coeff_data++ = i2_level_arr[k--];
@@ -655,12 +658,21 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_2to10(UWORD32 u4_isdc,
         while((u4_zeroes_left > 0) && k)
         {
             UWORD32 u4_code;
-            NEXTBITS(u4_code, u4_bitstream_offset, pu4_bitstrm_buf, 3);
 
+            /* Codes are at most 3 bits long */
+            if(u4_window_used > (INT_IN_BITS - 3))
+            {
+                FLUSHBITS(u4_bitstream_offset, u4_window_used);
+                NEXTBITS_32(u4_window, u4_bitstream_offset, pu4_bitstrm_buf);
+                u4_window_used = 0;
+            }
+
+            u4_code = u4_window >> (INT_IN_BITS - 3);
             u4_code = pu1_table_runbefore[u4_code + (u4_zeroes_left << 3)];
             u4_run = u4_code >> 2;
 
-            FLUSHBITS(u4_bitstream_offset, (u4_code & 0x03));
+            u4_window <<= (u4_code & 0x03);
+            u4_window_used += (u4_code & 0x03);
 
             SET_BIT(ps_tu_4x4->u2_sig_coeff_map, u4_scan_pos);
             *pi2_coeff_data++ = i2_level_arr[k--];
@@ -669,6 +681,7 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_2to10(UWORD32 u4_isdc,
         }
         if (u4_zeroes_left < 0 || u4_scan_pos < 0)
             return -1;
+        FLUSHBITS(u4_bitstream_offset, u4_window_used);
         /**************************************************************/
         /* Decoding Runs End                                          */
         /**************************************************************/
@@ -859,29 +872,42 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_11to16(UWORD32 u4_isdc,
         /*********************************************************/
         while(i >= 0)
         {
+            UWORD32 u4_word;
 
             /***************************************************************/
             /* Find leading zeros in next 32 bits                          */
             /***************************************************************/
-            FIND_ONE_IN_STREAM_32(u4_lev_prefix, u4_bitstream_offset,
-                                  pu4_bitstrm_buf);
-
-            u4_lev_suffix_size =
-                            (15 <= u4_lev_prefix) ?
-                                            (u4_lev_prefix - 3) : u4_suffix_len;
+            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
+            u4_lev_prefix = CLZ(u4_word);
 
             /*********************************************************/
             /* Compute level code using prefix and suffix            */
             /*********************************************************/
-            GETBITS(u4_lev_suffix, u4_bitstream_offset, pu4_bitstrm_buf,
-                    u4_lev_suffix_size);
-            u2_lev_code = (MIN(15,u4_lev_prefix) << u4_suffix_len)
-                            + u4_lev_suffix;
-
-            //HP_LEVEL_PREFIX
-            if(16 <= u4_lev_prefix)
+            if(15 > u4_lev_prefix)
             {
-                u2_lev_code += ((1 << (u4_lev_prefix - 3)) - 4096);
+                /*****************************************************/
+                /* Suffix of at most 6 bits is in the same window    */
+                /*****************************************************/
+                u4_lev_suffix = (u4_word << u4_lev_prefix << 1)
+                                >> (INT_IN_BITS - u4_suffix_len);
+                FLUSHBITS(u4_bitstream_offset,
+                          (u4_lev_prefix + 1 + u4_suffix_len));
+                u2_lev_code = (u4_lev_prefix << u4_suffix_len)
+                                + u4_lev_suffix;
+            }
+            else
+            {
+                FLUSHBITS(u4_bitstream_offset, (u4_lev_prefix + 1));
+                u4_lev_suffix_size = u4_lev_prefix - 3;
+                GETBITS(u4_lev_suffix, u4_bitstream_offset, pu4_bitstrm_buf,
+                        u4_lev_suffix_size);
+                u2_lev_code = (15 << u4_suffix_len) + u4_lev_suffix;
+
+                //HP_LEVEL_PREFIX
+                if(16 <= u4_lev_prefix)
+                {
+                    u2_lev_code += ((1 << (u4_lev_prefix - 3)) - 4096);
+                }
             }
             u2_abs_value = (u2_lev_code + 2) >> 1;
 
@@ -932,8 +958,17 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_11to16(UWORD32 u4_isdc,
         WORD32 k;
         WORD32 u4_scan_pos = u4_total_coeff + u4_total_zeroes - 1 + u4_isdc;
         WORD32 u4_zeroes_left = u4_total_zeroes;
+        UWORD32 u4_window, u4_window_used;
         k = u4_total_coeff - 1;
 
+        /**************************************************************/
+        /* The runs are decoded from a 32 bit window, which is        */
+        /* refilled only when the next code may not fit in the bits   */
+        /* left in it                                                 */
+        /**************************************************************/
+        NEXTBITS_32(u4_window, u4_bitstream_offset, pu4_bitstrm_buf);
+        u4_window_used = 0;
+
         /**************************************************************/
         /* Decoding Runs for 0 < zeros left <=6                       */
         /**************************************************************/
@@ -941,12 +976,22 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_11to16(UWORD32 u4_isdc,
         while((u4_zeroes_left > 0) && k)
         {
             UWORD32 u4_code;
-            NEXTBITS(u4_code, u4_bitstream_offset, pu4_bitstrm_buf, 3);
 
+            /* Codes are at most 3 bits long */
+            if(u4_window_used > (INT_IN_BITS - 3))
+            {
+                FLUSHBITS(u4_bitstream_offset, u4_window_used);
+                NEXTBITS_32(u4_window, u4_bitstream_offset, pu4_bitstrm_buf);
+                u4_window_used = 0;
+            }
+
+            u4_code = u4_window >> (INT_IN_BITS - 3);
             u4_code = pu1_table_runbefore[u4_code + (u4_zeroes_left << 3)];
             u4_run = u4_code >> 2;
 
-            FLUSHBITS(u4_bitstream_offset, (u4_code & 0x03));
+            u4_window <<= (u4_code & 0x03);
+            u4_window_used += (u4_code & 0x03);
+
             SET_BIT(ps_tu_4x4->u2_sig_coeff_map, u4_scan_pos);
             *pi2_coeff_data++ = i2_level_arr[k--];
             u4_zeroes_left -= (WORD32)u4_run;
@@ -954,6 +999,7 @@ WORD32 ih264d_cavlc_4x4res_block_totalcoeff_11to16(UWORD32 u4_isdc,
         }
         if (u4_zeroes_left < 0 || u4_scan_pos < 0)
           return -1;
+        FLUSHBITS(u4_bitstream_offset, u4_window_used);
 
         /**************************************************************/
         /* Decoding Runs End                                          */
@@ -1109,29 +1155,42 @@ void ih264d_rest_of_residual_cav_chroma_dc_block(UWORD32 u4_total_coeff_trail_on
         /*********************************************************/
         while(i >= 0)
         {
+            UWORD32 u4_word;
 
             /***************************************************************/
             /* Find leading zeros in next 32 bits                          */
             /***************************************************************/
-            FIND_ONE_IN_STREAM_32(u4_lev_prefix, u4_bitstream_offset,
-                                  pu4_bitstrm_buf);
-
-            u4_lev_suffix_size =
-                            (15 <= u4_lev_prefix) ?
-                                            (u4_lev_prefix - 3) : u4_suffix_len;
+            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
+            u4_lev_prefix = CLZ(u4_word);
 
             /*********************************************************/
             /* Compute level code using prefix and suffix            */
             /*********************************************************/
-            GETBITS(u4_lev_suffix, u4_bitstream_offset, pu4_bitstrm_buf,
-                    u4_lev_suffix_size);
-            u2_lev_code = (MIN(u4_lev_prefix,15) << u4_suffix_len)
-                            + u4_lev_suffix;
-
-            //HP_LEVEL_PREFIX
-            if(16 <= u4_lev_prefix)
+            if(15 > u4_lev_prefix)
             {
-                u2_lev_code += ((1 << (u4_lev_prefix - 3)) - 4096);
+                /*****************************************************/
+                /* Suffix of at most 6 bits is in the same window    */
+                /*****************************************************/
+                u4_lev_suffix = (u4_word << u4_lev_prefix << 1)
+                                >> (INT_IN_BITS - u4_suffix_len);
+                FLUSHBITS(u4_bitstream_offset,
+                          (u4_lev_prefix + 1 + u4_suffix_len));
+                u2_lev_code = (u4_lev_prefix << u4_suffix_len)
+                                + u4_lev_suffix;
+            }
+            else
+            {
+                FLUSHBITS(u4_bitstream_offset, (u4_lev_prefix + 1));
+                u4_lev_suffix_size = u4_lev_prefix - 3;
+                GETBITS(u4_lev_suffix, u4_bitstream_offset, pu4_bitstrm_buf,
+                        u4_lev_suffix_size);
+                u2_lev_code = (15 << u4_suffix_len) + u4_lev_suffix;
+
+                //HP_LEVEL_PREFIX
+                if(16 <= u4_lev_prefix)
+                {
+                    u2_lev_code += ((1 << (u4_lev_prefix - 3)) - 4096);
+                }
             }
             u2_abs_value = (u2_lev_code + 2) >> 1;
 
@@ -1239,7 +1298,7 @@ WORD32 ih264d_cavlc_parse4x4coeff_n0to7(WORD16 *pi2_coeff_block,
     dec_bit_stream_t *ps_bitstrm = ps_dec->ps_bitstrm;
     UWORD32 *pu4_bitstrm_buf = ps_bitstrm->pu4_buffer;
     UWORD32 u4_bitstream_offset = ps_bitstrm->u4_ofst;
-    UWORD32 u4_code, u4_index, u4_ldz;
+    UWORD32 u4_code, u4_index, u4_ldz, u4_word;
     const UWORD16 *pu2_code = (const UWORD16*)gau2_ih264d_code_gx;
     const UWORD16 *pu2_offset_num_vlc =
                     (const UWORD16 *)gau2_ih264d_offset_num_vlc_tab;
@@ -1248,8 +1307,19 @@ WORD32 ih264d_cavlc_parse4x4coeff_n0to7(WORD16 *pi2_coeff_block,
 
     UNUSED(pi2_coeff_block);
     *pu4_total_coeff = 0;
-    FIND_ONE_IN_STREAM_32(u4_ldz, u4_bitstream_offset, pu4_bitstrm_buf);
-    NEXTBITS(u4_index, u4_bitstream_offset, pu4_bitstrm_buf, 3);
+
+    /**************************************************************/
+    /* Leading zeros and the 3 bits following them index the      */
+    /* coeff_token table. Both are read from one 32 bit window,   */
+    /* except for invalid codes of more than 28 leading zeros     */
+    /**************************************************************/
+    NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
+    u4_ldz = CLZ(u4_word);
+    FLUSHBITS(u4_bitstream_offset, (u4_ldz + 1));
+    if(u4_ldz <= (INT_IN_BITS - 4))
+        u4_index = (u4_word << u4_ldz << 1) >> (INT_IN_BITS - 3);
+    else
+        NEXTBITS(u4_index, u4_bitstream_offset, pu4_bitstrm_buf, 3);
     u4_index += (u4_ldz << 3);
     u4_index += u4_offset_num_vlc;
 
@@ -1547,21 +1617,11 @@ WORD32 ih264d_parse_pmb_ref_index_cavlc(UWORD32 u4_num_part, /* Number of partit
         UWORD32 u4_ref_idx;
 //Inlined ih264d_uev
         UWORD32 u4_bitstream_offset = *pu4_bitstream_off;
-        UWORD32 u4_word, u4_ldz;
+        UWORD32 u4_word;
 
-        /***************************************************************/
-        /* Find leading zeros in next 32 bits                          */
-        /***************************************************************/
-        NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-        u4_ldz = CLZ(u4_word);
-        /* Flush the ps_bitstrm */
-        u4_bitstream_offset += (u4_ldz + 1);
-        /* Read the suffix from the ps_bitstrm */
-        u4_word = 0;
-        if(u4_ldz)
-            GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf, u4_ldz);
+        UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
         *pu4_bitstream_off = u4_bitstream_offset;
-        u4_ref_idx = ((1 << u4_ldz) + u4_word - 1);
+        u4_ref_idx = u4_word;
 //Inlined ih264d_uev
 
         if(u4_ref_idx > u4_num_ref_idx_active_minus1)
@@ -1660,21 +1720,11 @@ WORD32 ih264d_parse_bmb_ref_index_cavlc(UWORD32 u4_num_part, /* Number of partit
             UWORD32 u4_ref_idx;
 //inlining ih264d_uev
             UWORD32 u4_bitstream_offset = *pu4_bitstream_off;
-            UWORD32 u4_word, u4_ldz;
+            UWORD32 u4_word;
 
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf, u4_ldz);
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstream_off = u4_bitstream_offset;
-            u4_ref_idx = ((1 << u4_ldz) + u4_word - 1);
+            u4_ref_idx = u4_word;
 //inlining ih264d_uev
             if(u4_ref_idx > u4_num_ref_idx_active_minus1)
                 return ERROR_REF_IDX;
@@ -1265,7 +1265,7 @@ WORD32 ih264d_parse_nal_unit(iv_obj_t *dec_hdl,
         {
             ps_dec_op->u4_frame_decoded_flag = 0;
             ih264d_process_nal_unit(ps_dec->ps_bitstrm, pu1_buf,
-                                    u4_length);
+                                    u4_length, ps_dec->pf_find_zero_run);
 
             SWITCHOFFTRACE;
             u1_first_byte = ih264d_get_bits_h264(ps_bitstrm, 8);
@@ -159,24 +159,11 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t * ps_dec,
 //Inlined ih264d_uev
         {
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz, u4_temp;
+            UWORD32 u4_word, u4_temp;
 
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-            {
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
-            }
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            u4_temp = ((1 << u4_ldz) + u4_word - 1);
+            u4_temp = u4_word;
             if(u4_temp > 3)
             {
                 return ERROR_CHROMA_PRED_MODE;
@@ -189,24 +176,11 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t * ps_dec,
         /*--------------------------------------------------------------------*/
         {
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz;
+            UWORD32 u4_word;
 
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-            {
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
-            }
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            u4_cbp = ((1 << u4_ldz) + u4_word - 1);
+            u4_cbp = u4_word;
         }
         if(u4_cbp > 47)
         {
@@ -223,36 +197,9 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t * ps_dec,
         if(ps_cur_mb_info->u1_cbp)
         {
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-            {
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
-            }
 
+            SEV_64(i4_delta_qp, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-            if(u4_word & 0x1)
-            {
-                i4_delta_qp = (-(WORD32)u4_abs_val);
-            }
-            else
-            {
-                i4_delta_qp = (u4_abs_val);
-            }
 
             if((i4_delta_qp < -26) || (i4_delta_qp > 25))
             {
@@ -278,24 +225,11 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t * ps_dec,
         /*-------------------------------------------------------------------*/
         {
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz;
+            UWORD32 u4_word;
 
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-            {
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
-            }
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            u4_temp = ((1 << u4_ldz) + u4_word - 1);
+            u4_temp = u4_word;
 
 //Inlined ih264d_uev
 
@@ -317,30 +251,9 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t * ps_dec,
         /*-------------------------------------------------------------------*/
         {
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
 
+            SEV_64(i4_delta_qp, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-            if(u4_word & 0x1)
-                i4_delta_qp = (-(WORD32)u4_abs_val);
-            else
-                i4_delta_qp = (u4_abs_val);
 
             if((i4_delta_qp < -26) || (i4_delta_qp > 25))
                 return ERROR_INV_RANGE_QP_T;
@@ -791,6 +704,7 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
         }
 
         ps_cur_mb_info = ps_dec->ps_nmb_info + u4_num_mbs;
+        ps_cur_mb_info->pv_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
         ps_dec->u4_num_mbs_cur_nmb = u4_num_mbs;
         ps_dec->u4_num_pmbair = (u4_num_mbs >> u1_mbaff);
 
@@ -820,22 +734,11 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
 //Inlined ih264d_uev
         {
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz, u4_temp;
+            UWORD32 u4_word, u4_temp;
 
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            u4_temp = ((1 << u4_ldz) + u4_word - 1);
+            u4_temp = u4_word;
             if(u4_temp > 25)
                 return ERROR_MB_TYPE;
             u1_mb_type = u4_temp;
@@ -1033,6 +936,7 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
             UWORD8 u1_mb_type;
 
             ps_cur_mb_info = ps_dec->ps_nmb_info + u4_num_mbs;
+            ps_cur_mb_info->pv_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
             ps_dec->u4_num_mbs_cur_nmb = u4_num_mbs;
             ps_dec->u4_num_pmbair = (u4_num_mbs >> u1_mbaff);
 
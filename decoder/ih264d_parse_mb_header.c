@@ -849,8 +849,6 @@ UWORD32 ih264d_parse_ctx_cbp_cabac(struct _DecStruct * ps_dec)
         u4_symbol = ((u1_mps_state >> 6) & 0x1);
 
         /*if mps*/
-        u1_mps_state = (table_lookup >> 8) & 0x7F;
-
         CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                      u4_int_range_lps, u1_mps_state, table_lookup)
 
@@ -889,8 +887,6 @@ UWORD32 ih264d_parse_ctx_cbp_cabac(struct _DecStruct * ps_dec)
         u4_symbol = ((u1_mps_state >> 6) & 0x1);
 
         /*if mps*/
-        u1_mps_state = (table_lookup >> 8) & 0x7F;
-
         CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                      u4_int_range_lps, u1_mps_state, table_lookup)
 
@@ -929,8 +925,6 @@ UWORD32 ih264d_parse_ctx_cbp_cabac(struct _DecStruct * ps_dec)
         u4_symbol = ((u1_mps_state >> 6) & 0x1);
 
         /*if mps*/
-        u1_mps_state = (table_lookup >> 8) & 0x7F;
-
         CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                      u4_int_range_lps, u1_mps_state, table_lookup)
 
@@ -969,8 +963,6 @@ UWORD32 ih264d_parse_ctx_cbp_cabac(struct _DecStruct * ps_dec)
         u4_symbol = ((u1_mps_state >> 6) & 0x1);
 
         /*if mps*/
-        u1_mps_state = (table_lookup >> 8) & 0x7F;
-
         CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                      u4_int_range_lps, u1_mps_state, table_lookup)
 
@@ -1057,8 +1049,6 @@ UWORD32 ih264d_parse_ctx_cbp_cabac(struct _DecStruct * ps_dec)
                     u4_symbol = ((u1_mps_state >> 6) & 0x1);
 
                     /*if mps*/
-                    u1_mps_state = (table_lookup >> 8) & 0x7F;
-
                     CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst,
                                  u4_symbol, u4_int_range_lps, u1_mps_state,
                                  table_lookup)
@@ -1322,6 +1312,7 @@ WORD16 ih264d_parse_mvd_cabac(dec_bit_stream_t * ps_bitstrm,
     else
     {
         UWORD32 u4_code_int_val_ofst, u4_code_int_range;
+        UWORD32 u4_sign;
 
         u4_code_int_val_ofst = ps_cab_env->u4_code_int_val_ofst;
         u4_code_int_range = ps_cab_env->u4_code_int_range;
@@ -1338,14 +1329,9 @@ WORD16 ih264d_parse_mvd_cabac(dec_bit_stream_t * ps_bitstrm,
             ps_bitstrm->u4_ofst = u4_offset;
         }
 
-        u4_code_int_range = u4_code_int_range >> 1;
-
-        if(u4_code_int_val_ofst >= u4_code_int_range)
-        {
-            /* S=1 */
-            u4_code_int_val_ofst -= u4_code_int_range;
-            i2_mvd = (-i2_mvd);
-        }
+        DECODE_BYPASS_BIN_MACRO(u4_sign, u4_code_int_range,
+                                u4_code_int_val_ofst)
+        i2_mvd = u4_sign ? -i2_mvd : i2_mvd;
 
         ps_cab_env->u4_code_int_val_ofst = u4_code_int_val_ofst;
         ps_cab_env->u4_code_int_range = u4_code_int_range;
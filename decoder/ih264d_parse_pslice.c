@@ -123,22 +123,11 @@ WORD32 ih264d_parse_pmb_cavlc(dec_struct_t * ps_dec,
 
             //Inlined ih264d_uev
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz;
-
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
+            UWORD32 u4_word;
+
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            ui_sub_mb_mode = ((1 << u4_ldz) + u4_word - 1);
+            ui_sub_mb_mode = u4_word;
             //Inlined ih264d_uev
 
             if(ui_sub_mb_mode > 3)
@@ -269,31 +258,9 @@ WORD32 ih264d_parse_pmb_cavlc(dec_struct_t * ps_dec,
                 //inlining ih264d_sev
                 {
                     UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-                    UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-                    /***************************************************************/
-                    /* Find leading zeros in next 32 bits                          */
-                    /***************************************************************/
-                    NEXTBITS_32(u4_word, u4_bitstream_offset,
-                                pu4_bitstrm_buf);
-                    u4_ldz = CLZ(u4_word);
-
-                    /* Flush the ps_bitstrm */
-                    u4_bitstream_offset += (u4_ldz + 1);
-
-                    /* Read the suffix from the ps_bitstrm */
-                    u4_word = 0;
-                    if(u4_ldz)
-                        GETBITS(u4_word, u4_bitstream_offset,
-                                pu4_bitstrm_buf, u4_ldz);
 
+                    SEV_64(i2_mvx, u4_bitstream_offset, pu4_bitstrm_buf);
                     *pu4_bitstrm_ofst = u4_bitstream_offset;
-                    u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-                    if(u4_word & 0x1)
-                        i2_mvx = (-(WORD32)u4_abs_val);
-                    else
-                        i2_mvx = (u4_abs_val);
                 }
                 //inlinined ih264d_sev
                 COPYTHECONTEXT("MVD", i2_mvx);
@@ -325,21 +292,11 @@ WORD32 ih264d_parse_pmb_cavlc(dec_struct_t * ps_dec,
 
         /* Read the Coded block pattern */
         UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-        UWORD32 u4_word, u4_ldz;
+        UWORD32 u4_word;
 
-        /***************************************************************/
-        /* Find leading zeros in next 32 bits                          */
-        /***************************************************************/
-        NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-        u4_ldz = CLZ(u4_word);
-        /* Flush the ps_bitstrm */
-        u4_bitstream_offset += (u4_ldz + 1);
-        /* Read the suffix from the ps_bitstrm */
-        u4_word = 0;
-        if(u4_ldz)
-            GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf, u4_ldz);
+        UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
         *pu4_bitstrm_ofst = u4_bitstream_offset;
-        u4_cbp = ((1 << u4_ldz) + u4_word - 1);
+        u4_cbp = u4_word;
 
         if(u4_cbp > 47)
             return ERROR_CBP;
@@ -363,30 +320,9 @@ WORD32 ih264d_parse_pmb_cavlc(dec_struct_t * ps_dec,
             WORD32 i_temp;
 
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz, u4_abs_val;
-
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-            u4_ldz = CLZ(u4_word);
-
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
 
+            SEV_64(i_temp, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            u4_abs_val = ((1 << u4_ldz) + u4_word) >> 1;
-
-            if(u4_word & 0x1)
-                i_temp = (-(WORD32)u4_abs_val);
-            else
-                i_temp = (u4_abs_val);
 
             if((i_temp < -26) || (i_temp > 25))
                 return ERROR_INV_RANGE_QP_T;
@@ -883,6 +819,7 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
         }
 
         ps_cur_mb_info = ps_dec->ps_nmb_info + u1_num_mbs;
+        ps_cur_mb_info->pv_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
         ps_dec->u4_num_mbs_cur_nmb = u1_num_mbs;
 
         ps_cur_mb_info->u1_Mux = 0;
@@ -1203,6 +1140,7 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
 
 
         ps_cur_mb_info = ps_dec->ps_nmb_info + u1_num_mbs;
+        ps_cur_mb_info->pv_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
         ps_dec->u4_num_mbs_cur_nmb = u1_num_mbs;
 
         ps_cur_mb_info->u1_Mux = 0;
@@ -1220,26 +1158,11 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
 
             //Inlined ih264d_uev
             UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-            UWORD32 u4_word, u4_ldz;
-
-            /***************************************************************/
-            /* Find leading zeros in next 32 bits                          */
-            /***************************************************************/
-            NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
+            UWORD32 u4_word;
 
-            u4_ldz = CLZ(u4_word);
-
-            /* Flush the ps_bitstrm */
-            u4_bitstream_offset += (u4_ldz + 1);
-            /* Read the suffix from the ps_bitstrm */
-            u4_word = 0;
-            if(u4_ldz)
-            {
-                GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                        u4_ldz);
-            }
+            UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
             *pu4_bitstrm_ofst = u4_bitstream_offset;
-            i2_mb_skip_run = ((1 << u4_ldz) + u4_word - 1);
+            i2_mb_skip_run = u4_word;
             //Inlined ih264d_uev
             COPYTHECONTEXT("mb_skip_run", i2_mb_skip_run);
             uc_more_data_flag = MORE_RBSP_DATA(ps_bitstrm);
@@ -1293,24 +1216,13 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
             /**************************************************************/
             {
                 UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
-                UWORD32 u4_word, u4_ldz, u4_temp;
+                UWORD32 u4_word, u4_temp;
 
 
                 //Inlined ih264d_uev
-                /***************************************************************/
-                /* Find leading zeros in next 32 bits                          */
-                /***************************************************************/
-                NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
-                u4_ldz = CLZ(u4_word);
-                /* Flush the ps_bitstrm */
-                u4_bitstream_offset += (u4_ldz + 1);
-                /* Read the suffix from the ps_bitstrm */
-                u4_word = 0;
-                if(u4_ldz)
-                    GETBITS(u4_word, u4_bitstream_offset, pu4_bitstrm_buf,
-                            u4_ldz);
+                UEV_64(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
                 *pu4_bitstrm_ofst = u4_bitstream_offset;
-                u4_temp = ((1 << u4_ldz) + u4_word - 1);
+                u4_temp = u4_word;
                 //Inlined ih264d_uev
                 if(u4_temp > (UWORD32)(25 + u1_mb_threshold))
                     return ERROR_MB_TYPE;
@@ -1574,9 +1486,8 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
             {
                 if(ps_dec->u4_dec_thread_created == 0)
                 {
-                    ithread_create(ps_dec->pv_dec_thread_handle, NULL,
-                                   (void *)ih264d_decode_picture_thread,
-                                   (void *)ps_dec);
+                    ih264d_create_proc_thread(ps_dec, 0, ps_dec->pv_dec_thread_handle,
+                                              (void *)ih264d_decode_picture_thread);
 
                     ps_dec->u4_dec_thread_created = 1;
                 }
@@ -1593,14 +1504,16 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
                     RETURN_IF((ret != IV_SUCCESS), ret);
                 }
 
+                ret = ih264d_start_deblk_thread(ps_dec);
+                RETURN_IF((ret != OK), ret);
+
                 if((ps_dec->u4_num_cores == 3) &&
                                 ((ps_dec->u4_app_disable_deblk_frm == 0) || ps_dec->i1_recon_in_thread3_flag)
                                 && (ps_dec->u4_bs_deblk_thread_created == 0))
                 {
                     ps_dec->u4_start_recon_deblk = 0;
-                    ithread_create(ps_dec->pv_bs_deblk_thread_handle, NULL,
-                                   (void *)ih264d_recon_deblk_thread,
-                                   (void *)ps_dec);
+                    ih264d_create_proc_thread(ps_dec, 1, ps_dec->pv_bs_deblk_thread_handle,
+                                              (void *)ih264d_recon_deblk_thread);
                     ps_dec->u4_bs_deblk_thread_created = 1;
                 }
                 if(ps_dec->i4_threads_active)
@@ -1780,6 +1693,7 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
 
     ps_dec->ps_cur_slice->u1_slice_type = P_SLICE;
     ps_dec->ps_parse_cur_slice->slice_type = P_SLICE;
+    ps_dec->ps_parse_cur_slice->ps_pps = ps_dec->ps_cur_pps;
     ps_dec->pf_mvpred_ref_tfr_nby2mb = ih264d_mv_pred_ref_tfr_nby2_pmb;
     ps_dec->ps_part = ps_dec->ps_parse_part_params;
     ps_dec->u2_mbx =
@@ -1813,6 +1727,7 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
             break;
 
         ps_cur_mb_info = ps_dec->ps_nmb_info + u1_num_mbs;
+        ps_cur_mb_info->pv_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
         ps_dec->u4_num_mbs_cur_nmb = u1_num_mbs;
 
         ps_cur_mb_info->u1_Mux = 0;
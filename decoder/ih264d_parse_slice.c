@@ -68,6 +68,7 @@
 #include "ih264d_thread_parse_decode.h"
 #include "ih264d_thread_compute_bs.h"
 #include "ih264d_dpb_manager.h"
+#include "ih264d_format_conv.h"
 #include <assert.h>
 #include "ih264d_parse_islice.h"
 #define RET_LAST_SKIP  0x80000000
@@ -224,6 +225,7 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec,
     }
 
     ps_dec->u4_app_disable_deblk_frm = 0;
+    ps_dec->i4_mv_frac_mask = MV_FRAC_MASK_QPEL;
     /* If degrade is enabled, set the degrade flags appropriately */
     if(ps_dec->i4_degrade_type && ps_dec->i4_degrade_pics)
     {
@@ -287,6 +289,24 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec,
             ps_dec->i4_degrade_pic_cnt = 0;
     }
 
+    /* Degrade chosen to keep within the time budget. Non-reference B */
+    /* pictures of DEGRADE_LEVEL_DROP_B_NONREF are dropped before this */
+    if(ps_dec->u4_degrade_level)
+    {
+        if(0 == ps_cur_slice->u1_nal_ref_idc)
+        {
+            ps_dec->u4_app_disable_deblk_frm = 1;
+
+            if(ps_dec->u4_degrade_level >= DEGRADE_LEVEL_FAST_MC_NONREF)
+                ps_dec->i4_mv_frac_mask = 0;
+        }
+        else if((ps_dec->u4_degrade_level >= DEGRADE_LEVEL_NO_DEBLK_REF)
+                        && (ps_cur_slice->u1_slice_type != I_SLICE))
+        {
+            ps_dec->u4_app_disable_deblk_frm = 1;
+        }
+    }
+
     {
         dec_err_status_t * ps_err = ps_dec->ps_dec_err_status;
         if((ps_cur_slice->u1_slice_type == I_SLICE)
@@ -732,6 +752,8 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec,
 
     ps_dec->u4_deblk_mb_x = 0;
     ps_dec->u4_deblk_mb_y = 0;
+    ps_dec->u4_bs_done_mb_num = 0;
+    ps_dec->u4_deblk_in_own_thread = 0;
     ps_dec->pu4_wt_ofsts = ps_dec->pu4_wts_ofsts_mat;
 
     ps_dec->u4_first_slice_in_pic = 0;
@@ -935,6 +957,14 @@ WORD32 ih264d_deblock_display(dec_struct_t *ps_dec)
     /* Call deblocking */
     ih264d_deblock_picture(ps_dec);
 
+    /* Picture is padded now, publish it as complete once both fields are done */
+    if(!ps_dec->ps_cur_slice->u1_field_pic_flag
+                    || ((TOP_FIELD_ONLY | BOT_FIELD_ONLY)
+                                    == ps_dec->u1_top_bottom_decoded))
+    {
+        ih264d_publish_rows_done(ps_dec, ps_dec->u2_pic_ht >> 4);
+    }
+
     ret = ih264d_end_of_pic_dispbuf_mgr(ps_dec);
     if(ret != OK)
         return ret;
@@ -1045,6 +1075,65 @@ WORD32 ih264d_fix_error_in_dpb(dec_struct_t *ps_dec)
 }
 
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_skip_pic \endif
+ *
+ * \brief
+ *    Drops a picture excluded by the skip mode. The picture is not decoded
+ *    and does not enter the DPB, but the POC of the pictures that follow is
+ *    derived as if it had been decoded
+ *
+ * \return
+ *    0 on Success and Error code otherwise
+ **************************************************************************
+ */
+
+static WORD32 ih264d_skip_pic(dec_struct_t *ps_dec,
+                              dec_pic_params_t *ps_pps,
+                              pocstruct_t *ps_tmp_poc,
+                              UWORD16 u2_frame_num,
+                              UWORD8 u1_nal_ref_idc,
+                              UWORD8 u1_field_pic_flag,
+                              UWORD8 u1_bottom_field_flag)
+{
+    dec_slice_params_t *ps_cur_slice = ps_dec->ps_cur_slice;
+    pocstruct_t *ps_cur_poc = &ps_dec->s_cur_pic_poc;
+    WORD32 i4_poc;
+    WORD32 ret;
+
+    ret = ih264d_decode_pic_order_cnt(0, u2_frame_num, &ps_dec->s_prev_pic_poc,
+                                      ps_tmp_poc, ps_cur_slice, ps_pps,
+                                      u1_nal_ref_idc, u1_bottom_field_flag,
+                                      u1_field_pic_flag, &i4_poc);
+    if(ret != OK)
+        return ret;
+
+    ps_cur_poc->i4_pic_order_cnt_lsb = ps_tmp_poc->i4_pic_order_cnt_lsb;
+    ps_cur_poc->i4_pic_order_cnt_msb = ps_tmp_poc->i4_pic_order_cnt_msb;
+    ps_cur_poc->i4_delta_pic_order_cnt_bottom =
+                    ps_tmp_poc->i4_delta_pic_order_cnt_bottom;
+    ps_cur_poc->i4_delta_pic_order_cnt[0] = ps_tmp_poc->i4_delta_pic_order_cnt[0];
+    ps_cur_poc->i4_delta_pic_order_cnt[1] = ps_tmp_poc->i4_delta_pic_order_cnt[1];
+    ps_cur_poc->u1_bot_field = u1_bottom_field_flag;
+    ps_cur_poc->i4_prev_frame_num_ofst = ps_tmp_poc->i4_prev_frame_num_ofst;
+    ps_cur_poc->u2_frame_num = u2_frame_num;
+
+    /* Memory management commands of the picture are not parsed */
+    ps_cur_slice->u2_frame_num = u2_frame_num;
+    ps_cur_slice->u1_nal_ref_idc = u1_nal_ref_idc;
+    ps_cur_slice->u1_nal_unit_type = SLICE_NAL;
+    ps_cur_slice->u1_field_pic_flag = u1_field_pic_flag;
+    ps_cur_slice->u1_bottom_field_flag = u1_bottom_field_flag;
+    ps_cur_slice->i4_pic_order_cnt_lsb = ps_tmp_poc->i4_pic_order_cnt_lsb;
+    ps_cur_slice->u1_mmco_equalto5 = 0;
+
+    ps_dec->u1_last_pic_not_decoded = 1;
+    ps_dec->u1_pic_skipped = 1;
+
+    return OK;
+}
+
 /*!
  **************************************************************************
  * \if Function name : DecodeSlice \endif
@@ -1087,6 +1176,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     UWORD32 u4_temp;
     WORD32 i_temp;
     UWORD32 u4_call_end_of_pic = 0;
+    UWORD32 u4_skip_frm_mask;
 
     /* read FirstMbInSlice  and slice type*/
     ps_dec->ps_dpb_cmds->u1_dpb_commands_read_slc = 0;
@@ -1123,6 +1213,24 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
         u1_slice_type -= 5;
     }
 
+    /* Skip mode of the application, and that of the automatic degrade */
+    u4_skip_frm_mask = ps_dec->u4_skip_frm_mask;
+    if(ps_dec->u4_degrade_level >= DEGRADE_LEVEL_DROP_B_NONREF)
+        u4_skip_frm_mask |= B_SLC_BIT;
+
+    /* The process call that dropped a picture ends at the next picture */
+    if(ps_dec->u1_pic_skipped && (0 == u2_first_mb_in_slice))
+    {
+        return ERROR_INCOMPLETE_FRAME;
+    }
+
+    /* Drop the remaining slices of a picture dropped by the skip mode */
+    if(u4_skip_frm_mask && ps_dec->u4_first_slice_in_pic
+                    && u2_first_mb_in_slice && ps_dec->u1_last_pic_not_decoded)
+    {
+        return OK;
+    }
+
     u4_temp = ih264d_uev(pu4_bitstrm_ofst, pu4_bitstrm_buf);
     if(u4_temp & MASK_ERR_PIC_SET_ID)
         return ERROR_INV_SLICE_HDR_T;
@@ -1278,6 +1386,40 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
         COPYTHECONTEXT("SH: redundant_pic_cnt", u1_redundant_pic_cnt);
     }
 
+    /*--------------------------------------------------------------------*/
+    /* Drop the pictures excluded by the skip mode right after the slice  */
+    /* header, before any picture level processing                        */
+    /*--------------------------------------------------------------------*/
+    if(u4_skip_frm_mask && ps_dec->u4_first_slice_in_pic)
+    {
+        UWORD32 u4_skip_pic_mask = u4_skip_frm_mask;
+        WORD32 i4_skip_pic;
+
+        /* With both P and B pictures skipped only I pictures are decoded, */
+        /* so the skipped reference pictures are not needed either         */
+        if(u1_nal_ref_idc
+                        && ((P_SLC_BIT | B_SLC_BIT)
+                                        != (u4_skip_pic_mask & (P_SLC_BIT | B_SLC_BIT))))
+            u4_skip_pic_mask = SKIP_NONE;
+
+        i4_skip_pic = ((P_SLICE == u1_slice_type) && (u4_skip_pic_mask & P_SLC_BIT))
+                        || ((B_SLICE == u1_slice_type) && (u4_skip_pic_mask & B_SLC_BIT));
+
+        /* The second field of a frame is decoded with the first one */
+        if(u1_field_pic_flag && (u2_frame_num == ps_dec->u2_prv_frame_num)
+                        && ps_dec->u1_top_bottom_decoded
+                        && ((TOP_FIELD_ONLY | BOT_FIELD_ONLY)
+                                        != ps_dec->u1_top_bottom_decoded))
+            i4_skip_pic = 0;
+
+        if(i4_skip_pic)
+        {
+            return ih264d_skip_pic(ps_dec, ps_pps, &s_tmp_poc, u2_frame_num,
+                                   u1_nal_ref_idc, u1_field_pic_flag,
+                                   u1_bottom_field_flag);
+        }
+    }
+
     /*--------------------------------------------------------------------*/
     /* Check if the slice is part of new picture                          */
     /*--------------------------------------------------------------------*/
@@ -1588,9 +1730,8 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
         {
             if(ps_dec->u4_dec_thread_created == 0)
             {
-                ithread_create(ps_dec->pv_dec_thread_handle, NULL,
-                               (void *)ih264d_decode_picture_thread,
-                               (void *)ps_dec);
+                ih264d_create_proc_thread(ps_dec, 0, ps_dec->pv_dec_thread_handle,
+                                          (void *)ih264d_decode_picture_thread);
 
                 ps_dec->u4_dec_thread_created = 1;
             }
@@ -1607,14 +1748,17 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
                 RETURN_IF((ret != IV_SUCCESS), ret);
             }
 
+            ret = ih264d_start_deblk_thread(ps_dec);
+            RETURN_IF((ret != OK), ret);
+            ih264d_fused_fmt_conv_init(ps_dec);
+
             if((ps_dec->u4_num_cores == 3) &&
                             ((ps_dec->u4_app_disable_deblk_frm == 0) || ps_dec->i1_recon_in_thread3_flag)
                             && (ps_dec->u4_bs_deblk_thread_created == 0))
             {
                 ps_dec->u4_start_recon_deblk = 0;
-                ithread_create(ps_dec->pv_bs_deblk_thread_handle, NULL,
-                               (void *)ih264d_recon_deblk_thread,
-                               (void *)ps_dec);
+                ih264d_create_proc_thread(ps_dec, 1, ps_dec->pv_bs_deblk_thread_handle,
+                                          (void *)ih264d_recon_deblk_thread);
                 ps_dec->u4_bs_deblk_thread_created = 1;
             }
             if(ps_dec->i4_threads_active)
@@ -1676,46 +1820,6 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
         ps_err->u4_cur_frm = u2_frame_num;
     }
 
-    /* Decision for decoding if the picture is to be skipped */
-    {
-        WORD32 i4_skip_b_pic, i4_skip_p_pic;
-
-        i4_skip_b_pic = (ps_dec->u4_skip_frm_mask & B_SLC_BIT)
-                        && (B_SLICE == u1_slice_type) && (0 == u1_nal_ref_idc);
-
-        i4_skip_p_pic = (ps_dec->u4_skip_frm_mask & P_SLC_BIT)
-                        && (P_SLICE == u1_slice_type) && (0 == u1_nal_ref_idc);
-
-        /**************************************************************/
-        /* Skip the B picture if skip mask is set for B picture and   */
-        /* Current B picture is a non reference B picture or there is */
-        /* no user for reference B picture                            */
-        /**************************************************************/
-        if(i4_skip_b_pic)
-        {
-            ps_dec->ps_cur_pic->u4_pack_slc_typ |= B_SLC_BIT;
-            /* Don't decode the picture in SKIP-B mode if that picture is B */
-            /* and also it is not to be used as a reference picture         */
-            ps_dec->u1_last_pic_not_decoded = 1;
-
-            return OK;
-        }
-        /**************************************************************/
-        /* Skip the P picture if skip mask is set for P picture and   */
-        /* Current P picture is a non reference P picture or there is */
-        /* no user for reference P picture                            */
-        /**************************************************************/
-        if(i4_skip_p_pic)
-        {
-            ps_dec->ps_cur_pic->u4_pack_slc_typ |= P_SLC_BIT;
-            /* Don't decode the picture in SKIP-P mode if that picture is P */
-            /* and also it is not to be used as a reference picture         */
-            ps_dec->u1_last_pic_not_decoded = 1;
-
-            return OK;
-        }
-    }
-
     {
         UWORD16 u2_mb_x, u2_mb_y;
 
@@ -1847,6 +1951,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
                     ps_dec->ps_cur_slice->u2_first_mb_in_slice;
     ps_dec->ps_parse_cur_slice->slice_type =
                     ps_dec->ps_cur_slice->u1_slice_type;
+    ps_dec->ps_parse_cur_slice->ps_pps = ps_dec->ps_cur_pps;
 
 
     ps_dec->u4_start_recon_deblk = 1;
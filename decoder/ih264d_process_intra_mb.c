@@ -1756,6 +1756,11 @@ WORD32 ih264d_process_intra_mb(dec_struct_t * ps_dec,
     /* Decode Chroma Block */
     ih264d_unpack_chroma_coeff4x4_mb(ps_dec,
                                      ps_cur_mb_info);
+
+    /* Chroma coefficients are unpacked only to move past them */
+    if(ps_dec->u4_luma_only)
+        return OK;
+
     /*--------------------------------------------------------------------*/
     /* Chroma Blocks decoding                                             */
     /*--------------------------------------------------------------------*/
@@ -30,7 +30,11 @@
 #include "ih264d_defs.h"
 #include "ih264d_defs.h"
 #include "ih264d_bitstrm.h"
+#include "ih264d_nal.h"
+#include "ih264d_format_conv.h"
 #include "ih264d_debug.h"
+#include "ih264d_thread_sync.h"
+#include "ih264d_thread_pool.h"
 #include "ih264d_dpb_manager.h"
 /* includes for CABAC */
 #include "ih264d_cabac.h"
@@ -485,6 +489,9 @@ typedef struct _DecMbInfo
     mb_neigbour_params_t *ps_top_mb;
     mb_neigbour_params_t *ps_top_right_mb;
     mb_neigbour_params_t *ps_curmb;
+
+    /** Start of the parsed TU coefficient data of the MB */
+    void *pv_tu_coeff_data;
 } dec_mb_info_t;
 
 
@@ -677,6 +684,7 @@ typedef struct _dec_slice_struct
     volatile UWORD16 u2_log2Y_crwd;
     volatile void **ppv_map_ref_idx_to_poc;
     volatile void *pv_tu_coeff_data_start;
+    dec_pic_params_t *ps_pps;
 } dec_slice_struct_t;
 
 /**
@@ -734,6 +742,172 @@ typedef struct
     UWORD8 *pu1_mb_type_map;
 }ref_map_t;
 
+/** A worker of the row parallel picture level deblocking */
+typedef struct
+{
+    /** Decoder context */
+    struct _DecStruct *ps_dec;
+
+    /** Index of the worker */
+    UWORD32 u4_idx;
+
+    /** Job run on the worker pool */
+    pool_job_t s_pool_job;
+
+    /** Signalled as the worker completes MBs of its rows */
+    progress_sync_t s_progress;
+
+    /** Wait statistics of the worker */
+    wait_stats_t s_wait_stats;
+}deblk_row_worker_t;
+
+/** A stripe of rows of the display frame, format converted by a worker */
+typedef struct
+{
+    /** Decoder context */
+    struct _DecStruct *ps_dec;
+
+    /** Display frame being converted */
+    ivd_get_display_frame_op_t *ps_disp_op;
+
+    /** First row and number of rows of the stripe */
+    UWORD32 u4_start_y;
+    UWORD32 u4_num_rows;
+
+    /** Job run on the worker pool */
+    pool_job_t s_pool_job;
+
+    /**
+     * Two luma rows and a chroma row of the downscaled frame, converted from
+     * here to the output format
+     */
+    UWORD8 *pu1_scale_buf;
+}fmt_conv_stripe_t;
+
+/**
+ * Row parallel picture level deblocking. Workers pick MB rows in order and
+ * deblock MB x of a row once the row above is deblocked up to MB x + 1.
+ * In MBAFF pictures rows and MBs are MB pair rows and MB pairs
+ */
+typedef struct
+{
+    /** Transfer context at the top left of the picture */
+    tfr_ctxt_t s_tfr_ctxt;
+
+    /** Deblocking parameters of the first MB of the picture */
+    deblk_mb_t *ps_deblk_mb;
+
+    /** Picture dimensions in MBs */
+    UWORD32 u4_wd_mbs;
+    UWORD32 u4_ht_mbs;
+
+    /** Strides and chroma QP offsets passed to the deblocking */
+    WORD32 i4_strd_y;
+    WORD32 i4_strd_uv;
+    WORD8 i1_cb_qp_idx_ofst;
+    WORD8 i1_cr_qp_idx_ofst;
+
+    /** Publish the rows done of the current picture as rows complete */
+    WORD32 i4_publish_rows;
+
+    /** Set for MBAFF pictures */
+    UWORD8 u1_mbaff;
+
+    /** Protects u4_next_row, u4_rows_published and pu1_row_worker */
+    void *pv_mutex;
+
+    /** Next row to be picked */
+    UWORD32 u4_next_row;
+
+    /** Rows done published so far */
+    UWORD32 u4_rows_published;
+
+    /** Worker deblocking each row */
+    UWORD8 *pu1_row_worker;
+
+    /** Number of MBs deblocked in each row */
+    volatile UWORD32 *pu4_row_mbs_done;
+
+    /** Number of rows the above are allocated for */
+    UWORD32 u4_max_rows;
+
+    /** Workers */
+    deblk_row_worker_t as_worker[H264_MAX_NUM_CORES];
+}deblk_rows_ctxt_t;
+
+/** A worker of the row parallel reconstruction */
+typedef struct
+{
+    /** Decoder context */
+    struct _DecStruct *ps_dec;
+
+    /** Index of the worker */
+    UWORD32 u4_idx;
+
+    /** Job run on the worker pool */
+    pool_job_t s_pool_job;
+
+    /** Signalled as the worker completes MBs of its rows */
+    progress_sync_t s_progress;
+
+    /** Wait statistics of the worker */
+    wait_stats_t s_wait_stats;
+
+    /**
+     * Context the worker reconstructs with. Only the fields read by
+     * ih264d_process_inter_mb, ih264d_process_intra_mb and
+     * ih264d_copy_intra_pred_line are set: kernels, picture dimensions and
+     * scaling lists at the start of each picture, the PPS from the slice of
+     * each MB. The others stay zero
+     */
+    struct _DecStruct *ps_rec_ctxt;
+
+    /** IQ-IT scratch of the worker, MB_LUM_SIZE coefficients */
+    WORD16 *pi2_coeff_data;
+
+    /** Transfer context pointing at the MB being reconstructed */
+    tfr_ctxt_t s_tfr_ctxt;
+}recon_row_worker_t;
+
+/**
+ * Row parallel reconstruction (IQ-IT, intra prediction and residual add) of
+ * pictures motion compensated by the decode thread. Workers pick MB rows in
+ * order and reconstruct MB x of a row once the decode thread is done with
+ * MB x + 1 and the row above is reconstructed up to MB x + 1. The recon
+ * thread waits for the rows instead of reconstructing them, and picks the
+ * rows no worker has picked yet as worker 0
+ */
+typedef struct
+{
+    /** Protects u4_next_row and pu1_row_worker */
+    void *pv_mutex;
+
+    /** Workers reconstructing the current picture, 0 if the recon thread does */
+    UWORD32 u4_num_workers;
+
+    /** Workers that have a recon context, worker 0 included */
+    UWORD32 u4_max_workers;
+
+    /** Picture dimensions in MBs */
+    UWORD32 u4_wd_mbs;
+    UWORD32 u4_ht_mbs;
+
+    /** Next row to be picked */
+    UWORD32 u4_next_row;
+
+    /** Worker reconstructing each row */
+    UWORD8 *pu1_row_worker;
+
+    /** Number of MBs reconstructed in each row */
+    volatile UWORD32 *pu4_row_mbs_done;
+
+    /** Number of rows the above are allocated for */
+    UWORD32 u4_max_rows;
+
+    /** Workers */
+    recon_row_worker_t as_worker[H264_MAX_NUM_CORES];
+}recon_rows_ctxt_t;
+
 /** Aggregating structure that is globally available */
 typedef struct _DecStruct
 {
@@ -771,6 +945,9 @@ typedef struct _DecStruct
 
     UWORD8 i4_threads_active; /** Keeps thread active*/
 
+    /** Size of the length prefixing each NAL unit, 0 for start codes */
+    UWORD8 u1_nal_length_size;
+
     UWORD16 u2_pic_wd; /** Width of the picture being decoded */
     UWORD16 u2_pic_ht; /** Height of the picture being decoded */
     UWORD32 u4_total_mbs; /** Total MBs in the picture being decoded */
@@ -937,6 +1114,15 @@ typedef struct _DecStruct
     UWORD8 u1_pr_sl_type;
     WORD32 i4_frametype;
     UWORD32 u4_app_disp_width;
+
+    /** Output is downscaled by (1 << u4_out_scale_log2) in each dimension */
+    UWORD32 u4_out_scale_log2;
+
+    /**
+     * Only the luma is reconstructed and output. Chroma syntax is parsed, and
+     * the chroma planes of the picture buffers are left as they are
+     */
+    UWORD32 u4_luma_only;
     WORD32 i4_error_code;
     UWORD32 u4_bitoffset;
 
@@ -1134,6 +1320,9 @@ typedef struct _DecStruct
     /* in case of skip mode set by the application                  */
     UWORD8 u1_last_pic_not_decoded;
 
+    /* Set when the skip mode dropped a picture in the current process call */
+    UWORD8 u1_pic_skipped;
+
     WORD32 e_dec_status;
     UWORD32 u4_num_fld_in_frm;
 
@@ -1275,6 +1464,11 @@ typedef struct _DecStruct
     UWORD32 u4_num_mbs_cur_nmb;
     UWORD32 u4_app_deblk_disable_level;
     UWORD32 u4_app_disable_deblk_frm;
+
+    /**
+     * Mask applied to the fractional part of luma motion vectors, 0 for
+     * integer pel motion compensation in degraded pictures
+     */
     WORD32 i4_mv_frac_mask;
 
     disp_buf_t disp_bufs[MAX_DISP_BUFS_NEW];
@@ -1287,6 +1481,20 @@ typedef struct _DecStruct
     volatile UWORD32 u4_start_recon_deblk;
     void *pv_bs_deblk_thread_handle;
 
+    /**
+     * Deblocking thread that trails ih264d_recon_deblk_thread when auxiliary
+     * cores are available
+     */
+    UWORD32 u4_deblk_thread_created;
+    void *pv_deblk_thread_handle;
+    UWORD32 u4_deblk_in_own_thread;
+
+    /**
+     * Number of MBs of current picture for which recon and BS are done,
+     * published by ih264d_recon_deblk_thread for the deblocking thread
+     */
+    volatile UWORD32 u4_bs_done_mb_num;
+
     UWORD32 u4_cur_bs_mb_num;
     UWORD32 u4_bs_cur_slice_num_mbs;
     UWORD32 u4_cur_deblk_mb_num;
@@ -1305,6 +1513,25 @@ typedef struct _DecStruct
     ivd_get_display_frame_op_t s_disp_op;
     UWORD32 u4_output_present;
 
+    /**
+     * Set when the current picture is format converted into the output buffer
+     * as its MB rows are deblocked, in place of after it is decoded
+     */
+    UWORD32 u4_fused_fmt_conv;
+
+    /** Display frame and output of the current picture, for the above */
+    iv_yuv_buf_t s_fused_frame_info;
+    ivd_get_display_frame_op_t s_fused_disp_op;
+
+    /** Luma rows of the picture above the display frame */
+    UWORD32 u4_fused_crop_top;
+
+    /** Rows of the display frame converted so far */
+    UWORD32 u4_fused_fmt_conv_row;
+
+    /** MB rows reported to the row callback as converted */
+    UWORD32 u4_fused_rows_reported;
+
     volatile UWORD32 cur_dec_mb_num;
     volatile UWORD32 cur_recon_mb_num;
     volatile UWORD32 u4_cur_mb_addr;
@@ -1318,38 +1545,105 @@ typedef struct _DecStruct
     /**
      * Condition variable to signal process start - One for each thread
      */
-    void *apv_proc_start_condition[2];
+    void *apv_proc_start_condition[H264_MAX_PROC_THREADS];
 
     /**
      * Mutex used to keep the functions thread-safe - One for each thread
      */
-    void *apv_proc_start_mutex[2];
+    void *apv_proc_start_mutex[H264_MAX_PROC_THREADS];
 
     /**
      * Condition variable to signal process done - One for each thread
      */
-    void *apv_proc_done_condition[2];
+    void *apv_proc_done_condition[H264_MAX_PROC_THREADS];
 
     /**
      * Mutex used to keep the functions thread-safe - One for each thread
      */
-    void *apv_proc_done_mutex[2];
+    void *apv_proc_done_mutex[H264_MAX_PROC_THREADS];
 
     /**
      * Process state start - One for each thread
      */
-    proc_state_t ai4_process_start[2];
+    proc_state_t ai4_process_start[H264_MAX_PROC_THREADS];
 
     /**
      * Process state end - One for each thread
      */
-    proc_state_t ai4_process_done[2];
+    proc_state_t ai4_process_done[H264_MAX_PROC_THREADS];
 
     /**
      * Flag to signal processing thread to exit
      */
     WORD32 i4_break_threads;
 
+    /**
+     * Progress of pu1_dec_mb_map, produced by the parse thread
+     */
+    progress_sync_t s_dec_map_progress;
+
+    /**
+     * Progress of pu1_recon_mb_map, produced by the decode thread
+     */
+    progress_sync_t s_recon_map_progress;
+
+    /**
+     * Progress of u4_bs_done_mb_num, produced by the recon/bs thread
+     */
+    progress_sync_t s_bs_progress;
+
+    /**
+     * Wait statistics on the above progress, one entry per thread
+     */
+    wait_stats_t as_wait_stats[WAIT_STATS_NUM_THREADS];
+
+    /**
+     * Shared worker pool set by the application. When present, the threads
+     * above are run as jobs of the pool instead of being created
+     */
+    thread_pool_t *ps_thread_pool;
+
+    /**
+     * Pool jobs - One for each thread
+     */
+    pool_job_t as_pool_job[H264_MAX_PROC_THREADS];
+
+    /**
+     * Pool of this decoder, with a thread for each recon row worker. Created
+     * only when no shared pool is set and the row workers run. Also used by
+     * the other stages that split a picture over workers
+     */
+    thread_pool_t *ps_own_pool;
+
+    /**
+     * Context of the queue input / dequeue output API
+     */
+    void *pv_async_ctxt;
+
+    /**
+     * Row callback set with IH264D_CMD_CTL_SET_ROW_CALLBACK, and its context
+     */
+    void (*pf_row_done)(void *pv_cb_ctxt, UWORD32 u4_ts, UWORD32 u4_num_mb_rows);
+    void *pv_row_done_ctxt;
+
+    /**
+     * Row parallel picture level deblocking
+     */
+    deblk_rows_ctxt_t s_deblk_rows;
+
+    /**
+     * Row parallel reconstruction
+     */
+    recon_rows_ctxt_t s_recon_rows;
+
+    /**
+     * Stripes of the display frame format converted in parallel
+     */
+    fmt_conv_stripe_t as_fmt_conv_stripe[H264_MAX_NUM_CORES];
+
+    /** Buffer holding pu1_scale_buf of the above */
+    UWORD8 *pu1_fmt_conv_scale_buf;
+
     volatile UWORD8 *pu1_dec_mb_map;
     volatile UWORD8 *pu1_recon_mb_map;
     volatile UWORD16 *pu2_slice_num_map;
@@ -1365,6 +1659,14 @@ typedef struct _DecStruct
     /* 2 first slice not parsed , 1 :first slice parsed , 0 :first valid slice header parsed*/
     UWORD32 u4_first_slice_in_pic;
     UWORD32 u4_num_cores;
+
+    /**
+     * Cores requested by the application over and above the ones used by the
+     * parse/decode/bs-deblock pipeline (u4_num_cores). They run the trailing
+     * deblocking thread and the recon row workers within the picture; one
+     * picture is decoded at a time
+     */
+    UWORD32 u4_num_aux_cores;
     IVD_ARCH_T e_processor_arch;
     IVD_SOC_T e_processor_soc;
 
@@ -1395,6 +1697,22 @@ typedef struct _DecStruct
      *
      */
     WORD32 i4_degrade_pic_cnt;
+
+    /**
+     * Time budget per frame in microseconds for the automatic degrade, 0 when
+     * it is off
+     */
+    UWORD32 u4_degrade_budget_us;
+
+    /** Automatic degrade level, DEGRADE_LEVEL_* */
+    UWORD32 u4_degrade_level;
+
+    /** Time spent in decode calls since the last decoded frame */
+    UWORD32 u4_degrade_time_us;
+
+    /** Consecutive frames decoded over the budget and well within it */
+    UWORD32 u4_degrade_over_cnt;
+    UWORD32 u4_degrade_under_cnt;
     WORD32 i4_display_index;
     UWORD32 u4_pic_buf_got;
 
@@ -1538,6 +1856,35 @@ typedef struct _DecStruct
      */
     ih264_deblk_chroma_edge_bslt4_ft *pf_deblk_chroma_horz_bslt4;
 
+    /**
+     * deblock the inner vertical luma edges of a MB with blocking strength
+     * less than 4
+     */
+    ih264_deblk_luma_inner_bslt4_ft *pf_deblk_luma_vert_inner_bslt4;
+
+    /**
+     * deblock the inner horizontal luma edges of a MB with blocking strength
+     * less than 4
+     */
+    ih264_deblk_luma_inner_bslt4_ft *pf_deblk_luma_horz_inner_bslt4;
+
+    /**
+     * skip the bytes that can not begin a start code
+     */
+    ih264d_find_zero_run_ft *pf_find_zero_run;
+
+    /**
+     * format conversion of the display frame
+     */
+    ih264d_fmt_conv_420sp_to_420p_ft *pf_fmt_conv_420sp_to_420p;
+
+    ih264d_fmt_conv_420sp_to_420sp_ft *pf_fmt_conv_420sp_to_420sp_swap_uv;
+
+    ih264d_fmt_conv_420sp_to_rgb565_ft *pf_fmt_conv_420sp_to_rgb565;
+
+    ih264d_fmt_conv_420sp_to_rgba8888_ft *pf_fmt_conv_420sp_to_rgba8888;
+
+    ih264d_fmt_conv_downscale_ft *pf_fmt_conv_downscale;
 
 } dec_struct_t;
 
@@ -44,6 +44,7 @@
 #include "ih264d_mb_utils.h"
 
 #include "ih264d_thread_compute_bs.h"
+#include "ih264d_thread_parse_decode.h"
 #include "ithread.h"
 #include "ih264d_deblocking.h"
 #include "ih264d_process_pslice.h"
@@ -324,6 +325,7 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec,
     UWORD32 u4_mb_num;
     UWORD32 u4_cond;
     volatile UWORD8 *mb_map = ps_dec->pu1_recon_mb_map;
+    wait_stats_t *ps_stats = &ps_dec->as_wait_stats[WAIT_STATS_PARSE_THREAD];
     const WORD32 i4_cb_qp_idx_ofst =
                     ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
     const WORD32 i4_cr_qp_idx_ofst =
@@ -339,9 +341,12 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec,
 
     for(i = 0; i < deblk_mb_grp; i++)
     {
-        WORD32 nop_cnt = 8*128;
+        WORD32 nop_cnt = PROGRESS_SPIN_CNT;
         while(u4_check_mb_map == 1)
         {
+            UWORD32 u4_seq =
+                            ih264d_progress_get_seq(&ps_dec->s_recon_map_progress);
+
             u4_mb_num = ps_dec->u4_cur_deblk_mb_num;
             /*we wait for the right mb because of intra pred data dependency*/
             u4_mb_num = MIN(u4_mb_num + 1, (ps_dec->u4_deblk_mb_y + 1) * ps_dec->u2_frm_wd_in_mbs - 1);
@@ -351,18 +356,11 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec,
             {
                 break;
             }
-            else
+            else if(!ih264d_progress_spin(&nop_cnt, ps_stats))
             {
-                if(nop_cnt > 0)
-                {
-                    nop_cnt -= 128;
-                    NOP(128);
-                }
-                else
-                {
-                    nop_cnt = 8*128;
-                    ithread_yield();
-                }
+                ih264d_progress_sleep(&ps_dec->s_recon_map_progress, u4_seq,
+                                      ps_stats);
+                nop_cnt = PROGRESS_SPIN_CNT;
             }
         }
 
@@ -375,6 +373,398 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec,
 
 
 }
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_recon_mb_row \endif
+ *
+ * \brief
+ *    Reconstructs an MB row of the current picture with the recon context
+ *    of a worker of the row parallel reconstruction. MB x is
+ *    reconstructed once the decode thread is done with MB x + 1, as chroma
+ *    IQ-IT loads and stores pixels of the right MB, and once the row above
+ *    is done up to MB x + 1, as intra prediction reads its intra pred line
+ *    and intra 4x4 / 8x8 modes
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_recon_mb_row(recon_row_worker_t *ps_worker,
+                                UWORD32 u4_row,
+                                progress_sync_t *ps_top_prog)
+{
+    dec_struct_t *ps_dec = ps_worker->ps_dec;
+    dec_struct_t *ps_rec = ps_worker->ps_rec_ctxt;
+    recon_rows_ctxt_t *ps_rows = &ps_dec->s_recon_rows;
+    tfr_ctxt_t *ps_trns_addr = &ps_worker->s_tfr_ctxt;
+    UWORD32 u4_wd_mbs = ps_rows->u4_wd_mbs;
+    UWORD32 u4_first_mb = u4_row * u4_wd_mbs;
+    UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag;
+    UWORD32 u4_strd_y = ps_dec->u2_frm_wd_y << u1_field_pic_flag;
+    UWORD32 u4_strd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
+    UWORD32 u4_top_mbs_done = 0;
+    UWORD32 u4_ofst_y = u4_wd_mbs * MB_SIZE;
+    UWORD32 u4_ofst_uv = u4_wd_mbs * BLK8x8SIZE;
+    UWORD32 u4_mb_x;
+
+    /*
+     * Intra pred lines of even rows are written to the first half of the
+     * buffers and those of odd rows to the second, as the recon thread's
+     * swap in ih264d_copy_intra_pred_line does
+     */
+    if(u4_row & 1)
+    {
+        ps_rec->pu1_cur_y_intra_pred_line = ps_dec->pu1_y_intra_pred_line + u4_ofst_y;
+        ps_rec->pu1_cur_u_intra_pred_line = ps_dec->pu1_u_intra_pred_line
+                        + u4_ofst_uv * YUV420SP_FACTOR;
+        ps_rec->pu1_cur_v_intra_pred_line = ps_dec->pu1_v_intra_pred_line + u4_ofst_uv;
+        ps_rec->pu1_prev_y_intra_pred_line = ps_dec->pu1_y_intra_pred_line;
+        ps_rec->pu1_prev_u_intra_pred_line = ps_dec->pu1_u_intra_pred_line;
+        ps_rec->pu1_prev_v_intra_pred_line = ps_dec->pu1_v_intra_pred_line;
+    }
+    else
+    {
+        ps_rec->pu1_cur_y_intra_pred_line = ps_dec->pu1_y_intra_pred_line;
+        ps_rec->pu1_cur_u_intra_pred_line = ps_dec->pu1_u_intra_pred_line;
+        ps_rec->pu1_cur_v_intra_pred_line = ps_dec->pu1_v_intra_pred_line;
+        ps_rec->pu1_prev_y_intra_pred_line = ps_dec->pu1_y_intra_pred_line + u4_ofst_y;
+        ps_rec->pu1_prev_u_intra_pred_line = ps_dec->pu1_u_intra_pred_line
+                        + u4_ofst_uv * YUV420SP_FACTOR;
+        ps_rec->pu1_prev_v_intra_pred_line = ps_dec->pu1_v_intra_pred_line + u4_ofst_uv;
+    }
+    ps_rec->pu1_cur_y_intra_pred_line_base = ps_rec->pu1_cur_y_intra_pred_line;
+    ps_rec->pu1_cur_u_intra_pred_line_base = ps_rec->pu1_cur_u_intra_pred_line;
+    ps_rec->pu1_cur_v_intra_pred_line_base = ps_rec->pu1_cur_v_intra_pred_line;
+
+    ps_trns_addr->pu1_dest_y = ps_dec->s_cur_pic.pu1_buf1
+                    + ((u4_row * u4_strd_y) << 4);
+    ps_trns_addr->pu1_dest_u = ps_dec->s_cur_pic.pu1_buf2
+                    + ((u4_row * u4_strd_uv) << 3);
+    ps_trns_addr->pu1_dest_v = ps_dec->s_cur_pic.pu1_buf3
+                    + ((u4_row * u4_strd_uv) << 3);
+
+    for(u4_mb_x = 0; u4_mb_x < u4_wd_mbs; u4_mb_x++)
+    {
+        UWORD32 u4_mb_num = u4_first_mb + u4_mb_x;
+        UWORD32 u4_mc_mb_num = MIN(u4_mb_num + 1, u4_first_mb + u4_wd_mbs - 1);
+        dec_mb_info_t *ps_cur_mb_info = &ps_dec->ps_frm_mb_info[u4_mb_num];
+        WORD32 nop_cnt = PROGRESS_SPIN_CNT;
+        UWORD32 u1_slice_type, u1_B, u1_ipcm_th;
+        WORD32 u1_skip_th;
+        UWORD16 u2_slice_num;
+
+        while(1)
+        {
+            UWORD32 u4_cond = 0;
+            UWORD32 u4_seq = ih264d_progress_get_seq(&ps_dec->s_recon_map_progress);
+
+            CHECK_MB_MAP_BYTE(u4_mc_mb_num, ps_dec->pu1_recon_mb_map, u4_cond);
+            if(u4_cond)
+                break;
+
+            if(!ih264d_progress_spin(&nop_cnt, &ps_worker->s_wait_stats))
+                ih264d_progress_sleep(&ps_dec->s_recon_map_progress, u4_seq,
+                                      &ps_worker->s_wait_stats);
+        }
+
+        if(NULL != ps_top_prog)
+        {
+            UWORD32 u4_needed = MIN(u4_mb_x + 2, u4_wd_mbs);
+
+            nop_cnt = PROGRESS_SPIN_CNT;
+            while(u4_top_mbs_done < u4_needed)
+            {
+                UWORD32 u4_seq = ih264d_progress_get_seq(ps_top_prog);
+
+                u4_top_mbs_done = ps_rows->pu4_row_mbs_done[u4_row - 1];
+                if(u4_top_mbs_done >= u4_needed)
+                    break;
+
+                if(!ih264d_progress_spin(&nop_cnt, &ps_worker->s_wait_stats))
+                    ih264d_progress_sleep(ps_top_prog, u4_seq,
+                                          &ps_worker->s_wait_stats);
+            }
+        }
+        DATA_SYNC();
+
+        GET_SLICE_NUM_MAP(ps_dec->pu2_slice_num_map, u4_mb_num, u2_slice_num);
+        u1_slice_type = ps_dec->ps_dec_slice_buf[u2_slice_num].slice_type;
+        u1_B = (u1_slice_type == B_SLICE);
+        u1_skip_th = ((u1_slice_type != I_SLICE) ?
+                                        (u1_B ? B_8x8 : PRED_8x8R0) : -1);
+        u1_ipcm_th = ((u1_slice_type != I_SLICE) ? (u1_B ? 23 : 5) : 0);
+
+        /* Slices of a picture may use different PPSs */
+        ps_rec->ps_cur_pps = ps_dec->ps_dec_slice_buf[u2_slice_num].ps_pps;
+        ps_rec->pv_proc_tu_coeff_data = ps_cur_mb_info->pv_tu_coeff_data;
+
+        if(ps_cur_mb_info->u1_mb_type <= u1_skip_th)
+        {
+            ih264d_process_inter_mb(ps_rec, ps_cur_mb_info, 0);
+        }
+        else if(ps_cur_mb_info->u1_mb_type != MB_SKIP)
+        {
+            if((u1_ipcm_th + 25) != ps_cur_mb_info->u1_mb_type)
+            {
+                ps_cur_mb_info->u1_mb_type -= (u1_skip_th + 1);
+                ih264d_process_intra_mb(ps_rec, ps_cur_mb_info, 0);
+            }
+        }
+
+        ih264d_copy_intra_pred_line(ps_rec, ps_cur_mb_info, 0);
+
+        if(ps_rec->i4_error_code)
+        {
+            ps_dec->i4_error_code = ps_rec->i4_error_code;
+            ps_rec->i4_error_code = 0;
+        }
+
+        ps_trns_addr->pu1_dest_y += MB_SIZE;
+        ps_trns_addr->pu1_dest_u += BLK8x8SIZE * YUV420SP_FACTOR;
+        ps_trns_addr->pu1_dest_v += BLK8x8SIZE * YUV420SP_FACTOR;
+
+        DATA_SYNC();
+        ps_rows->pu4_row_mbs_done[u4_row] = u4_mb_x + 1;
+        ih264d_progress_signal(&ps_worker->s_progress);
+    }
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_recon_rows_worker \endif
+ *
+ * \brief
+ *    Worker of the row parallel reconstruction. Picks MB rows in order
+ *    until all rows of the picture are picked
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_recon_rows_worker(recon_row_worker_t *ps_worker)
+{
+    recon_rows_ctxt_t *ps_rows = &ps_worker->ps_dec->s_recon_rows;
+
+    ithread_set_name("ih264d_recon_rows_worker");
+
+    while(1)
+    {
+        progress_sync_t *ps_top_prog = NULL;
+        UWORD32 u4_row;
+
+        ithread_mutex_lock(ps_rows->pv_mutex);
+        u4_row = ps_rows->u4_next_row;
+        if(u4_row < ps_rows->u4_ht_mbs)
+        {
+            ps_rows->pu1_row_worker[u4_row] = (UWORD8)ps_worker->u4_idx;
+            ps_rows->u4_next_row++;
+            if(u4_row > 0)
+            {
+                ps_top_prog = &ps_rows->as_worker[ps_rows->pu1_row_worker[u4_row - 1]].s_progress;
+            }
+        }
+        ithread_mutex_unlock(ps_rows->pv_mutex);
+
+        if(u4_row >= ps_rows->u4_ht_mbs)
+            break;
+
+        ih264d_recon_mb_row(ps_worker, u4_row, ps_top_prog);
+    }
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_init_recon_ctxt \endif
+ *
+ * \brief
+ *    Sets the picture level fields of a worker's recon context: the fields
+ *    the reconstruction reads that do not change within a picture
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_init_recon_ctxt(dec_struct_t *ps_dec,
+                                   recon_row_worker_t *ps_worker)
+{
+    dec_struct_t *ps_rec = ps_worker->ps_rec_ctxt;
+
+    memcpy(ps_rec->apf_intra_pred_luma_16x16, ps_dec->apf_intra_pred_luma_16x16,
+           sizeof(ps_dec->apf_intra_pred_luma_16x16));
+    memcpy(ps_rec->apf_intra_pred_luma_8x8, ps_dec->apf_intra_pred_luma_8x8,
+           sizeof(ps_dec->apf_intra_pred_luma_8x8));
+    memcpy(ps_rec->apf_intra_pred_luma_4x4, ps_dec->apf_intra_pred_luma_4x4,
+           sizeof(ps_dec->apf_intra_pred_luma_4x4));
+    memcpy(ps_rec->apf_intra_pred_chroma, ps_dec->apf_intra_pred_chroma,
+           sizeof(ps_dec->apf_intra_pred_chroma));
+    ps_rec->pf_intra_pred_ref_filtering = ps_dec->pf_intra_pred_ref_filtering;
+    ps_rec->pf_iquant_itrans_recon_luma_4x4 = ps_dec->pf_iquant_itrans_recon_luma_4x4;
+    ps_rec->pf_iquant_itrans_recon_luma_4x4_dc = ps_dec->pf_iquant_itrans_recon_luma_4x4_dc;
+    ps_rec->pf_iquant_itrans_recon_luma_8x8 = ps_dec->pf_iquant_itrans_recon_luma_8x8;
+    ps_rec->pf_iquant_itrans_recon_luma_8x8_dc = ps_dec->pf_iquant_itrans_recon_luma_8x8_dc;
+    ps_rec->pf_iquant_itrans_recon_chroma_4x4 = ps_dec->pf_iquant_itrans_recon_chroma_4x4;
+    ps_rec->pf_iquant_itrans_recon_chroma_4x4_dc =
+                    ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc;
+    ps_rec->pf_ihadamard_scaling_4x4 = ps_dec->pf_ihadamard_scaling_4x4;
+
+    /* Scaling lists are formed once per picture, in ih264d_init_pic */
+    ps_rec->s_high_profile = ps_dec->s_high_profile;
+
+    ps_rec->ps_cur_slice = ps_dec->ps_cur_slice;
+    ps_rec->ps_cur_pps = ps_dec->ps_cur_pps;
+    ps_rec->u2_frm_wd_y = ps_dec->u2_frm_wd_y;
+    ps_rec->u2_frm_wd_uv = ps_dec->u2_frm_wd_uv;
+    ps_rec->u2_frm_wd_in_mbs = ps_dec->u2_frm_wd_in_mbs;
+    ps_rec->u4_use_intrapred_line_copy = ps_dec->u4_use_intrapred_line_copy;
+    ps_rec->u4_luma_only = ps_dec->u4_luma_only;
+
+    ps_rec->pi2_coeff_data = ps_worker->pi2_coeff_data;
+    ps_rec->ps_frame_buf_ip_recon = &ps_worker->s_tfr_ctxt;
+    ps_rec->i4_error_code = 0;
+    ps_worker->s_tfr_ctxt = ps_dec->s_tran_iprecon;
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_start_recon_rows \endif
+ *
+ * \brief
+ *    Starts the workers of the row parallel reconstruction for the current
+ *    picture as jobs of the worker pool. Rows of workers that the pool does
+ *    not get to are picked by the others and by the recon thread
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_start_recon_rows(dec_struct_t *ps_dec)
+{
+    recon_rows_ctxt_t *ps_rows = &ps_dec->s_recon_rows;
+    thread_pool_t *ps_pool = ih264d_get_worker_pool(ps_dec);
+    UWORD32 u4_wd_mbs = ps_dec->u2_frm_wd_in_mbs;
+    UWORD32 u4_ht_mbs = (ps_dec->ps_cur_sps->u4_max_mb_addr + 1) / u4_wd_mbs;
+    UWORD32 u4_num_workers, i;
+
+    ps_rows->u4_num_workers = 0;
+
+    /* Decoders that do not set up the workers reconstruct in this thread */
+    if((NULL == ps_rows->pv_mutex) || (NULL == ps_pool)
+                    || (ps_rows->u4_max_workers < 2)
+                    || (u4_ht_mbs > ps_rows->u4_max_rows))
+        return;
+
+    if(!ps_dec->i1_recon_in_thread3_flag
+                    || ps_dec->ps_cur_slice->u1_mbaff_frame_flag)
+        return;
+
+    /* One auxiliary core is taken by the trailing deblocking thread */
+    u4_num_workers = (ps_dec->u4_num_aux_cores > 1) ?
+                    ps_dec->u4_num_aux_cores - 1 : 0;
+    u4_num_workers = MIN(u4_num_workers, ps_rows->u4_max_workers - 1);
+    u4_num_workers = MIN(u4_num_workers, u4_ht_mbs);
+    if(0 == u4_num_workers)
+        return;
+
+    ps_rows->u4_wd_mbs = u4_wd_mbs;
+    ps_rows->u4_ht_mbs = u4_ht_mbs;
+    ps_rows->u4_next_row = 0;
+    memset((void *)ps_rows->pu4_row_mbs_done, 0, u4_ht_mbs * sizeof(UWORD32));
+
+    for(i = 0; i <= u4_num_workers; i++)
+    {
+        ih264d_init_recon_ctxt(ps_dec, &ps_rows->as_worker[i]);
+    }
+    ps_rows->u4_num_workers = u4_num_workers;
+
+    for(i = 1; i <= u4_num_workers; i++)
+    {
+        recon_row_worker_t *ps_worker = &ps_rows->as_worker[i];
+
+        ih264d_thread_pool_submit(ps_pool, &ps_worker->s_pool_job,
+                                  (pf_pool_job_t)ih264d_recon_rows_worker,
+                                  (void *)ps_worker);
+    }
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_join_recon_rows \endif
+ *
+ * \brief
+ *    Waits for the workers of the row parallel reconstruction to return
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_join_recon_rows(dec_struct_t *ps_dec)
+{
+    recon_rows_ctxt_t *ps_rows = &ps_dec->s_recon_rows;
+    thread_pool_t *ps_pool = ih264d_get_worker_pool(ps_dec);
+    UWORD32 i;
+
+    for(i = 1; i <= ps_rows->u4_num_workers; i++)
+    {
+        ih264d_thread_pool_wait(ps_pool, &ps_rows->as_worker[i].s_pool_job);
+    }
+    ps_rows->u4_num_workers = 0;
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_wait_recon_rows \endif
+ *
+ * \brief
+ *    Waits till MB u4_mb_num is reconstructed by the row parallel
+ *    reconstruction. A row that no worker has picked yet is picked and
+ *    reconstructed by the calling recon thread as worker 0
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_wait_recon_rows(dec_struct_t *ps_dec, UWORD32 u4_mb_num)
+{
+    recon_rows_ctxt_t *ps_rows = &ps_dec->s_recon_rows;
+    wait_stats_t *ps_stats = &ps_dec->as_wait_stats[WAIT_STATS_RECON_THREAD];
+    UWORD32 u4_row = u4_mb_num / ps_rows->u4_wd_mbs;
+    UWORD32 u4_needed = u4_mb_num - u4_row * ps_rows->u4_wd_mbs + 1;
+    progress_sync_t *ps_prog;
+    WORD32 nop_cnt = PROGRESS_SPIN_CNT;
+
+    /* Rows above are reconstructed, so this row is the next one if unpicked */
+    ithread_mutex_lock(ps_rows->pv_mutex);
+    if(u4_row == ps_rows->u4_next_row)
+    {
+        progress_sync_t *ps_top_prog = NULL;
+
+        ps_rows->pu1_row_worker[u4_row] = 0;
+        ps_rows->u4_next_row++;
+        if(u4_row > 0)
+        {
+            ps_top_prog = &ps_rows->as_worker[ps_rows->pu1_row_worker[u4_row - 1]].s_progress;
+        }
+        ithread_mutex_unlock(ps_rows->pv_mutex);
+
+        ih264d_recon_mb_row(&ps_rows->as_worker[0], u4_row, ps_top_prog);
+        return;
+    }
+    ps_prog = &ps_rows->as_worker[ps_rows->pu1_row_worker[u4_row]].s_progress;
+    ithread_mutex_unlock(ps_rows->pv_mutex);
+
+    while(1)
+    {
+        UWORD32 u4_seq = ih264d_progress_get_seq(ps_prog);
+
+        if(ps_rows->pu4_row_mbs_done[u4_row] >= u4_needed)
+            break;
+
+        if(!ih264d_progress_spin(&nop_cnt, ps_stats))
+            ih264d_progress_sleep(ps_prog, u4_seq, ps_stats);
+    }
+    DATA_SYNC();
+}
+
 void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
 {
     dec_mb_info_t *p_cur_mb;
@@ -399,13 +789,15 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     UWORD32 x_offset, y_offset;
     UWORD32 u4_slice_end;
     pad_mgr_t *ps_pad_mgr ;
+    WORD32 nop_cnt = PROGRESS_SPIN_CNT;
+    wait_stats_t *ps_stats = &ps_dec->as_wait_stats[WAIT_STATS_RECON_THREAD];
 
     /*check for mb map of first mb in slice to ensure slice header is parsed*/
     while(1)
     {
         UWORD32 u4_mb_num = ps_dec->cur_recon_mb_num;
         UWORD32 u4_cond = 0;
-        WORD32 nop_cnt = 8*128;
+        UWORD32 u4_seq = ih264d_progress_get_seq(&ps_dec->s_recon_map_progress);
 
         CHECK_MB_MAP_BYTE(u4_mb_num, ps_dec->pu1_recon_mb_map, u4_cond);
         if(u4_cond)
@@ -414,12 +806,7 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
         }
         else
         {
-            if(nop_cnt > 0)
-            {
-                nop_cnt -= 128;
-                NOP(128);
-            }
-            else
+            if(!ih264d_progress_spin(&nop_cnt, ps_stats))
             {
                 if(ps_dec->u4_output_present &&
                    (ps_dec->u4_fmt_conv_cur_row < ps_dec->s_disp_frame_info.u4_y_ht))
@@ -435,8 +822,9 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
                 }
                 else
                 {
-                    nop_cnt = 8*128;
-                    ithread_yield();
+                    ih264d_progress_sleep(&ps_dec->s_recon_map_progress,
+                                          u4_seq, ps_stats);
+                    nop_cnt = PROGRESS_SPIN_CNT;
                 }
             }
             DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u2_cur_mb_addr  = %d\n",u2_cur_dec_mb_num,
@@ -452,7 +840,7 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     u1_mbaff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
     ps_pad_mgr = &ps_dec->s_pad_mgr;
 
-    if(u2_first_mb_in_slice == 0)
+    if((u2_first_mb_in_slice == 0) && (0 == ps_dec->u4_deblk_in_own_thread))
     ih264d_init_deblk_tfr_ctxt(ps_dec, ps_pad_mgr, ps_tfr_cxt,
                                ps_dec->u2_frm_wd_in_mbs, 0);
 
@@ -512,7 +900,7 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     while(u4_slice_end != 1)
     {
         WORD32 recon_mb_grp,bs_mb_grp;
-        WORD32 nop_cnt = 8*128;
+        nop_cnt = PROGRESS_SPIN_CNT;
         u4_num_mbsleft = ((i2_pic_wdin_mbs - i16_mb_x) << u1_mbaff);
         if(u4_num_mbsleft <= ps_dec->u4_recon_mb_grp)
         {
@@ -532,6 +920,8 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
         {
             UWORD32 u4_cond = 0;
             UWORD32 u4_mb_num = ps_dec->cur_recon_mb_num + recon_mb_grp - 1;
+            UWORD32 u4_seq =
+                            ih264d_progress_get_seq(&ps_dec->s_recon_map_progress);
 
             /*
              * Wait for one extra mb of MC, because some chroma IQ-IT functions
@@ -547,12 +937,7 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
             }
             else
             {
-                if(nop_cnt > 0)
-                {
-                    nop_cnt -= 128;
-                    NOP(128);
-                }
-                else
+                if(!ih264d_progress_spin(&nop_cnt, ps_stats))
                 {
                     if(ps_dec->u4_output_present &&
                        (ps_dec->u4_fmt_conv_cur_row < ps_dec->s_disp_frame_info.u4_y_ht))
@@ -568,8 +953,9 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
                     }
                     else
                     {
-                        nop_cnt = 8*128;
-                        ithread_yield();
+                        ih264d_progress_sleep(&ps_dec->s_recon_map_progress,
+                                              u4_seq, ps_stats);
+                        nop_cnt = PROGRESS_SPIN_CNT;
                     }
                 }
             }
@@ -585,7 +971,11 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
                 u4_slice_end = 1;
                 break;
             }
-            if(ps_dec->i1_recon_in_thread3_flag)
+            if(ps_dec->s_recon_rows.u4_num_workers)
+            {
+                ih264d_wait_recon_rows(ps_dec, ps_dec->cur_recon_mb_num);
+            }
+            else if(ps_dec->i1_recon_in_thread3_flag)
             {
                 ps_cur_mb_info = &ps_dec->ps_frm_mb_info[ps_dec->cur_recon_mb_num];
 
@@ -653,13 +1043,17 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
             ps_dec->u4_bs_cur_slice_num_mbs++;
 
         }
+        DATA_SYNC();
+        ps_dec->u4_bs_done_mb_num = ps_dec->u4_cur_bs_mb_num;
+        ih264d_progress_signal(&ps_dec->s_bs_progress);
 
         if(ps_dec->u4_cur_bs_mb_num > u4_max_addr)
         {
             u4_slice_end = 1;
         }
 
-        /*deblock MB group*/
+        /*deblock MB group, unless ih264d_deblk_picture_thread is doing it*/
+        if(0 == ps_dec->u4_deblk_in_own_thread)
         {
             UWORD32 u4_num_mbs;
 
@@ -680,6 +1074,8 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
                 u4_num_mbs = 0;
 
             ih264d_check_mb_map_deblk(ps_dec, u4_num_mbs, ps_tfr_cxt,0);
+            if(u4_end_of_row)
+                ih264d_fused_fmt_conv_rows(ps_dec);
         }
 
     }
@@ -716,6 +1112,8 @@ void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
                 break;
         }
 
+        ih264d_start_recon_rows(ps_dec);
+
         while(1)
         {
 
@@ -737,6 +1135,12 @@ void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
 
         }
 
+        ih264d_join_recon_rows(ps_dec);
+
+        /* Picture is done only after the trailing deblocking is done */
+        ih264d_signal_deblk_thread(ps_dec);
+        ih264d_fused_fmt_conv_rows(ps_dec);
+
         if(ps_dec->u4_output_present &&
             (3 == ps_dec->u4_num_cores) &&
             (ps_dec->u4_fmt_conv_cur_row < ps_dec->s_disp_frame_info.u4_y_ht))
@@ -771,3 +1175,377 @@ void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
 }
 
 
+
+void ih264d_deblk_picture_wavefront(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
+{
+    UWORD32 u4_num_mbs = ps_dec->ps_cur_sps->u4_max_mb_addr + 1;
+    UWORD32 u4_wd_in_mbs = ps_dec->u2_frm_wd_in_mbs;
+    const WORD32 i4_cb_qp_idx_ofst =
+                    ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
+    const WORD32 i4_cr_qp_idx_ofst =
+                    ps_dec->ps_cur_pps->i1_second_chroma_qp_index_offset;
+    UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag;
+    UWORD32 u4_wd_y, u4_wd_uv;
+    wait_stats_t *ps_stats = &ps_dec->as_wait_stats[WAIT_STATS_DEBLK_THREAD];
+
+    u4_wd_y = ps_dec->u2_frm_wd_y << u1_field_pic_flag;
+    u4_wd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
+
+    ih264d_init_deblk_tfr_ctxt(ps_dec, &ps_dec->s_pad_mgr, ps_tfr_cxt,
+                               u4_wd_in_mbs, 0);
+
+    while(ps_dec->u4_cur_deblk_mb_num < u4_num_mbs)
+    {
+        WORD32 nop_cnt = PROGRESS_SPIN_CNT;
+        UWORD32 u4_mb_num = ps_dec->u4_cur_deblk_mb_num;
+        UWORD32 u4_seq;
+
+        /*
+         * Recon of the right MB has to be done before this MB is filtered,
+         * since its intra pred and chroma IQ-IT read this MB's pixels
+         */
+        u4_mb_num = MIN(u4_mb_num + 1,
+                        (ps_dec->u4_deblk_mb_y + 1) * u4_wd_in_mbs - 1);
+        while(1)
+        {
+            u4_seq = ih264d_progress_get_seq(&ps_dec->s_bs_progress);
+            if(ps_dec->u4_bs_done_mb_num > u4_mb_num)
+                break;
+
+            if(!ih264d_progress_spin(&nop_cnt, ps_stats))
+            {
+                ih264d_progress_sleep(&ps_dec->s_bs_progress, u4_seq, ps_stats);
+                nop_cnt = PROGRESS_SPIN_CNT;
+            }
+        }
+
+        ih264d_deblock_mb_nonmbaff(ps_dec, ps_tfr_cxt,
+                                   i4_cb_qp_idx_ofst, i4_cr_qp_idx_ofst,
+                                   u4_wd_y, u4_wd_uv);
+    }
+}
+
+void ih264d_deblk_picture_thread(dec_struct_t *ps_dec)
+{
+    tfr_ctxt_t s_tfr_ctxt;
+    UWORD32 ret;
+
+    ithread_set_name("ih264d_deblk_picture_thread");
+
+    while(1)
+    {
+        if(ps_dec->i4_threads_active)
+        {
+            ret = ithread_mutex_lock(ps_dec->apv_proc_start_mutex[2]);
+            if(OK != ret)
+                break;
+
+            while(ps_dec->ai4_process_start[2] != PROC_START)
+            {
+                ithread_cond_wait(ps_dec->apv_proc_start_condition[2],
+                                  ps_dec->apv_proc_start_mutex[2]);
+            }
+            ps_dec->ai4_process_start[2] = PROC_IN_PROGRESS;
+
+            ret = ithread_mutex_unlock(ps_dec->apv_proc_start_mutex[2]);
+            if(OK != ret || ps_dec->i4_break_threads == 1)
+                break;
+        }
+
+        ih264d_deblk_picture_wavefront(ps_dec, &s_tfr_ctxt);
+
+        if(ps_dec->i4_threads_active)
+        {
+            ret = ithread_mutex_lock(ps_dec->apv_proc_done_mutex[2]);
+            if(OK != ret)
+                break;
+
+            ps_dec->ai4_process_done[2] = PROC_DONE;
+            ithread_cond_signal(ps_dec->apv_proc_done_condition[2]);
+
+            ret = ithread_mutex_unlock(ps_dec->apv_proc_done_mutex[2]);
+            if(OK != ret)
+                break;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+WORD32 ih264d_start_deblk_thread(dec_struct_t *ps_dec)
+{
+    WORD32 ret;
+
+    /*
+     * Deblocking gets its own thread only when recon runs in thread 3.
+     * Has to be called before ih264d_recon_deblk_thread is started for the
+     * picture, as that thread checks u4_deblk_in_own_thread
+     */
+    ps_dec->u4_deblk_in_own_thread = (ps_dec->u4_num_aux_cores > 0)
+                    && (ps_dec->u4_num_cores == 3);
+    if(0 == ps_dec->u4_deblk_in_own_thread)
+        return OK;
+
+    if(ps_dec->u4_deblk_thread_created == 0)
+    {
+        ih264d_create_proc_thread(ps_dec, 2, ps_dec->pv_deblk_thread_handle,
+                                  (void *)ih264d_deblk_picture_thread);
+        ps_dec->u4_deblk_thread_created = 1;
+    }
+    if(ps_dec->i4_threads_active)
+    {
+        ret = ithread_mutex_lock(ps_dec->apv_proc_start_mutex[2]);
+        RETURN_IF((ret != IV_SUCCESS), ret);
+
+        ps_dec->ai4_process_start[2] = PROC_START;
+        ret = ithread_cond_signal(ps_dec->apv_proc_start_condition[2]);
+        RETURN_IF((ret != IV_SUCCESS), ret);
+
+        ret = ithread_mutex_unlock(ps_dec->apv_proc_start_mutex[2]);
+        RETURN_IF((ret != IV_SUCCESS), ret);
+    }
+    return OK;
+}
+
+void ih264d_signal_deblk_thread(dec_struct_t *ps_dec)
+{
+    if(ps_dec->u4_deblk_in_own_thread && ps_dec->u4_deblk_thread_created)
+    {
+        if(ps_dec->i4_threads_active)
+        {
+            proc_state_t i4_process_state;
+            ithread_mutex_lock(ps_dec->apv_proc_start_mutex[2]);
+            i4_process_state = ps_dec->ai4_process_start[2];
+            ithread_mutex_unlock(ps_dec->apv_proc_start_mutex[2]);
+
+            // only wait if the thread has started deblking
+            if(i4_process_state != PROC_INIT)
+            {
+                ithread_mutex_lock(ps_dec->apv_proc_done_mutex[2]);
+
+                while(ps_dec->ai4_process_done[2] != PROC_DONE)
+                {
+                    ithread_cond_wait(ps_dec->apv_proc_done_condition[2],
+                                        ps_dec->apv_proc_done_mutex[2]);
+                }
+                ps_dec->ai4_process_done[2] = PROC_INIT;
+                ithread_mutex_unlock(ps_dec->apv_proc_done_mutex[2]);
+            }
+        }
+        else
+        {
+            ih264d_join_proc_thread(ps_dec, 2, ps_dec->pv_deblk_thread_handle);
+            ps_dec->u4_deblk_thread_created = 0;
+        }
+    }
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_deblk_rows_worker \endif
+ *
+ * \brief
+ *    Worker of the row parallel picture level deblocking. Picks MB rows in
+ *    order and deblocks each MB once the row above is deblocked up to the
+ *    next MB, as the left edge filtering of that MB is the last write to
+ *    the pixels read by the top edge filtering of this MB. MBAFF pictures
+ *    are handled the same way with MB pair rows
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_deblk_rows_worker(deblk_row_worker_t *ps_worker)
+{
+    dec_struct_t *ps_dec = ps_worker->ps_dec;
+    deblk_rows_ctxt_t *ps_rows = &ps_dec->s_deblk_rows;
+    UWORD32 u4_wd_mbs = ps_rows->u4_wd_mbs;
+    UWORD8 u1_mbaff = ps_rows->u1_mbaff;
+
+    ithread_set_name("ih264d_deblk_rows_worker");
+
+    while(1)
+    {
+        progress_sync_t *ps_top_prog = NULL;
+        UWORD32 u4_top_mbs_done = 0;
+        deblk_mb_t *ps_cur_mb;
+        tfr_ctxt_t s_tfr_ctxt;
+        UWORD8 *pu1_deb_y, *pu1_deb_u, *pu1_deb_v;
+        UWORD32 u4_row, u4_mb_x;
+
+        ithread_mutex_lock(ps_rows->pv_mutex);
+        u4_row = ps_rows->u4_next_row;
+        if(u4_row < ps_rows->u4_ht_mbs)
+        {
+            ps_rows->pu1_row_worker[u4_row] = (UWORD8)ps_worker->u4_idx;
+            ps_rows->u4_next_row++;
+        }
+        if(u4_row > 0)
+        {
+            ps_top_prog = &ps_rows->as_worker[ps_rows->pu1_row_worker[u4_row - 1]].s_progress;
+        }
+        ithread_mutex_unlock(ps_rows->pv_mutex);
+
+        if(u4_row >= ps_rows->u4_ht_mbs)
+            break;
+
+        s_tfr_ctxt = ps_rows->s_tfr_ctxt;
+        pu1_deb_y = s_tfr_ctxt.pu1_mb_y + u4_row * (16 << u1_mbaff) * ps_rows->i4_strd_y;
+        pu1_deb_u = s_tfr_ctxt.pu1_mb_u + u4_row * (8 << u1_mbaff) * ps_rows->i4_strd_uv;
+        pu1_deb_v = s_tfr_ctxt.pu1_mb_v + u4_row * (8 << u1_mbaff) * ps_rows->i4_strd_uv;
+        ps_cur_mb = ps_rows->ps_deblk_mb + u4_row * (u4_wd_mbs << u1_mbaff);
+
+        for(u4_mb_x = 0; u4_mb_x < u4_wd_mbs; u4_mb_x++)
+        {
+            if(NULL != ps_top_prog)
+            {
+                UWORD32 u4_needed = MIN(u4_mb_x + 2, u4_wd_mbs);
+                WORD32 nop_cnt = PROGRESS_SPIN_CNT;
+
+                while(u4_top_mbs_done < u4_needed)
+                {
+                    UWORD32 u4_seq = ih264d_progress_get_seq(ps_top_prog);
+
+                    u4_top_mbs_done = ps_rows->pu4_row_mbs_done[u4_row - 1];
+                    if(u4_top_mbs_done >= u4_needed)
+                        break;
+
+                    if(!ih264d_progress_spin(&nop_cnt, &ps_worker->s_wait_stats))
+                        ih264d_progress_sleep(ps_top_prog, u4_seq,
+                                              &ps_worker->s_wait_stats);
+                }
+                DATA_SYNC();
+            }
+
+            s_tfr_ctxt.pu1_mb_y = pu1_deb_y;
+            s_tfr_ctxt.pu1_mb_u = pu1_deb_u;
+            s_tfr_ctxt.pu1_mb_v = pu1_deb_v;
+            if(u1_mbaff)
+            {
+                ih264d_filter_mb_pair_mbaff(ps_dec, &s_tfr_ctxt, ps_cur_mb,
+                                            u4_mb_x, (0 == u4_row),
+                                            ps_rows->i1_cb_qp_idx_ofst,
+                                            ps_rows->i1_cr_qp_idx_ofst,
+                                            ps_rows->i4_strd_y,
+                                            ps_rows->i4_strd_uv);
+            }
+            else
+            {
+                ih264d_filter_mb_nonmbaff(ps_dec, &s_tfr_ctxt, ps_cur_mb,
+                                          u4_mb_x, u4_row,
+                                          ps_rows->i1_cb_qp_idx_ofst,
+                                          ps_rows->i1_cr_qp_idx_ofst,
+                                          ps_rows->i4_strd_y,
+                                          ps_rows->i4_strd_uv);
+            }
+
+            pu1_deb_y += 16;
+            pu1_deb_u += 8 * YUV420SP_FACTOR;
+            pu1_deb_v += 8;
+            ps_cur_mb += 1 << u1_mbaff;
+
+            DATA_SYNC();
+            ps_rows->pu4_row_mbs_done[u4_row] = u4_mb_x + 1;
+            ih264d_progress_signal(&ps_worker->s_progress);
+        }
+
+        /* Rows above this one are not written to any more */
+        if(ps_rows->i4_publish_rows)
+        {
+            ithread_mutex_lock(ps_rows->pv_mutex);
+            if(u4_row > ps_rows->u4_rows_published)
+            {
+                ps_rows->u4_rows_published = u4_row;
+                ih264d_publish_rows_done(ps_dec, u4_row);
+            }
+            ithread_mutex_unlock(ps_rows->pv_mutex);
+        }
+    }
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_deblock_rows_parallel \endif
+ *
+ * \brief
+ *    Deblocks the current picture from its top, with MB rows spread over
+ *    the calling thread and the jobs of the worker pool. u1_mbaff is set
+ *    for MBAFF pictures, which are deblocked by MB pair rows
+ *
+ * \return
+ *    1 if the picture is deblocked, 0 if it has to be deblocked serially
+ **************************************************************************
+ */
+WORD32 ih264d_deblock_rows_parallel(dec_struct_t *ps_dec,
+                                    tfr_ctxt_t *ps_tfr_cxt,
+                                    WORD8 i1_cb_qp_idx_ofst,
+                                    WORD8 i1_cr_qp_idx_ofst,
+                                    WORD32 i4_strd_y,
+                                    WORD32 i4_strd_uv,
+                                    UWORD8 u1_mbaff)
+{
+    deblk_rows_ctxt_t *ps_rows = &ps_dec->s_deblk_rows;
+    thread_pool_t *ps_pool = ih264d_get_worker_pool(ps_dec);
+    UWORD32 u4_wd_mbs = ps_dec->u2_frm_wd_in_mbs;
+    UWORD32 u4_ht_mbs = ps_dec->u2_frm_ht_in_mbs >> u1_mbaff;
+    UWORD32 u4_num_workers, i;
+
+    /* Decoders without a worker pool deblock serially */
+    if((NULL == ps_pool) || (NULL == ps_rows->pv_mutex)
+                    || (NULL == ps_rows->pu4_row_mbs_done)
+                    || (u4_ht_mbs > ps_rows->u4_max_rows))
+        return 0;
+
+    if(!u1_mbaff && (ps_dec->u4_deblk_mb_x || ps_dec->u4_deblk_mb_y))
+        return 0;
+
+    u4_num_workers = ps_pool->u4_num_threads + 1;
+    u4_num_workers = MIN(u4_num_workers, H264_MAX_NUM_CORES);
+    u4_num_workers = MIN(u4_num_workers, u4_ht_mbs);
+    if(u4_num_workers < 2)
+        return 0;
+
+    ps_rows->s_tfr_ctxt = *ps_tfr_cxt;
+    ps_rows->ps_deblk_mb = u1_mbaff ? ps_dec->ps_deblk_pic : ps_dec->ps_cur_deblk_mb;
+    ps_rows->u4_wd_mbs = u4_wd_mbs;
+    ps_rows->u4_ht_mbs = u4_ht_mbs;
+    ps_rows->i4_strd_y = i4_strd_y;
+    ps_rows->i4_strd_uv = i4_strd_uv;
+    ps_rows->i1_cb_qp_idx_ofst = i1_cb_qp_idx_ofst;
+    ps_rows->i1_cr_qp_idx_ofst = i1_cr_qp_idx_ofst;
+    ps_rows->i4_publish_rows = !ps_dec->ps_cur_slice->u1_field_pic_flag && !u1_mbaff;
+    ps_rows->u1_mbaff = u1_mbaff;
+    ps_rows->u4_next_row = 0;
+    ps_rows->u4_rows_published = 0;
+    memset((void *)ps_rows->pu4_row_mbs_done, 0, u4_ht_mbs * sizeof(UWORD32));
+
+    /* Rows are picked in order, so a worker only ever waits for a row that
+     * is picked already, even if it is started after the others end */
+    for(i = 1; i < u4_num_workers; i++)
+    {
+        deblk_row_worker_t *ps_worker = &ps_rows->as_worker[i];
+
+        ih264d_thread_pool_submit(ps_pool, &ps_worker->s_pool_job,
+                                  (pf_pool_job_t)ih264d_deblk_rows_worker,
+                                  (void *)ps_worker);
+    }
+
+    ih264d_deblk_rows_worker(&ps_rows->as_worker[0]);
+
+    for(i = 1; i < u4_num_workers; i++)
+    {
+        ih264d_thread_pool_wait(ps_pool, &ps_rows->as_worker[i].s_pool_job);
+    }
+
+    if(u1_mbaff)
+        return 1;
+
+    /* Leave the deblocking position where the serial deblocking would */
+    ps_dec->u4_deblk_mb_y = u4_ht_mbs;
+    ps_dec->ps_cur_deblk_mb += u4_ht_mbs * u4_wd_mbs;
+    ps_dec->u4_cur_deblk_mb_num += u4_ht_mbs * u4_wd_mbs;
+
+    return 1;
+}
@@ -35,4 +35,16 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec,
                                     UWORD32 deblk_mb_grp,
                                     tfr_ctxt_t *ps_tfr_cxt,
                                     UWORD32 u4_check_mb_map);
+void ih264d_deblk_picture_wavefront(dec_struct_t *ps_dec,
+                                    tfr_ctxt_t *ps_tfr_cxt);
+void ih264d_deblk_picture_thread(dec_struct_t *ps_dec);
+WORD32 ih264d_start_deblk_thread(dec_struct_t *ps_dec);
+void ih264d_signal_deblk_thread(dec_struct_t *ps_dec);
+WORD32 ih264d_deblock_rows_parallel(dec_struct_t *ps_dec,
+                                    tfr_ctxt_t *ps_tfr_cxt,
+                                    WORD8 i1_cb_qp_idx_ofst,
+                                    WORD8 i1_cr_qp_idx_ofst,
+                                    WORD32 i4_strd_y,
+                                    WORD32 i4_strd_uv,
+                                    UWORD8 u1_mbaff);
 #endif /* _IH264D_THREAD_COMPUTE_BS_H_ */
@@ -93,6 +93,7 @@ void ih264d_parse_tfr_nmb(dec_struct_t * ps_dec,
 
             u4_mb_num++;
         }
+        ih264d_progress_signal(&ps_dec->s_dec_map_progress);
 
         /****************************************************************/
         /* Check for End Of Row in Next iteration                       */
@@ -213,7 +214,8 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
     UWORD16 u2_slice_num,u2_cur_dec_mb_num;
     WORD32 ret;
     UWORD32 u4_mb_num;
-    WORD32 nop_cnt = 8*128;
+    WORD32 nop_cnt = PROGRESS_SPIN_CNT;
+    wait_stats_t *ps_stats = &ps_dec->as_wait_stats[WAIT_STATS_DECODE_THREAD];
     u1_slice_type = ps_dec->ps_decode_cur_slice->slice_type;
 
     u1_B = (u1_slice_type == B_SLICE);
@@ -229,6 +231,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
     {
 
         UWORD32 u4_max_mb = (UWORD32)(ps_dec->i2_dec_thread_mb_y + (1 << u1_mbaff)) * ps_dec->u2_frm_wd_in_mbs - 1;
+        UWORD32 u4_seq = ih264d_progress_get_seq(&ps_dec->s_dec_map_progress);
         u4_mb_num = u2_cur_dec_mb_num;
         /*introducing 1 MB delay*/
         u4_mb_num = MIN(u4_mb_num + u4_num_mbs + 1, u4_max_mb);
@@ -240,12 +243,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
         }
         else
         {
-            if(nop_cnt > 0)
-            {
-                nop_cnt -= 128;
-                NOP(128);
-            }
-            else
+            if(!ih264d_progress_spin(&nop_cnt, ps_stats))
             {
                 if(ps_dec->u4_output_present && (2 == ps_dec->u4_num_cores) &&
                    (ps_dec->u4_fmt_conv_cur_row < ps_dec->s_disp_frame_info.u4_y_ht))
@@ -261,8 +259,9 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
                 }
                 else
                 {
-                    nop_cnt = 8*128;
-                    ithread_yield();
+                    ih264d_progress_sleep(&ps_dec->s_dec_map_progress, u4_seq,
+                                          ps_stats);
+                    nop_cnt = PROGRESS_SPIN_CNT;
                 }
             }
         }
@@ -389,6 +388,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
         }
         ps_dec->cur_dec_mb_num++;
      }
+    ih264d_progress_signal(&ps_dec->s_recon_map_progress);
 
     /*N MB deblocking*/
     if(ps_dec->u4_nmb_deblk == 1)
@@ -448,13 +448,16 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
     WORD32 ret;
 
     tfr_ctxt_t *ps_trns_addr;
+    WORD32 nop_cnt = PROGRESS_SPIN_CNT;
+    wait_stats_t *ps_stats = &ps_dec->as_wait_stats[WAIT_STATS_DECODE_THREAD];
 
     /*check for mb map of first mb in slice to ensure slice header is parsed*/
     while(1)
     {
         UWORD32 u4_mb_num = ps_dec->cur_dec_mb_num;
         UWORD32 u4_cond = 0;
-        WORD32 nop_cnt = 8 * 128;
+        UWORD32 u4_seq = ih264d_progress_get_seq(&ps_dec->s_dec_map_progress);
+
         CHECK_MB_MAP_BYTE(u4_mb_num, ps_dec->pu1_dec_mb_map, u4_cond);
         if(u4_cond)
         {
@@ -462,12 +465,10 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
         }
         else
         {
-            if(nop_cnt > 0)
-            {
-                nop_cnt -= 128;
-                NOP(128);
-            }
-            else if(ps_dec->u4_output_present && (2 == ps_dec->u4_num_cores) &&
+            if(ih264d_progress_spin(&nop_cnt, ps_stats))
+                continue;
+
+            if(ps_dec->u4_output_present && (2 == ps_dec->u4_num_cores) &&
                (ps_dec->u4_fmt_conv_cur_row < ps_dec->s_disp_frame_info.u4_y_ht))
             {
                 ps_dec->u4_fmt_conv_num_rows =
@@ -481,8 +482,9 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
             }
             else
             {
-                nop_cnt = 8*128;
-                ithread_yield();
+                ih264d_progress_sleep(&ps_dec->s_dec_map_progress, u4_seq,
+                                      ps_stats);
+                nop_cnt = PROGRESS_SPIN_CNT;
             }
             DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u4_cur_mb_addr  = %d\n",u2_cur_dec_mb_num,
                             ps_dec->u4_cur_mb_addr);
@@ -696,7 +698,7 @@ void ih264d_signal_decode_thread(dec_struct_t *ps_dec)
         }
         else
         {
-            ithread_join(ps_dec->pv_dec_thread_handle, NULL);
+            ih264d_join_proc_thread(ps_dec, 0, ps_dec->pv_dec_thread_handle);
             ps_dec->u4_dec_thread_created = 0;
         }
     }
@@ -728,9 +730,84 @@ void ih264d_signal_bs_deblk_thread(dec_struct_t *ps_dec)
         }
         else
         {
-            ithread_join(ps_dec->pv_bs_deblk_thread_handle, NULL);
+            ih264d_join_proc_thread(ps_dec, 1, ps_dec->pv_bs_deblk_thread_handle);
             ps_dec->u4_bs_deblk_thread_created = 0;
         }
     }
 
 }
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_create_proc_thread \endif
+ *
+ * \brief
+ *    Starts one of the decoder threads. If a shared worker pool is set, the
+ *    thread function is queued as a job of the pool instead
+ *
+ * \return
+ *    0 on Success and error code otherwise
+ **************************************************************************
+ */
+WORD32 ih264d_create_proc_thread(dec_struct_t *ps_dec,
+                                 UWORD32 u4_thread_idx,
+                                 void *pv_thread_handle,
+                                 void *pv_thread_func)
+{
+    if(ps_dec->ps_thread_pool)
+    {
+        ih264d_thread_pool_submit(ps_dec->ps_thread_pool,
+                                  &ps_dec->as_pool_job[u4_thread_idx],
+                                  (pf_pool_job_t)pv_thread_func,
+                                  (void *)ps_dec);
+        return OK;
+    }
+
+    return ithread_create(pv_thread_handle, NULL, pv_thread_func,
+                          (void *)ps_dec);
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_join_proc_thread \endif
+ *
+ * \brief
+ *    Waits for a thread started by ih264d_create_proc_thread to exit
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+void ih264d_join_proc_thread(dec_struct_t *ps_dec,
+                             UWORD32 u4_thread_idx,
+                             void *pv_thread_handle)
+{
+    if(ps_dec->ps_thread_pool)
+    {
+        ih264d_thread_pool_wait(ps_dec->ps_thread_pool,
+                                &ps_dec->as_pool_job[u4_thread_idx]);
+        return;
+    }
+
+    ithread_join(pv_thread_handle, NULL);
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_get_worker_pool \endif
+ *
+ * \brief
+ *    Returns the pool that the stages splitting a picture over workers run
+ *    on: the shared pool if one is set, else the decoder's own pool
+ *
+ * \return
+ *    Pool, NULL if the picture is to be processed serially
+ **************************************************************************
+ */
+thread_pool_t *ih264d_get_worker_pool(dec_struct_t *ps_dec)
+{
+    if(ps_dec->ps_thread_pool)
+        return ps_dec->ps_thread_pool;
+
+    return ps_dec->ps_own_pool;
+}
@@ -42,6 +42,14 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
                                           UWORD32 u4_end_of_row);
 void ih264d_decode_picture_thread(dec_struct_t *ps_dec);
 WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec);
+WORD32 ih264d_create_proc_thread(dec_struct_t *ps_dec,
+                                 UWORD32 u4_thread_idx,
+                                 void *pv_thread_handle,
+                                 void *pv_thread_func);
+void ih264d_join_proc_thread(dec_struct_t *ps_dec,
+                             UWORD32 u4_thread_idx,
+                             void *pv_thread_handle);
+thread_pool_t *ih264d_get_worker_pool(dec_struct_t *ps_dec);
 
 
 
@@ -0,0 +1,342 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_thread_pool.c
+ *
+ * @brief
+ *  Worker pool shared by decoder instances
+ *
+ * @par List of Functions:
+ *  - ih264d_create_thread_pool()
+ *  - ih264d_delete_thread_pool()
+ *  - ih264d_thread_pool_worker()
+ *  - ih264d_thread_pool_submit()
+ *  - ih264d_thread_pool_wait()
+ *
+ * @remarks
+ *  The decoder stages run as jobs of the pool block on the progress of the
+ *  stages queued before them for the same picture. Jobs are therefore picked
+ *  in FIFO order, and a thread waiting for a job that is not picked yet runs
+ *  the job itself. This way a stage never waits for a stage that cannot run.
+ *  Stages do not yield while they wait, so a blocked stage keeps its thread
+ *  and the threads in use follow the number of pictures in flight.
+ *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
+#include "ithread.h"
+#include "ih264d_thread_pool.h"
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Worker thread of the pool. Runs the queued jobs until the pool is deleted
+ *
+ * @param[in] ps_pool
+ *  Pool
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+static void ih264d_thread_pool_worker(thread_pool_t *ps_pool)
+{
+    ithread_set_name("ih264d_thread_pool_worker");
+
+    ithread_mutex_lock(ps_pool->pv_mutex);
+    while(1)
+    {
+        pool_job_t *ps_job;
+
+        while((NULL == ps_pool->ps_head) && (0 == ps_pool->i4_exit))
+        {
+            ithread_cond_wait(ps_pool->pv_cond, ps_pool->pv_mutex);
+        }
+        if(NULL == ps_pool->ps_head)
+            break;
+
+        ps_job = ps_pool->ps_head;
+        ps_pool->ps_head = ps_job->ps_next;
+        if(NULL == ps_pool->ps_head)
+            ps_pool->ps_tail = NULL;
+        ps_job->i4_state = POOL_JOB_RUNNING;
+        ithread_mutex_unlock(ps_pool->pv_mutex);
+
+        ps_job->pf_job(ps_job->pv_arg);
+
+        ithread_mutex_lock(ps_pool->pv_mutex);
+        ps_job->i4_state = POOL_JOB_DONE;
+        ithread_cond_broadcast(ps_job->pv_done_cond);
+    }
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Queues a job at the end of the pool's FIFO
+ *
+ * @param[in] ps_pool
+ *  Pool
+ *
+ * @param[in] ps_job
+ *  Job, which must not be queued or running already
+ *
+ * @param[in] pf_job
+ *  Function to be run
+ *
+ * @param[in] pv_arg
+ *  Argument to pf_job
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_thread_pool_submit(thread_pool_t *ps_pool,
+                               pool_job_t *ps_job,
+                               pf_pool_job_t pf_job,
+                               void *pv_arg)
+{
+    ithread_mutex_lock(ps_pool->pv_mutex);
+
+    ps_job->pf_job = pf_job;
+    ps_job->pv_arg = pv_arg;
+    ps_job->ps_next = NULL;
+    ps_job->i4_state = POOL_JOB_QUEUED;
+
+    if(NULL == ps_pool->ps_tail)
+        ps_pool->ps_head = ps_job;
+    else
+        ps_pool->ps_tail->ps_next = ps_job;
+    ps_pool->ps_tail = ps_job;
+
+    ithread_cond_signal(ps_pool->pv_cond);
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Waits for a job to complete. If no worker has picked the job yet, it is
+ *  removed from the queue and run by the calling thread
+ *
+ * @param[in] ps_pool
+ *  Pool
+ *
+ * @param[in] ps_job
+ *  Job
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_thread_pool_wait(thread_pool_t *ps_pool, pool_job_t *ps_job)
+{
+    ithread_mutex_lock(ps_pool->pv_mutex);
+
+    if(POOL_JOB_QUEUED == ps_job->i4_state)
+    {
+        pool_job_t *ps_prev = NULL;
+        pool_job_t *ps_cur = ps_pool->ps_head;
+
+        while(ps_cur != ps_job)
+        {
+            ps_prev = ps_cur;
+            ps_cur = ps_cur->ps_next;
+        }
+        if(NULL == ps_prev)
+            ps_pool->ps_head = ps_job->ps_next;
+        else
+            ps_prev->ps_next = ps_job->ps_next;
+        if(ps_pool->ps_tail == ps_job)
+            ps_pool->ps_tail = ps_prev;
+
+        ps_job->i4_state = POOL_JOB_RUNNING;
+        ithread_mutex_unlock(ps_pool->pv_mutex);
+
+        ps_job->pf_job(ps_job->pv_arg);
+
+        ithread_mutex_lock(ps_pool->pv_mutex);
+        ps_job->i4_state = POOL_JOB_DONE;
+    }
+
+    while(POOL_JOB_RUNNING == ps_job->i4_state)
+    {
+        ithread_cond_wait(ps_job->pv_done_cond, ps_pool->pv_mutex);
+    }
+    ps_job->i4_state = POOL_JOB_IDLE;
+
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Creates a worker pool that can be shared by decoder instances
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to ih264d_create_thread_pool_ip_t
+ *
+ * @param[out] pv_api_op
+ *  Pointer to ih264d_create_thread_pool_op_t
+ *
+ * @returns  IV_SUCCESS / IV_FAIL
+ *
+ *******************************************************************************
+ */
+IV_API_CALL_STATUS_T ih264d_create_thread_pool(void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_create_thread_pool_ip_t *ps_ip;
+    ih264d_create_thread_pool_op_t *ps_op;
+    thread_pool_t *ps_pool;
+    UWORD32 u4_handle_size, u4_mutex_size, u4_cond_size, u4_size;
+    UWORD8 *pu1_buf;
+    UWORD32 i;
+    WORD32 ret;
+
+    ps_ip = (ih264d_create_thread_pool_ip_t *)pv_api_ip;
+    ps_op = (ih264d_create_thread_pool_op_t *)pv_api_op;
+
+    if((NULL == ps_ip) || (NULL == ps_op))
+        return IV_FAIL;
+
+    if(ps_op->u4_size != sizeof(ih264d_create_thread_pool_op_t))
+        return IV_FAIL;
+
+    ps_op->u4_error_code = 0;
+    ps_op->pv_thread_pool = NULL;
+
+    if(ps_ip->u4_size != sizeof(ih264d_create_thread_pool_ip_t))
+    {
+        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+        ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+        return IV_FAIL;
+    }
+
+    if((ps_ip->u4_num_threads < 1)
+                    || (ps_ip->u4_num_threads > THREAD_POOL_MAX_THREADS)
+                    || (NULL == ps_ip->pf_aligned_alloc)
+                    || (NULL == ps_ip->pf_aligned_free))
+    {
+        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+        return IV_FAIL;
+    }
+
+    u4_handle_size = ALIGN128(ithread_get_handle_size());
+    u4_mutex_size = ALIGN128(ithread_get_mutex_lock_size());
+    u4_cond_size = ALIGN128(ithread_get_cond_struct_size());
+    u4_size = ALIGN128(sizeof(thread_pool_t)) + u4_mutex_size + u4_cond_size
+                    + ps_ip->u4_num_threads * u4_handle_size;
+
+    pu1_buf = ps_ip->pf_aligned_alloc(ps_ip->pv_mem_ctxt, 128, u4_size);
+    if(NULL == pu1_buf)
+    {
+        ps_op->u4_error_code = IVD_MEM_ALLOC_FAILED;
+        return IV_FAIL;
+    }
+
+    ps_pool = (thread_pool_t *)pu1_buf;
+    pu1_buf += ALIGN128(sizeof(thread_pool_t));
+    ps_pool->pv_mutex = pu1_buf;
+    pu1_buf += u4_mutex_size;
+    ps_pool->pv_cond = pu1_buf;
+    pu1_buf += u4_cond_size;
+    ps_pool->pu1_thread_handles = pu1_buf;
+
+    ps_pool->u4_num_threads = 0;
+    ps_pool->ps_head = NULL;
+    ps_pool->ps_tail = NULL;
+    ps_pool->i4_exit = 0;
+    ps_pool->pv_mem_ctxt = ps_ip->pv_mem_ctxt;
+    ps_pool->pf_aligned_free = ps_ip->pf_aligned_free;
+
+    ithread_mutex_init(ps_pool->pv_mutex);
+    ithread_cond_init(ps_pool->pv_cond);
+
+    for(i = 0; i < ps_ip->u4_num_threads; i++)
+    {
+        ret = ithread_create(ps_pool->pu1_thread_handles + i * u4_handle_size,
+                             NULL, (void *)ih264d_thread_pool_worker,
+                             (void *)ps_pool);
+        if(0 != ret)
+        {
+            ih264d_delete_thread_pool(ps_pool);
+            ps_op->u4_error_code = IVD_MEM_ALLOC_FAILED;
+            return IV_FAIL;
+        }
+        ps_pool->u4_num_threads++;
+    }
+
+    ps_op->pv_thread_pool = ps_pool;
+    return IV_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Stops the workers and frees the pool. To be called after all the decoders
+ *  using the pool are deleted
+ *
+ * @param[in] pv_thread_pool
+ *  Pool handle returned by ih264d_create_thread_pool()
+ *
+ * @returns  IV_SUCCESS / IV_FAIL
+ *
+ *******************************************************************************
+ */
+IV_API_CALL_STATUS_T ih264d_delete_thread_pool(void *pv_thread_pool)
+{
+    thread_pool_t *ps_pool = (thread_pool_t *)pv_thread_pool;
+    UWORD32 u4_handle_size = ALIGN128(ithread_get_handle_size());
+    UWORD32 i;
+
+    if(NULL == ps_pool)
+        return IV_FAIL;
+
+    ithread_mutex_lock(ps_pool->pv_mutex);
+    ps_pool->i4_exit = 1;
+    ithread_cond_broadcast(ps_pool->pv_cond);
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+
+    for(i = 0; i < ps_pool->u4_num_threads; i++)
+    {
+        ithread_join(ps_pool->pu1_thread_handles + i * u4_handle_size, NULL);
+    }
+
+    ithread_cond_destroy(ps_pool->pv_cond);
+    ithread_mutex_destroy(ps_pool->pv_mutex);
+    ps_pool->pf_aligned_free(ps_pool->pv_mem_ctxt, ps_pool);
+
+    return IV_SUCCESS;
+}
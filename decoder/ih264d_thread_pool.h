@@ -0,0 +1,103 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_thread_pool.h
+ *
+ * @brief
+ *  Worker pool shared by decoder instances
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+
+#ifndef _IH264D_THREAD_POOL_H_
+#define _IH264D_THREAD_POOL_H_
+
+/** Maximum number of worker threads in a pool */
+#define THREAD_POOL_MAX_THREADS     64
+
+typedef void (*pf_pool_job_t)(void *pv_arg);
+
+typedef enum
+{
+    POOL_JOB_IDLE = 0,
+    POOL_JOB_QUEUED,
+    POOL_JOB_RUNNING,
+    POOL_JOB_DONE
+}POOL_JOB_STATE_T;
+
+/**
+ * A job of the pool. Owned by the submitter and reused across pictures, so
+ * that submitting does not allocate
+ */
+typedef struct pool_job_t
+{
+    /** Next job in the queue */
+    struct pool_job_t *ps_next;
+
+    /** Function run by the job and its argument */
+    pf_pool_job_t pf_job;
+    void *pv_arg;
+
+    /** POOL_JOB_STATE_T, protected by the pool mutex */
+    WORD32 i4_state;
+
+    /** Signalled when the job is done, of size ithread_get_cond_struct_size() */
+    void *pv_done_cond;
+}pool_job_t;
+
+typedef struct
+{
+    /** Number of worker threads */
+    UWORD32 u4_num_threads;
+
+    /** Worker thread handles, each of size ithread_get_handle_size() */
+    UWORD8 *pu1_thread_handles;
+
+    /** Protects the queue and the state of the queued jobs */
+    void *pv_mutex;
+
+    /** Signalled when a job is queued or the pool is deleted */
+    void *pv_cond;
+
+    /** FIFO of queued jobs */
+    pool_job_t *ps_head;
+    pool_job_t *ps_tail;
+
+    /** Set when the pool is being deleted */
+    WORD32 i4_exit;
+
+    /** Memory manager of the application */
+    void *pv_mem_ctxt;
+    void (*pf_aligned_free)(void *pv_mem_ctxt, void *pv_buf);
+}thread_pool_t;
+
+void ih264d_thread_pool_submit(thread_pool_t *ps_pool,
+                               pool_job_t *ps_job,
+                               pf_pool_job_t pf_job,
+                               void *pv_arg);
+
+void ih264d_thread_pool_wait(thread_pool_t *ps_pool, pool_job_t *ps_job);
+
+#endif /* _IH264D_THREAD_POOL_H_ */
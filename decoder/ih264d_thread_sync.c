@@ -0,0 +1,245 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_thread_sync.c
+ *
+ * @brief
+ *  Progress based wait / wake-up between decoder threads
+ *
+ * @par List of Functions:
+ *  - ih264d_progress_init()
+ *  - ih264d_progress_deinit()
+ *  - ih264d_progress_get_seq()
+ *  - ih264d_progress_signal()
+ *  - ih264d_progress_spin()
+ *  - ih264d_progress_sleep()
+ *
+ * @remarks
+ *  A consumer reads the sequence number before checking the progress it is
+ *  waiting for. If the check fails, it spins for a bounded time and then
+ *  sleeps until the sequence number moves. The producer bumps the sequence
+ *  number after publishing progress and wakes up the consumers only if some
+ *  are sleeping, so the common path does not touch the mutex.
+ *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ithread.h"
+#include "ih264d_thread_sync.h"
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Initializes a progress sync object
+ *
+ * @param[in] ps_prog
+ *  Progress sync object
+ *
+ * @param[in] pv_mutex
+ *  Memory for the mutex, of size ithread_get_mutex_lock_size()
+ *
+ * @param[in] pv_cond
+ *  Memory for the condition, of size ithread_get_cond_struct_size()
+ *
+ * @returns  0 on success, error otherwise
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_progress_init(progress_sync_t *ps_prog,
+                            void *pv_mutex,
+                            void *pv_cond)
+{
+    WORD32 ret;
+
+    ps_prog->u4_seq = 0;
+    ps_prog->i4_num_waiters = 0;
+    ps_prog->pv_mutex = pv_mutex;
+    ps_prog->pv_cond = pv_cond;
+
+    ret = ithread_mutex_init(pv_mutex);
+    RETURN_IF((ret != 0), ret);
+
+    return ithread_cond_init(pv_cond);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Destroys the mutex and condition of a progress sync object
+ *
+ * @param[in] ps_prog
+ *  Progress sync object
+ *
+ * @returns  None
+ *
+ *******************************************************************************
+ */
+void ih264d_progress_deinit(progress_sync_t *ps_prog)
+{
+    ithread_cond_destroy(ps_prog->pv_cond);
+    ithread_mutex_destroy(ps_prog->pv_mutex);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Returns the current sequence number. To be read before the consumer
+ *  checks for progress
+ *
+ * @param[in] ps_prog
+ *  Progress sync object
+ *
+ * @returns  Sequence number
+ *
+ *******************************************************************************
+ */
+UWORD32 ih264d_progress_get_seq(progress_sync_t *ps_prog)
+{
+    UWORD32 u4_seq = ps_prog->u4_seq;
+
+    DATA_SYNC();
+    return u4_seq;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Called by the producer after publishing progress
+ *
+ * @param[in] ps_prog
+ *  Progress sync object
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  Only one thread is expected to produce progress on an object
+ *
+ *******************************************************************************
+ */
+void ih264d_progress_signal(progress_sync_t *ps_prog)
+{
+    DATA_SYNC();
+    ps_prog->u4_seq++;
+    DATA_SYNC();
+
+    if(ps_prog->i4_num_waiters)
+    {
+        ithread_mutex_lock(ps_prog->pv_mutex);
+        ithread_cond_broadcast(ps_prog->pv_cond);
+        ithread_mutex_unlock(ps_prog->pv_mutex);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Spins for one round if the spin budget is not exhausted
+ *
+ * @param[in,out] pi4_nop_cnt
+ *  Remaining spin budget, to be initialized to PROGRESS_SPIN_CNT by the caller
+ *
+ * @param[in] ps_stats
+ *  Wait statistics of the calling thread
+ *
+ * @returns  1 if it spun, 0 if the budget is exhausted
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_progress_spin(WORD32 *pi4_nop_cnt, wait_stats_t *ps_stats)
+{
+    UWORD32 u4_start_time_us;
+
+    if(*pi4_nop_cnt <= 0)
+        return 0;
+
+    if(*pi4_nop_cnt == PROGRESS_SPIN_CNT)
+        ps_stats->u4_num_waits++;
+
+    *pi4_nop_cnt -= 128;
+    ps_stats->u4_num_spins++;
+    u4_start_time_us = ithread_get_time_us();
+    NOP(128);
+    ps_stats->u8_wait_time_us += ithread_get_time_us() - u4_start_time_us;
+    return 1;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Sleeps until the producer publishes progress after u4_seq was read
+ *
+ * @param[in] ps_prog
+ *  Progress sync object
+ *
+ * @param[in] u4_seq
+ *  Sequence number read before the failed progress check
+ *
+ * @param[in] ps_stats
+ *  Wait statistics of the calling thread
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  Yields instead, if the sync object is not initialized
+ *
+ *******************************************************************************
+ */
+void ih264d_progress_sleep(progress_sync_t *ps_prog,
+                           UWORD32 u4_seq,
+                           wait_stats_t *ps_stats)
+{
+    UWORD32 u4_start_time_us = ithread_get_time_us();
+
+    ps_stats->u4_num_sleeps++;
+
+    /* Decoders that do not set up the sync objects fall back to yielding */
+    if(NULL == ps_prog->pv_mutex)
+    {
+        ithread_yield();
+        ps_stats->u8_wait_time_us += ithread_get_time_us() - u4_start_time_us;
+        return;
+    }
+
+    ithread_mutex_lock(ps_prog->pv_mutex);
+    ps_prog->i4_num_waiters++;
+    DATA_SYNC();
+
+    while(u4_seq == ps_prog->u4_seq)
+    {
+        ithread_cond_wait(ps_prog->pv_cond, ps_prog->pv_mutex);
+    }
+
+    ps_prog->i4_num_waiters--;
+    ithread_mutex_unlock(ps_prog->pv_mutex);
+    ps_stats->u8_wait_time_us += ithread_get_time_us() - u4_start_time_us;
+}
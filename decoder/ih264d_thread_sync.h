@@ -0,0 +1,99 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_thread_sync.h
+ *
+ * @brief
+ *  Progress based wait / wake-up between decoder threads
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+
+#ifndef _IH264D_THREAD_SYNC_H_
+#define _IH264D_THREAD_SYNC_H_
+
+/** Spin budget (in NOP cycles) before a waiting thread goes to sleep */
+#define PROGRESS_SPIN_CNT       (8 * 128)
+
+/** Threads for which wait statistics are maintained */
+typedef enum
+{
+    WAIT_STATS_PARSE_THREAD = 0,
+    WAIT_STATS_DECODE_THREAD,
+    WAIT_STATS_RECON_THREAD,
+    WAIT_STATS_DEBLK_THREAD,
+    WAIT_STATS_NUM_THREADS
+}WAIT_STATS_THREAD_T;
+
+/**
+ * Progress published by a single producer thread (e.g. an MB map). Consumers
+ * spin for a bounded time and then sleep until the producer publishes again
+ */
+typedef struct
+{
+    /** Incremented by the producer after every progress update */
+    volatile UWORD32 u4_seq;
+
+    /** Number of consumers sleeping on this progress */
+    volatile WORD32 i4_num_waiters;
+
+    /** Mutex and condition used for sleeping */
+    void *pv_mutex;
+    void *pv_cond;
+}progress_sync_t;
+
+/** Wait statistics of one thread */
+typedef struct
+{
+    /** Waits that were not satisfied on the first check */
+    UWORD32 u4_num_waits;
+
+    /** NOP(128) rounds spent spinning */
+    UWORD32 u4_num_spins;
+
+    /** Waits that ended up sleeping */
+    UWORD32 u4_num_sleeps;
+
+    /** Time spent spinning and sleeping, in microseconds */
+    UWORD64 u8_wait_time_us;
+}wait_stats_t;
+
+WORD32 ih264d_progress_init(progress_sync_t *ps_prog,
+                            void *pv_mutex,
+                            void *pv_cond);
+
+void ih264d_progress_deinit(progress_sync_t *ps_prog);
+
+UWORD32 ih264d_progress_get_seq(progress_sync_t *ps_prog);
+
+void ih264d_progress_signal(progress_sync_t *ps_prog);
+
+WORD32 ih264d_progress_spin(WORD32 *pi4_nop_cnt, wait_stats_t *ps_stats);
+
+void ih264d_progress_sleep(progress_sync_t *ps_prog,
+                           UWORD32 u4_seq,
+                           wait_stats_t *ps_stats);
+
+#endif /* _IH264D_THREAD_SYNC_H_ */
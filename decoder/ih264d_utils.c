@@ -56,6 +56,7 @@
 #include "ih264d_dpb_manager.h"
 #include "iv.h"
 #include "ivd.h"
+#include "ih264d.h"
 #include "ih264d_format_conv.h"
 #include "ih264_error.h"
 #include "ih264_disp_mgr.h"
@@ -948,6 +949,171 @@ WORD32 ih264d_init_pic(dec_struct_t *ps_dec,
     return OK;
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fill_disp_frm_buf                                 */
+/*                                                                           */
+/*  Description   : Fills the dimensions and strides of the output buffer    */
+/*                  the picture in ps_op_frm is copied or converted into     */
+/*                                                                           */
+/*  Inputs        : ps_dec     - Decoder parameters                          */
+/*                  pic_buf    - Picture being displayed                     */
+/*                  ps_op_frm  - Display frame of the picture                */
+/*                  pv_disp_op - Display output to fill                      */
+/*  Globals       : None                                                     */
+/*  Processing    : None                                                     */
+/*  Outputs       : pv_disp_op->s_disp_frm_buf                               */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*         27 05 2005   Ittiam          Draft                                */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fill_disp_frm_buf(dec_struct_t *ps_dec,
+                              pic_buffer_t *pic_buf,
+                              iv_yuv_buf_t *ps_op_frm,
+                              ivd_get_display_frame_op_t *pv_disp_op)
+{
+    UWORD32 temp;
+    UWORD32 dest_inc_Y = 0, dest_inc_UV = 0;
+
+    pv_disp_op->s_disp_frm_buf.u4_y_wd = temp = MIN(ps_op_frm->u4_y_wd,
+                                                    ps_op_frm->u4_y_strd);
+    pv_disp_op->s_disp_frm_buf.u4_y_wd = OUT_SCALED_DIM(
+                    pv_disp_op->s_disp_frm_buf.u4_y_wd, ps_dec->u4_out_scale_log2);
+    pv_disp_op->s_disp_frm_buf.u4_u_wd = pv_disp_op->s_disp_frm_buf.u4_y_wd
+                    >> 1;
+    pv_disp_op->s_disp_frm_buf.u4_v_wd = pv_disp_op->s_disp_frm_buf.u4_y_wd
+                    >> 1;
+
+    pv_disp_op->s_disp_frm_buf.u4_y_ht = OUT_SCALED_DIM(
+                    ps_op_frm->u4_y_ht, ps_dec->u4_out_scale_log2);
+    pv_disp_op->s_disp_frm_buf.u4_u_ht = pv_disp_op->s_disp_frm_buf.u4_y_ht
+                    >> 1;
+    pv_disp_op->s_disp_frm_buf.u4_v_ht = pv_disp_op->s_disp_frm_buf.u4_y_ht
+                    >> 1;
+    if(0 == ps_dec->u4_share_disp_buf)
+    {
+        pv_disp_op->s_disp_frm_buf.u4_y_strd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_wd;
+        pv_disp_op->s_disp_frm_buf.u4_u_strd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
+        pv_disp_op->s_disp_frm_buf.u4_v_strd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
+
+    }
+    else
+    {
+        pv_disp_op->s_disp_frm_buf.u4_y_strd = ps_op_frm->u4_y_strd;
+    }
+
+    if(ps_dec->u4_app_disp_width)
+    {
+        pv_disp_op->s_disp_frm_buf.u4_y_strd = MAX(
+                        ps_dec->u4_app_disp_width,
+                        pv_disp_op->s_disp_frm_buf.u4_y_strd);
+    }
+
+    pv_disp_op->u4_error_code = 0;
+    if(pv_disp_op->e_output_format == IV_YUV_420P)
+    {
+        UWORD32 i;
+        pv_disp_op->s_disp_frm_buf.u4_u_strd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_strd >> 1;
+        pv_disp_op->s_disp_frm_buf.u4_v_strd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_strd >> 1;
+
+        pv_disp_op->s_disp_frm_buf.u4_u_wd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
+        pv_disp_op->s_disp_frm_buf.u4_v_wd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
+
+        if(1 == ps_dec->u4_share_disp_buf)
+        {
+            pv_disp_op->s_disp_frm_buf.pv_y_buf = ps_op_frm->pv_y_buf;
+
+            for(i = 0; i < MAX_DISP_BUFS_NEW; i++)
+            {
+                UWORD8 *buf = ps_dec->disp_bufs[i].buf[0];
+                buf += ps_dec->disp_bufs[i].u4_ofst[0];
+                if(((UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_y_buf
+                                - pic_buf->u2_crop_offset_y) == buf)
+                {
+                    buf = ps_dec->disp_bufs[i].buf[1];
+                    buf += ps_dec->disp_bufs[i].u4_ofst[1];
+                    pv_disp_op->s_disp_frm_buf.pv_u_buf = buf
+                                    + (pic_buf->u2_crop_offset_uv
+                                       / YUV420SP_FACTOR);
+
+                    buf = ps_dec->disp_bufs[i].buf[2];
+                    buf += ps_dec->disp_bufs[i].u4_ofst[2];
+                    pv_disp_op->s_disp_frm_buf.pv_v_buf = buf
+                                    + (pic_buf->u2_crop_offset_uv
+                                       / YUV420SP_FACTOR);
+
+                }
+            }
+        }
+
+    }
+    else if((pv_disp_op->e_output_format == IV_YUV_420SP_UV)
+                    || (pv_disp_op->e_output_format == IV_YUV_420SP_VU))
+    {
+        pv_disp_op->s_disp_frm_buf.u4_u_strd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_strd;
+        pv_disp_op->s_disp_frm_buf.u4_v_strd = 0;
+
+        if(1 == ps_dec->u4_share_disp_buf)
+        {
+            UWORD32 i;
+
+            pv_disp_op->s_disp_frm_buf.pv_y_buf = ps_op_frm->pv_y_buf;
+
+            for(i = 0; i < MAX_DISP_BUFS_NEW; i++)
+            {
+                UWORD8 *buf = ps_dec->disp_bufs[i].buf[0];
+                buf += ps_dec->disp_bufs[i].u4_ofst[0];
+                if((UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_y_buf
+                                - pic_buf->u2_crop_offset_y == buf)
+                {
+                    buf = ps_dec->disp_bufs[i].buf[1];
+                    buf += ps_dec->disp_bufs[i].u4_ofst[1];
+                    pv_disp_op->s_disp_frm_buf.pv_u_buf = buf
+                                    + pic_buf->u2_crop_offset_uv;
+                    ;
+
+                    buf = ps_dec->disp_bufs[i].buf[2];
+                    buf += ps_dec->disp_bufs[i].u4_ofst[2];
+                    pv_disp_op->s_disp_frm_buf.pv_v_buf = buf
+                                    + pic_buf->u2_crop_offset_uv;
+                    ;
+                }
+            }
+        }
+        pv_disp_op->s_disp_frm_buf.u4_u_wd =
+                        pv_disp_op->s_disp_frm_buf.u4_y_wd;
+        pv_disp_op->s_disp_frm_buf.u4_v_wd = 0;
+
+    }
+    else if((pv_disp_op->e_output_format == IV_RGB_565)
+                    || (pv_disp_op->e_output_format == IV_RGBA_8888)
+                    || (pv_disp_op->e_output_format == IV_YUV_422ILE))
+    {
+
+        pv_disp_op->s_disp_frm_buf.u4_u_strd = 0;
+        pv_disp_op->s_disp_frm_buf.u4_v_strd = 0;
+        pv_disp_op->s_disp_frm_buf.u4_u_wd = 0;
+        pv_disp_op->s_disp_frm_buf.u4_v_wd = 0;
+        pv_disp_op->s_disp_frm_buf.u4_u_ht = 0;
+        pv_disp_op->s_disp_frm_buf.u4_v_ht = 0;
+
+    }
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : ih264d_get_next_display_field                                   */
@@ -1041,138 +1207,7 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
     }
     else
     {
-
-        //Release the buffer if being sent for display
-        UWORD32 temp;
-        UWORD32 dest_inc_Y = 0, dest_inc_UV = 0;
-
-        pv_disp_op->s_disp_frm_buf.u4_y_wd = temp = MIN(ps_op_frm->u4_y_wd,
-                                                        ps_op_frm->u4_y_strd);
-        pv_disp_op->s_disp_frm_buf.u4_u_wd = pv_disp_op->s_disp_frm_buf.u4_y_wd
-                        >> 1;
-        pv_disp_op->s_disp_frm_buf.u4_v_wd = pv_disp_op->s_disp_frm_buf.u4_y_wd
-                        >> 1;
-
-        pv_disp_op->s_disp_frm_buf.u4_y_ht = ps_op_frm->u4_y_ht;
-        pv_disp_op->s_disp_frm_buf.u4_u_ht = pv_disp_op->s_disp_frm_buf.u4_y_ht
-                        >> 1;
-        pv_disp_op->s_disp_frm_buf.u4_v_ht = pv_disp_op->s_disp_frm_buf.u4_y_ht
-                        >> 1;
-        if(0 == ps_dec->u4_share_disp_buf)
-        {
-            pv_disp_op->s_disp_frm_buf.u4_y_strd =
-                            pv_disp_op->s_disp_frm_buf.u4_y_wd;
-            pv_disp_op->s_disp_frm_buf.u4_u_strd =
-                            pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
-            pv_disp_op->s_disp_frm_buf.u4_v_strd =
-                            pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
-
-        }
-        else
-        {
-            pv_disp_op->s_disp_frm_buf.u4_y_strd = ps_op_frm->u4_y_strd;
-        }
-
-        if(ps_dec->u4_app_disp_width)
-        {
-            pv_disp_op->s_disp_frm_buf.u4_y_strd = MAX(
-                            ps_dec->u4_app_disp_width,
-                            pv_disp_op->s_disp_frm_buf.u4_y_strd);
-        }
-
-        pv_disp_op->u4_error_code = 0;
-        if(pv_disp_op->e_output_format == IV_YUV_420P)
-        {
-            UWORD32 i;
-            pv_disp_op->s_disp_frm_buf.u4_u_strd =
-                            pv_disp_op->s_disp_frm_buf.u4_y_strd >> 1;
-            pv_disp_op->s_disp_frm_buf.u4_v_strd =
-                            pv_disp_op->s_disp_frm_buf.u4_y_strd >> 1;
-
-            pv_disp_op->s_disp_frm_buf.u4_u_wd = ps_op_frm->u4_y_wd >> 1;
-            pv_disp_op->s_disp_frm_buf.u4_v_wd = ps_op_frm->u4_y_wd >> 1;
-
-            if(1 == ps_dec->u4_share_disp_buf)
-            {
-                pv_disp_op->s_disp_frm_buf.pv_y_buf = ps_op_frm->pv_y_buf;
-
-                for(i = 0; i < MAX_DISP_BUFS_NEW; i++)
-                {
-                    UWORD8 *buf = ps_dec->disp_bufs[i].buf[0];
-                    buf += ps_dec->disp_bufs[i].u4_ofst[0];
-                    if(((UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_y_buf
-                                    - pic_buf->u2_crop_offset_y) == buf)
-                    {
-                        buf = ps_dec->disp_bufs[i].buf[1];
-                        buf += ps_dec->disp_bufs[i].u4_ofst[1];
-                        pv_disp_op->s_disp_frm_buf.pv_u_buf = buf
-                                        + (pic_buf->u2_crop_offset_uv
-                                           / YUV420SP_FACTOR);
-
-                        buf = ps_dec->disp_bufs[i].buf[2];
-                        buf += ps_dec->disp_bufs[i].u4_ofst[2];
-                        pv_disp_op->s_disp_frm_buf.pv_v_buf = buf
-                                        + (pic_buf->u2_crop_offset_uv
-                                           / YUV420SP_FACTOR);
-
-                    }
-                }
-            }
-
-        }
-        else if((pv_disp_op->e_output_format == IV_YUV_420SP_UV)
-                        || (pv_disp_op->e_output_format == IV_YUV_420SP_VU))
-        {
-            pv_disp_op->s_disp_frm_buf.u4_u_strd =
-                            pv_disp_op->s_disp_frm_buf.u4_y_strd;
-            pv_disp_op->s_disp_frm_buf.u4_v_strd = 0;
-
-            if(1 == ps_dec->u4_share_disp_buf)
-            {
-                UWORD32 i;
-
-                pv_disp_op->s_disp_frm_buf.pv_y_buf = ps_op_frm->pv_y_buf;
-
-                for(i = 0; i < MAX_DISP_BUFS_NEW; i++)
-                {
-                    UWORD8 *buf = ps_dec->disp_bufs[i].buf[0];
-                    buf += ps_dec->disp_bufs[i].u4_ofst[0];
-                    if((UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_y_buf
-                                    - pic_buf->u2_crop_offset_y == buf)
-                    {
-                        buf = ps_dec->disp_bufs[i].buf[1];
-                        buf += ps_dec->disp_bufs[i].u4_ofst[1];
-                        pv_disp_op->s_disp_frm_buf.pv_u_buf = buf
-                                        + pic_buf->u2_crop_offset_uv;
-                        ;
-
-                        buf = ps_dec->disp_bufs[i].buf[2];
-                        buf += ps_dec->disp_bufs[i].u4_ofst[2];
-                        pv_disp_op->s_disp_frm_buf.pv_v_buf = buf
-                                        + pic_buf->u2_crop_offset_uv;
-                        ;
-                    }
-                }
-            }
-            pv_disp_op->s_disp_frm_buf.u4_u_wd =
-                            pv_disp_op->s_disp_frm_buf.u4_y_wd;
-            pv_disp_op->s_disp_frm_buf.u4_v_wd = 0;
-
-        }
-        else if((pv_disp_op->e_output_format == IV_RGB_565)
-                        || (pv_disp_op->e_output_format == IV_YUV_422ILE))
-        {
-
-            pv_disp_op->s_disp_frm_buf.u4_u_strd = 0;
-            pv_disp_op->s_disp_frm_buf.u4_v_strd = 0;
-            pv_disp_op->s_disp_frm_buf.u4_u_wd = 0;
-            pv_disp_op->s_disp_frm_buf.u4_v_wd = 0;
-            pv_disp_op->s_disp_frm_buf.u4_u_ht = 0;
-            pv_disp_op->s_disp_frm_buf.u4_v_ht = 0;
-
-        }
-
-
+        ih264d_fill_disp_frm_buf(ps_dec, pic_buf, ps_op_frm, pv_disp_op);
     }
 
     return u4_api_ret;
@@ -1514,6 +1549,53 @@ void ih264d_assign_pic_num(dec_struct_t *ps_dec)
     }
 }
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_update_degrade_level \endif
+ *
+ * \brief
+ *    Raises the automatic degrade level when frames keep taking longer to
+ *    decode than the budget, and lowers it when they keep taking well less
+ *
+ * \return
+ *    None
+ *
+ **************************************************************************
+ */
+void ih264d_update_degrade_level(dec_struct_t *ps_dec, UWORD32 u4_frame_time_us)
+{
+    UWORD32 u4_budget_us = ps_dec->u4_degrade_budget_us;
+
+    if(u4_frame_time_us > u4_budget_us)
+    {
+        ps_dec->u4_degrade_under_cnt = 0;
+        ps_dec->u4_degrade_over_cnt++;
+        if((ps_dec->u4_degrade_over_cnt >= DEGRADE_RAISE_FRAMES)
+                        && (ps_dec->u4_degrade_level < DEGRADE_LEVEL_MAX))
+        {
+            ps_dec->u4_degrade_level++;
+            ps_dec->u4_degrade_over_cnt = 0;
+        }
+    }
+    else if((UWORD64)u4_frame_time_us * 100
+                    < (UWORD64)u4_budget_us * DEGRADE_RELAX_PCT)
+    {
+        ps_dec->u4_degrade_over_cnt = 0;
+        ps_dec->u4_degrade_under_cnt++;
+        if((ps_dec->u4_degrade_under_cnt >= DEGRADE_RELAX_FRAMES)
+                        && ps_dec->u4_degrade_level)
+        {
+            ps_dec->u4_degrade_level--;
+            ps_dec->u4_degrade_under_cnt = 0;
+        }
+    }
+    else
+    {
+        ps_dec->u4_degrade_over_cnt = 0;
+        ps_dec->u4_degrade_under_cnt = 0;
+    }
+}
+
 /*!
  **************************************************************************
  * \if Function name : ih264d_update_qp \endif
@@ -2062,6 +2144,103 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
 
     memset(ps_dec->ps_deblk_pic, 0, size);
 
+    /* Allocate per MB row state of the row parallel deblocking */
+    {
+        deblk_rows_ctxt_t *ps_rows = &ps_dec->s_deblk_rows;
+        UWORD32 u4_max_rows = u4_total_mbs / u4_wd_mbs;
+
+        size = u4_max_rows * (sizeof(UWORD32) + sizeof(UWORD8));
+        pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+        RETURN_IF((NULL == pv_buf), IV_FAIL);
+        memset(pv_buf, 0, size);
+
+        ps_rows->pu4_row_mbs_done = pv_buf;
+        ps_rows->pu1_row_worker = (UWORD8 *)pv_buf + u4_max_rows * sizeof(UWORD32);
+        ps_rows->u4_max_rows = u4_max_rows;
+    }
+
+    /*
+     * Allocate per MB row state of the row parallel reconstruction, and a
+     * recon context and IQ-IT scratch for the recon thread and each worker.
+     * Workers take the auxiliary cores left after the trailing deblocking
+     * thread
+     */
+    if(ps_dec->u4_num_aux_cores > 1)
+    {
+        recon_rows_ctxt_t *ps_rows = &ps_dec->s_recon_rows;
+        UWORD32 u4_max_rows = u4_total_mbs / u4_wd_mbs;
+        UWORD32 u4_rows_size = ALIGN128(u4_max_rows * (sizeof(UWORD32) + sizeof(UWORD8)));
+        UWORD32 u4_worker_size = ALIGN128(sizeof(dec_struct_t))
+                        + MB_LUM_SIZE * sizeof(WORD16);
+        UWORD32 u4_max_workers = MIN(ps_dec->u4_num_aux_cores, H264_MAX_NUM_CORES);
+        UWORD8 *pu1_buf;
+        UWORD32 i;
+
+        size = u4_rows_size + u4_max_workers * u4_worker_size;
+        pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+        RETURN_IF((NULL == pv_buf), IV_FAIL);
+        memset(pv_buf, 0, size);
+
+        ps_rows->pu4_row_mbs_done = pv_buf;
+        ps_rows->pu1_row_worker = (UWORD8 *)pv_buf + u4_max_rows * sizeof(UWORD32);
+        ps_rows->u4_max_rows = u4_max_rows;
+
+        pu1_buf = (UWORD8 *)pv_buf + u4_rows_size;
+        for(i = 0; i < u4_max_workers; i++)
+        {
+            recon_row_worker_t *ps_worker = &ps_rows->as_worker[i];
+
+            ps_worker->ps_rec_ctxt = (dec_struct_t *)pu1_buf;
+            ps_worker->pi2_coeff_data =
+                            (WORD16 *)(pu1_buf + ALIGN128(sizeof(dec_struct_t)));
+            pu1_buf += u4_worker_size;
+        }
+        ps_rows->u4_max_workers = u4_max_workers;
+    }
+
+    /*
+     * Create the pool of the recon row workers, unless a shared pool is set.
+     * It has a thread for each auxiliary core left after the trailing
+     * deblocking thread, and is only created when the row workers run, i.e.
+     * for streams without MBAFF. Picture level deblocking and format
+     * conversion are split over it too; without a pool they run serially
+     */
+    if((NULL == ps_dec->ps_thread_pool) && (NULL == ps_dec->ps_own_pool)
+                    && (ps_dec->u4_num_aux_cores > 1)
+                    && (0 == ps_dec->ps_cur_sps->u1_mb_aff_flag))
+    {
+        ih264d_create_thread_pool_ip_t s_pool_ip;
+        ih264d_create_thread_pool_op_t s_pool_op;
+
+        s_pool_ip.u4_size = sizeof(ih264d_create_thread_pool_ip_t);
+        s_pool_ip.u4_num_threads = MIN(ps_dec->u4_num_aux_cores - 1,
+                                       H264_MAX_NUM_CORES - 1);
+        s_pool_ip.pf_aligned_alloc = ps_dec->pf_aligned_alloc;
+        s_pool_ip.pf_aligned_free = ps_dec->pf_aligned_free;
+        s_pool_ip.pv_mem_ctxt = ps_dec->pv_mem_ctxt;
+        s_pool_op.u4_size = sizeof(ih264d_create_thread_pool_op_t);
+
+        if(IV_SUCCESS == ih264d_create_thread_pool(&s_pool_ip, &s_pool_op))
+            ps_dec->ps_own_pool = (thread_pool_t *)s_pool_op.pv_thread_pool;
+    }
+
+    /* Allocate the rows each format conversion stripe downscales into */
+    {
+        UWORD32 u4_stripe_size = ALIGN64(3 * (u4_luma_wd >> 1));
+        WORD32 i;
+
+        size = u4_stripe_size * H264_MAX_NUM_CORES;
+        pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+        RETURN_IF((NULL == pv_buf), IV_FAIL);
+        ps_dec->pu1_fmt_conv_scale_buf = pv_buf;
+
+        for(i = 0; i < H264_MAX_NUM_CORES; i++)
+        {
+            ps_dec->as_fmt_conv_stripe[i].pu1_scale_buf =
+                            (UWORD8 *)pv_buf + i * u4_stripe_size;
+        }
+    }
+
     /* Allocate frame level mb info */
     size = sizeof(dec_mb_info_t) * u4_total_mbs;
     pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
@@ -2288,6 +2467,17 @@ WORD16 ih264d_free_dynamic_bufs(dec_struct_t * ps_dec)
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_bits_buf_dynamic);
 
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_deblk_pic);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->s_deblk_rows.pu4_row_mbs_done);
+    ps_dec->s_deblk_rows.u4_max_rows = 0;
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->s_recon_rows.pu4_row_mbs_done);
+    ps_dec->s_recon_rows.u4_max_rows = 0;
+    ps_dec->s_recon_rows.u4_max_workers = 0;
+    if(ps_dec->ps_own_pool)
+    {
+        ih264d_delete_thread_pool(ps_dec->ps_own_pool);
+        ps_dec->ps_own_pool = NULL;
+    }
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_fmt_conv_scale_buf);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_dec_mb_map);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_recon_mb_map);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu2_slice_num_map);
@@ -81,10 +81,16 @@ void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
                                       WORD16 *pi2_out_coeff_data,
                                       UWORD8 *pu1_inv_scan);
 
+void ih264d_update_degrade_level(dec_struct_t *ps_dec, UWORD32 u4_frame_time_us);
 WORD32 ih264d_update_qp(dec_struct_t * ps_dec, const WORD8 i1_qp);
 WORD32 ih264d_decode_gaps_in_frame_num(dec_struct_t *ps_dec,
                                        UWORD16 u2_frame_num);
 
+void ih264d_fill_disp_frm_buf(dec_struct_t *ps_dec,
+                              pic_buffer_t *pic_buf,
+                              iv_yuv_buf_t *ps_op_frm,
+                              ivd_get_display_frame_op_t *pv_disp_op);
+
 WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
                                   ivd_out_bufdesc_t *ps_out_buffer,
                                   ivd_get_display_frame_op_t *pv_disp_op);
@@ -3,6 +3,7 @@ list(
   APPEND
   LIBAVCDEC_SRCS
   "${AVC_ROOT}/decoder/ih264d_api.c"
+  "${AVC_ROOT}/decoder/ih264d_async.c"
   "${AVC_ROOT}/decoder/ih264d_bitstrm.c"
   "${AVC_ROOT}/decoder/ih264d_cabac.c"
   "${AVC_ROOT}/decoder/ih264d_cabac_init_tables.c"
@@ -31,6 +32,8 @@ list(
   "${AVC_ROOT}/decoder/ih264d_tables.c"
   "${AVC_ROOT}/decoder/ih264d_thread_compute_bs.c"
   "${AVC_ROOT}/decoder/ih264d_thread_parse_decode.c"
+  "${AVC_ROOT}/decoder/ih264d_thread_pool.c"
+  "${AVC_ROOT}/decoder/ih264d_thread_sync.c"
   "${AVC_ROOT}/decoder/ih264d_utils.c"
   "${AVC_ROOT}/decoder/ih264d_vui.c")
 
@@ -46,7 +49,16 @@ else()
   list(
     APPEND LIBAVCDEC_SRCS "${AVC_ROOT}/decoder/x86/ih264d_function_selector.c"
     "${AVC_ROOT}/decoder/x86/ih264d_function_selector_sse42.c"
-    "${AVC_ROOT}/decoder/x86/ih264d_function_selector_ssse3.c")
+    "${AVC_ROOT}/decoder/x86/ih264d_function_selector_ssse3.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_format_conv_ssse3.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_compute_bs_sse42.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_nal_sse42.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_function_selector_avx2.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_format_conv_avx2.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_nal_avx2.c")
+  libavc_set_avx2_compile_options(
+    "${AVC_ROOT}/decoder/x86/ih264d_format_conv_avx2.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_nal_avx2.c")
 endif()
 
 add_library(libavcdec STATIC ${LIBAVC_COMMON_SRCS} ${LIBAVC_COMMON_ASMS}
@@ -217,6 +217,8 @@ static IV_API_CALL_STATUS_T imvcd_check_num_view_slices_in_au(mvc_dec_ctxt_t *ps
 {
     AVC_EXT_NALU_ID_T e_nalu_id;
 
+    dec_struct_t *ps_view_ctxt = &ps_mvcd_ctxt->s_view_dec_ctxt;
+
     UWORD16 u2_num_view_slices_in_au = 0;
     UWORD8 *pu1_input_buffer = (UWORD8 *) ps_ip->s_ivd_ip.pv_stream_buffer;
     UWORD32 u4_num_bytes_remaining = ps_ip->s_ivd_ip.u4_num_Bytes;
@@ -226,7 +228,8 @@ static IV_API_CALL_STATUS_T imvcd_check_num_view_slices_in_au(mvc_dec_ctxt_t *ps
         UWORD32 u4_length_of_start_code = 0;
         UWORD32 u4_next_is_aud = 0;
         WORD32 i4_nalu_length = ih264d_find_start_code(pu1_input_buffer, 0, u4_num_bytes_remaining,
-                                                       &u4_length_of_start_code, &u4_next_is_aud);
+                                                       &u4_length_of_start_code, &u4_next_is_aud,
+                                                       ps_view_ctxt->pf_find_zero_run);
 
         if(i4_nalu_length <= 0)
         {
@@ -714,6 +714,7 @@ static WORD32 imvcd_pic_init(mvc_dec_ctxt_t *ps_mvcd_ctxt, pocstruct_t *ps_cur_p
     }
 
     ps_view_ctxt->u4_app_disable_deblk_frm = 0;
+    ps_view_ctxt->i4_mv_frac_mask = MV_FRAC_MASK_QPEL;
     if(ps_view_ctxt->i4_degrade_type && ps_view_ctxt->i4_degrade_pics)
     {
         WORD32 i4_degrade_pic = 0;
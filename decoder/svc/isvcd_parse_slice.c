@@ -181,6 +181,7 @@ WORD32 isvcd_start_of_pic(svc_dec_lyr_struct_t *ps_svc_lyr_dec, WORD32 i4_poc,
     }
 
     ps_dec->u4_app_disable_deblk_frm = 0;
+    ps_dec->i4_mv_frac_mask = MV_FRAC_MASK_QPEL;
     /* If degrade is enabled, set the degrade flags appropriately */
     if(ps_dec->i4_degrade_type && ps_dec->i4_degrade_pics)
     {
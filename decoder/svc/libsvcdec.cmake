@@ -3,6 +3,7 @@ list(
   APPEND
   LIBSVCDEC_SRCS
   "${AVC_ROOT}/decoder/ih264d_api.c"
+  "${AVC_ROOT}/decoder/ih264d_async.c"
   "${AVC_ROOT}/decoder/ih264d_bitstrm.c"
   "${AVC_ROOT}/decoder/ih264d_cabac.c"
   "${AVC_ROOT}/decoder/ih264d_cabac_init_tables.c"
@@ -31,6 +32,8 @@ list(
   "${AVC_ROOT}/decoder/ih264d_tables.c"
   "${AVC_ROOT}/decoder/ih264d_thread_compute_bs.c"
   "${AVC_ROOT}/decoder/ih264d_thread_parse_decode.c"
+  "${AVC_ROOT}/decoder/ih264d_thread_pool.c"
+  "${AVC_ROOT}/decoder/ih264d_thread_sync.c"
   "${AVC_ROOT}/decoder/ih264d_utils.c"
   "${AVC_ROOT}/decoder/ih264d_vui.c"
   "${AVC_ROOT}/decoder/svc/isvcd_api.c"
@@ -88,6 +91,12 @@ else()
     "${AVC_ROOT}/decoder/x86/ih264d_function_selector.c"
     "${AVC_ROOT}/decoder/x86/ih264d_function_selector_sse42.c"
     "${AVC_ROOT}/decoder/x86/ih264d_function_selector_ssse3.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_format_conv_ssse3.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_compute_bs_sse42.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_nal_sse42.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_function_selector_avx2.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_format_conv_avx2.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_nal_avx2.c"
     "${AVC_ROOT}/decoder/x86/svc/isvcd_function_selector.c"
     "${AVC_ROOT}/decoder/x86/svc/isvcd_function_selector_sse42.c"
     "${AVC_ROOT}/decoder/x86/svc/isvcd_intra_resamp_sse42.c"
@@ -96,6 +105,9 @@ else()
     "${AVC_ROOT}/decoder/x86/svc/isvcd_iquant_itrans_sse42.c"
     "${AVC_ROOT}/decoder/x86/svc/isvcd_pred_residual_recon_sse42.c"
     "${AVC_ROOT}/decoder/x86/svc/isvcd_residual_resamp_sse42.c")
+  libavc_set_avx2_compile_options(
+    "${AVC_ROOT}/decoder/x86/ih264d_format_conv_avx2.c"
+    "${AVC_ROOT}/decoder/x86/ih264d_nal_avx2.c")
 endif()
 
 add_library(libsvcdec STATIC ${LIBAVC_COMMON_SRCS} ${LIBAVC_COMMON_ASMS}
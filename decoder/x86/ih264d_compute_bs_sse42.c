@@ -0,0 +1,524 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_compute_bs_sse42.c
+ *
+ * @brief
+ *  Boundary strength (=1) computation of inter MBs with more than one
+ *  partition
+ *
+ * @par List of Functions:
+ *  - ih264d_fill_bs1_non16x16mb_pslice_sse42()
+ *  - ih264d_fill_bs1_non16x16mb_bslice_sse42()
+ *
+ * @remarks
+ *  The motion vectors of the 32 internal and left/top 4x4 edges of a MB are
+ *  compared at once; reference picture addresses are compared without
+ *  branches in C. The result is merged into the BS table only where the BS
+ *  is not set yet, same as the generic versions.
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <immintrin.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_structs.h"
+#include "ih264d_defs.h"
+#include "ih264d_deblocking.h"
+#include "ih264d_debug.h"
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Compares the motion vectors of two sets of 4x4 blocks
+ *
+ * @param[in] nbr_8x16b
+ *  Neighbour motion vectors, x and y in alternate lanes
+ *
+ * @param[in] cur_8x16b
+ *  Current motion vectors, x and y in alternate lanes
+ *
+ * @param[in] lim_8x16b
+ *  4 in x lanes and the vertical mv limit in y lanes
+ *
+ * @returns
+ *  0xFFFF in lanes whose absolute difference is at least the limit
+ *
+ * @remarks
+ *  The saturating difference gives the same result as the wide one since
+ *  the limits are positive 16 bit values.
+ *
+ *******************************************************************************
+ */
+static __inline __m128i ih264d_mv_diff_ge_sse42(__m128i nbr_8x16b,
+                                                __m128i cur_8x16b,
+                                                __m128i lim_8x16b)
+{
+    __m128i abs_8x16b = _mm_abs_epi16(_mm_subs_epi16(nbr_8x16b, cur_8x16b));
+
+    return _mm_cmpeq_epi16(_mm_max_epu16(abs_8x16b, lim_8x16b), abs_8x16b);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Reduces the per lane flags of two pairs of B slice blocks to one dword per
+ *  block
+ *
+ * @param[in] ge01_8x16b
+ *  Flags of blocks 0 and 1, four lanes per block
+ *
+ * @param[in] ge23_8x16b
+ *  Flags of blocks 2 and 3, four lanes per block
+ *
+ * @returns
+ *  Nonzero dword for each block with any flag set
+ *
+ *******************************************************************************
+ */
+static __inline __m128i ih264d_bs_any_2x64_sse42(__m128i ge01_8x16b,
+                                                 __m128i ge23_8x16b)
+{
+    ge01_8x16b = _mm_or_si128(ge01_8x16b,
+                              _mm_shuffle_epi32(ge01_8x16b, _MM_SHUFFLE(2, 3, 0, 1)));
+    ge23_8x16b = _mm_or_si128(ge23_8x16b,
+                              _mm_shuffle_epi32(ge23_8x16b, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(ge01_8x16b),
+                                           _mm_castsi128_ps(ge23_8x16b),
+                                           _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Packs one dword per 4x4 block of the four rows of a MB into one byte per
+ *  block, 1 if the dword is nonzero and 0 otherwise
+ *
+ *******************************************************************************
+ */
+static __inline __m128i ih264d_bs_pack_4x4x32_sse42(__m128i row0_4x32b,
+                                                    __m128i row1_4x32b,
+                                                    __m128i row2_4x32b,
+                                                    __m128i row3_4x32b)
+{
+    __m128i row01_8x16b = _mm_packs_epi32(row0_4x32b, row1_4x32b);
+    __m128i row23_8x16b = _mm_packs_epi32(row2_4x32b, row3_4x32b);
+
+    return _mm_min_epu8(_mm_packs_epi16(row01_8x16b, row23_8x16b),
+                        _mm_set1_epi8(1));
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Sets BS = 1 for the edges whose BS is not set yet
+ *
+ * @param[in] pu4_bs_table
+ *  BS table of the MB, horizontal edges in words 0 to 3 and vertical edges
+ *  in words 4 to 7
+ *
+ * @param[in] horz_16x8b
+ *  1 for each 4x4 block whose top edge needs BS = 1, raster order
+ *
+ * @param[in] vert_16x8b
+ *  1 for each 4x4 block whose left edge needs BS = 1, raster order
+ *
+ * @remarks
+ *  The BS of the leftmost (topmost) block of a horizontal (vertical) edge is
+ *  in the most significant byte of its word
+ *
+ *******************************************************************************
+ */
+static __inline void ih264d_bs1_merge_sse42(UWORD32 *pu4_bs_table,
+                                            __m128i horz_16x8b,
+                                            __m128i vert_16x8b)
+{
+    const __m128i zero_16x8b = _mm_setzero_si128();
+    const __m128i nibble_16x8b = _mm_set1_epi8(0x0F);
+    __m128i bs_16x8b;
+    __m128i free_16x8b;
+
+    horz_16x8b = _mm_shuffle_epi8(horz_16x8b,
+                                  _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                                11, 10, 9, 8, 15, 14, 13, 12));
+    vert_16x8b = _mm_shuffle_epi8(vert_16x8b,
+                                  _mm_setr_epi8(12, 8, 4, 0, 13, 9, 5, 1,
+                                                14, 10, 6, 2, 15, 11, 7, 3));
+
+    bs_16x8b = _mm_loadu_si128((__m128i *)pu4_bs_table);
+    free_16x8b = _mm_cmpeq_epi8(_mm_and_si128(bs_16x8b, nibble_16x8b), zero_16x8b);
+    bs_16x8b = _mm_or_si128(bs_16x8b, _mm_and_si128(horz_16x8b, free_16x8b));
+    _mm_storeu_si128((__m128i *)pu4_bs_table, bs_16x8b);
+
+    bs_16x8b = _mm_loadu_si128((__m128i *)(pu4_bs_table + 4));
+    free_16x8b = _mm_cmpeq_epi8(_mm_and_si128(bs_16x8b, nibble_16x8b), zero_16x8b);
+    bs_16x8b = _mm_or_si128(bs_16x8b, _mm_and_si128(vert_16x8b, free_16x8b));
+    _mm_storeu_si128((__m128i *)(pu4_bs_table + 4), bs_16x8b);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Fills BS = 1 for the horz and vert edges of a non 16x16 P MB that are set
+ *  to 0 by ih264d_fill_bs2_horz_vert
+ *
+ * @par Description:
+ *  Same as ih264d_fill_bs1_non16x16mb_pslice. The forward motion vectors of
+ *  a row of 4x4 blocks are held in one register, so the top neighbours of
+ *  rows 1 to 3 are the previous rows and the left neighbours are a row
+ *  shifted by one block.
+ *
+ * @param[in] ps_cur_mv_pred
+ *  Motion vectors of the 16 4x4 blocks of the MB
+ *
+ * @param[in] ps_top_mv_pred
+ *  Motion vectors of the bottom 4x4 blocks of the top MB
+ *
+ * @param[in] ppv_map_ref_idx_to_poc
+ *  Reference index to picture address map
+ *
+ * @param[in] pu4_bs_table
+ *  BS table of the MB
+ *
+ * @param[in] ps_leftmost_mv_pred
+ *  Motion vectors of the right 4x4 blocks of the left MB, 4 apart
+ *
+ * @param[in] ps_left_addr
+ *  Reference picture addresses of the left MB
+ *
+ * @param[in] u4_pic_addrress
+ *  Reference picture addresses of the top MB
+ *
+ * @param[in] i4_ver_mvlimit
+ *  Vertical motion vector difference limit
+ *
+ * @returns  none
+ *
+ *******************************************************************************
+ */
+void ih264d_fill_bs1_non16x16mb_pslice_sse42(mv_pred_t *ps_cur_mv_pred,
+                                             mv_pred_t *ps_top_mv_pred,
+                                             void **ppv_map_ref_idx_to_poc,
+                                             UWORD32 *pu4_bs_table,
+                                             mv_pred_t *ps_leftmost_mv_pred,
+                                             neighbouradd_t *ps_left_addr,
+                                             void **u4_pic_addrress,
+                                             WORD32 i4_ver_mvlimit)
+{
+    void *apv_cur_addr[16];
+    UWORD8 au1_horz_ref[16];
+    UWORD8 au1_vert_ref[16];
+    __m128i lim_8x16b;
+    __m128i cur_4x32b[4];
+    __m128i horz_4x32b[4];
+    __m128i vert_4x32b[4];
+    __m128i horz_16x8b, vert_16x8b;
+    WORD32 i, j;
+
+    PROFILE_DISABLE_BOUNDARY_STRENGTH()
+
+    /*****************************************************************/
+    /* Reference picture of each block against its top and left ones */
+    /*****************************************************************/
+    for(i = 0; i < 16; i++)
+    {
+        apv_cur_addr[i] = ppv_map_ref_idx_to_poc[ps_cur_mv_pred[i].i1_ref_frame[0]];
+    }
+    for(j = 0; j < 4; j++)
+    {
+        au1_horz_ref[j] = (u4_pic_addrress[j & 2] != apv_cur_addr[j])
+                        | (u4_pic_addrress[1 + (j & 2)] != NULL);
+        au1_vert_ref[j << 2] = (ps_left_addr->u4_add[j & 2] != apv_cur_addr[j << 2])
+                        | (ps_left_addr->u4_add[1 + (j & 2)] != NULL);
+    }
+    for(i = 4; i < 16; i++)
+    {
+        au1_horz_ref[i] = (apv_cur_addr[i - 4] != apv_cur_addr[i]);
+    }
+    for(i = 0; i < 16; i++)
+    {
+        if(i & 3)
+        {
+            au1_vert_ref[i] = (apv_cur_addr[i - 1] != apv_cur_addr[i]);
+        }
+    }
+
+    /*****************************************************************/
+    /* Forward motion vectors, one dword per block                   */
+    /*****************************************************************/
+    lim_8x16b = _mm_set1_epi32((i4_ver_mvlimit << 16) | 4);
+
+    for(j = 0; j < 4; j++)
+    {
+        mv_pred_t *ps_mv = ps_cur_mv_pred + (j << 2);
+        __m128i mv01_4x32b = _mm_unpacklo_epi32(_mm_loadl_epi64((__m128i *)ps_mv[0].i2_mv),
+                                                _mm_loadl_epi64((__m128i *)ps_mv[1].i2_mv));
+        __m128i mv23_4x32b = _mm_unpacklo_epi32(_mm_loadl_epi64((__m128i *)ps_mv[2].i2_mv),
+                                                _mm_loadl_epi64((__m128i *)ps_mv[3].i2_mv));
+
+        cur_4x32b[j] = _mm_unpacklo_epi64(mv01_4x32b, mv23_4x32b);
+    }
+
+    {
+        __m128i mv01_4x32b = _mm_unpacklo_epi32(_mm_loadl_epi64((__m128i *)ps_top_mv_pred[0].i2_mv),
+                                                _mm_loadl_epi64((__m128i *)ps_top_mv_pred[1].i2_mv));
+        __m128i mv23_4x32b = _mm_unpacklo_epi32(_mm_loadl_epi64((__m128i *)ps_top_mv_pred[2].i2_mv),
+                                                _mm_loadl_epi64((__m128i *)ps_top_mv_pred[3].i2_mv));
+        __m128i top_4x32b = _mm_unpacklo_epi64(mv01_4x32b, mv23_4x32b);
+
+        horz_4x32b[0] = ih264d_mv_diff_ge_sse42(top_4x32b, cur_4x32b[0], lim_8x16b);
+    }
+
+    for(j = 0; j < 4; j++)
+    {
+        __m128i left_4x32b = _mm_slli_si128(
+                        _mm_loadl_epi64((__m128i *)ps_leftmost_mv_pred[j << 2].i2_mv), 12);
+
+        left_4x32b = _mm_alignr_epi8(cur_4x32b[j], left_4x32b, 12);
+        vert_4x32b[j] = ih264d_mv_diff_ge_sse42(left_4x32b, cur_4x32b[j], lim_8x16b);
+
+        if(j)
+        {
+            horz_4x32b[j] = ih264d_mv_diff_ge_sse42(cur_4x32b[j - 1], cur_4x32b[j], lim_8x16b);
+        }
+    }
+
+    horz_16x8b = ih264d_bs_pack_4x4x32_sse42(horz_4x32b[0], horz_4x32b[1],
+                                             horz_4x32b[2], horz_4x32b[3]);
+    vert_16x8b = ih264d_bs_pack_4x4x32_sse42(vert_4x32b[0], vert_4x32b[1],
+                                             vert_4x32b[2], vert_4x32b[3]);
+
+    horz_16x8b = _mm_or_si128(horz_16x8b, _mm_loadu_si128((__m128i *)au1_horz_ref));
+    vert_16x8b = _mm_or_si128(vert_16x8b, _mm_loadu_si128((__m128i *)au1_vert_ref));
+
+    ih264d_bs1_merge_sse42(pu4_bs_table, horz_16x8b, vert_16x8b);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Fills BS = 1 for the horz and vert edges of a non 16x16 B MB that are set
+ *  to 0 by ih264d_fill_bs2_horz_vert
+ *
+ * @par Description:
+ *  Same as ih264d_fill_bs1_non16x16mb_bslice. Both motion vectors of two 4x4
+ *  blocks are held in one register; the cross comparison (fwd-bwd, bwd-fwd)
+ *  swaps the two motion vectors of the current blocks.
+ *
+ * @param[in] ps_cur_mv_pred
+ *  Motion vectors of the 16 4x4 blocks of the MB
+ *
+ * @param[in] ps_top_mv_pred
+ *  Motion vectors of the bottom 4x4 blocks of the top MB
+ *
+ * @param[in] ppv_map_ref_idx_to_poc
+ *  Reference index to picture address map
+ *
+ * @param[in] pu4_bs_table
+ *  BS table of the MB
+ *
+ * @param[in] ps_leftmost_mv_pred
+ *  Motion vectors of the right 4x4 blocks of the left MB, 4 apart
+ *
+ * @param[in] ps_left_addr
+ *  Reference picture addresses of the left MB
+ *
+ * @param[in] u4_pic_addrress
+ *  Reference picture addresses of the top MB
+ *
+ * @param[in] i4_ver_mvlimit
+ *  Vertical motion vector difference limit
+ *
+ * @returns  none
+ *
+ *******************************************************************************
+ */
+void ih264d_fill_bs1_non16x16mb_bslice_sse42(mv_pred_t *ps_cur_mv_pred,
+                                             mv_pred_t *ps_top_mv_pred,
+                                             void **ppv_map_ref_idx_to_poc,
+                                             UWORD32 *pu4_bs_table,
+                                             mv_pred_t *ps_leftmost_mv_pred,
+                                             neighbouradd_t *ps_left_addr,
+                                             void **u4_pic_addrress,
+                                             WORD32 i4_ver_mvlimit)
+{
+    void **ppv_map_ref_idx_to_poc_l1 = ppv_map_ref_idx_to_poc + POC_LIST_L0_TO_L1_DIFF;
+    void *apv_cur_addr0[16], *apv_cur_addr1[16];
+    UWORD8 au1_horz_ref[16], au1_horz_ref_cross[16];
+    UWORD8 au1_vert_ref[16], au1_vert_ref_cross[16];
+    __m128i lim_8x16b;
+    __m128i cur_2x64b[8];
+    __m128i ge_8x16b[8], ge_cross_8x16b[8];
+    __m128i any_4x32b[4], any_cross_4x32b[4];
+    __m128i horz_16x8b, vert_16x8b;
+    WORD32 i, j;
+
+    PROFILE_DISABLE_BOUNDARY_STRENGTH()
+
+    /*****************************************************************/
+    /* Reference pictures of each block against its top and left     */
+    /* ones, straight and crossed                                    */
+    /*****************************************************************/
+    for(i = 0; i < 16; i++)
+    {
+        apv_cur_addr0[i] = ppv_map_ref_idx_to_poc[ps_cur_mv_pred[i].i1_ref_frame[0]];
+        apv_cur_addr1[i] = ppv_map_ref_idx_to_poc_l1[ps_cur_mv_pred[i].i1_ref_frame[1]];
+    }
+    for(j = 0; j < 4; j++)
+    {
+        void *pv_nbr_addr0 = u4_pic_addrress[j & 2];
+        void *pv_nbr_addr1 = u4_pic_addrress[1 + (j & 2)];
+
+        au1_horz_ref[j] = (pv_nbr_addr0 != apv_cur_addr0[j])
+                        | (pv_nbr_addr1 != apv_cur_addr1[j]);
+        au1_horz_ref_cross[j] = (pv_nbr_addr0 != apv_cur_addr1[j])
+                        | (pv_nbr_addr1 != apv_cur_addr0[j]);
+
+        pv_nbr_addr0 = ps_left_addr->u4_add[j & 2];
+        pv_nbr_addr1 = ps_left_addr->u4_add[1 + (j & 2)];
+
+        au1_vert_ref[j << 2] = (pv_nbr_addr0 != apv_cur_addr0[j << 2])
+                        | (pv_nbr_addr1 != apv_cur_addr1[j << 2]);
+        au1_vert_ref_cross[j << 2] = (pv_nbr_addr0 != apv_cur_addr1[j << 2])
+                        | (pv_nbr_addr1 != apv_cur_addr0[j << 2]);
+    }
+    for(i = 4; i < 16; i++)
+    {
+        au1_horz_ref[i] = (apv_cur_addr0[i - 4] != apv_cur_addr0[i])
+                        | (apv_cur_addr1[i - 4] != apv_cur_addr1[i]);
+        au1_horz_ref_cross[i] = (apv_cur_addr0[i - 4] != apv_cur_addr1[i])
+                        | (apv_cur_addr1[i - 4] != apv_cur_addr0[i]);
+    }
+    for(i = 0; i < 16; i++)
+    {
+        if(i & 3)
+        {
+            au1_vert_ref[i] = (apv_cur_addr0[i - 1] != apv_cur_addr0[i])
+                            | (apv_cur_addr1[i - 1] != apv_cur_addr1[i]);
+            au1_vert_ref_cross[i] = (apv_cur_addr0[i - 1] != apv_cur_addr1[i])
+                            | (apv_cur_addr1[i - 1] != apv_cur_addr0[i]);
+        }
+    }
+
+    /*****************************************************************/
+    /* Forward and backward motion vectors, one qword per block      */
+    /*****************************************************************/
+    lim_8x16b = _mm_set1_epi32((i4_ver_mvlimit << 16) | 4);
+
+    for(i = 0; i < 8; i++)
+    {
+        cur_2x64b[i] = _mm_unpacklo_epi64(
+                        _mm_loadl_epi64((__m128i *)ps_cur_mv_pred[2 * i].i2_mv),
+                        _mm_loadl_epi64((__m128i *)ps_cur_mv_pred[2 * i + 1].i2_mv));
+    }
+
+    /* Top edges */
+    for(i = 0; i < 8; i++)
+    {
+        __m128i top_2x64b;
+        __m128i cur_cross_2x64b = _mm_shuffle_epi32(cur_2x64b[i], _MM_SHUFFLE(2, 3, 0, 1));
+
+        if(i < 2)
+        {
+            top_2x64b = _mm_unpacklo_epi64(
+                            _mm_loadl_epi64((__m128i *)ps_top_mv_pred[2 * i].i2_mv),
+                            _mm_loadl_epi64((__m128i *)ps_top_mv_pred[2 * i + 1].i2_mv));
+        }
+        else
+        {
+            top_2x64b = cur_2x64b[i - 2];
+        }
+
+        ge_8x16b[i] = ih264d_mv_diff_ge_sse42(top_2x64b, cur_2x64b[i], lim_8x16b);
+        ge_cross_8x16b[i] = ih264d_mv_diff_ge_sse42(top_2x64b, cur_cross_2x64b, lim_8x16b);
+    }
+
+    for(j = 0; j < 4; j++)
+    {
+        any_4x32b[j] = ih264d_bs_any_2x64_sse42(ge_8x16b[2 * j], ge_8x16b[2 * j + 1]);
+        any_cross_4x32b[j] = ih264d_bs_any_2x64_sse42(ge_cross_8x16b[2 * j],
+                                                      ge_cross_8x16b[2 * j + 1]);
+    }
+
+    horz_16x8b = _mm_or_si128(ih264d_bs_pack_4x4x32_sse42(any_4x32b[0], any_4x32b[1],
+                                                          any_4x32b[2], any_4x32b[3]),
+                              _mm_loadu_si128((__m128i *)au1_horz_ref));
+    horz_16x8b = _mm_and_si128(horz_16x8b,
+                               _mm_or_si128(ih264d_bs_pack_4x4x32_sse42(any_cross_4x32b[0],
+                                                                        any_cross_4x32b[1],
+                                                                        any_cross_4x32b[2],
+                                                                        any_cross_4x32b[3]),
+                                            _mm_loadu_si128((__m128i *)au1_horz_ref_cross)));
+
+    /* Left edges */
+    for(i = 0; i < 8; i++)
+    {
+        __m128i left_2x64b;
+        __m128i cur_cross_2x64b = _mm_shuffle_epi32(cur_2x64b[i], _MM_SHUFFLE(2, 3, 0, 1));
+
+        if(i & 1)
+        {
+            left_2x64b = _mm_alignr_epi8(cur_2x64b[i], cur_2x64b[i - 1], 8);
+        }
+        else
+        {
+            left_2x64b = _mm_unpacklo_epi64(
+                            _mm_loadl_epi64((__m128i *)ps_leftmost_mv_pred[2 * i].i2_mv),
+                            cur_2x64b[i]);
+        }
+
+        ge_8x16b[i] = ih264d_mv_diff_ge_sse42(left_2x64b, cur_2x64b[i], lim_8x16b);
+        ge_cross_8x16b[i] = ih264d_mv_diff_ge_sse42(left_2x64b, cur_cross_2x64b, lim_8x16b);
+    }
+
+    for(j = 0; j < 4; j++)
+    {
+        any_4x32b[j] = ih264d_bs_any_2x64_sse42(ge_8x16b[2 * j], ge_8x16b[2 * j + 1]);
+        any_cross_4x32b[j] = ih264d_bs_any_2x64_sse42(ge_cross_8x16b[2 * j],
+                                                      ge_cross_8x16b[2 * j + 1]);
+    }
+
+    vert_16x8b = _mm_or_si128(ih264d_bs_pack_4x4x32_sse42(any_4x32b[0], any_4x32b[1],
+                                                          any_4x32b[2], any_4x32b[3]),
+                              _mm_loadu_si128((__m128i *)au1_vert_ref));
+    vert_16x8b = _mm_and_si128(vert_16x8b,
+                               _mm_or_si128(ih264d_bs_pack_4x4x32_sse42(any_cross_4x32b[0],
+                                                                        any_cross_4x32b[1],
+                                                                        any_cross_4x32b[2],
+                                                                        any_cross_4x32b[3]),
+                                            _mm_loadu_si128((__m128i *)au1_vert_ref_cross)));
+
+    ih264d_bs1_merge_sse42(pu4_bs_table, horz_16x8b, vert_16x8b);
+}
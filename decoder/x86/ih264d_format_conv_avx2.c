@@ -0,0 +1,651 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_format_conv_avx2.c
+ *
+ * @brief
+ *  Conversion of the decoded 420SP frame to the display formats
+ *
+ * @par List of Functions:
+ *  - ih264d_fmt_conv_get_rgb_avx2()
+ *  - ih264d_fmt_conv_get_coefs_avx2()
+ *  - ih264d_fmt_conv_420sp_to_rgb565_avx2()
+ *  - ih264d_fmt_conv_420sp_to_rgba8888_avx2()
+ *  - ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2()
+ *  - ih264d_fmt_conv_420sp_to_420p_avx2()
+ *
+ * @remarks
+ *  This file is built with AVX2 enabled and its functions are called only
+ *  when the CPU supports AVX2. The outputs match the generic versions bit
+ *  exactly. Columns of the RGB outputs that do not fill a vector are
+ *  converted by the generic versions.
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <string.h>
+#include <immintrin.h>
+
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_format_conv.h"
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Computes the B, G and R samples of 32 pixels of two rows sharing 16 chroma
+ *  samples
+ *
+ * @par Description:
+ *  The chroma terms are computed in 32 bits with the products of interleaved
+ *  U and V, shifted as in the generic version and added to the luma of both
+ *  rows. The in-lane pack of the terms leaves them in the 64 bit order 0, 2,
+ *  1, 3, from which the in-lane unpacks give the terms of pixels 0 to 15 and
+ *  16 to 31 in order. The sums are clipped to 8 bits but kept in 16 bits.
+ *
+ * @param[in] pu1_y_src
+ *  Luma of the first row, the second row is at src_y_strd from it
+ *
+ * @param[in] pu1_uv_src
+ *  Interleaved chroma
+ *
+ * @param[in] src_y_strd
+ *  Luma stride
+ *
+ * @param[in] coef_b_16x16b
+ *  B coefficients of the U and V of each chroma pair
+ *
+ * @param[in] coef_g_16x16b
+ *  G coefficients of the U and V of each chroma pair
+ *
+ * @param[in] coef_r_16x16b
+ *  R coefficients of the U and V of each chroma pair
+ *
+ * @param[out] ps_b_16x16b
+ *  B of pixels 0 to 15 and 16 to 31 of the two rows
+ *
+ * @param[out] ps_g_16x16b
+ *  G of pixels 0 to 15 and 16 to 31 of the two rows
+ *
+ * @param[out] ps_r_16x16b
+ *  R of pixels 0 to 15 and 16 to 31 of the two rows
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+static void ih264d_fmt_conv_get_rgb_avx2(UWORD8 *pu1_y_src,
+                                         UWORD8 *pu1_uv_src,
+                                         WORD32 src_y_strd,
+                                         __m256i coef_b_16x16b,
+                                         __m256i coef_g_16x16b,
+                                         __m256i coef_r_16x16b,
+                                         __m256i *ps_b_16x16b,
+                                         __m256i *ps_g_16x16b,
+                                         __m256i *ps_r_16x16b)
+{
+    __m256i zero_16x16b = _mm256_setzero_si256();
+    __m256i max_16x16b = _mm256_set1_epi16(255);
+    __m256i const_128_16x16b = _mm256_set1_epi16(128);
+    __m256i uv_lo_16x16b, uv_hi_16x16b;
+    __m256i b_16x16b, g_16x16b, r_16x16b;
+    __m256i lo_8x32b, hi_8x32b;
+    WORD32 row;
+
+    uv_lo_16x16b = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)pu1_uv_src));
+    uv_hi_16x16b = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(pu1_uv_src + 16)));
+    uv_lo_16x16b = _mm256_sub_epi16(uv_lo_16x16b, const_128_16x16b);
+    uv_hi_16x16b = _mm256_sub_epi16(uv_hi_16x16b, const_128_16x16b);
+
+    lo_8x32b = _mm256_srai_epi32(_mm256_madd_epi16(uv_lo_16x16b, coef_b_16x16b), 13);
+    hi_8x32b = _mm256_srai_epi32(_mm256_madd_epi16(uv_hi_16x16b, coef_b_16x16b), 13);
+    b_16x16b = _mm256_packs_epi32(lo_8x32b, hi_8x32b);
+
+    lo_8x32b = _mm256_srai_epi32(_mm256_madd_epi16(uv_lo_16x16b, coef_g_16x16b), 13);
+    hi_8x32b = _mm256_srai_epi32(_mm256_madd_epi16(uv_hi_16x16b, coef_g_16x16b), 13);
+    g_16x16b = _mm256_packs_epi32(lo_8x32b, hi_8x32b);
+
+    lo_8x32b = _mm256_srai_epi32(_mm256_madd_epi16(uv_lo_16x16b, coef_r_16x16b), 13);
+    hi_8x32b = _mm256_srai_epi32(_mm256_madd_epi16(uv_hi_16x16b, coef_r_16x16b), 13);
+    r_16x16b = _mm256_packs_epi32(lo_8x32b, hi_8x32b);
+
+    for(row = 0; row < 2; row++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + row * src_y_strd;
+        __m256i y_lo_16x16b, y_hi_16x16b;
+
+        y_lo_16x16b = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)pu1_y));
+        y_hi_16x16b = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(pu1_y + 16)));
+
+        /* Each chroma term applies to two horizontally adjacent pixels */
+        ps_b_16x16b[2 * row] = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(
+                        y_lo_16x16b, _mm256_unpacklo_epi16(b_16x16b, b_16x16b)),
+                        zero_16x16b), max_16x16b);
+        ps_b_16x16b[2 * row + 1] = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(
+                        y_hi_16x16b, _mm256_unpackhi_epi16(b_16x16b, b_16x16b)),
+                        zero_16x16b), max_16x16b);
+        ps_g_16x16b[2 * row] = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(
+                        y_lo_16x16b, _mm256_unpacklo_epi16(g_16x16b, g_16x16b)),
+                        zero_16x16b), max_16x16b);
+        ps_g_16x16b[2 * row + 1] = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(
+                        y_hi_16x16b, _mm256_unpackhi_epi16(g_16x16b, g_16x16b)),
+                        zero_16x16b), max_16x16b);
+        ps_r_16x16b[2 * row] = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(
+                        y_lo_16x16b, _mm256_unpacklo_epi16(r_16x16b, r_16x16b)),
+                        zero_16x16b), max_16x16b);
+        ps_r_16x16b[2 * row + 1] = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(
+                        y_hi_16x16b, _mm256_unpackhi_epi16(r_16x16b, r_16x16b)),
+                        zero_16x16b), max_16x16b);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Sets the coefficients of the chroma terms for the order of U and V
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[out] ps_coef_b_16x16b
+ *  B coefficients of the U and V of each chroma pair
+ *
+ * @param[out] ps_coef_g_16x16b
+ *  G coefficients of the U and V of each chroma pair
+ *
+ * @param[out] ps_coef_r_16x16b
+ *  R coefficients of the U and V of each chroma pair
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+static void ih264d_fmt_conv_get_coefs_avx2(WORD32 is_u_first,
+                                           __m256i *ps_coef_b_16x16b,
+                                           __m256i *ps_coef_g_16x16b,
+                                           __m256i *ps_coef_r_16x16b)
+{
+    __m256i zero_16x16b = _mm256_setzero_si256();
+    __m256i coef1_16x16b = _mm256_set1_epi16(COEFF1);
+    __m256i coef2_16x16b = _mm256_set1_epi16(COEFF2);
+    __m256i coef3_16x16b = _mm256_set1_epi16(COEFF3);
+    __m256i coef4_16x16b = _mm256_set1_epi16(COEFF4);
+
+    if(is_u_first)
+    {
+        *ps_coef_b_16x16b = _mm256_unpacklo_epi16(coef4_16x16b, zero_16x16b);
+        *ps_coef_g_16x16b = _mm256_unpacklo_epi16(coef2_16x16b, coef3_16x16b);
+        *ps_coef_r_16x16b = _mm256_unpacklo_epi16(zero_16x16b, coef1_16x16b);
+    }
+    else
+    {
+        *ps_coef_b_16x16b = _mm256_unpacklo_epi16(zero_16x16b, coef4_16x16b);
+        *ps_coef_g_16x16b = _mm256_unpacklo_epi16(coef3_16x16b, coef2_16x16b);
+        *ps_coef_r_16x16b = _mm256_unpacklo_epi16(coef1_16x16b, zero_16x16b);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Converts a 420SP buffer to RGB565
+ *
+ * @par Description:
+ *  Converts 32 pixels of two rows per iteration
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[out] pu2_rgb_dst
+ *  Output RGB565 pointer
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_strd
+ *  Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_rgb565_avx2(UWORD8 *pu1_y_src,
+                                          UWORD8 *pu1_uv_src,
+                                          UWORD16 *pu2_rgb_dst,
+                                          WORD32 wd,
+                                          WORD32 ht,
+                                          WORD32 src_y_strd,
+                                          WORD32 src_uv_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 is_u_first)
+{
+    __m256i coef_b_16x16b, coef_g_16x16b, coef_r_16x16b;
+    __m256i mask_r_16x16b = _mm256_set1_epi16((WORD16)0xF800);
+    __m256i mask_g_16x16b = _mm256_set1_epi16(0x07E0);
+    WORD32 wd_simd = wd & ~31;
+    WORD32 i, j;
+
+    ih264d_fmt_conv_get_coefs_avx2(is_u_first, &coef_b_16x16b, &coef_g_16x16b,
+                                   &coef_r_16x16b);
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD16 *pu2_dst = pu2_rgb_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 32)
+        {
+            __m256i as_b_16x16b[4], as_g_16x16b[4], as_r_16x16b[4];
+            WORD32 k;
+
+            ih264d_fmt_conv_get_rgb_avx2(pu1_y + j, pu1_uv + j, src_y_strd,
+                                         coef_b_16x16b, coef_g_16x16b,
+                                         coef_r_16x16b, as_b_16x16b, as_g_16x16b,
+                                         as_r_16x16b);
+
+            /* Halves of the first row, then of the second */
+            for(k = 0; k < 4; k++)
+            {
+                __m256i rgb_16x16b;
+                UWORD16 *pu2_out = pu2_dst + (k >> 1) * dst_strd + j + (k & 1) * 16;
+
+                /* R in the top 5 bits, G in the next 6 and B in the last 5 */
+                rgb_16x16b = _mm256_and_si256(_mm256_slli_epi16(as_r_16x16b[k], 8),
+                                              mask_r_16x16b);
+                rgb_16x16b = _mm256_or_si256(rgb_16x16b, _mm256_and_si256(
+                                _mm256_slli_epi16(as_g_16x16b[k], 3), mask_g_16x16b));
+                rgb_16x16b = _mm256_or_si256(rgb_16x16b,
+                                             _mm256_srli_epi16(as_b_16x16b[k], 3));
+
+                _mm256_storeu_si256((__m256i *)pu2_out, rgb_16x16b);
+            }
+        }
+    }
+
+    if(wd_simd < wd)
+    {
+        ih264d_fmt_conv_420sp_to_rgb565(pu1_y_src + wd_simd,
+                                        pu1_uv_src + wd_simd,
+                                        pu2_rgb_dst + wd_simd,
+                                        wd - wd_simd, ht, src_y_strd,
+                                        src_uv_strd, dst_strd, is_u_first);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Converts a 420SP buffer to RGBA8888
+ *
+ * @par Description:
+ *  Converts 32 pixels of two rows per iteration. The alpha byte is zero as
+ *  in the generic version
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[out] pu4_rgba_dst
+ *  Output RGBA8888 pointer
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_strd
+ *  Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_rgba8888_avx2(UWORD8 *pu1_y_src,
+                                            UWORD8 *pu1_uv_src,
+                                            UWORD32 *pu4_rgba_dst,
+                                            WORD32 wd,
+                                            WORD32 ht,
+                                            WORD32 src_y_strd,
+                                            WORD32 src_uv_strd,
+                                            WORD32 dst_strd,
+                                            WORD32 is_u_first)
+{
+    __m256i coef_b_16x16b, coef_g_16x16b, coef_r_16x16b;
+    WORD32 wd_simd = wd & ~31;
+    WORD32 i, j;
+
+    ih264d_fmt_conv_get_coefs_avx2(is_u_first, &coef_b_16x16b, &coef_g_16x16b,
+                                   &coef_r_16x16b);
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD32 *pu4_dst = pu4_rgba_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 32)
+        {
+            __m256i as_b_16x16b[4], as_g_16x16b[4], as_r_16x16b[4];
+            WORD32 k;
+
+            ih264d_fmt_conv_get_rgb_avx2(pu1_y + j, pu1_uv + j, src_y_strd,
+                                         coef_b_16x16b, coef_g_16x16b,
+                                         coef_r_16x16b, as_b_16x16b, as_g_16x16b,
+                                         as_r_16x16b);
+
+            /* Halves of the first row, then of the second */
+            for(k = 0; k < 4; k++)
+            {
+                __m256i bg_16x16b, lo_8x32b, hi_8x32b;
+                UWORD32 *pu4_out = pu4_dst + (k >> 1) * dst_strd + j + (k & 1) * 16;
+
+                /* Bytes of each pixel are B, G, R and a zero alpha */
+                bg_16x16b = _mm256_or_si256(as_b_16x16b[k],
+                                            _mm256_slli_epi16(as_g_16x16b[k], 8));
+                lo_8x32b = _mm256_unpacklo_epi16(bg_16x16b, as_r_16x16b[k]);
+                hi_8x32b = _mm256_unpackhi_epi16(bg_16x16b, as_r_16x16b[k]);
+
+                /* The unpacks hold pixels 0-3, 8-11 and 4-7, 12-15 */
+                _mm256_storeu_si256((__m256i *)(pu4_out + 0),
+                                    _mm256_permute2x128_si256(lo_8x32b, hi_8x32b, 0x20));
+                _mm256_storeu_si256((__m256i *)(pu4_out + 8),
+                                    _mm256_permute2x128_si256(lo_8x32b, hi_8x32b, 0x31));
+            }
+        }
+    }
+
+    if(wd_simd < wd)
+    {
+        ih264d_fmt_conv_420sp_to_rgba8888(pu1_y_src + wd_simd,
+                                          pu1_uv_src + wd_simd,
+                                          pu4_rgba_dst + wd_simd,
+                                          wd - wd_simd, ht, src_y_strd,
+                                          src_uv_strd, dst_strd, is_u_first);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Swaps the U and V of a 420SP buffer
+ *
+ * @par Description:
+ *  Swaps the bytes of 16 chroma pairs per iteration
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *  Output Y pointer
+ *
+ * @param[in] pu1_uv_dst
+ *  Output UV pointer (UV is interleaved in the other format)
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *  Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *  Output UV stride
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2(UWORD8 *pu1_y_src,
+                                                 UWORD8 *pu1_uv_src,
+                                                 UWORD8 *pu1_y_dst,
+                                                 UWORD8 *pu1_uv_dst,
+                                                 WORD32 wd,
+                                                 WORD32 ht,
+                                                 WORD32 src_y_strd,
+                                                 WORD32 src_uv_strd,
+                                                 WORD32 dst_y_strd,
+                                                 WORD32 dst_uv_strd)
+{
+    __m256i swap_32x8b = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                          9, 8, 11, 10, 13, 12, 15, 14,
+                                          1, 0, 3, 2, 5, 4, 7, 6,
+                                          9, 8, 11, 10, 13, 12, 15, 14);
+    WORD32 i, j;
+
+    /* copy luma */
+    for(i = 0; i < ht; i++)
+    {
+        memcpy(pu1_y_dst, pu1_y_src, wd);
+        pu1_y_dst += dst_y_strd;
+        pu1_y_src += src_y_strd;
+    }
+
+    /* copy U and V */
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        for(j = 0; j + 32 <= wd; j += 32)
+        {
+            __m256i uv_32x8b = _mm256_loadu_si256((__m256i *)(pu1_uv_src + j));
+
+            _mm256_storeu_si256((__m256i *)(pu1_uv_dst + j),
+                                _mm256_shuffle_epi8(uv_32x8b, swap_32x8b));
+        }
+        for(; j < wd; j += 2)
+        {
+            pu1_uv_dst[j + 0] = pu1_uv_src[j + 1];
+            pu1_uv_dst[j + 1] = pu1_uv_src[j + 0];
+        }
+        pu1_uv_dst += dst_uv_strd;
+        pu1_uv_src += src_uv_strd;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Converts a 420SP buffer to 420P
+ *
+ * @par Description:
+ *  Separates 32 chroma pairs per iteration. The in-lane shuffle leaves 8
+ *  first and 8 second samples in each lane, which the 64 bit permute puts
+ *  in order before the lanes of the two loads are combined
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *  Output Y pointer
+ *
+ * @param[in] pu1_u_dst
+ *  Output U pointer
+ *
+ * @param[in] pu1_v_dst
+ *  Output V pointer
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *  Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *  Output UV stride
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] disable_luma_copy
+ *  Flag to skip the copy of luma
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_420p_avx2(UWORD8 *pu1_y_src,
+                                        UWORD8 *pu1_uv_src,
+                                        UWORD8 *pu1_y_dst,
+                                        UWORD8 *pu1_u_dst,
+                                        UWORD8 *pu1_v_dst,
+                                        WORD32 wd,
+                                        WORD32 ht,
+                                        WORD32 src_y_strd,
+                                        WORD32 src_uv_strd,
+                                        WORD32 dst_y_strd,
+                                        WORD32 dst_uv_strd,
+                                        WORD32 is_u_first,
+                                        WORD32 disable_luma_copy)
+{
+    __m256i split_32x8b = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                           1, 3, 5, 7, 9, 11, 13, 15,
+                                           0, 2, 4, 6, 8, 10, 12, 14,
+                                           1, 3, 5, 7, 9, 11, 13, 15);
+    UWORD8 *pu1_first_dst, *pu1_second_dst;
+    WORD32 num_cols = wd >> 1;
+    WORD32 i, j;
+
+    if(0 == disable_luma_copy)
+    {
+        /* copy luma */
+        for(i = 0; i < ht; i++)
+        {
+            memcpy(pu1_y_dst, pu1_y_src, wd);
+            pu1_y_dst += dst_y_strd;
+            pu1_y_src += src_y_strd;
+        }
+    }
+
+    /* de-interleave U and V and copy to destination */
+    pu1_first_dst = is_u_first ? pu1_u_dst : pu1_v_dst;
+    pu1_second_dst = is_u_first ? pu1_v_dst : pu1_u_dst;
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        for(j = 0; j + 32 <= num_cols; j += 32)
+        {
+            __m256i src0_32x8b, src1_32x8b;
+
+            src0_32x8b = _mm256_loadu_si256((__m256i *)(pu1_uv_src + 2 * j));
+            src1_32x8b = _mm256_loadu_si256((__m256i *)(pu1_uv_src + 2 * j + 32));
+            src0_32x8b = _mm256_shuffle_epi8(src0_32x8b, split_32x8b);
+            src1_32x8b = _mm256_shuffle_epi8(src1_32x8b, split_32x8b);
+
+            /* First samples 0-15 in the lower lane, second ones in the upper */
+            src0_32x8b = _mm256_permute4x64_epi64(src0_32x8b, 0xD8);
+            src1_32x8b = _mm256_permute4x64_epi64(src1_32x8b, 0xD8);
+
+            _mm256_storeu_si256((__m256i *)(pu1_first_dst + j),
+                                _mm256_permute2x128_si256(src0_32x8b, src1_32x8b, 0x20));
+            _mm256_storeu_si256((__m256i *)(pu1_second_dst + j),
+                                _mm256_permute2x128_si256(src0_32x8b, src1_32x8b, 0x31));
+        }
+        for(; j < num_cols; j++)
+        {
+            pu1_first_dst[j] = pu1_uv_src[j * 2];
+            pu1_second_dst[j] = pu1_uv_src[j * 2 + 1];
+        }
+
+        pu1_first_dst += dst_uv_strd;
+        pu1_second_dst += dst_uv_strd;
+        pu1_uv_src += src_uv_strd;
+    }
+}
@@ -0,0 +1,760 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_format_conv_ssse3.c
+ *
+ * @brief
+ *  Conversion of the decoded 420SP frame to the display formats
+ *
+ * @par List of Functions:
+ *  - ih264d_fmt_conv_get_rgb_ssse3()
+ *  - ih264d_fmt_conv_get_coefs_ssse3()
+ *  - ih264d_fmt_conv_420sp_to_rgb565_ssse3()
+ *  - ih264d_fmt_conv_420sp_to_rgba8888_ssse3()
+ *  - ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3()
+ *  - ih264d_fmt_conv_420sp_to_420p_ssse3()
+ *  - ih264d_fmt_conv_downscale_ssse3()
+ *
+ * @remarks
+ *  The outputs match the generic versions bit exactly. Columns that do not
+ *  fill a vector are converted by the generic versions.
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <string.h>
+#include <immintrin.h>
+
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_format_conv.h"
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Computes the B, G and R samples of 16 pixels of two rows sharing 8 chroma
+ *  samples
+ *
+ * @par Description:
+ *  The chroma terms are computed in 32 bits with the products of interleaved
+ *  U and V, shifted as in the generic version and added to the luma of both
+ *  rows. The sums are clipped by the saturating pack.
+ *
+ * @param[in] pu1_y_src
+ *  Luma of the first row, the second row is at src_y_strd from it
+ *
+ * @param[in] pu1_uv_src
+ *  Interleaved chroma
+ *
+ * @param[in] src_y_strd
+ *  Luma stride
+ *
+ * @param[in] coef_b_8x16b
+ *  B coefficients of the U and V of each chroma pair
+ *
+ * @param[in] coef_g_8x16b
+ *  G coefficients of the U and V of each chroma pair
+ *
+ * @param[in] coef_r_8x16b
+ *  R coefficients of the U and V of each chroma pair
+ *
+ * @param[out] ps_b_16x8b
+ *  B of the two rows
+ *
+ * @param[out] ps_g_16x8b
+ *  G of the two rows
+ *
+ * @param[out] ps_r_16x8b
+ *  R of the two rows
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+static void ih264d_fmt_conv_get_rgb_ssse3(UWORD8 *pu1_y_src,
+                                          UWORD8 *pu1_uv_src,
+                                          WORD32 src_y_strd,
+                                          __m128i coef_b_8x16b,
+                                          __m128i coef_g_8x16b,
+                                          __m128i coef_r_8x16b,
+                                          __m128i *ps_b_16x8b,
+                                          __m128i *ps_g_16x8b,
+                                          __m128i *ps_r_16x8b)
+{
+    __m128i zero_16x8b = _mm_setzero_si128();
+    __m128i const_128_8x16b = _mm_set1_epi16(128);
+    __m128i uv_16x8b, uv_lo_8x16b, uv_hi_8x16b;
+    __m128i b_8x16b, g_8x16b, r_8x16b;
+    __m128i lo_4x32b, hi_4x32b;
+    WORD32 row;
+
+    uv_16x8b = _mm_loadu_si128((__m128i *)pu1_uv_src);
+    uv_lo_8x16b = _mm_unpacklo_epi8(uv_16x8b, zero_16x8b);
+    uv_hi_8x16b = _mm_unpackhi_epi8(uv_16x8b, zero_16x8b);
+    uv_lo_8x16b = _mm_sub_epi16(uv_lo_8x16b, const_128_8x16b);
+    uv_hi_8x16b = _mm_sub_epi16(uv_hi_8x16b, const_128_8x16b);
+
+    lo_4x32b = _mm_srai_epi32(_mm_madd_epi16(uv_lo_8x16b, coef_b_8x16b), 13);
+    hi_4x32b = _mm_srai_epi32(_mm_madd_epi16(uv_hi_8x16b, coef_b_8x16b), 13);
+    b_8x16b = _mm_packs_epi32(lo_4x32b, hi_4x32b);
+
+    lo_4x32b = _mm_srai_epi32(_mm_madd_epi16(uv_lo_8x16b, coef_g_8x16b), 13);
+    hi_4x32b = _mm_srai_epi32(_mm_madd_epi16(uv_hi_8x16b, coef_g_8x16b), 13);
+    g_8x16b = _mm_packs_epi32(lo_4x32b, hi_4x32b);
+
+    lo_4x32b = _mm_srai_epi32(_mm_madd_epi16(uv_lo_8x16b, coef_r_8x16b), 13);
+    hi_4x32b = _mm_srai_epi32(_mm_madd_epi16(uv_hi_8x16b, coef_r_8x16b), 13);
+    r_8x16b = _mm_packs_epi32(lo_4x32b, hi_4x32b);
+
+    for(row = 0; row < 2; row++)
+    {
+        __m128i y_16x8b, y_lo_8x16b, y_hi_8x16b;
+
+        y_16x8b = _mm_loadu_si128((__m128i *)(pu1_y_src + row * src_y_strd));
+        y_lo_8x16b = _mm_unpacklo_epi8(y_16x8b, zero_16x8b);
+        y_hi_8x16b = _mm_unpackhi_epi8(y_16x8b, zero_16x8b);
+
+        /* Each chroma term applies to two horizontally adjacent pixels */
+        ps_b_16x8b[row] = _mm_packus_epi16(
+                        _mm_add_epi16(y_lo_8x16b, _mm_unpacklo_epi16(b_8x16b, b_8x16b)),
+                        _mm_add_epi16(y_hi_8x16b, _mm_unpackhi_epi16(b_8x16b, b_8x16b)));
+        ps_g_16x8b[row] = _mm_packus_epi16(
+                        _mm_add_epi16(y_lo_8x16b, _mm_unpacklo_epi16(g_8x16b, g_8x16b)),
+                        _mm_add_epi16(y_hi_8x16b, _mm_unpackhi_epi16(g_8x16b, g_8x16b)));
+        ps_r_16x8b[row] = _mm_packus_epi16(
+                        _mm_add_epi16(y_lo_8x16b, _mm_unpacklo_epi16(r_8x16b, r_8x16b)),
+                        _mm_add_epi16(y_hi_8x16b, _mm_unpackhi_epi16(r_8x16b, r_8x16b)));
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Sets the coefficients of the chroma terms for the order of U and V
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[out] ps_coef_b_8x16b
+ *  B coefficients of the U and V of each chroma pair
+ *
+ * @param[out] ps_coef_g_8x16b
+ *  G coefficients of the U and V of each chroma pair
+ *
+ * @param[out] ps_coef_r_8x16b
+ *  R coefficients of the U and V of each chroma pair
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+static void ih264d_fmt_conv_get_coefs_ssse3(WORD32 is_u_first,
+                                            __m128i *ps_coef_b_8x16b,
+                                            __m128i *ps_coef_g_8x16b,
+                                            __m128i *ps_coef_r_8x16b)
+{
+    __m128i zero_8x16b = _mm_setzero_si128();
+    __m128i coef1_8x16b = _mm_set1_epi16(COEFF1);
+    __m128i coef2_8x16b = _mm_set1_epi16(COEFF2);
+    __m128i coef3_8x16b = _mm_set1_epi16(COEFF3);
+    __m128i coef4_8x16b = _mm_set1_epi16(COEFF4);
+
+    if(is_u_first)
+    {
+        *ps_coef_b_8x16b = _mm_unpacklo_epi16(coef4_8x16b, zero_8x16b);
+        *ps_coef_g_8x16b = _mm_unpacklo_epi16(coef2_8x16b, coef3_8x16b);
+        *ps_coef_r_8x16b = _mm_unpacklo_epi16(zero_8x16b, coef1_8x16b);
+    }
+    else
+    {
+        *ps_coef_b_8x16b = _mm_unpacklo_epi16(zero_8x16b, coef4_8x16b);
+        *ps_coef_g_8x16b = _mm_unpacklo_epi16(coef3_8x16b, coef2_8x16b);
+        *ps_coef_r_8x16b = _mm_unpacklo_epi16(coef1_8x16b, zero_8x16b);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Converts a 420SP buffer to RGB565
+ *
+ * @par Description:
+ *  Converts 16 pixels of two rows per iteration
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[out] pu2_rgb_dst
+ *  Output RGB565 pointer
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_strd
+ *  Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_rgb565_ssse3(UWORD8 *pu1_y_src,
+                                           UWORD8 *pu1_uv_src,
+                                           UWORD16 *pu2_rgb_dst,
+                                           WORD32 wd,
+                                           WORD32 ht,
+                                           WORD32 src_y_strd,
+                                           WORD32 src_uv_strd,
+                                           WORD32 dst_strd,
+                                           WORD32 is_u_first)
+{
+    __m128i coef_b_8x16b, coef_g_8x16b, coef_r_8x16b;
+    __m128i zero_16x8b = _mm_setzero_si128();
+    __m128i mask_r_8x16b = _mm_set1_epi16((WORD16)0xF800);
+    __m128i mask_g_8x16b = _mm_set1_epi16(0x07E0);
+    WORD32 wd_simd = wd & ~15;
+    WORD32 i, j;
+
+    ih264d_fmt_conv_get_coefs_ssse3(is_u_first, &coef_b_8x16b, &coef_g_8x16b,
+                                    &coef_r_8x16b);
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD16 *pu2_dst = pu2_rgb_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 16)
+        {
+            __m128i as_b_16x8b[2], as_g_16x8b[2], as_r_16x8b[2];
+            WORD32 row;
+
+            ih264d_fmt_conv_get_rgb_ssse3(pu1_y + j, pu1_uv + j, src_y_strd,
+                                          coef_b_8x16b, coef_g_8x16b,
+                                          coef_r_8x16b, as_b_16x8b, as_g_16x8b,
+                                          as_r_16x8b);
+
+            for(row = 0; row < 2; row++)
+            {
+                __m128i lo_8x16b, hi_8x16b;
+
+                /* R in the top 5 bits, G in the next 6 and B in the last 5 */
+                lo_8x16b = _mm_and_si128(_mm_unpacklo_epi8(zero_16x8b, as_r_16x8b[row]),
+                                         mask_r_8x16b);
+                hi_8x16b = _mm_and_si128(_mm_unpackhi_epi8(zero_16x8b, as_r_16x8b[row]),
+                                         mask_r_8x16b);
+                lo_8x16b = _mm_or_si128(lo_8x16b, _mm_and_si128(
+                                _mm_slli_epi16(_mm_unpacklo_epi8(as_g_16x8b[row], zero_16x8b), 3),
+                                mask_g_8x16b));
+                hi_8x16b = _mm_or_si128(hi_8x16b, _mm_and_si128(
+                                _mm_slli_epi16(_mm_unpackhi_epi8(as_g_16x8b[row], zero_16x8b), 3),
+                                mask_g_8x16b));
+                lo_8x16b = _mm_or_si128(lo_8x16b, _mm_srli_epi16(
+                                _mm_unpacklo_epi8(as_b_16x8b[row], zero_16x8b), 3));
+                hi_8x16b = _mm_or_si128(hi_8x16b, _mm_srli_epi16(
+                                _mm_unpackhi_epi8(as_b_16x8b[row], zero_16x8b), 3));
+
+                _mm_storeu_si128((__m128i *)(pu2_dst + row * dst_strd + j), lo_8x16b);
+                _mm_storeu_si128((__m128i *)(pu2_dst + row * dst_strd + j + 8), hi_8x16b);
+            }
+        }
+    }
+
+    if(wd_simd < wd)
+    {
+        ih264d_fmt_conv_420sp_to_rgb565(pu1_y_src + wd_simd,
+                                        pu1_uv_src + wd_simd,
+                                        pu2_rgb_dst + wd_simd,
+                                        wd - wd_simd, ht, src_y_strd,
+                                        src_uv_strd, dst_strd, is_u_first);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Converts a 420SP buffer to RGBA8888
+ *
+ * @par Description:
+ *  Converts 16 pixels of two rows per iteration. The alpha byte is zero as
+ *  in the generic version
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[out] pu4_rgba_dst
+ *  Output RGBA8888 pointer
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_strd
+ *  Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_rgba8888_ssse3(UWORD8 *pu1_y_src,
+                                             UWORD8 *pu1_uv_src,
+                                             UWORD32 *pu4_rgba_dst,
+                                             WORD32 wd,
+                                             WORD32 ht,
+                                             WORD32 src_y_strd,
+                                             WORD32 src_uv_strd,
+                                             WORD32 dst_strd,
+                                             WORD32 is_u_first)
+{
+    __m128i coef_b_8x16b, coef_g_8x16b, coef_r_8x16b;
+    __m128i zero_16x8b = _mm_setzero_si128();
+    WORD32 wd_simd = wd & ~15;
+    WORD32 i, j;
+
+    ih264d_fmt_conv_get_coefs_ssse3(is_u_first, &coef_b_8x16b, &coef_g_8x16b,
+                                    &coef_r_8x16b);
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD32 *pu4_dst = pu4_rgba_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 16)
+        {
+            __m128i as_b_16x8b[2], as_g_16x8b[2], as_r_16x8b[2];
+            WORD32 row;
+
+            ih264d_fmt_conv_get_rgb_ssse3(pu1_y + j, pu1_uv + j, src_y_strd,
+                                          coef_b_8x16b, coef_g_8x16b,
+                                          coef_r_8x16b, as_b_16x8b, as_g_16x8b,
+                                          as_r_16x8b);
+
+            for(row = 0; row < 2; row++)
+            {
+                __m128i bg_lo_16x8b, bg_hi_16x8b, ra_lo_16x8b, ra_hi_16x8b;
+                UWORD32 *pu4_out = pu4_dst + row * dst_strd + j;
+
+                /* Bytes of each pixel are B, G, R and a zero alpha */
+                bg_lo_16x8b = _mm_unpacklo_epi8(as_b_16x8b[row], as_g_16x8b[row]);
+                bg_hi_16x8b = _mm_unpackhi_epi8(as_b_16x8b[row], as_g_16x8b[row]);
+                ra_lo_16x8b = _mm_unpacklo_epi8(as_r_16x8b[row], zero_16x8b);
+                ra_hi_16x8b = _mm_unpackhi_epi8(as_r_16x8b[row], zero_16x8b);
+
+                _mm_storeu_si128((__m128i *)(pu4_out + 0),
+                                 _mm_unpacklo_epi16(bg_lo_16x8b, ra_lo_16x8b));
+                _mm_storeu_si128((__m128i *)(pu4_out + 4),
+                                 _mm_unpackhi_epi16(bg_lo_16x8b, ra_lo_16x8b));
+                _mm_storeu_si128((__m128i *)(pu4_out + 8),
+                                 _mm_unpacklo_epi16(bg_hi_16x8b, ra_hi_16x8b));
+                _mm_storeu_si128((__m128i *)(pu4_out + 12),
+                                 _mm_unpackhi_epi16(bg_hi_16x8b, ra_hi_16x8b));
+            }
+        }
+    }
+
+    if(wd_simd < wd)
+    {
+        ih264d_fmt_conv_420sp_to_rgba8888(pu1_y_src + wd_simd,
+                                          pu1_uv_src + wd_simd,
+                                          pu4_rgba_dst + wd_simd,
+                                          wd - wd_simd, ht, src_y_strd,
+                                          src_uv_strd, dst_strd, is_u_first);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Copies a 420SP buffer swapping U and V
+ *
+ * @par Description:
+ *  Swaps the bytes of 8 chroma pairs per iteration
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *  Output Y pointer
+ *
+ * @param[in] pu1_uv_dst
+ *  Output UV pointer (UV is interleaved in the other format)
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *  Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *  Output UV stride
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3(UWORD8 *pu1_y_src,
+                                                  UWORD8 *pu1_uv_src,
+                                                  UWORD8 *pu1_y_dst,
+                                                  UWORD8 *pu1_uv_dst,
+                                                  WORD32 wd,
+                                                  WORD32 ht,
+                                                  WORD32 src_y_strd,
+                                                  WORD32 src_uv_strd,
+                                                  WORD32 dst_y_strd,
+                                                  WORD32 dst_uv_strd)
+{
+    __m128i swap_16x8b = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                       9, 8, 11, 10, 13, 12, 15, 14);
+    WORD32 i, j;
+
+    /* copy luma */
+    for(i = 0; i < ht; i++)
+    {
+        memcpy(pu1_y_dst, pu1_y_src, wd);
+        pu1_y_dst += dst_y_strd;
+        pu1_y_src += src_y_strd;
+    }
+
+    /* copy U and V */
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        for(j = 0; j + 16 <= wd; j += 16)
+        {
+            __m128i uv_16x8b = _mm_loadu_si128((__m128i *)(pu1_uv_src + j));
+
+            _mm_storeu_si128((__m128i *)(pu1_uv_dst + j),
+                             _mm_shuffle_epi8(uv_16x8b, swap_16x8b));
+        }
+        for(; j < wd; j += 2)
+        {
+            pu1_uv_dst[j + 0] = pu1_uv_src[j + 1];
+            pu1_uv_dst[j + 1] = pu1_uv_src[j + 0];
+        }
+        pu1_uv_dst += dst_uv_strd;
+        pu1_uv_src += src_uv_strd;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Converts a 420SP buffer to 420P
+ *
+ * @par Description:
+ *  Separates 16 chroma pairs per iteration
+ *
+ * @param[in] pu1_y_src
+ *  Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *  Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *  Output Y pointer
+ *
+ * @param[in] pu1_u_dst
+ *  Output U pointer
+ *
+ * @param[in] pu1_v_dst
+ *  Output V pointer
+ *
+ * @param[in] wd
+ *  Width
+ *
+ * @param[in] ht
+ *  Height
+ *
+ * @param[in] src_y_strd
+ *  Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *  Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *  Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *  Output UV stride
+ *
+ * @param[in] is_u_first
+ *  Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] disable_luma_copy
+ *  Flag to skip the copy of luma
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_420sp_to_420p_ssse3(UWORD8 *pu1_y_src,
+                                         UWORD8 *pu1_uv_src,
+                                         UWORD8 *pu1_y_dst,
+                                         UWORD8 *pu1_u_dst,
+                                         UWORD8 *pu1_v_dst,
+                                         WORD32 wd,
+                                         WORD32 ht,
+                                         WORD32 src_y_strd,
+                                         WORD32 src_uv_strd,
+                                         WORD32 dst_y_strd,
+                                         WORD32 dst_uv_strd,
+                                         WORD32 is_u_first,
+                                         WORD32 disable_luma_copy)
+{
+    __m128i split_16x8b = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                        1, 3, 5, 7, 9, 11, 13, 15);
+    UWORD8 *pu1_first_dst, *pu1_second_dst;
+    WORD32 num_cols = wd >> 1;
+    WORD32 i, j;
+
+    if(0 == disable_luma_copy)
+    {
+        /* copy luma */
+        for(i = 0; i < ht; i++)
+        {
+            memcpy(pu1_y_dst, pu1_y_src, wd);
+            pu1_y_dst += dst_y_strd;
+            pu1_y_src += src_y_strd;
+        }
+    }
+
+    /* de-interleave U and V and copy to destination */
+    pu1_first_dst = is_u_first ? pu1_u_dst : pu1_v_dst;
+    pu1_second_dst = is_u_first ? pu1_v_dst : pu1_u_dst;
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        for(j = 0; j + 16 <= num_cols; j += 16)
+        {
+            __m128i src0_16x8b, src1_16x8b;
+
+            src0_16x8b = _mm_loadu_si128((__m128i *)(pu1_uv_src + 2 * j));
+            src1_16x8b = _mm_loadu_si128((__m128i *)(pu1_uv_src + 2 * j + 16));
+            src0_16x8b = _mm_shuffle_epi8(src0_16x8b, split_16x8b);
+            src1_16x8b = _mm_shuffle_epi8(src1_16x8b, split_16x8b);
+
+            _mm_storeu_si128((__m128i *)(pu1_first_dst + j),
+                             _mm_unpacklo_epi64(src0_16x8b, src1_16x8b));
+            _mm_storeu_si128((__m128i *)(pu1_second_dst + j),
+                             _mm_unpackhi_epi64(src0_16x8b, src1_16x8b));
+        }
+        for(; j < num_cols; j++)
+        {
+            pu1_first_dst[j] = pu1_uv_src[j * 2];
+            pu1_second_dst[j] = pu1_uv_src[j * 2 + 1];
+        }
+
+        pu1_first_dst += dst_uv_strd;
+        pu1_second_dst += dst_uv_strd;
+        pu1_uv_src += src_uv_strd;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Downscales a plane of a 420SP buffer by averaging boxes of samples
+ *
+ * @par Description
+ *  Each iteration averages the boxes of 8 output samples. The rows of a box
+ *  are summed in 16 bit lanes, then adjacent sums of the same component are
+ *  added with phaddw scale_log2 times. Interleaved chroma is first shuffled
+ *  so that the two U and two V sums to be added are adjacent.
+ *
+ * @param[in] pu1_src
+ *  Input pointer
+ *
+ * @param[out] pu1_dst
+ *  Output pointer
+ *
+ * @param[in] wd
+ *  Output width in bytes
+ *
+ * @param[in] ht
+ *  Output height
+ *
+ * @param[in] src_strd
+ *  Input stride
+ *
+ * @param[in] dst_strd
+ *  Output stride
+ *
+ * @param[in] scale_log2
+ *  Log2 of the downscale factor, 1 to MAX_OUT_SCALE_LOG2
+ *
+ * @param[in] is_chroma
+ *  Flag to indicate interleaved chroma
+ *
+ * @returns  None
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+void ih264d_fmt_conv_downscale_ssse3(UWORD8 *pu1_src,
+                                     UWORD8 *pu1_dst,
+                                     WORD32 wd,
+                                     WORD32 ht,
+                                     WORD32 src_strd,
+                                     WORD32 dst_strd,
+                                     WORD32 scale_log2,
+                                     WORD32 is_chroma)
+{
+    __m128i pair_uv_8x16b = _mm_setr_epi8(0, 1, 4, 5, 2, 3, 6, 7,
+                                          8, 9, 12, 13, 10, 11, 14, 15);
+    __m128i rnd_8x16b = _mm_set1_epi16(1 << (2 * scale_log2 - 1));
+    __m128i zero_16x8b = _mm_setzero_si128();
+    WORD32 scale = 1 << scale_log2;
+    WORD32 wd_simd = wd & ~7;
+    WORD32 i, j, k, l, n;
+
+    if(wd_simd < wd)
+    {
+        ih264d_fmt_conv_downscale(pu1_src + (wd_simd << scale_log2),
+                                  pu1_dst + wd_simd, wd - wd_simd, ht,
+                                  src_strd, dst_strd, scale_log2, is_chroma);
+    }
+
+    for(i = 0; i < ht; i++)
+    {
+        for(j = 0; j < wd_simd; j += 8)
+        {
+            __m128i acc_8x16b[8];
+            UWORD8 *pu1_box = pu1_src + (j << scale_log2);
+
+            /* Sum the rows of 8 << scale_log2 input bytes */
+            for(l = 0; l < scale; l += 2)
+            {
+                acc_8x16b[l] = zero_16x8b;
+                acc_8x16b[l + 1] = zero_16x8b;
+            }
+            for(k = 0; k < scale; k++)
+            {
+                for(l = 0; l < scale; l += 2)
+                {
+                    __m128i src_16x8b;
+
+                    src_16x8b = _mm_loadu_si128((__m128i *)(pu1_box + 8 * l));
+                    acc_8x16b[l] = _mm_add_epi16(acc_8x16b[l],
+                                                 _mm_unpacklo_epi8(src_16x8b, zero_16x8b));
+                    acc_8x16b[l + 1] = _mm_add_epi16(acc_8x16b[l + 1],
+                                                     _mm_unpackhi_epi8(src_16x8b, zero_16x8b));
+                }
+                pu1_box += src_strd;
+            }
+
+            /* Halve the number of sums per component scale_log2 times */
+            for(n = scale; n > 1; n >>= 1)
+            {
+                for(l = 0; l < n; l += 2)
+                {
+                    if(is_chroma)
+                    {
+                        acc_8x16b[l] = _mm_shuffle_epi8(acc_8x16b[l], pair_uv_8x16b);
+                        acc_8x16b[l + 1] = _mm_shuffle_epi8(acc_8x16b[l + 1],
+                                                            pair_uv_8x16b);
+                    }
+                    acc_8x16b[l >> 1] = _mm_hadd_epi16(acc_8x16b[l], acc_8x16b[l + 1]);
+                }
+            }
+
+            acc_8x16b[0] = _mm_add_epi16(acc_8x16b[0], rnd_8x16b);
+            acc_8x16b[0] = _mm_srli_epi16(acc_8x16b[0], 2 * scale_log2);
+            _mm_storel_epi64((__m128i *)(pu1_dst + j),
+                             _mm_packus_epi16(acc_8x16b[0], acc_8x16b[0]));
+        }
+        pu1_src += src_strd << scale_log2;
+        pu1_dst += dst_strd;
+    }
+}
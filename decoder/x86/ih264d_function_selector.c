@@ -45,6 +45,7 @@
 
 /* User Include files */
 #include "ih264_typedefs.h"
+#include "ih264_macros.h"
 #include "iv.h"
 #include "ivd.h"
 #include "ih264_defs.h"
@@ -52,12 +53,96 @@
 #include "ih264_error.h"
 #include "ih264_trans_quant_itrans_iquant.h"
 #include "ih264_inter_pred_filters.h"
+#include "ih264_cpu_features.h"
 
 #include "ih264d_structs.h"
 #include "ih264d_function_selector.h"
 
+/*****************************************************************************/
+/* Highest architecture the build allows. Lower architectures are used on    */
+/* CPUs that do not support it. Android.bp cannot build only the AVX2 kernel */
+/* files with -mavx2, so Android x86 builds define DISABLE_AVX2 and stop at  */
+/* SSE4.2                                                                    */
+/*****************************************************************************/
+#if defined(DEFAULT_ARCH) && (DEFAULT_ARCH == D_ARCH_X86_AVX2) \
+        && !defined(DISABLE_AVX2)
+#define MAX_ARCH ARCH_X86_AVX2
+#elif defined(DEFAULT_ARCH) && (DEFAULT_ARCH == D_ARCH_X86_SSSE3)
+#define MAX_ARCH ARCH_X86_SSSE3
+#elif defined(DEFAULT_ARCH) && (DEFAULT_ARCH == D_ARCH_X86_GENERIC)
+#define MAX_ARCH ARCH_X86_GENERIC
+#else
+#define MAX_ARCH ARCH_X86_SSE42
+#endif
+
+/**
+*******************************************************************************
+*
+* @brief Returns the highest x86 architecture the CPU and the build support
+*
+* @returns  Architecture to use
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static IVD_ARCH_T ih264d_detect_arch(void)
+{
+    IVD_ARCH_T e_arch;
+
+    switch(ih264_get_x86_cpu_level())
+    {
+        case X86_CPU_AVX2:
+            e_arch = ARCH_X86_AVX2;
+            break;
+        case X86_CPU_SSE42:
+            e_arch = ARCH_X86_SSE42;
+            break;
+        case X86_CPU_SSSE3:
+            e_arch = ARCH_X86_SSSE3;
+            break;
+        case X86_CPU_GENERIC:
+        default:
+            e_arch = ARCH_X86_GENERIC;
+            break;
+    }
+
+    if(e_arch > MAX_ARCH)
+        e_arch = MAX_ARCH;
+    return e_arch;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Returns the architecture to use for a requested architecture
+*
+* @par Description: A requested x86 architecture is lowered to the highest one
+* the CPU supports. Any other architecture selects the highest one the CPU
+* supports
+*
+* @param[in] e_arch
+*  Requested architecture
+*
+* @returns  Architecture to use
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+IVD_ARCH_T ih264d_get_supported_arch(IVD_ARCH_T e_arch)
+{
+    IVD_ARCH_T e_supported_arch = ih264d_detect_arch();
+
+    if((e_arch >= ARCH_X86_GENERIC) && (e_arch < e_supported_arch))
+        return e_arch;
+    return e_supported_arch;
+}
+
 void ih264d_init_function_ptr(dec_struct_t *ps_codec)
 {
+    ps_codec->e_processor_arch =
+                    ih264d_get_supported_arch(ps_codec->e_processor_arch);
 
     ih264d_init_function_ptr_generic(ps_codec);
     switch(ps_codec->e_processor_arch)
@@ -68,6 +153,13 @@ void ih264d_init_function_ptr(dec_struct_t *ps_codec)
         case ARCH_X86_SSSE3:
             ih264d_init_function_ptr_ssse3(ps_codec);
             break;
+#ifndef DISABLE_AVX2
+        case ARCH_X86_AVX2:
+            ih264d_init_function_ptr_ssse3(ps_codec);
+            ih264d_init_function_ptr_sse42(ps_codec);
+            ih264d_init_function_ptr_avx2(ps_codec);
+            break;
+#endif
         case ARCH_X86_SSE42:
         default:
             ih264d_init_function_ptr_ssse3(ps_codec);
@@ -77,18 +169,5 @@ void ih264d_init_function_ptr(dec_struct_t *ps_codec)
 }
 void ih264d_init_arch(dec_struct_t *ps_codec)
 {
-#ifdef DEFAULT_ARCH
-#if DEFAULT_ARCH == D_ARCH_X86_SSE42
-    ps_codec->e_processor_arch = ARCH_X86_SSE42;
-#elif DEFAULT_ARCH == D_ARCH_X86_SSSE3
-    ps_codec->e_processor_arch = ARCH_X86_SSSE3;
-#elif DEFAULT_ARCH == D_ARCH_X86_AVX2
-    ps_codec->e_processor_arch = D_ARCH_X86_AVX2;
-#else
-    ps_codec->e_processor_arch = ARCH_X86_GENERIC;
-#endif
-#else
-    ps_codec->e_processor_arch = ARCH_X86_SSE42;
-#endif
-
+    ps_codec->e_processor_arch = ih264d_detect_arch();
 }
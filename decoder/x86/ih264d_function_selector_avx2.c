@@ -0,0 +1,110 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264d_function_selector_avx2.c
+*
+* @brief
+*  Contains functions to initialize function pointers of codec context
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ih264d_init_function_ptr_avx2
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System Include files */
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* User Include files */
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ih264_error.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+
+#include "ih264d_structs.h"
+#include "ih264d_function_selector.h"
+
+
+/**
+*******************************************************************************
+*
+* @brief Initialize the function pointers that have AVX2 versions
+*
+* @par Description: Called after the SSSE3 and SSE4.2 function pointers are
+* initialized, overrides the ones that have AVX2 versions
+*
+* @param[in] ps_codec
+*  Codec context pointer
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264d_init_function_ptr_avx2(dec_struct_t *ps_codec)
+{
+    ps_codec->apf_inter_pred_luma[1] = ih264_inter_pred_luma_horz_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[2] = ih264_inter_pred_luma_horz_avx2;
+    ps_codec->apf_inter_pred_luma[3] = ih264_inter_pred_luma_horz_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[4] = ih264_inter_pred_luma_vert_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[5] = ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[6] = ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[7] = ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[8] = ih264_inter_pred_luma_vert_avx2;
+    ps_codec->apf_inter_pred_luma[9] = ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2;
+    ps_codec->apf_inter_pred_luma[10] = ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2;
+    ps_codec->apf_inter_pred_luma[11] = ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2;
+    ps_codec->apf_inter_pred_luma[12] = ih264_inter_pred_luma_vert_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[13] = ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[14] = ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2;
+    ps_codec->apf_inter_pred_luma[15] = ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2;
+
+    ps_codec->pf_deblk_luma_vert_inner_bslt4 = ih264_deblk_luma_vert_inner_bslt4_avx2;
+    ps_codec->pf_deblk_luma_horz_inner_bslt4 = ih264_deblk_luma_horz_inner_bslt4_avx2;
+
+    ps_codec->pf_find_zero_run = ih264d_find_zero_run_avx2;
+
+    ps_codec->pf_fmt_conv_420sp_to_420p = ih264d_fmt_conv_420sp_to_420p_avx2;
+    ps_codec->pf_fmt_conv_420sp_to_420sp_swap_uv = ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2;
+    ps_codec->pf_fmt_conv_420sp_to_rgb565 = ih264d_fmt_conv_420sp_to_rgb565_avx2;
+    ps_codec->pf_fmt_conv_420sp_to_rgba8888 = ih264d_fmt_conv_420sp_to_rgba8888_avx2;
+    return;
+}
@@ -59,6 +59,7 @@
 #include "ih264_inter_pred_filters.h"
 
 #include "ih264d_structs.h"
+#include "ih264d_deblocking.h"
 
 
 /**
@@ -91,5 +92,10 @@ void ih264d_init_function_ptr_sse42(dec_struct_t *ps_codec)
     ps_codec->pf_iquant_itrans_recon_luma_4x4 = ih264_iquant_itrans_recon_4x4_sse42;
     ps_codec->pf_iquant_itrans_recon_chroma_4x4 = ih264_iquant_itrans_recon_chroma_4x4_sse42;
     ps_codec->pf_ihadamard_scaling_4x4 = ih264_ihadamard_scaling_4x4_sse42;
+
+    ps_codec->pf_find_zero_run = ih264d_find_zero_run_sse42;
+
+    ps_codec->pf_fill_bs1[0][1] = ih264d_fill_bs1_non16x16mb_pslice_sse42;
+    ps_codec->pf_fill_bs1[1][1] = ih264d_fill_bs1_non16x16mb_bslice_sse42;
     return;
 }
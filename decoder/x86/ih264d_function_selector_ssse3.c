@@ -176,6 +176,12 @@ void ih264d_init_function_ptr_ssse3(dec_struct_t *ps_codec)
 
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma_ssse3;
 
+    ps_codec->pf_fmt_conv_420sp_to_420p = ih264d_fmt_conv_420sp_to_420p_ssse3;
+    ps_codec->pf_fmt_conv_420sp_to_420sp_swap_uv = ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3;
+    ps_codec->pf_fmt_conv_420sp_to_rgb565 = ih264d_fmt_conv_420sp_to_rgb565_ssse3;
+    ps_codec->pf_fmt_conv_420sp_to_rgba8888 = ih264d_fmt_conv_420sp_to_rgba8888_ssse3;
+    ps_codec->pf_fmt_conv_downscale = ih264d_fmt_conv_downscale_ssse3;
+
 
     return;
 }
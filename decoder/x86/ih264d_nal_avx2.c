@@ -0,0 +1,112 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_nal_avx2.c
+ *
+ * @brief
+ *  Start code search routines
+ *
+ * @par List of Functions:
+ *  - ih264d_find_zero_run_avx2()
+ *
+ * @remarks
+ *  This file is built with AVX2 enabled and its functions are called only
+ *  when the CPU supports AVX2
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <immintrin.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_nal.h"
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Skips the bytes that can not begin a start code
+ *
+ * @par Description:
+ *  Compares 64 bytes per iteration and their next bytes against zero, so that
+ *  a pair of zero bytes is found without looking at each byte. The remaining
+ *  bytes are searched by the generic version.
+ *
+ * @param[in] pu1_buf
+ *  Pointer to the bitstream
+ *
+ * @param[in] u4_pos
+ *  Position to start the search from
+ *
+ * @param[in] u4_max_ofst
+ *  Number of bytes in the bitstream
+ *
+ * @returns
+ *  Position of the first zero byte at or after u4_pos that is followed by a
+ *  zero byte or by the end of the bitstream, u4_max_ofst if there is none
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+UWORD32 ih264d_find_zero_run_avx2(UWORD8 *pu1_buf,
+                                  UWORD32 u4_pos,
+                                  UWORD32 u4_max_ofst)
+{
+    __m256i zero_32x8b = _mm256_setzero_si256();
+
+    /* The next byte of each byte is loaded as well, hence the extra byte */
+    while(u4_pos + 65 <= u4_max_ofst)
+    {
+        __m256i cur0_32x8b, cur1_32x8b, nxt0_32x8b, nxt1_32x8b;
+        UWORD32 u4_mask0, u4_mask1;
+
+        cur0_32x8b = _mm256_loadu_si256((__m256i *)(pu1_buf + u4_pos));
+        cur1_32x8b = _mm256_loadu_si256((__m256i *)(pu1_buf + u4_pos + 32));
+        nxt0_32x8b = _mm256_loadu_si256((__m256i *)(pu1_buf + u4_pos + 1));
+        nxt1_32x8b = _mm256_loadu_si256((__m256i *)(pu1_buf + u4_pos + 33));
+
+        /* A pair of zero bytes is where both the byte and its next are zero */
+        cur0_32x8b = _mm256_or_si256(cur0_32x8b, nxt0_32x8b);
+        cur1_32x8b = _mm256_or_si256(cur1_32x8b, nxt1_32x8b);
+        cur0_32x8b = _mm256_cmpeq_epi8(cur0_32x8b, zero_32x8b);
+        cur1_32x8b = _mm256_cmpeq_epi8(cur1_32x8b, zero_32x8b);
+
+        u4_mask0 = (UWORD32)_mm256_movemask_epi8(cur0_32x8b);
+        if(u4_mask0)
+            return u4_pos + CTZ(u4_mask0);
+
+        u4_mask1 = (UWORD32)_mm256_movemask_epi8(cur1_32x8b);
+        if(u4_mask1)
+            return u4_pos + 32 + CTZ(u4_mask1);
+
+        u4_pos += 64;
+    }
+
+    return ih264d_find_zero_run_sse42(pu1_buf, u4_pos, u4_max_ofst);
+}
@@ -67,6 +67,9 @@
  */
 void isvcd_init_function_ptr(svc_dec_lyr_struct_t *ps_svc_lyr_dec)
 {
+    ps_svc_lyr_dec->s_dec.e_processor_arch =
+        ih264d_get_supported_arch(ps_svc_lyr_dec->s_dec.e_processor_arch);
+
     isvcd_init_function_ptr_generic(ps_svc_lyr_dec);
     switch(ps_svc_lyr_dec->s_dec.e_processor_arch)
     {
@@ -76,6 +79,13 @@ void isvcd_init_function_ptr(svc_dec_lyr_struct_t *ps_svc_lyr_dec)
         case ARCH_X86_SSSE3:
             ih264d_init_function_ptr_ssse3(&ps_svc_lyr_dec->s_dec);
             break;
+#ifndef DISABLE_AVX2
+        case ARCH_X86_AVX2:
+            ih264d_init_function_ptr_ssse3(&ps_svc_lyr_dec->s_dec);
+            isvcd_init_function_ptr_sse42(ps_svc_lyr_dec);
+            ih264d_init_function_ptr_avx2(&ps_svc_lyr_dec->s_dec);
+            break;
+#endif
         case ARCH_X86_SSE42:
         default:
             ih264d_init_function_ptr_ssse3(&ps_svc_lyr_dec->s_dec);
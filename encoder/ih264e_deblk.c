@@ -806,54 +806,28 @@ void ih264e_deblock_mb(process_ctxt_t *ps_proc, deblk_ctxt_t * ps_deblk)
         ih264e_filter_left_edge(ps_codec, ps_proc, pu1_pic_qp, pu1_cur_pic_luma, pu1_cur_pic_chroma, pu4_pic_vert_bs);
     }
 
-    /* vertical edge 1 */
-    if (pu4_pic_vert_bs[1] == 0x04040404)
-    {
-        /* strong filter */
-        ps_codec->pf_deblk_luma_vert_bs4(pu1_cur_pic_luma + 4, i4_rec_strd, u4_alpha_luma, u4_beta_luma);
-    }
-    else
-    {
-        /* normal filter */
-        ps_codec->pf_deblk_luma_vert_bslt4(pu1_cur_pic_luma + 4, i4_rec_strd,
-                                           u4_alpha_luma, u4_beta_luma,
-                                           pu4_pic_vert_bs[1],
-                                           gu1_ih264_clip_table[u4_idx_A_luma]);
-    }
-
-    /* vertical edge 2 */
+    /* vertical edges 1, 2 and 3 */
+    /* inner edges are never strong, see ih264e_compute_bs() */
+    ps_codec->pf_deblk_luma_vert_inner_bslt4(pu1_cur_pic_luma, i4_rec_strd,
+                                             u4_alpha_luma, u4_beta_luma,
+                                             &pu4_pic_vert_bs[1],
+                                             gu1_ih264_clip_table[u4_idx_A_luma],
+                                             ps_codec->pf_deblk_luma_vert_bslt4);
+
+    /* vertical edge 2 chroma */
     if (pu4_pic_vert_bs[2] == 0x04040404)
     {
         /* strong filter */
-        ps_codec->pf_deblk_luma_vert_bs4(pu1_cur_pic_luma + 8, i4_rec_strd, u4_alpha_luma, u4_beta_luma);
         ps_codec->pf_deblk_chroma_vert_bs4(pu1_cur_pic_chroma + 8, i4_rec_strd, u4_alpha_chroma, u4_beta_chroma, u4_alpha_chroma, u4_beta_chroma);
     }
     else
     {
         /* normal filter */
-        ps_codec->pf_deblk_luma_vert_bslt4(pu1_cur_pic_luma + 8, i4_rec_strd, u4_alpha_luma,
-                                           u4_beta_luma, pu4_pic_vert_bs[2],
-                                           gu1_ih264_clip_table[u4_idx_A_luma]);
-
         ps_codec->pf_deblk_chroma_vert_bslt4(pu1_cur_pic_chroma + 8, i4_rec_strd, u4_alpha_chroma,
                                              u4_beta_chroma, u4_alpha_chroma, u4_beta_chroma, pu4_pic_vert_bs[2],
                                              gu1_ih264_clip_table[u4_idx_A_chroma], gu1_ih264_clip_table[u4_idx_A_chroma]);
     }
 
-    /* vertical edge 3 */
-    if (pu4_pic_vert_bs[3] == 0x04040404)
-    {
-        /* strong filter */
-        ps_codec->pf_deblk_luma_vert_bs4(pu1_cur_pic_luma + 12, i4_rec_strd, u4_alpha_luma, u4_beta_luma);
-    }
-    else
-    {
-        /* normal filter */
-        ps_codec->pf_deblk_luma_vert_bslt4(pu1_cur_pic_luma + 12, i4_rec_strd, u4_alpha_luma,
-                                           u4_beta_luma, pu4_pic_vert_bs[3],
-                                           gu1_ih264_clip_table[u4_idx_A_luma]);
-    }
-
     /* Deblock Horizontal edges */
     /* Horizontal edge 0 */
     if (u1_mb_b)
@@ -861,52 +835,26 @@ void ih264e_deblock_mb(process_ctxt_t *ps_proc, deblk_ctxt_t * ps_deblk)
         ih264e_filter_top_edge(ps_codec, ps_proc, pu1_pic_qp, pu1_cur_pic_luma, pu1_cur_pic_chroma, pu4_pic_horz_bs);
     }
 
-    /* horizontal edge 1 */
-    if (pu4_pic_horz_bs[1] == 0x04040404)
-    {
-        /* strong filter */
-        ps_codec->pf_deblk_luma_horz_bs4(pu1_cur_pic_luma + 4 * i4_rec_strd, i4_rec_strd, u4_alpha_luma, u4_beta_luma);
-    }
-    else
-    {
-        /* normal filter */
-        ps_codec->pf_deblk_luma_horz_bslt4(pu1_cur_pic_luma + 4 * i4_rec_strd, i4_rec_strd, u4_alpha_luma,
-                                           u4_beta_luma, pu4_pic_horz_bs[1],
-                                           gu1_ih264_clip_table[u4_idx_A_luma]);
-    }
+    /* horizontal edges 1, 2 and 3 */
+    ps_codec->pf_deblk_luma_horz_inner_bslt4(pu1_cur_pic_luma, i4_rec_strd,
+                                             u4_alpha_luma, u4_beta_luma,
+                                             &pu4_pic_horz_bs[1],
+                                             gu1_ih264_clip_table[u4_idx_A_luma],
+                                             ps_codec->pf_deblk_luma_horz_bslt4);
 
-    /* horizontal edge 2 */
+    /* horizontal edge 2 chroma */
     if (pu4_pic_horz_bs[2] == 0x04040404)
     {
         /* strong filter */
-        ps_codec->pf_deblk_luma_horz_bs4(pu1_cur_pic_luma + 8 * i4_rec_strd, i4_rec_strd, u4_alpha_luma, u4_beta_luma);
         ps_codec->pf_deblk_chroma_horz_bs4(pu1_cur_pic_chroma + 4 * i4_rec_strd, i4_rec_strd, u4_alpha_chroma, u4_beta_chroma, u4_alpha_chroma, u4_beta_chroma);
     }
     else
     {
         /* normal filter */
-        ps_codec->pf_deblk_luma_horz_bslt4(pu1_cur_pic_luma + 8 * i4_rec_strd, i4_rec_strd, u4_alpha_luma,
-                                           u4_beta_luma, pu4_pic_horz_bs[2],
-                                           gu1_ih264_clip_table[u4_idx_A_luma]);
-
         ps_codec->pf_deblk_chroma_horz_bslt4(pu1_cur_pic_chroma + 4 * i4_rec_strd, i4_rec_strd, u4_alpha_chroma,
                                              u4_beta_chroma, u4_alpha_chroma, u4_beta_chroma, pu4_pic_horz_bs[2],
                                              gu1_ih264_clip_table[u4_idx_A_chroma], gu1_ih264_clip_table[u4_idx_A_chroma]);
     }
 
-    /* horizontal edge 3 */
-    if (pu4_pic_horz_bs[3] == 0x04040404)
-    {
-        /* strong filter */
-        ps_codec->pf_deblk_luma_horz_bs4(pu1_cur_pic_luma + 12 * i4_rec_strd, i4_rec_strd, u4_alpha_luma, u4_beta_luma);
-    }
-    else
-    {
-        /* normal filter */
-        ps_codec->pf_deblk_luma_horz_bslt4(pu1_cur_pic_luma + 12 * i4_rec_strd, i4_rec_strd, u4_alpha_luma,
-                                           u4_beta_luma, pu4_pic_horz_bs[3],
-                                           gu1_ih264_clip_table[u4_idx_A_luma]);
-    }
-
     return ;
 }
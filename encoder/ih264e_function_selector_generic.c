@@ -183,6 +183,8 @@ void ih264e_init_function_ptr_generic(codec_t *ps_codec)
     ps_codec->pf_deblk_luma_vert_bslt4 = ih264_deblk_luma_vert_bslt4;
     ps_codec->pf_deblk_luma_horz_bs4 = ih264_deblk_luma_horz_bs4;
     ps_codec->pf_deblk_luma_horz_bslt4 = ih264_deblk_luma_horz_bslt4;
+    ps_codec->pf_deblk_luma_vert_inner_bslt4 = ih264_deblk_luma_vert_inner_bslt4;
+    ps_codec->pf_deblk_luma_horz_inner_bslt4 = ih264_deblk_luma_horz_inner_bslt4;
 
     /* Init fn ptr chroma deblocking */
     ps_codec->pf_deblk_chroma_vert_bs4 = ih264_deblk_chroma_vert_bs4;
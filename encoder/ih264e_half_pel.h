@@ -80,4 +80,8 @@ ih264e_sixtap_filter_2dvh_vert_ft ih264e_sixtap_filter_2dvh_vert_av8;
 ih264e_sixtapfilter_horz_ft ih264e_sixtapfilter_horz_ssse3;
 ih264e_sixtap_filter_2dvh_vert_ft ih264e_sixtap_filter_2dvh_vert_ssse3;
 
+/* AVX2 Declarations */
+ih264e_sixtapfilter_horz_ft ih264e_sixtapfilter_horz_avx2;
+ih264e_sixtap_filter_2dvh_vert_ft ih264e_sixtap_filter_2dvh_vert_avx2;
+
 #endif /* _IH264E_HALF_PEL_H_ */
@@ -2809,6 +2809,18 @@ struct _codec_t
      */
     ih264_deblk_chroma_edge_bslt4_ft *pf_deblk_chroma_horz_bslt4;
 
+    /**
+     * deblock the inner vertical luma edges of a MB with blocking strength
+     * less than 4
+     */
+    ih264_deblk_luma_inner_bslt4_ft *pf_deblk_luma_vert_inner_bslt4;
+
+    /**
+     * deblock the inner horizontal luma edges of a MB with blocking strength
+     * less than 4
+     */
+    ih264_deblk_luma_inner_bslt4_ft *pf_deblk_luma_horz_inner_bslt4;
+
 
     /**
      * functions for padding
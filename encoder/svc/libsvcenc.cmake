@@ -105,8 +105,10 @@ else()
     APPEND
     LIBSVCENC_SRCS
     "${AVC_ROOT}/encoder/x86/ih264e_function_selector.c"
+    "${AVC_ROOT}/encoder/x86/ih264e_function_selector_avx2.c"
     "${AVC_ROOT}/encoder/x86/ih264e_function_selector_sse42.c"
     "${AVC_ROOT}/encoder/x86/ih264e_function_selector_ssse3.c"
+    "${AVC_ROOT}/encoder/x86/ih264e_half_pel_avx2.c"
     "${AVC_ROOT}/encoder/x86/ih264e_half_pel_ssse3.c"
     "${AVC_ROOT}/encoder/x86/ih264e_intra_modes_eval_ssse3.c"
     "${AVC_ROOT}/encoder/x86/ime_distortion_metrics_sse42.c"
@@ -116,6 +118,8 @@ else()
     "${AVC_ROOT}/encoder/x86/svc/isvce_function_selector_ssse3.c"
     "${AVC_ROOT}/encoder/x86/svc/isvce_rc_utils_sse42.c"
     "${AVC_ROOT}/encoder/x86/svc/isvce_residual_pred_sse42.c")
+  libavc_set_avx2_compile_options(
+    "${AVC_ROOT}/encoder/x86/ih264e_half_pel_avx2.c")
 
   include_directories(${AVC_ROOT}/encoder/x86)
   include_directories(${AVC_ROOT}/encoder/x86/svc)
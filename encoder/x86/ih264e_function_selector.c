@@ -67,6 +67,7 @@
 #include "ih264_deblk_edge_filters.h"
 #include "ih264_cabac_tables.h"
 #include "ih264_platform_macros.h"
+#include "ih264_cpu_features.h"
 
 #include "ime_defs.h"
 #include "ime_distortion_metrics.h"
@@ -89,6 +90,57 @@
 /* Function Definitions                                                      */
 /*****************************************************************************/
 
+/**
+*******************************************************************************
+*
+* @brief Returns the rank of an x86 architecture, -1 for other architectures
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_get_arch_rank(IV_ARCH_T e_arch)
+{
+    switch(e_arch)
+    {
+        case ARCH_X86_GENERIC:
+            return 0;
+        case ARCH_X86_SSSE3:
+            return 1;
+        case ARCH_X86_SSE42:
+            return 2;
+        case ARCH_X86_AVX2:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Returns the highest x86 architecture the CPU and the build support
+*
+* @returns  Architecture to use
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static IV_ARCH_T ih264e_detect_arch(void)
+{
+    switch(ih264_get_x86_cpu_level())
+    {
+        case X86_CPU_AVX2:
+            return ARCH_X86_AVX2;
+        case X86_CPU_SSE42:
+            return ARCH_X86_SSE42;
+        case X86_CPU_SSSE3:
+            return ARCH_X86_SSSE3;
+        case X86_CPU_GENERIC:
+        default:
+            return ARCH_X86_GENERIC;
+    }
+}
+
 /**
 *******************************************************************************
 *
@@ -109,9 +161,18 @@
 void ih264e_init_function_ptr(void *pv_codec)
 {
     codec_t *ps_codec = (codec_t *)pv_codec;
+    IV_ARCH_T e_arch = ih264e_detect_arch();
+
+    /* A requested x86 architecture is lowered to what the CPU supports */
+    if((ih264e_get_arch_rank(ps_codec->s_cfg.e_arch) >= 0)
+                    && (ih264e_get_arch_rank(ps_codec->s_cfg.e_arch)
+                                    < ih264e_get_arch_rank(e_arch)))
+    {
+        e_arch = ps_codec->s_cfg.e_arch;
+    }
 
     ih264e_init_function_ptr_generic(ps_codec);
-    switch(ps_codec->s_cfg.e_arch)
+    switch(e_arch)
     {
         case ARCH_X86_GENERIC:
             ih264e_init_function_ptr_generic(ps_codec);
@@ -119,6 +180,13 @@ void ih264e_init_function_ptr(void *pv_codec)
         case ARCH_X86_SSSE3:
             ih264e_init_function_ptr_ssse3(ps_codec);
             break;
+#ifndef DISABLE_AVX2
+        case ARCH_X86_AVX2:
+            ih264e_init_function_ptr_ssse3(ps_codec);
+            ih264e_init_function_ptr_sse42(ps_codec);
+            ih264e_init_function_ptr_avx2(ps_codec);
+            break;
+#endif
         case ARCH_X86_SSE42:
         default:
             ih264e_init_function_ptr_ssse3(ps_codec);
@@ -146,6 +214,6 @@ void ih264e_init_function_ptr(void *pv_codec)
 */
 IV_ARCH_T ih264e_default_arch(void)
 {
-    return ARCH_X86_SSE42;
+    return ih264e_detect_arch();
 }
 
@@ -0,0 +1,120 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264e_function_selector_avx2.c
+*
+* @brief
+*  Contains functions to initialize function pointers of codec context
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - ih264e_init_function_ptr_avx2
+*
+* @remarks
+*  none
+*
+*******************************************************************************
+*/
+
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System Include Files */
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* User Include Files */
+#include "ih264_typedefs.h"
+#include "iv2.h"
+#include "ive2.h"
+
+#include "ih264_error.h"
+#include "ih264_defs.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_cavlc_tables.h"
+#include "ih264_cabac_tables.h"
+
+#include "ime_defs.h"
+#include "ime_distortion_metrics.h"
+#include "ime_structs.h"
+
+#include "irc_cntrl_param.h"
+#include "irc_frame_info_collector.h"
+
+#include "ih264e_error.h"
+#include "ih264e_defs.h"
+#include "ih264e_rate_control.h"
+#include "ih264e_bitstream.h"
+#include "ih264e_cabac_structs.h"
+#include "ih264e_structs.h"
+#include "ih264e_half_pel.h"
+#include "ih264e_intra_modes_eval.h"
+#include "ih264e_core_coding.h"
+#include "ih264e_cavlc.h"
+#include "ih264e_cabac.h"
+#include "ih264e_fmt_conv.h"
+#include "ih264e_platform_macros.h"
+
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief Initialize the function pointers that have AVX2 versions
+*
+* @par Description: Called after the SSSE3 and SSE4.2 function pointers are
+* initialized, overrides the ones that have AVX2 versions
+*
+* @param[in] ps_codec
+*  Codec context pointer
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_init_function_ptr_avx2(codec_t *ps_codec)
+{
+    /* Init fn ptr luma deblocking */
+    ps_codec->pf_deblk_luma_vert_inner_bslt4 = ih264_deblk_luma_vert_inner_bslt4_avx2;
+    ps_codec->pf_deblk_luma_horz_inner_bslt4 = ih264_deblk_luma_horz_inner_bslt4_avx2;
+
+    /* Init fn ptr half pel filters of motion estimation */
+    ps_codec->pf_ih264e_sixtapfilter_horz = ih264e_sixtapfilter_horz_avx2;
+    ps_codec->pf_ih264e_sixtap_filter_2dvh_vert = ih264e_sixtap_filter_2dvh_vert_avx2;
+}
@@ -0,0 +1,441 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264e_half_pel_avx2.c
+ *
+ * @brief
+ *  Contains the x86 AVX2 intrinsic function definitions for 6-tap horizontal
+ *  filter and cascaded 2D filter used in motion estimation in H264 encoder.
+ *
+ * @author
+ *  ittiam
+ *
+ * @par List of Functions:
+ *  ih264e_sixtapfilter_horz_avx2
+ *  ih264e_sixtap_filter_2dvh_vert_avx2
+ *
+ * @remarks
+ *  The outputs and the intermediate buffer are the same as those of the
+ *  ssse3 functions
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <immintrin.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_platform_macros.h"
+#include "ih264_macros.h"
+#include "ih264e_half_pel.h"
+
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+/*
+*******************************************************************************
+*
+* @brief
+*  Loads the 22 pixels of a row the cascaded filter reads, x[-2] to x[13] in
+*  the lower lane and x[4] to x[19] in the upper lane
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to x[-2]
+*
+* @returns
+*  Pixels of the row
+*
+* @remarks
+*  none
+*
+*******************************************************************************
+*/
+static __inline __m256i ih264e_load_row_22_avx2(UWORD8 *pu1_src)
+{
+    __m256i src_32x8b;
+
+    src_32x8b = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src));
+    return _mm256_inserti128_si256(src_32x8b,
+                                   _mm_loadu_si128((__m128i *)(pu1_src + 6)), 1);
+}
+
+/*
+*******************************************************************************
+*
+* @brief
+*  Interprediction luma filter for horizontal input(Filter run for width = 17
+*  and height =16)
+*
+* @par Description:
+*  Applies a 6 tap horizontal filter .The output is  clipped to 8 bits sec.
+*  8.4.2.2.1 titled "Luma sample interpolation process". Two rows are
+*  filtered per iteration, the columns 0 to 7 of each row in the lower lane
+*  and the columns 8 to 15 in the upper lane
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @returns
+*  none
+*
+* @remarks
+*  none
+*
+*******************************************************************************
+*/
+void ih264e_sixtapfilter_horz_avx2(UWORD8 *pu1_src,
+                                   UWORD8 *pu1_dst,
+                                   WORD32 src_strd,
+                                   WORD32 dst_strd)
+{
+    WORD32 ht;
+    WORD32 tmp0, tmp1;
+
+    __m256i src_r0_32x8b, src_r1_32x8b;
+    __m256i res_r0_16x16b, res_r1_16x16b, res_t_16x16b;
+
+    __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+    __m256i shuf0_1_32x8b, shuf2_3_32x8b, shuf4_5_32x8b;
+    __m256i const_val16_16x16b;
+
+    ht = 16;
+    pu1_src -= 2; // the filter input starts from x[-2] (till x[3])
+
+    coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 c1 c0 c1 ...
+    coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 c3 c2 c3 ...
+    coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB); //c4 c5 c4 c5 ...
+                                                    //c0 = c5 = 1, c1 = c4 = -5, c2 = c3 = 20
+    const_val16_16x16b = _mm256_set1_epi16(16);
+
+    /* Pairs of pixels (a[n], a[n + 1]) for the taps c0 c1, c2 c3 and c4 c5 */
+    shuf0_1_32x8b = _mm256_setr_epi8(0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+                                     0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8);
+    shuf2_3_32x8b = _mm256_add_epi8(shuf0_1_32x8b, _mm256_set1_epi8(2));
+    shuf4_5_32x8b = _mm256_add_epi8(shuf0_1_32x8b, _mm256_set1_epi8(4));
+
+    do
+    {
+        //Lower lane : a0 a1 a2 ... a15, upper lane : a8 a9 a10 ... a23
+        src_r0_32x8b = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src));
+        src_r0_32x8b = _mm256_inserti128_si256(src_r0_32x8b,
+                            _mm_loadu_si128((__m128i *)(pu1_src + 8)), 1);
+        src_r1_32x8b = _mm256_castsi128_si256(
+                            _mm_loadu_si128((__m128i *)(pu1_src + src_strd)));
+        src_r1_32x8b = _mm256_inserti128_si256(src_r1_32x8b,
+                            _mm_loadu_si128((__m128i *)(pu1_src + src_strd + 8)), 1);
+
+        res_r0_16x16b = _mm256_maddubs_epi16(
+                            _mm256_shuffle_epi8(src_r0_32x8b, shuf0_1_32x8b), coeff0_1_32x8b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_shuffle_epi8(src_r0_32x8b, shuf2_3_32x8b), coeff2_3_32x8b);
+        res_r0_16x16b = _mm256_add_epi16(res_r0_16x16b, res_t_16x16b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_shuffle_epi8(src_r0_32x8b, shuf4_5_32x8b), coeff4_5_32x8b);
+        res_t_16x16b = _mm256_add_epi16(res_t_16x16b, const_val16_16x16b);
+        res_r0_16x16b = _mm256_add_epi16(res_r0_16x16b, res_t_16x16b);
+
+        res_r1_16x16b = _mm256_maddubs_epi16(
+                            _mm256_shuffle_epi8(src_r1_32x8b, shuf0_1_32x8b), coeff0_1_32x8b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_shuffle_epi8(src_r1_32x8b, shuf2_3_32x8b), coeff2_3_32x8b);
+        res_r1_16x16b = _mm256_add_epi16(res_r1_16x16b, res_t_16x16b);
+        res_t_16x16b = _mm256_maddubs_epi16(
+                            _mm256_shuffle_epi8(src_r1_32x8b, shuf4_5_32x8b), coeff4_5_32x8b);
+        res_t_16x16b = _mm256_add_epi16(res_t_16x16b, const_val16_16x16b);
+        res_r1_16x16b = _mm256_add_epi16(res_r1_16x16b, res_t_16x16b);
+
+        tmp0 = ((pu1_src[18] + pu1_src[19]) << 2) - pu1_src[17] - pu1_src[20];
+        tmp0 = pu1_src[16] + pu1_src[21] + (tmp0 << 2) + tmp0;
+        tmp1 = ((pu1_src[src_strd + 18] + pu1_src[src_strd + 19]) << 2)
+                        - pu1_src[src_strd + 17] - pu1_src[src_strd + 20];
+        tmp1 = pu1_src[src_strd + 16] + pu1_src[src_strd + 21] + (tmp1 << 2) + tmp1;
+
+        res_r0_16x16b = _mm256_srai_epi16(res_r0_16x16b, 5);                    //shifting right by 5 bits.
+        res_r1_16x16b = _mm256_srai_epi16(res_r1_16x16b, 5);
+        tmp0 = (tmp0 + 16) >> 5;
+        tmp1 = (tmp1 + 16) >> 5;
+
+        //Row 0 columns 0 to 15 in the lower lane, row 1 in the upper lane
+        src_r0_32x8b = _mm256_packus_epi16(res_r0_16x16b, res_r1_16x16b);
+        src_r0_32x8b = _mm256_permute4x64_epi64(src_r0_32x8b, 0xD8);
+        pu1_dst[16] = CLIP_U8(tmp0);
+        pu1_dst[dst_strd + 16] = CLIP_U8(tmp1);
+
+        _mm_storeu_si128((__m128i *)pu1_dst, _mm256_castsi256_si128(src_r0_32x8b));
+        _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd),
+                         _mm256_extracti128_si256(src_r0_32x8b, 1));
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*
+*******************************************************************************
+*
+* @brief
+*   This function implements a two stage cascaded six tap filter. It
+*    applies the six tap filter in the vertical direction on the
+*    predictor values, followed by applying the same filter in the
+*    horizontal direction on the output of the first stage. The six tap
+*    filtering operation is described in sec 8.4.2.2.1 titled "Luma sample
+*    interpolation process" (Filter run for width = 17 and height =17)
+*
+* @par Description:
+*    The function interpolates the predictors first in the vertical direction
+*    and then in the horizontal direction to output the (1/2,1/2). The output
+*    of the first stage of the filter is stored in the buffer pointed to by
+*    pi4_pred1 in 16 bit precision. The vertical stage filters the 22 input
+*    columns of a row at once, the columns -2 to 13 in the lower lane and the
+*    columns 4 to 19 in the upper lane. The horizontal stage filters the 16
+*    output columns of a row at once
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_dst1
+*  UWORD8 pointer to the destination(Vertical filtered output)
+*
+* @param[out] pu1_dst2
+*  UWORD8 pointer to the destination(out put after applying horizontal filter
+*  to the intermediate vertical output)
+*
+* @param[in] src_strd
+*  integer source stride
+
+* @param[in] dst_strd
+*  integer destination stride of pu1_dst
+*
+* @param[in]pi4_pred1
+*  Pointer to 16bit intermediate buffer
+*
+* @param[in] pred1_strd
+*  integer destination stride of pi4_pred1
+*
+* @returns
+*  none
+*
+* @remarks
+*  none
+*
+*******************************************************************************
+*/
+void ih264e_sixtap_filter_2dvh_vert_avx2(UWORD8 *pu1_src,
+                                         UWORD8 *pu1_dst1,
+                                         UWORD8 *pu1_dst2,
+                                         WORD32 src_strd,
+                                         WORD32 dst_strd,
+                                         WORD32 *pi4_pred1,
+                                         WORD32 pred1_strd)
+{
+    WORD32 ht;
+    WORD16 *pi2_pred1;
+
+    ht = 17;
+    pi2_pred1 = (WORD16 *)pi4_pred1;
+    pred1_strd = pred1_strd << 1;
+
+    // Vertical 6-tap filter
+    {
+        __m256i src_r0_32x8b, src_r1_32x8b, src_r2_32x8b;
+        __m256i src_r3_32x8b, src_r4_32x8b, src_r5_32x8b;
+
+        __m256i src_r0r1_32x8b, src_r2r3_32x8b, src_r4r5_32x8b;
+
+        __m256i res_lo_16x16b, res_hi_16x16b, res_t_16x16b;
+        __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+
+        coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 c1 c0 c1 ...
+        coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 c3 c2 c3 ...
+        coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB); //c4 c5 c4 c5 ...
+                                                        //c0 = c5 = 1, c1 = c4 = -5, c2 = c3 = 20
+
+        pu1_src -= 2;
+        pu1_src -= src_strd << 1; // the filter input starts from x[-2] (till x[3])
+
+        // Loading first five rows to start first row processing.
+        // 22 values loaded in each row.
+
+        src_r0_32x8b = ih264e_load_row_22_avx2(pu1_src);
+        pu1_src += src_strd;
+
+        src_r1_32x8b = ih264e_load_row_22_avx2(pu1_src);
+        pu1_src += src_strd;
+
+        src_r2_32x8b = ih264e_load_row_22_avx2(pu1_src);
+        pu1_src += src_strd;
+
+        src_r3_32x8b = ih264e_load_row_22_avx2(pu1_src);
+        pu1_src += src_strd;
+
+        src_r4_32x8b = ih264e_load_row_22_avx2(pu1_src);
+        pu1_src += src_strd;
+
+        do
+        {
+            src_r5_32x8b = ih264e_load_row_22_avx2(pu1_src);
+
+            // Columns -2 to 5 in the lower lane, 4 to 11 in the upper lane
+            src_r0r1_32x8b = _mm256_unpacklo_epi8(src_r0_32x8b, src_r1_32x8b);
+            src_r2r3_32x8b = _mm256_unpacklo_epi8(src_r2_32x8b, src_r3_32x8b);
+            src_r4r5_32x8b = _mm256_unpacklo_epi8(src_r4_32x8b, src_r5_32x8b);
+
+            res_lo_16x16b = _mm256_maddubs_epi16(src_r0r1_32x8b, coeff0_1_32x8b);
+            res_t_16x16b = _mm256_maddubs_epi16(src_r2r3_32x8b, coeff2_3_32x8b);
+            res_lo_16x16b = _mm256_add_epi16(res_lo_16x16b, res_t_16x16b);
+            res_t_16x16b = _mm256_maddubs_epi16(src_r4r5_32x8b, coeff4_5_32x8b);
+            res_lo_16x16b = _mm256_add_epi16(res_t_16x16b, res_lo_16x16b);
+
+            // Columns 6 to 13 in the lower lane, 12 to 19 in the upper lane
+            src_r0r1_32x8b = _mm256_unpackhi_epi8(src_r0_32x8b, src_r1_32x8b);
+            src_r2r3_32x8b = _mm256_unpackhi_epi8(src_r2_32x8b, src_r3_32x8b);
+            src_r4r5_32x8b = _mm256_unpackhi_epi8(src_r4_32x8b, src_r5_32x8b);
+
+            res_hi_16x16b = _mm256_maddubs_epi16(src_r0r1_32x8b, coeff0_1_32x8b);
+            res_t_16x16b = _mm256_maddubs_epi16(src_r2r3_32x8b, coeff2_3_32x8b);
+            res_hi_16x16b = _mm256_add_epi16(res_hi_16x16b, res_t_16x16b);
+            res_t_16x16b = _mm256_maddubs_epi16(src_r4r5_32x8b, coeff4_5_32x8b);
+            res_hi_16x16b = _mm256_add_epi16(res_t_16x16b, res_hi_16x16b);
+
+            _mm_storeu_si128((__m128i *)pi2_pred1, _mm256_castsi256_si128(res_lo_16x16b));
+            _mm_storeu_si128((__m128i *)(pi2_pred1 + 8), _mm256_castsi256_si128(res_hi_16x16b));
+            _mm_storeu_si128((__m128i *)(pi2_pred1 + 14),
+                             _mm256_extracti128_si256(res_hi_16x16b, 1));
+
+            src_r0_32x8b = src_r1_32x8b;
+            src_r1_32x8b = src_r2_32x8b;
+            src_r2_32x8b = src_r3_32x8b;
+            src_r3_32x8b = src_r4_32x8b;
+            src_r4_32x8b = src_r5_32x8b;
+
+            ht--;
+            pu1_src += src_strd;
+            pi2_pred1 += pred1_strd;
+        }
+        while(ht > 0);
+    }
+
+    ht = 17;
+    pi2_pred1 = (WORD16 *)pi4_pred1;
+
+    // Horizontal 6-tap filter
+    {
+        WORD32 temp;
+
+        __m256i src_r0_16x16b, src_r1_16x16b, src_r2_16x16b, src_r3_16x16b;
+        __m256i src_r4_16x16b, src_r5_16x16b;
+        __m256i src_r0r1_16x16b, src_r2r3_16x16b, src_r4r5_16x16b;
+        __m256i res_vert_16x16b, res_32x8b;
+
+        __m256i res_t0_8x32b, res_t1_8x32b, res_t2_8x32b, res_t3_8x32b;
+        __m256i res_c_16x16b;
+
+        __m256i coeff0_1_16x16b, coeff2_3_16x16b, coeff4_5_16x16b;
+        __m256i const_val512_8x32b, const_val16_16x16b;
+
+        coeff0_1_16x16b = _mm256_set1_epi32(0xFFFB0001); //c0 c1 c0 c1 ...
+        coeff2_3_16x16b = _mm256_set1_epi32(0x00140014); //c2 c3 c2 c3 ...
+        coeff4_5_16x16b = _mm256_set1_epi32(0x0001FFFB); //c4 c5 c4 c5 ...
+                                                         //c0 = c5 = 1, c1 = c4 = -5, c2 = c3 = 20
+        const_val512_8x32b = _mm256_set1_epi32(512);
+        const_val16_16x16b = _mm256_set1_epi16(16);
+
+        do
+        {
+            src_r0_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1));
+            src_r1_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 1));
+            src_r2_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 2));
+            src_r3_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 3));
+            src_r4_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 4));
+            src_r5_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 5));
+
+            res_vert_16x16b = _mm256_add_epi16(src_r2_16x16b, const_val16_16x16b);
+            res_vert_16x16b = _mm256_srai_epi16(res_vert_16x16b, 5); //shifting right by 5 bits.
+
+            // Columns 0 to 3 in the lower lane, 8 to 11 in the upper lane
+            src_r0r1_16x16b = _mm256_unpacklo_epi16(src_r0_16x16b, src_r1_16x16b);
+            src_r2r3_16x16b = _mm256_unpacklo_epi16(src_r2_16x16b, src_r3_16x16b);
+            src_r4r5_16x16b = _mm256_unpacklo_epi16(src_r4_16x16b, src_r5_16x16b);
+
+            res_t1_8x32b = _mm256_madd_epi16(src_r0r1_16x16b, coeff0_1_16x16b);
+            res_t2_8x32b = _mm256_madd_epi16(src_r2r3_16x16b, coeff2_3_16x16b);
+            res_t3_8x32b = _mm256_madd_epi16(src_r4r5_16x16b, coeff4_5_16x16b);
+
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t2_8x32b);
+            res_t3_8x32b = _mm256_add_epi32(res_t3_8x32b, const_val512_8x32b);
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t3_8x32b);
+            res_t0_8x32b = _mm256_srai_epi32(res_t1_8x32b, 10);
+
+            // Columns 4 to 7 in the lower lane, 12 to 15 in the upper lane
+            src_r0r1_16x16b = _mm256_unpackhi_epi16(src_r0_16x16b, src_r1_16x16b);
+            src_r2r3_16x16b = _mm256_unpackhi_epi16(src_r2_16x16b, src_r3_16x16b);
+            src_r4r5_16x16b = _mm256_unpackhi_epi16(src_r4_16x16b, src_r5_16x16b);
+
+            res_t1_8x32b = _mm256_madd_epi16(src_r0r1_16x16b, coeff0_1_16x16b);
+            res_t2_8x32b = _mm256_madd_epi16(src_r2r3_16x16b, coeff2_3_16x16b);
+            res_t3_8x32b = _mm256_madd_epi16(src_r4r5_16x16b, coeff4_5_16x16b);
+
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t2_8x32b);
+            res_t3_8x32b = _mm256_add_epi32(res_t3_8x32b, const_val512_8x32b);
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t3_8x32b);
+            res_t1_8x32b = _mm256_srai_epi32(res_t1_8x32b, 10);
+
+            // Columns 0 to 15 in order
+            res_c_16x16b = _mm256_packs_epi32(res_t0_8x32b, res_t1_8x32b);
+
+            // (1/2,1/2) output in the lower half, vertical output in the upper half
+            res_32x8b = _mm256_packus_epi16(res_c_16x16b, res_vert_16x16b);
+            res_32x8b = _mm256_permute4x64_epi64(res_32x8b, 0xD8);
+
+            _mm_storeu_si128((__m128i *)pu1_dst1, _mm256_extracti128_si256(res_32x8b, 1));
+            pu1_dst1[16] = CLIP_U8((pi2_pred1[18] + 16) >> 5);
+
+            _mm_storeu_si128((__m128i *)pu1_dst2, _mm256_castsi256_si128(res_32x8b));
+            temp = ((pi2_pred1[18] + pi2_pred1[19]) << 2) - pi2_pred1[17] - pi2_pred1[20];
+            temp = pi2_pred1[16] + pi2_pred1[21] + (temp << 2) + temp;
+            pu1_dst2[16] = CLIP_U8((temp + 512) >> 10);
+
+            ht--;
+            pi2_pred1 += pred1_strd;
+            pu1_dst1 += dst_strd;
+            pu1_dst2 += dst_strd;
+        }
+        while(ht > 0);
+    }
+}
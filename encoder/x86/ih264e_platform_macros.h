@@ -45,6 +45,7 @@
 void ih264e_init_function_ptr_generic(codec_t *ps_codec);
 void ih264e_init_function_ptr_ssse3(codec_t *ps_codec);
 void ih264e_init_function_ptr_sse42(codec_t *ps_codec);
+void ih264e_init_function_ptr_avx2(codec_t *ps_codec);
 void ih264e_init_function_ptr(void *pv_codec);
 IV_ARCH_T ih264e_default_arch(void);
 
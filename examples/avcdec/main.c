@@ -233,6 +233,17 @@ typedef struct
     /* Active threads present*/
     UWORD32 i4_active_threads;
 
+    /* Threads in the shared worker pool, 0 if not used */
+    UWORD32 u4_thread_pool_size;
+    UWORD32 u4_out_scale_log2;
+    UWORD32 u4_keyframes_only;
+    UWORD32 u4_frame_budget_us;
+    UWORD32 u4_luma_only;
+    void *pv_thread_pool;
+
+    /* Size of the length prefixing each NAL unit, 0 for start codes */
+    UWORD32 u4_nal_length_size;
+
     void *pv_disp_ctx;
     void *display_thread_handle;
     WORD32 display_thread_created;
@@ -284,6 +295,12 @@ typedef enum
     PICLEN_FILE,
 
     KEEP_THREADS_ACTIVE,
+    THREAD_POOL,
+    NAL_LENGTH_SIZE,
+    OUT_SCALE,
+    KEYFRAMES_ONLY,
+    FRAME_BUDGET,
+    LUMA_ONLY,
 } ARGUMENT_T;
 
 typedef struct
@@ -324,11 +341,11 @@ static const argument_t argument_mapping[] =
     { "--", "--save_chksum",            SAVE_CHKSUM,
           "Save Check sum file\n" },
     {"--",  "--chroma_format",          CHROMA_FORMAT,
-         "Output Chroma format Supported values YUV_420P, YUV_422ILE, RGB_565, YUV_420SP_UV, YUV_420SP_VU\n" },
+         "Output Chroma format Supported values YUV_420P, YUV_422ILE, RGB_565, RGBA_8888, YUV_420SP_UV, YUV_420SP_VU\n" },
     { "-n", "--num_frames",             NUM_FRAMES,
          "Number of frames to be decoded\n" },
     { "--", "--num_cores",              NUM_CORES,
-          "Number of cores to be used\n" },
+          "Number of cores to be used. 4 adds a deblocking thread, more reconstruct MB rows in parallel\n" },
     { "--", "--share_display_buf",      SHARE_DISPLAY_BUF,
           "Enable shared display buffer mode\n" },
     {"--", "--disable_deblock_level", DISABLE_DEBLOCK_LEVEL,
@@ -350,11 +367,23 @@ static const argument_t argument_mapping[] =
          "Degrade pics : 0 : No degrade  1 : Only on non-reference frames  2 : Do not degrade every 4th or key frames  3 : All non-key frames  4 : All frames"},
 
     {"--",  "--arch", ARCH,
-         "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR,ARMV8_GENERIC, X86_GENERIC, X86_SSSE3, X86_SSE4 \n" },
+         "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR,ARMV8_GENERIC, X86_GENERIC, X86_SSSE3, X86_SSE42, X86_AVX2 \n" },
     {"--",  "--soc", SOC,
          "Set SOC. Supported values  GENERIC, HISI_37X \n" },
     {"--", "--keep_threads_active", KEEP_THREADS_ACTIVE,
         "Keep threads active"},
+    {"--", "--thread_pool", THREAD_POOL,
+        "Number of threads in a shared worker pool to run the decoder threads. 0 : Decoder creates its own threads. Turns keep_threads_active off"},
+    {"--", "--nal_length_size", NAL_LENGTH_SIZE,
+        "Size of the length prefixing each NAL unit in the input : 1, 2 or 4. 0 : Input has start codes"},
+    {"--", "--out_scale_log2", OUT_SCALE,
+        "Downscale the output by 2, 4 or 8 in each dimension : 1, 2 or 3. 0 : Full size output"},
+    {"--", "--keyframes_only", KEYFRAMES_ONLY,
+        "Decode and output the I pictures only, skipping the P and B pictures"},
+    {"--", "--frame_budget_us", FRAME_BUDGET,
+        "Time budget per frame in microseconds, the decoder degrades itself to keep within. 0 : No automatic degrade"},
+    {"--", "--luma_only", LUMA_ONLY,
+        "Decode the luma only. Chroma of the output is grey. Needs a YUV 420 chroma_format"},
 
 };
 
@@ -1366,6 +1395,30 @@ void parse_argument(vid_dec_ctx_t *ps_app_ctx, CHAR *argument, CHAR *value)
             sscanf(value, "%d", &ps_app_ctx->i4_active_threads);
             break;
 
+        case THREAD_POOL:
+            sscanf(value, "%d", &ps_app_ctx->u4_thread_pool_size);
+            break;
+
+        case NAL_LENGTH_SIZE:
+            sscanf(value, "%d", &ps_app_ctx->u4_nal_length_size);
+            break;
+
+        case OUT_SCALE:
+            sscanf(value, "%d", &ps_app_ctx->u4_out_scale_log2);
+            break;
+
+        case KEYFRAMES_ONLY:
+            sscanf(value, "%d", &ps_app_ctx->u4_keyframes_only);
+            break;
+
+        case FRAME_BUDGET:
+            sscanf(value, "%d", &ps_app_ctx->u4_frame_budget_us);
+            break;
+
+        case LUMA_ONLY:
+            sscanf(value, "%d", &ps_app_ctx->u4_luma_only);
+            break;
+
         case INVALID:
         default:
             printf("Ignoring argument :  %s\n", argument);
@@ -2165,6 +2218,13 @@ int main(WORD32 argc, CHAR *argv[])
     s_app_ctx.u4_chksum_save_flag = 0;
     s_app_ctx.u4_frame_info_enable = 0;
     s_app_ctx.i4_active_threads = 1;
+    s_app_ctx.u4_thread_pool_size = 0;
+    s_app_ctx.u4_out_scale_log2 = 0;
+    s_app_ctx.u4_keyframes_only = 0;
+    s_app_ctx.u4_frame_budget_us = 0;
+    s_app_ctx.u4_luma_only = 0;
+    s_app_ctx.pv_thread_pool = NULL;
+    s_app_ctx.u4_nal_length_size = 0;
 
     s_app_ctx.get_stride = &default_get_stride;
 
@@ -2435,7 +2495,12 @@ int main(WORD32 argc, CHAR *argv[])
             s_create_ip.s_ivd_create_ip_t.u4_size = sizeof(ih264d_create_ip_t);
             s_create_op.s_ivd_create_op_t.u4_size = sizeof(ih264d_create_op_t);
             s_create_ip.u4_enable_frame_info = s_app_ctx.u4_frame_info_enable;
+            /* Threads kept active are not supported with a shared pool */
+            if(s_app_ctx.u4_thread_pool_size)
+                s_app_ctx.i4_active_threads = 0;
             s_create_ip.u4_keep_threads_active = s_app_ctx.i4_active_threads;
+            s_create_ip.u4_nal_length_size = s_app_ctx.u4_nal_length_size;
+            s_create_ip.u4_luma_only = s_app_ctx.u4_luma_only;
 
 
 
@@ -2515,6 +2580,92 @@ int main(WORD32 argc, CHAR *argv[])
 
     }
 
+    /*************************************************************************/
+    /* set shared worker pool                                                */
+    /*************************************************************************/
+    if(s_app_ctx.u4_thread_pool_size)
+    {
+        ih264d_create_thread_pool_ip_t s_create_pool_ip;
+        ih264d_create_thread_pool_op_t s_create_pool_op;
+        ih264d_ctl_set_thread_pool_ip_t s_ctl_set_pool_ip;
+        ih264d_ctl_set_thread_pool_op_t s_ctl_set_pool_op;
+
+        s_create_pool_ip.u4_size = sizeof(ih264d_create_thread_pool_ip_t);
+        s_create_pool_ip.u4_num_threads = s_app_ctx.u4_thread_pool_size;
+        s_create_pool_ip.pf_aligned_alloc = ih264a_aligned_malloc;
+        s_create_pool_ip.pf_aligned_free = ih264a_aligned_free;
+        s_create_pool_ip.pv_mem_ctxt = NULL;
+        s_create_pool_op.u4_size = sizeof(ih264d_create_thread_pool_op_t);
+
+        ret = ih264d_create_thread_pool(&s_create_pool_ip, &s_create_pool_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in creating thread pool");
+            codec_exit(ac_error_str);
+        }
+        s_app_ctx.pv_thread_pool = s_create_pool_op.pv_thread_pool;
+
+        s_ctl_set_pool_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_pool_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_THREAD_POOL;
+        s_ctl_set_pool_ip.pv_thread_pool = s_app_ctx.pv_thread_pool;
+        s_ctl_set_pool_ip.u4_size = sizeof(ih264d_ctl_set_thread_pool_ip_t);
+        s_ctl_set_pool_op.u4_size = sizeof(ih264d_ctl_set_thread_pool_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_pool_ip,
+                                   (void *)&s_ctl_set_pool_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in setting thread pool");
+            codec_exit(ac_error_str);
+        }
+    }
+
+    /*************************************************************************/
+    /* set output scale                                                      */
+    /*************************************************************************/
+    if(s_app_ctx.u4_out_scale_log2)
+    {
+        ih264d_ctl_set_output_scale_ip_t s_ctl_set_scale_ip;
+        ih264d_ctl_set_output_scale_op_t s_ctl_set_scale_op;
+
+        s_ctl_set_scale_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_scale_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_OUTPUT_SCALE;
+        s_ctl_set_scale_ip.u4_scale_log2 = s_app_ctx.u4_out_scale_log2;
+        s_ctl_set_scale_ip.u4_size = sizeof(ih264d_ctl_set_output_scale_ip_t);
+        s_ctl_set_scale_op.u4_size = sizeof(ih264d_ctl_set_output_scale_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_scale_ip,
+                                   (void *)&s_ctl_set_scale_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in setting output scale");
+            codec_exit(ac_error_str);
+        }
+    }
+
+    /*************************************************************************/
+    /* set degrade deadline                                                  */
+    /*************************************************************************/
+    if(s_app_ctx.u4_frame_budget_us)
+    {
+        ih264d_ctl_set_degrade_deadline_ip_t s_ctl_set_deadline_ip;
+        ih264d_ctl_set_degrade_deadline_op_t s_ctl_set_deadline_op;
+
+        s_ctl_set_deadline_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_deadline_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_DEGRADE_DEADLINE;
+        s_ctl_set_deadline_ip.u4_frame_budget_us = s_app_ctx.u4_frame_budget_us;
+        s_ctl_set_deadline_ip.u4_size = sizeof(ih264d_ctl_set_degrade_deadline_ip_t);
+        s_ctl_set_deadline_op.u4_size = sizeof(ih264d_ctl_set_degrade_deadline_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_deadline_ip,
+                                   (void *)&s_ctl_set_deadline_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in setting degrade deadline");
+            codec_exit(ac_error_str);
+        }
+    }
+
     /*************************************************************************/
     /* set processsor                                                        */
     /*************************************************************************/
@@ -2777,6 +2928,11 @@ int main(WORD32 argc, CHAR *argv[])
                     ps_out_buf->pu1_bufs[2] = ps_out_buf->pu1_bufs[1]
                                     + (s_ctl_op.u4_min_out_buf_size[1]);
 
+                /* The decoder does not write the chroma in luma only mode */
+                if(s_app_ctx.u4_luma_only)
+                    memset(ps_out_buf->pu1_bufs[0] + s_ctl_op.u4_min_out_buf_size[0],
+                           128, outlen - s_ctl_op.u4_min_out_buf_size[0]);
+
                 ps_out_buf->u4_num_bufs = s_ctl_op.u4_min_num_out_bufs;
             }
 
@@ -2826,6 +2982,11 @@ int main(WORD32 argc, CHAR *argv[])
                                     s_app_ctx.s_disp_buffers[i].pu1_bufs[1]
                                                     + (s_ctl_op.u4_min_out_buf_size[1]);
 
+                if(s_app_ctx.u4_luma_only)
+                    memset(s_app_ctx.s_disp_buffers[i].pu1_bufs[0]
+                                    + s_ctl_op.u4_min_out_buf_size[0],
+                           128, outlen - s_ctl_op.u4_min_out_buf_size[0]);
+
                 s_app_ctx.s_disp_buffers[i].u4_num_bufs =
                                 s_ctl_op.u4_min_num_out_bufs;
             }
@@ -2967,6 +3128,8 @@ int main(WORD32 argc, CHAR *argv[])
         if(1 == s_app_ctx.display)
             ps_ctl_ip->u4_disp_wd = s_app_ctx.get_stride();
         ps_ctl_ip->e_frm_skip_mode = IVD_SKIP_NONE;
+        if(s_app_ctx.u4_keyframes_only)
+            ps_ctl_ip->e_frm_skip_mode = IVD_SKIP_PB;
 
         ps_ctl_ip->e_frm_out_mode = IVD_DISPLAY_FRAME_OUT;
         ps_ctl_ip->e_vid_dec_mode = IVD_DECODE_FRAME;
@@ -3639,6 +3802,11 @@ int main(WORD32 argc, CHAR *argv[])
             sprintf(ac_error_str, "Error in Codec delete");
             codec_exit(ac_error_str);
         }
+
+        if(s_app_ctx.pv_thread_pool)
+        {
+            ih264d_delete_thread_pool(s_app_ctx.pv_thread_pool);
+        }
     }
     /***********************************************************************/
     /*              Close all the files and free all the memory            */
@@ -209,7 +209,7 @@ static const argument_t argument_mapping[] =
         { "--", "--max_wd", MAX_WD, "Maximum width (Default: 1920) \n" },
         { "--", "--max_ht", MAX_HT, "Maximum height (Default: 1088)\n" },
         { "--", "--max_level", MAX_LEVEL, "Maximum Level (Default: 50)\n" },
-        { "--", "--arch", ARCH, "Set Architecture. Supported values ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR, X86_GENERIC, X86_SSSE3, X86_SSE4 \n" },
+        { "--", "--arch", ARCH, "Set Architecture. Supported values ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR, X86_GENERIC, X86_SSSE3, X86_SSE42, X86_AVX2 \n" },
         { "--", "--soc", SOC, "Set SOC. Supported values GENERIC\n" },
         { "--", "--chksum", CHKSUM_FILE, "Save Check sum file for recon data\n" },
         { "--", "--chksum_enable", CHKSUM_ENABLE, "Recon MD5 Checksum file\n"},
@@ -662,6 +662,8 @@ void parse_argument(app_ctxt_t *ps_app_ctxt, CHAR *argument, CHAR *value)
                 ps_app_ctxt->e_arch = ARCH_X86_SSSE3;
             else if((strcmp(value, "X86_SSE42")) == 0)
                 ps_app_ctxt->e_arch = ARCH_X86_SSE42;
+            else if((strcmp(value, "X86_AVX2")) == 0)
+                ps_app_ctxt->e_arch = ARCH_X86_AVX2;
             else if((strcmp(value, "ARM_A53")) == 0)
                 ps_app_ctxt->e_arch = ARCH_ARM_A53;
             else if((strcmp(value, "ARM_A57")) == 0)
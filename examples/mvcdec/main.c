@@ -220,7 +220,7 @@ static const argument_t argument_mapping[] = {
      "frames\n"},
     {"--", "--arch", ARCH,
      "Set Architecture. Supported values - ARM_A9Q, ARMV8_GENERIC, "
-     "X86_GENERIC, X86_SSE4 \n"},
+     "X86_GENERIC, X86_SSSE3, X86_SSE42 \n"},
 };
 
 #if ANDROID_NDK
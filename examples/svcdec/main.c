@@ -347,7 +347,7 @@ static const argument_t argument_mapping[] = {
 
     {"--", "--arch", ARCH,
      "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, "
-     "ARM_NEONINTR,ARMV8_GENERIC, X86_GENERIC, X86_SSSE3, X86_SSE4 \n"},
+     "ARM_NEONINTR,ARMV8_GENERIC, X86_GENERIC, X86_SSSE3, X86_SSE42, X86_AVX2 \n"},
     {"--", "--soc", SOC, "Set SOC. Supported values  GENERIC, HISI_37X \n"},
     {"-t", "--target_layer_id", TARGET_LAYER_ID, "Version information\n"},
 
@@ -0,0 +1,14 @@
+list(
+  APPEND
+  AVCDECASYNCTEST_SRCS
+  "${AVC_ROOT}/tests/AvcDecAsyncTest.cpp")
+
+libavc_add_executable(AvcDecAsyncTest libavcdec
+    SOURCES ${AVCDECASYNCTEST_SRCS}
+    INCLUDES "${AVC_ROOT}/third_party/googletest/googletest/include")
+
+target_link_libraries(AvcDecAsyncTest
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest.a
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest_main.a)
+
+add_dependencies(AvcDecAsyncTest googletest)
@@ -0,0 +1,654 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
+}
+
+#define ivd_api_function ih264d_api_function
+
+constexpr uint32_t kWidth = 48;
+constexpr uint32_t kHeight = 32;
+constexpr uint32_t kFrameSize = kWidth * kHeight * 3 / 2;
+constexpr uint32_t kNumPictures = 12;
+constexpr uint32_t kMaxDecodeCalls = 100;
+constexpr uint32_t kNumDispBufs = 16;
+
+// 12 pictures of 48x32 in decode order, I P B P B ..., Main profile, encoded by avcenc with
+// --bframes 1. More pictures than IH264D_ASYNC_QUEUE_DEPTH, so that the queue fills up.
+static const uint8_t kStream[] = {
+        0x00, 0x00, 0x00, 0x01, 0x67, 0x4d, 0x40, 0x32, 0x8d, 0x95, 0x9a, 0xd2,
+        0x10, 0x20, 0x20, 0x20, 0x78, 0x44, 0x22, 0x9c, 0x00, 0x00, 0x00, 0x01,
+        0x68, 0xce, 0x01, 0xa8, 0x35, 0xc8, 0x00, 0x00, 0x00, 0x01, 0x06, 0x94,
+        0x08, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0xcd,
+        0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e,
+        0xa6, 0x02, 0x80, 0x00, 0x00, 0x00, 0x01, 0x65, 0xb8, 0x00, 0x04, 0x00,
+        0x02, 0x82, 0x0c, 0x60, 0x27, 0x0b, 0x60, 0x50, 0xe1, 0xca, 0x7f, 0xa7,
+        0xf4, 0xf8, 0x1a, 0xb0, 0xa9, 0x6c, 0xc9, 0xc9, 0xd5, 0xf3, 0x32, 0x72,
+        0x77, 0xf0, 0xc6, 0x00, 0xe6, 0x70, 0x8a, 0x05, 0xd8, 0x77, 0xf6, 0xfe,
+        0xde, 0x18, 0x31, 0x90, 0x60, 0xa3, 0x25, 0x7d, 0x4e, 0x99, 0x3b, 0xfa,
+        0xce, 0xa6, 0xa3, 0x83, 0x18, 0x06, 0xae, 0x0f, 0x01, 0x77, 0x77, 0xf4,
+        0xfe, 0x9e, 0x1c, 0x0f, 0xb0, 0x30, 0x00, 0xf8, 0x4e, 0xfe, 0xff, 0x4d,
+        0x47, 0x3f, 0xbf, 0xd3, 0x0b, 0x60, 0x06, 0x00, 0x56, 0x68, 0x0d, 0x43,
+        0x6a, 0xf7, 0xed, 0xfd, 0xbe, 0x06, 0x74, 0x22, 0x49, 0x47, 0x3f, 0xbf,
+        0xd3, 0x51, 0xc3, 0xaf, 0x8e, 0xbf, 0x4c, 0x31, 0x80, 0x2a, 0xeb, 0x19,
+        0x14, 0x0a, 0x39, 0x5f, 0xa6, 0x9f, 0xa6, 0x9e, 0x15, 0x78, 0x54, 0x6e,
+        0x9a, 0x8e, 0x27, 0x1d, 0x7e, 0x9c, 0x31, 0x8e, 0x7f, 0x0c, 0x60, 0x0e,
+        0x56, 0x17, 0x80, 0x5d, 0xa5, 0xfd, 0xbe, 0xf6, 0xf0, 0x39, 0x26, 0x12,
+        0x8b, 0x1d, 0x7e, 0x9d, 0x31, 0x8e, 0x7f, 0x59, 0xcb, 0x39, 0x47, 0x40,
+        0x00, 0x00, 0x00, 0x01, 0x06, 0xcd, 0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c,
+        0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00,
+        0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00,
+        0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e, 0xa6, 0x02, 0x80, 0x00, 0x00, 0x00,
+        0x01, 0x61, 0xe0, 0x00, 0x20, 0x40, 0x0a, 0x8b, 0x08, 0x04, 0x56, 0x10,
+        0xc2, 0x15, 0xc6, 0x3c, 0xf5, 0x9f, 0xd3, 0x9f, 0xc9, 0xf0, 0x84, 0xfc,
+        0xb3, 0xef, 0x1f, 0x5f, 0xeb, 0x08, 0x79, 0xff, 0x9f, 0x59, 0xf6, 0xd4,
+        0x2f, 0x80, 0x00, 0x00, 0x00, 0x01, 0x06, 0xcd, 0x25, 0xc0, 0x5b, 0x8d,
+        0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e, 0xa6, 0x02, 0x80, 0x00,
+        0x00, 0x00, 0x01, 0x01, 0xa8, 0x00, 0x10, 0x0c, 0x01, 0x61, 0x1e, 0x00,
+        0x00, 0x00, 0x01, 0x06, 0xcd, 0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c, 0x00,
+        0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x1d, 0x4c, 0x00, 0x00, 0x0e, 0xa6, 0x02, 0x80, 0x00, 0x00, 0x00, 0x01,
+        0x61, 0xe0, 0x00, 0x40, 0x80, 0x0a, 0x8b, 0x0c, 0x09, 0x09, 0x5e, 0xf5,
+        0xd7, 0x10, 0x24, 0xf1, 0xd0, 0x1b, 0xed, 0xb4, 0xf3, 0xf8, 0xff, 0x0d,
+        0x6f, 0x71, 0xb2, 0x63, 0x79, 0x3d, 0xe4, 0xf8, 0x81, 0x2b, 0xdf, 0x3c,
+        0x3d, 0x01, 0xe9, 0xa6, 0xda, 0xd3, 0x6f, 0xf0, 0xd6, 0xb5, 0xe9, 0xd1,
+        0x8f, 0xbc, 0xa6, 0x63, 0x0b, 0xae, 0x00, 0x00, 0x00, 0x01, 0x06, 0xcd,
+        0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e,
+        0xa6, 0x02, 0x80, 0x00, 0x00, 0x00, 0x01, 0x01, 0xa8, 0x00, 0x18, 0x1c,
+        0x01, 0x61, 0x16, 0xac, 0x14, 0x00, 0x00, 0x00, 0x01, 0x06, 0xcd, 0x25,
+        0xc0, 0x5b, 0x8d, 0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c,
+        0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c,
+        0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e, 0xa6,
+        0x02, 0x80, 0x00, 0x00, 0x00, 0x01, 0x61, 0xe0, 0x00, 0x60, 0xc0, 0x0a,
+        0x8b, 0x0c, 0x09, 0x04, 0x37, 0x7e, 0x0e, 0x20, 0x49, 0xf8, 0xc3, 0x69,
+        0xed, 0xa7, 0xf8, 0x7a, 0xef, 0xc5, 0x71, 0x5c, 0x57, 0xe0, 0xc7, 0x9b,
+        0x1b, 0x67, 0x5c, 0x40, 0x93, 0xce, 0x74, 0xb5, 0x67, 0xff, 0xcf, 0x0f,
+        0x4c, 0x78, 0x4d, 0xbd, 0x36, 0xff, 0x0b, 0xe2, 0xf1, 0x78, 0xbe, 0x52,
+        0x52, 0xcd, 0x42, 0xee, 0x30, 0xb7, 0xf8, 0x00, 0x00, 0x00, 0x01, 0x06,
+        0xcd, 0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x0e, 0xa6, 0x02, 0x80, 0x00, 0x00, 0x00, 0x01, 0x01, 0xa8, 0x00, 0x20,
+        0x2c, 0x01, 0x61, 0x5e, 0xb1, 0x86, 0xb8, 0xc6, 0x7f, 0x51, 0x9f, 0xff,
+        0x27, 0xdc, 0x00, 0x00, 0x00, 0x01, 0x06, 0xcd, 0x25, 0xc0, 0x5b, 0x8d,
+        0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e, 0xa6, 0x02, 0x80, 0x00,
+        0x00, 0x00, 0x01, 0x61, 0xe0, 0x00, 0x81, 0x00, 0x0a, 0x8b, 0x04, 0x10,
+        0x41, 0x51, 0x7e, 0xeb, 0x7b, 0xb8, 0xa4, 0x13, 0x82, 0x79, 0xf9, 0x3f,
+        0x9f, 0xf0, 0x88, 0x6a, 0xef, 0x98, 0x2f, 0xb9, 0x19, 0xfe, 0x0c, 0x2e,
+        0xfd, 0xee, 0x23, 0x80, 0xb4, 0x6d, 0x9d, 0x7c, 0x99, 0xc2, 0x27, 0xe9,
+        0xc4, 0xb5, 0xa7, 0xff, 0xcf, 0x1e, 0x0a, 0x04, 0xa9, 0xf5, 0x75, 0x6f,
+        0xf0, 0xe6, 0xb5, 0x48, 0x12, 0x65, 0xfe, 0x00, 0x00, 0x00, 0x01, 0x06,
+        0xcd, 0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+        0x0e, 0xa6, 0x02, 0x80, 0x00, 0x00, 0x00, 0x01, 0x01, 0xa8, 0x00, 0x28,
+        0x3c, 0x01, 0x61, 0x5e, 0x79, 0x0c, 0xd5, 0x7f, 0x9f, 0x8c, 0x1f, 0xb1,
+        0x9f, 0xf5, 0xee, 0xa7, 0x67, 0x74, 0x10, 0x9f, 0x02, 0x86, 0xaf, 0xea,
+        0x00, 0x00, 0x00, 0x01, 0x06, 0xcd, 0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c,
+        0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00,
+        0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00,
+        0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e, 0xa6, 0x02, 0x80, 0x00, 0x00, 0x00,
+        0x01, 0x61, 0xe0, 0x00, 0xa1, 0x40, 0x0a, 0x8b, 0x0c, 0x09, 0x04, 0x55,
+        0x5e, 0x0e, 0x22, 0x1a, 0xbb, 0xe4, 0x64, 0x67, 0xa4, 0x7b, 0xc9, 0xfe,
+        0x17, 0xee, 0xee, 0xf7, 0x38, 0x1d, 0x7b, 0x6b, 0xe2, 0x04, 0x9e, 0x71,
+        0x38, 0x9f, 0x53, 0xed, 0x89, 0xa5, 0xfc, 0xf2, 0x81, 0x40, 0x9d, 0xbe,
+        0x4f, 0xff, 0x0b, 0xf5, 0x55, 0x5a, 0x90, 0x04, 0xc1, 0x47, 0x74, 0xd1,
+        0xde, 0x00, 0x00, 0x00, 0x01, 0x06, 0xcd, 0x25, 0xc0, 0x5b, 0x8d, 0x80,
+        0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c,
+        0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c,
+        0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e, 0xa6, 0x02, 0x80, 0x00, 0x00,
+        0x00, 0x01, 0x01, 0xa8, 0x00, 0x30, 0x4c, 0x01, 0x61, 0x5e, 0xa5, 0x08,
+        0x67, 0xe2, 0xd4, 0x9f, 0xfc, 0xfc, 0xe3, 0xec, 0xdd, 0x75, 0x3b, 0xc6,
+        0x7c, 0x0a, 0x3e, 0x4f, 0xf5, 0x8b, 0x00, 0x00, 0x00, 0x01, 0x06, 0xcd,
+        0x25, 0xc0, 0x5b, 0x8d, 0x80, 0x1c, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d,
+        0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00, 0x0e,
+        0xa6, 0x02, 0x80, 0x00, 0x00, 0x00, 0x01, 0x61, 0xe0, 0x00, 0xc1, 0x80,
+        0x0a, 0x8b, 0x08, 0x04, 0x44, 0xd5, 0x77, 0xbf, 0x88, 0x3e, 0x60, 0x76,
+        0x34, 0xff, 0xe1, 0xaa, 0xae, 0x5e, 0x1b, 0x5d, 0xb4, 0xed, 0xf9, 0xfb,
+        0x8f, 0x6d, 0x3f, 0x89, 0x3f, 0xa4, 0xa1, 0xf7, 0x46, 0x7a, 0xfe, 0xb0,
+        0x15, 0x10,
+};
+
+// MD5 of RFC 1321
+class Md5 {
+  public:
+    Md5() : mState{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476}, mSize(0), mBlock{} {}
+
+    void update(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            mBlock[mSize++ % 64] = data[i];
+            if (0 == mSize % 64) transform();
+        }
+    }
+
+    std::string digest() {
+        uint64_t bits = mSize * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (mSize % 64 != 56) update(&pad, 1);
+        for (int i = 0; i < 8; i++) {
+            uint8_t byte = (uint8_t)(bits >> (8 * i));
+            update(&byte, 1);
+        }
+
+        char hex[33];
+        for (int i = 0; i < 16; i++) {
+            snprintf(hex + 2 * i, 3, "%02x", (mState[i / 4] >> (8 * (i % 4))) & 0xff);
+        }
+        return std::string(hex);
+    }
+
+  private:
+    static uint32_t rotate(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+    void transform() {
+        static const uint32_t kShifts[64] = {
+                7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+                4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+        uint32_t m[16];
+        uint32_t a = mState[0], b = mState[1], c = mState[2], d = mState[3];
+
+        for (int i = 0; i < 16; i++) {
+            m[i] = mBlock[4 * i] | (mBlock[4 * i + 1] << 8) | (mBlock[4 * i + 2] << 16) |
+                   ((uint32_t)mBlock[4 * i + 3] << 24);
+        }
+        for (int i = 0; i < 64; i++) {
+            uint32_t f;
+            int g;
+            if (i < 16) {
+                f = (b & c) | (~b & d);
+                g = i;
+            } else if (i < 32) {
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) % 16;
+            } else if (i < 48) {
+                f = b ^ c ^ d;
+                g = (3 * i + 5) % 16;
+            } else {
+                f = c ^ (b | ~d);
+                g = (7 * i) % 16;
+            }
+            uint32_t k = (uint32_t)(std::fabs(std::sin(i + 1.0)) * 4294967296.0);
+            f += a + k + m[g];
+            a = d;
+            d = c;
+            c = b;
+            b += rotate(f, kShifts[i]);
+        }
+        mState[0] += a;
+        mState[1] += b;
+        mState[2] += c;
+        mState[3] += d;
+    }
+
+    uint32_t mState[4];
+    uint64_t mSize;
+    uint8_t mBlock[64];
+};
+
+static void* alignedMalloc(void* ctxt, WORD32 alignment, WORD32 size) {
+    void* buf = nullptr;
+    (void)ctxt;
+    if (0 != posix_memalign(&buf, alignment, size)) {
+        return nullptr;
+    }
+    return buf;
+}
+
+static void alignedFree(void* ctxt, void* buf) {
+    (void)ctxt;
+    free(buf);
+}
+
+// Results of a decode call, compared between the synchronous and the queued decode
+struct DecodeResult {
+    IV_API_CALL_STATUS_T status;
+    UWORD32 bytesConsumed;
+    UWORD32 outputPresent;
+};
+
+class AvcDecoder {
+  public:
+    explicit AvcDecoder(uint32_t numCores, bool shareDispBuf = false)
+        : mCodec(nullptr), mShareDispBuf(shareDispBuf) {
+        ih264d_create_ip_t createIp{};
+        ih264d_create_op_t createOp{};
+
+        createIp.s_ivd_create_ip_t.e_cmd = IVD_CMD_CREATE;
+        createIp.s_ivd_create_ip_t.u4_share_disp_buf = shareDispBuf ? 1 : 0;
+        createIp.s_ivd_create_ip_t.e_output_format = IV_YUV_420P;
+        createIp.s_ivd_create_ip_t.pf_aligned_alloc = alignedMalloc;
+        createIp.s_ivd_create_ip_t.pf_aligned_free = alignedFree;
+        createIp.s_ivd_create_ip_t.pv_mem_ctxt = nullptr;
+        createIp.u4_keep_threads_active = 1;
+        createIp.s_ivd_create_ip_t.u4_size = sizeof(ih264d_create_ip_t);
+        createOp.s_ivd_create_op_t.u4_size = sizeof(ih264d_create_op_t);
+        if (IV_SUCCESS != ivd_api_function(nullptr, &createIp, &createOp)) return;
+
+        mCodec = (iv_obj_t*)createOp.s_ivd_create_op_t.pv_handle;
+        mCodec->pv_fxns = (void*)&ivd_api_function;
+        mCodec->u4_size = sizeof(iv_obj_t);
+
+        ih264d_ctl_set_num_cores_ip_t coresIp{};
+        ih264d_ctl_set_num_cores_op_t coresOp{};
+
+        coresIp.e_cmd = IVD_CMD_VIDEO_CTL;
+        coresIp.e_sub_cmd = (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_SET_NUM_CORES;
+        coresIp.u4_num_cores = numCores;
+        coresIp.u4_size = sizeof(ih264d_ctl_set_num_cores_ip_t);
+        coresOp.u4_size = sizeof(ih264d_ctl_set_num_cores_op_t);
+        ivd_api_function(mCodec, &coresIp, &coresOp);
+    }
+
+    ~AvcDecoder() {
+        if (!mCodec) return;
+
+        ih264d_delete_ip_t deleteIp{};
+        ih264d_delete_op_t deleteOp{};
+
+        deleteIp.s_ivd_delete_ip_t.e_cmd = IVD_CMD_DELETE;
+        deleteIp.s_ivd_delete_ip_t.u4_size = sizeof(ih264d_delete_ip_t);
+        deleteOp.s_ivd_delete_op_t.u4_size = sizeof(ih264d_delete_op_t);
+        ivd_api_function(mCodec, &deleteIp, &deleteOp);
+    }
+
+    bool created() const { return mCodec != nullptr; }
+
+    IV_API_CALL_STATUS_T call(void* ip, void* op) { return ivd_api_function(mCodec, ip, op); }
+
+    // Decodes the SPS and the PPS, returns the number of bytes they take
+    size_t decodeHeader() {
+        std::vector<uint8_t> frame(kFrameSize);
+        ih264d_video_decode_ip_t ip;
+        ih264d_video_decode_op_t op;
+
+        setDecodeMode(IVD_DECODE_HEADER);
+        setupDecode(&ip, &op, 0, frame.data());
+        call(&ip, &op);
+        setDecodeMode(IVD_DECODE_FRAME);
+        return op.s_ivd_video_decode_op_t.u4_num_bytes_consumed;
+    }
+
+    void setFlush() {
+        ivd_ctl_flush_ip_t ip{};
+        ivd_ctl_flush_op_t op{};
+
+        ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        ip.e_sub_cmd = IVD_CMD_CTL_FLUSH;
+        ip.u4_size = sizeof(ivd_ctl_flush_ip_t);
+        op.u4_size = sizeof(ivd_ctl_flush_op_t);
+        call(&ip, &op);
+    }
+
+    // Arguments of a decode call from the offset of the stream to its end, to a 420P frame
+    static void setupDecode(ih264d_video_decode_ip_t* ip, ih264d_video_decode_op_t* op,
+                            size_t offset, uint8_t* frame) {
+        ivd_video_decode_ip_t* decodeIp = &ip->s_ivd_video_decode_ip_t;
+        ivd_out_bufdesc_t* outBuf = &decodeIp->s_out_buffer;
+
+        memset(ip, 0, sizeof(*ip));
+        memset(op, 0, sizeof(*op));
+        decodeIp->e_cmd = IVD_CMD_VIDEO_DECODE;
+        decodeIp->u4_ts = offset;
+        decodeIp->pv_stream_buffer = (void*)(kStream + offset);
+        decodeIp->u4_num_Bytes = sizeof(kStream) - offset;
+        decodeIp->u4_size = sizeof(ih264d_video_decode_ip_t);
+        outBuf->u4_num_bufs = 3;
+        outBuf->pu1_bufs[0] = frame;
+        outBuf->pu1_bufs[1] = frame + kWidth * kHeight;
+        outBuf->pu1_bufs[2] = frame + kWidth * kHeight * 5 / 4;
+        outBuf->u4_min_out_buf_size[0] = kWidth * kHeight;
+        outBuf->u4_min_out_buf_size[1] = kWidth * kHeight / 4;
+        outBuf->u4_min_out_buf_size[2] = kWidth * kHeight / 4;
+        op->s_ivd_video_decode_op_t.u4_size = sizeof(ih264d_video_decode_op_t);
+    }
+
+    // Adds the displayed frame of a decode call to the MD5, row by row so that the padded
+    // display buffers give the same MD5 as the 420P output buffers
+    static void hashDisplay(Md5* md5, const ivd_video_decode_op_t& op) {
+        const iv_yuv_buf_t& disp = op.s_disp_frm_buf;
+
+        for (uint32_t i = 0; i < kHeight; i++) {
+            md5->update((const uint8_t*)disp.pv_y_buf + i * disp.u4_y_strd, kWidth);
+        }
+        for (uint32_t i = 0; i < kHeight / 2; i++) {
+            md5->update((const uint8_t*)disp.pv_u_buf + i * disp.u4_u_strd, kWidth / 2);
+        }
+        for (uint32_t i = 0; i < kHeight / 2; i++) {
+            md5->update((const uint8_t*)disp.pv_v_buf + i * disp.u4_v_strd, kWidth / 2);
+        }
+    }
+
+    // Gives the decoder numBufs display buffers of the size it asks for, after the header
+    bool setDisplayBuffers(uint32_t numBufs) {
+        ivd_ctl_getbufinfo_ip_t infoIp{};
+        ivd_ctl_getbufinfo_op_t infoOp{};
+        ivd_set_display_frame_ip_t dispIp{};
+        ivd_set_display_frame_op_t dispOp{};
+
+        infoIp.e_cmd = IVD_CMD_VIDEO_CTL;
+        infoIp.e_sub_cmd = IVD_CMD_CTL_GETBUFINFO;
+        infoIp.u4_size = sizeof(ivd_ctl_getbufinfo_ip_t);
+        infoOp.u4_size = sizeof(ivd_ctl_getbufinfo_op_t);
+        if (IV_SUCCESS != call(&infoIp, &infoOp)) return false;
+
+        mDispBufs.resize(numBufs);
+        for (uint32_t i = 0; i < numBufs; i++) {
+            ivd_out_bufdesc_t* outBuf = &dispIp.s_disp_buffer[i];
+
+            outBuf->u4_num_bufs = infoOp.u4_min_num_out_bufs;
+            for (uint32_t j = 0; j < infoOp.u4_min_num_out_bufs; j++) {
+                mDispBufs[i].emplace_back(infoOp.u4_min_out_buf_size[j]);
+                outBuf->pu1_bufs[j] = mDispBufs[i][j].data();
+                outBuf->u4_min_out_buf_size[j] = infoOp.u4_min_out_buf_size[j];
+            }
+        }
+        dispIp.e_cmd = IVD_CMD_SET_DISPLAY_FRAME;
+        dispIp.num_disp_bufs = numBufs;
+        dispIp.u4_size = sizeof(ivd_set_display_frame_ip_t);
+        dispOp.u4_size = sizeof(ivd_set_display_frame_op_t);
+        if (IV_SUCCESS != call(&dispIp, &dispOp)) return false;
+
+        // The display buffers start out with the application
+        for (uint32_t i = 0; i < numBufs; i++) {
+            if (IV_SUCCESS != releaseDisplayBuffer(i)) return false;
+        }
+        return true;
+    }
+
+    IV_API_CALL_STATUS_T releaseDisplayBuffer(uint32_t id) {
+        ivd_rel_display_frame_ip_t ip{};
+        ivd_rel_display_frame_op_t op{};
+
+        ip.e_cmd = IVD_CMD_REL_DISPLAY_FRAME;
+        ip.u4_disp_buf_id = id;
+        ip.u4_size = sizeof(ivd_rel_display_frame_ip_t);
+        op.u4_size = sizeof(ivd_rel_display_frame_op_t);
+        return call(&ip, &op);
+    }
+
+    // Outputs the frames left in the decoder, adds them to the MD5
+    void flush(Md5* md5) {
+        std::vector<uint8_t> frame(kFrameSize);
+
+        for (uint32_t n = 0; n < kMaxDecodeCalls; n++) {
+            ih264d_video_decode_ip_t ip;
+            ih264d_video_decode_op_t op;
+
+            setFlush();
+            setupDecode(&ip, &op, 0, frame.data());
+            call(&ip, &op);
+            if (!op.s_ivd_video_decode_op_t.u4_output_present) break;
+            if (mShareDispBuf) {
+                hashDisplay(md5, op.s_ivd_video_decode_op_t);
+            } else {
+                md5->update(frame.data(), kFrameSize);
+            }
+        }
+    }
+
+  private:
+    void setDecodeMode(IVD_VIDEO_DECODE_MODE_T mode) {
+        ivd_ctl_set_config_ip_t ip{};
+        ivd_ctl_set_config_op_t op{};
+
+        ip.u4_disp_wd = 0;
+        ip.e_frm_skip_mode = IVD_SKIP_NONE;
+        ip.e_frm_out_mode = IVD_DISPLAY_FRAME_OUT;
+        ip.e_vid_dec_mode = mode;
+        ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        ip.e_sub_cmd = IVD_CMD_CTL_SETPARAMS;
+        ip.u4_size = sizeof(ivd_ctl_set_config_ip_t);
+        op.u4_size = sizeof(ivd_ctl_set_config_op_t);
+        call(&ip, &op);
+    }
+
+    iv_obj_t* mCodec;
+    bool mShareDispBuf;
+    std::vector<std::vector<std::vector<uint8_t>>> mDispBufs;
+};
+
+class AvcDecAsyncTest : public ::testing::TestWithParam<uint32_t> {
+  protected:
+    // Decodes the stream with IVD_CMD_VIDEO_DECODE, one access unit per call
+    void decodeSync() {
+        AvcDecoder decoder(GetParam());
+        std::vector<uint8_t> frame(kFrameSize);
+        Md5 md5;
+
+        ASSERT_TRUE(decoder.created());
+        mHeaderSize = decoder.decodeHeader();
+        ASSERT_GT(mHeaderSize, 0u);
+
+        size_t offset = mHeaderSize;
+        while (offset < sizeof(kStream) && mSyncResults.size() < kMaxDecodeCalls) {
+            ih264d_video_decode_ip_t ip;
+            ih264d_video_decode_op_t op;
+
+            AvcDecoder::setupDecode(&ip, &op, offset, frame.data());
+            IV_API_CALL_STATUS_T status = decoder.call(&ip, &op);
+            const ivd_video_decode_op_t& decodeOp = op.s_ivd_video_decode_op_t;
+
+            mSyncResults.push_back({status, decodeOp.u4_num_bytes_consumed,
+                                    decodeOp.u4_output_present});
+            if (decodeOp.u4_output_present) md5.update(frame.data(), kFrameSize);
+            if (0 == decodeOp.u4_num_bytes_consumed) break;
+            offset += decodeOp.u4_num_bytes_consumed;
+        }
+        decoder.flush(&md5);
+        mSyncMd5 = md5.digest();
+    }
+
+    size_t mHeaderSize = 0;
+    std::vector<DecodeResult> mSyncResults;
+    std::string mSyncMd5;
+};
+
+// Queues all the access units, dequeuing only when the queue is full, and checks that the
+// results come out in order and that the output matches the synchronous decode
+TEST_P(AvcDecAsyncTest, QueueMatchesSync) {
+    decodeSync();
+    ASSERT_EQ(kNumPictures, mSyncResults.size());
+
+    AvcDecoder decoder(GetParam());
+    ASSERT_TRUE(decoder.created());
+    ASSERT_EQ(mHeaderSize, decoder.decodeHeader());
+
+    // Each queued access unit has its own output buffer, valid until it is dequeued
+    std::vector<std::vector<uint8_t>> frames(mSyncResults.size(),
+                                             std::vector<uint8_t>(kFrameSize));
+    size_t numQueued = 0;
+    size_t numDequeued = 0;
+    uint32_t numQueueFull = 0;
+    size_t offset = mHeaderSize;
+    Md5 md5;
+
+    while (numDequeued < mSyncResults.size()) {
+        if (numQueued < mSyncResults.size()) {
+            ih264d_queue_input_ip_t queueIp{};
+            ih264d_queue_input_op_t queueOp{};
+            ih264d_video_decode_op_t decodeOp;
+
+            queueIp.u4_size = sizeof(ih264d_queue_input_ip_t);
+            queueIp.e_cmd = IH264D_CMD_QUEUE_INPUT;
+            queueOp.u4_size = sizeof(ih264d_queue_input_op_t);
+            AvcDecoder::setupDecode(&queueIp.s_video_decode_ip, &decodeOp, offset,
+                                    frames[numQueued].data());
+            if (IV_SUCCESS == decoder.call(&queueIp, &queueOp)) {
+                offset += mSyncResults[numQueued].bytesConsumed;
+                numQueued++;
+                continue;
+            }
+            ASSERT_EQ((UWORD32)IH264D_ASYNC_QUEUE_FULL, queueOp.u4_error_code);
+            ASSERT_EQ((size_t)IH264D_ASYNC_QUEUE_DEPTH, numQueued - numDequeued);
+            numQueueFull++;
+        }
+
+        ih264d_dequeue_output_ip_t dequeueIp{};
+        ih264d_dequeue_output_op_t dequeueOp{};
+
+        dequeueIp.u4_size = sizeof(ih264d_dequeue_output_ip_t);
+        dequeueIp.e_cmd = IH264D_CMD_DEQUEUE_OUTPUT;
+        dequeueIp.u4_blocking = 1;
+        dequeueOp.u4_size = sizeof(ih264d_dequeue_output_op_t);
+        ASSERT_EQ(IV_SUCCESS, decoder.call(&dequeueIp, &dequeueOp));
+
+        const DecodeResult& expected = mSyncResults[numDequeued];
+        const ivd_video_decode_op_t& decodeOp =
+                dequeueOp.s_video_decode_op.s_ivd_video_decode_op_t;
+        ASSERT_EQ(expected.status, dequeueOp.e_video_decode_status)
+                << "access unit " << numDequeued;
+        ASSERT_EQ(expected.bytesConsumed, decodeOp.u4_num_bytes_consumed)
+                << "access unit " << numDequeued;
+        ASSERT_EQ(expected.outputPresent, decodeOp.u4_output_present)
+                << "access unit " << numDequeued;
+        if (decodeOp.u4_output_present) md5.update(frames[numDequeued].data(), kFrameSize);
+        numDequeued++;
+    }
+    EXPECT_GT(numQueueFull, 0u);
+
+    ih264d_dequeue_output_ip_t dequeueIp{};
+    ih264d_dequeue_output_op_t dequeueOp{};
+
+    dequeueIp.u4_size = sizeof(ih264d_dequeue_output_ip_t);
+    dequeueIp.e_cmd = IH264D_CMD_DEQUEUE_OUTPUT;
+    dequeueIp.u4_blocking = 0;
+    dequeueOp.u4_size = sizeof(ih264d_dequeue_output_op_t);
+    EXPECT_EQ(IV_FAIL, decoder.call(&dequeueIp, &dequeueOp));
+    EXPECT_EQ((UWORD32)IH264D_ASYNC_QUEUE_EMPTY, dequeueOp.u4_error_code);
+
+    decoder.flush(&md5);
+    EXPECT_EQ(mSyncMd5, md5.digest());
+}
+
+// Queues the access units with display buffers shared with the decoder, and checks that the
+// displayed buffers can be released, and read-only control calls made, while access units are
+// pending, while the other calls still fail
+TEST_P(AvcDecAsyncTest, ShareDisplayBuffers) {
+    decodeSync();
+    ASSERT_EQ(kNumPictures, mSyncResults.size());
+
+    AvcDecoder decoder(GetParam(), true);
+    ASSERT_TRUE(decoder.created());
+    ASSERT_EQ(mHeaderSize, decoder.decodeHeader());
+    ASSERT_TRUE(decoder.setDisplayBuffers(kNumDispBufs));
+
+    // The output buffers of the decode calls are not used with shared display buffers
+    std::vector<uint8_t> frame(kFrameSize);
+    size_t numQueued = 0;
+    size_t numDequeued = 0;
+    uint32_t numReleased = 0;
+    size_t offset = mHeaderSize;
+    Md5 md5;
+
+    while (numDequeued < mSyncResults.size()) {
+        if (numQueued < mSyncResults.size()) {
+            ih264d_queue_input_ip_t queueIp{};
+            ih264d_queue_input_op_t queueOp{};
+            ih264d_video_decode_op_t decodeOp;
+
+            queueIp.u4_size = sizeof(ih264d_queue_input_ip_t);
+            queueIp.e_cmd = IH264D_CMD_QUEUE_INPUT;
+            queueOp.u4_size = sizeof(ih264d_queue_input_op_t);
+            AvcDecoder::setupDecode(&queueIp.s_video_decode_ip, &decodeOp, offset, frame.data());
+            if (IV_SUCCESS == decoder.call(&queueIp, &queueOp)) {
+                offset += mSyncResults[numQueued].bytesConsumed;
+                numQueued++;
+                continue;
+            }
+            ASSERT_EQ((UWORD32)IH264D_ASYNC_QUEUE_FULL, queueOp.u4_error_code);
+        }
+
+        ih264d_dequeue_output_ip_t dequeueIp{};
+        ih264d_dequeue_output_op_t dequeueOp{};
+
+        dequeueIp.u4_size = sizeof(ih264d_dequeue_output_ip_t);
+        dequeueIp.e_cmd = IH264D_CMD_DEQUEUE_OUTPUT;
+        dequeueIp.u4_blocking = 1;
+        dequeueOp.u4_size = sizeof(ih264d_dequeue_output_op_t);
+        ASSERT_EQ(IV_SUCCESS, decoder.call(&dequeueIp, &dequeueOp));
+
+        const DecodeResult& expected = mSyncResults[numDequeued];
+        const ivd_video_decode_op_t& decodeOp =
+                dequeueOp.s_video_decode_op.s_ivd_video_decode_op_t;
+        ASSERT_EQ(expected.status, dequeueOp.e_video_decode_status)
+                << "access unit " << numDequeued;
+        ASSERT_EQ(expected.outputPresent, decodeOp.u4_output_present)
+                << "access unit " << numDequeued;
+        numDequeued++;
+        if (!decodeOp.u4_output_present) continue;
+        AvcDecoder::hashDisplay(&md5, decodeOp);
+        if (numQueued == numDequeued) continue;
+
+        ASSERT_EQ(IV_SUCCESS, decoder.releaseDisplayBuffer(decodeOp.u4_disp_buf_id))
+                << "access unit " << numDequeued;
+        numReleased++;
+
+        ivd_ctl_getversioninfo_ip_t versionIp{};
+        ivd_ctl_getversioninfo_op_t versionOp{};
+        char version[512];
+
+        versionIp.e_cmd = IVD_CMD_VIDEO_CTL;
+        versionIp.e_sub_cmd = IVD_CMD_CTL_GETVERSION;
+        versionIp.pv_version_buffer = version;
+        versionIp.u4_version_buffer_size = sizeof(version);
+        versionIp.u4_size = sizeof(ivd_ctl_getversioninfo_ip_t);
+        versionOp.u4_size = sizeof(ivd_ctl_getversioninfo_op_t);
+        EXPECT_EQ(IV_SUCCESS, decoder.call(&versionIp, &versionOp));
+
+        ivd_ctl_flush_ip_t flushIp{};
+        ivd_ctl_flush_op_t flushOp{};
+
+        flushIp.e_cmd = IVD_CMD_VIDEO_CTL;
+        flushIp.e_sub_cmd = IVD_CMD_CTL_FLUSH;
+        flushIp.u4_size = sizeof(ivd_ctl_flush_ip_t);
+        flushOp.u4_size = sizeof(ivd_ctl_flush_op_t);
+        EXPECT_EQ(IV_FAIL, decoder.call(&flushIp, &flushOp));
+        EXPECT_EQ((UWORD32)IH264D_ASYNC_AU_PENDING, flushOp.u4_error_code & 0xff);
+    }
+    EXPECT_GT(numReleased, 0u);
+
+    decoder.flush(&md5);
+    EXPECT_EQ(mSyncMd5, md5.digest());
+}
+
+INSTANTIATE_TEST_SUITE_P(AvcDecAsyncTestAll, AvcDecAsyncTest, ::testing::Values(1, 4));
@@ -0,0 +1,14 @@
+list(
+  APPEND
+  AVCDECBSTEST_SRCS
+  "${AVC_ROOT}/tests/AvcDecBsTest.cpp")
+
+libavc_add_executable(AvcDecBsTest libavcdec
+    SOURCES ${AVCDECBSTEST_SRCS}
+    INCLUDES "${AVC_ROOT}/third_party/googletest/googletest/include")
+
+target_link_libraries(AvcDecBsTest
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest.a
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest_main.a)
+
+add_dependencies(AvcDecBsTest googletest)
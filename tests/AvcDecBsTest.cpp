@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_structs.h"
+#include "ih264d_defs.h"
+#include "ih264d_deblocking.h"
+}
+
+constexpr uint32_t kNumRandomMbs = 100000;
+constexpr uint32_t kBenchmarkIterations = 2000000;
+constexpr int kNumRefPics = 4;
+constexpr int kMaxRefIdx = 5;
+
+typedef decltype(ih264d_fill_bs1_non16x16mb_pslice) fill_bs1_ft;
+
+struct Kernel {
+    const char* name;
+    fill_bs1_ft* function;
+};
+
+// Kernels available on the build target, the generic one first
+static std::vector<Kernel> getKernels(int isBSlice) {
+    std::vector<Kernel> kernels = {
+            {"generic", isBSlice ? ih264d_fill_bs1_non16x16mb_bslice
+                                 : ih264d_fill_bs1_non16x16mb_pslice}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"sse42", isBSlice ? ih264d_fill_bs1_non16x16mb_bslice_sse42
+                                         : ih264d_fill_bs1_non16x16mb_pslice_sse42});
+#endif
+    return kernels;
+}
+
+// Motion vectors, reference indices and neighbour picture addresses of a random MB. The MVs
+// are mostly close to each other, so that the differences straddle the limits, with some
+// extreme values to exercise the overflow of the differences.
+struct Mb {
+    char pics[kNumRefPics];
+    std::vector<void*> map;
+    mv_pred_t cur[16];
+    mv_pred_t top[4];
+    mv_pred_t left[16];
+    neighbouradd_t leftAddr;
+    void* topAddr[4];
+    UWORD32 bs[8];
+    WORD32 verMvLimit;
+
+    // Index -1 and the L1 list are valid, as in the decoder
+    void** mapL0() { return map.data() + 1; }
+
+    void* randomPic(std::mt19937& rng) {
+        std::uniform_int_distribution<int> pic(-1, kNumRefPics - 1);
+        int idx = pic(rng);
+        return idx < 0 ? nullptr : &pics[idx];
+    }
+
+    void randomMv(std::mt19937& rng, mv_pred_t* mv) {
+        std::uniform_int_distribution<int> small(-6, 6);
+        std::uniform_int_distribution<int> full(-32768, 32767);
+        std::uniform_int_distribution<int> kind(0, 15);
+        std::uniform_int_distribution<int> ref(-1, kMaxRefIdx);
+
+        for (int i = 0; i < 4; i++) {
+            mv->i2_mv[i] = (WORD16)(kind(rng) == 0 ? full(rng) : small(rng));
+        }
+        mv->i1_ref_frame[0] = (WORD8)ref(rng);
+        mv->i1_ref_frame[1] = (WORD8)ref(rng);
+    }
+
+    explicit Mb(std::mt19937& rng) : map(1 + 2 * POC_LIST_L0_TO_L1_DIFF) {
+        std::uniform_int_distribution<int> bsValue(0, 15);
+        std::uniform_int_distribution<int> limit(0, 1);
+
+        for (void*& pic : map) {
+            pic = randomPic(rng);
+        }
+        for (mv_pred_t& mv : cur) randomMv(rng, &mv);
+        for (mv_pred_t& mv : top) randomMv(rng, &mv);
+        for (mv_pred_t& mv : left) randomMv(rng, &mv);
+        for (void*& addr : leftAddr.u4_add) addr = randomPic(rng);
+        for (void*& addr : topAddr) addr = randomPic(rng);
+
+        // Most edges are not set yet, the others take any BS of the table
+        UWORD8* bsBytes = (UWORD8*)bs;
+        for (size_t i = 0; i < sizeof(bs); i++) {
+            int value = bsValue(rng);
+            bsBytes[i] = value < 10 ? 0 : value - 10;
+        }
+        verMvLimit = limit(rng) ? 4 : 2;
+    }
+
+    void fill(fill_bs1_ft* function, UWORD32* pu4_bs) {
+        memcpy(pu4_bs, bs, sizeof(bs));
+        function(cur, top, mapL0(), pu4_bs, left, &leftAddr, topAddr, verMvLimit);
+    }
+};
+
+static void expectSameBs(int isBSlice, uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto kernels = getKernels(isBSlice);
+
+    for (uint32_t n = 0; n < kNumRandomMbs; n++) {
+        Mb mb(rng);
+        UWORD32 expected[8];
+
+        mb.fill(kernels[0].function, expected);
+        for (size_t k = 1; k < kernels.size(); k++) {
+            UWORD32 actual[8];
+            mb.fill(kernels[k].function, actual);
+            ASSERT_EQ(0, memcmp(expected, actual, sizeof(expected)))
+                    << kernels[k].name << " mb " << n;
+        }
+    }
+}
+
+TEST(AvcDecBsTest, PSliceMatchesGeneric) {
+    expectSameBs(0, 1);
+}
+
+TEST(AvcDecBsTest, BSliceMatchesGeneric) {
+    expectSameBs(1, 2);
+}
+
+TEST(AvcDecBsTest, Benchmark) {
+    std::mt19937 rng(3);
+    Mb mb(rng);
+
+    for (int isBSlice = 0; isBSlice < 2; isBSlice++) {
+        for (const Kernel& kernel : getKernels(isBSlice)) {
+            UWORD32 bs[8];
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+                mb.fill(kernel.function, bs);
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+
+            printf("%s %-8s %8.2f Mmbs/s\n", isBSlice ? "B" : "P", kernel.name,
+                   kBenchmarkIterations / seconds / 1e6);
+        }
+    }
+}
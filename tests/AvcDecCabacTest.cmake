@@ -0,0 +1,14 @@
+list(
+  APPEND
+  AVCDECCABACTEST_SRCS
+  "${AVC_ROOT}/tests/AvcDecCabacTest.cpp")
+
+libavc_add_executable(AvcDecCabacTest libavcdec
+    SOURCES ${AVCDECCABACTEST_SRCS}
+    INCLUDES "${AVC_ROOT}/third_party/googletest/googletest/include")
+
+target_link_libraries(AvcDecCabacTest
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest.a
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest_main.a)
+
+add_dependencies(AvcDecCabacTest googletest)
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "ih264_typedefs.h"
+#include "ih264d_tables.h"
+}
+
+constexpr uint32_t kNumContexts = 16;
+constexpr uint32_t kNumRandomSymbols = 20000;
+constexpr uint32_t kNumBenchmarkBins = 1 << 22;
+constexpr uint32_t kBenchmarkIterations = 4;
+constexpr size_t kBitstreamPadding = 8;
+
+enum SymbolType { kDecision, kBypass, kBypassUnary };
+
+struct Symbol {
+    SymbolType type;
+    uint32_t ctx;
+    uint32_t numBins;
+    uint32_t value;
+};
+
+// Arithmetic encoder of 9.3.4.2, sharing the state transition table with the decoder
+class CabacEncoder {
+  public:
+    CabacEncoder() : mLow(0), mRange(510), mBitsOutstanding(0), mFirstBitFlag(true) {}
+
+    void encodeDecision(UWORD8* mpsState, uint32_t bin) {
+        UWORD32 entry = gau4_ih264d_cabac_table[*mpsState][(mRange >> 6) & 3];
+        uint32_t rangeLps = entry & 0xff;
+
+        mRange -= rangeLps;
+        if (bin != (uint32_t)((*mpsState >> 6) & 1)) {
+            mLow += mRange;
+            mRange = rangeLps;
+            *mpsState = (entry >> 15) & 0x7f;
+        } else {
+            *mpsState = (entry >> 8) & 0x7f;
+        }
+        renormalize();
+    }
+
+    void encodeBypass(uint32_t bin) {
+        mLow <<= 1;
+        if (bin) mLow += mRange;
+        if (mLow >= 1024) {
+            putBit(1);
+            mLow -= 1024;
+        } else if (mLow < 512) {
+            putBit(0);
+        } else {
+            mLow -= 512;
+            mBitsOutstanding++;
+        }
+    }
+
+    // Encodes a terminating bin of 1 and flushes, as at the end of a slice
+    void encodeFlush() {
+        mRange -= 2;
+        mLow += mRange;
+        mRange = 2;
+        renormalize();
+        putBit((mLow >> 9) & 1);
+        writeBit((mLow >> 8) & 1);
+        writeBit(1);
+    }
+
+    // Output packed into big endian words, as the decoder reads it
+    std::vector<UWORD32> getWords() const {
+        std::vector<UWORD32> words(mBits.size() / 32 + kBitstreamPadding, 0);
+        for (size_t i = 0; i < mBits.size(); i++) {
+            words[i / 32] |= (UWORD32)mBits[i] << (31 - i % 32);
+        }
+        return words;
+    }
+
+    size_t getNumBits() const { return mBits.size(); }
+
+  private:
+    void renormalize() {
+        while (mRange < 256) {
+            if (mLow < 256) {
+                putBit(0);
+            } else if (mLow >= 512) {
+                mLow -= 512;
+                putBit(1);
+            } else {
+                mLow -= 256;
+                mBitsOutstanding++;
+            }
+            mRange <<= 1;
+            mLow <<= 1;
+        }
+    }
+
+    void putBit(uint32_t bit) {
+        if (mFirstBitFlag) {
+            mFirstBitFlag = false;
+        } else {
+            writeBit(bit);
+        }
+        for (; mBitsOutstanding > 0; mBitsOutstanding--) {
+            writeBit(1 - bit);
+        }
+    }
+
+    void writeBit(uint32_t bit) { mBits.push_back(bit); }
+
+    uint32_t mLow;
+    uint32_t mRange;
+    uint32_t mBitsOutstanding;
+    bool mFirstBitFlag;
+    std::vector<uint8_t> mBits;
+};
+
+static std::vector<UWORD8> getInitialStates(std::mt19937& rng) {
+    std::uniform_int_distribution<int> state(0, 62);
+    std::vector<UWORD8> states(kNumContexts);
+
+    for (UWORD8& s : states) {
+        s = state(rng) | ((rng() & 1) << 6);
+    }
+    return states;
+}
+
+static std::vector<UWORD32> encode(const std::vector<Symbol>& symbols,
+                                   std::vector<UWORD8> states, size_t* numBits) {
+    CabacEncoder encoder;
+
+    for (const Symbol& symbol : symbols) {
+        switch (symbol.type) {
+            case kDecision:
+                encoder.encodeDecision(&states[symbol.ctx], symbol.value);
+                break;
+            case kBypass:
+                for (uint32_t i = symbol.numBins; i > 0; i--) {
+                    encoder.encodeBypass((symbol.value >> (i - 1)) & 1);
+                }
+                break;
+            case kBypassUnary:
+                for (uint32_t i = 0; i < symbol.value; i++) {
+                    encoder.encodeBypass(1);
+                }
+                if (symbol.value < 32) encoder.encodeBypass(0);
+                break;
+        }
+    }
+    encoder.encodeFlush();
+    *numBits = encoder.getNumBits();
+    return encoder.getWords();
+}
+
+// Returns the number of symbols decoded as encoded
+static uint32_t decode(const std::vector<Symbol>& symbols, std::vector<UWORD8> states,
+                       std::vector<UWORD32>& words, size_t numBits) {
+    dec_bit_stream_t bitstrm = {};
+    decoding_envirnoment_t cabEnv = {};
+    std::vector<bin_ctxt_model_t> contexts(kNumContexts);
+    uint32_t numMatching = 0;
+
+    for (uint32_t i = 0; i < kNumContexts; i++) {
+        contexts[i].u1_mps_state = states[i];
+    }
+    bitstrm.pu4_buffer = words.data();
+    bitstrm.u4_max_ofst = numBits;
+    cabEnv.cabac_table = gau4_ih264d_cabac_table;
+    if (OK != ih264d_init_cabac_dec_envirnoment(&cabEnv, &bitstrm)) return 0;
+
+    for (const Symbol& symbol : symbols) {
+        UWORD32 value = 0;
+        switch (symbol.type) {
+            case kDecision:
+                value = ih264d_decode_bin(symbol.ctx, contexts.data(), &bitstrm, &cabEnv);
+                break;
+            case kBypass:
+                value = ih264d_decode_bypass_bins(&cabEnv, symbol.numBins, &bitstrm);
+                break;
+            case kBypassUnary:
+                value = ih264d_decode_bypass_bins_unary(&cabEnv, &bitstrm);
+                break;
+        }
+        if (value != symbol.value) break;
+        numMatching++;
+    }
+    if (numMatching == symbols.size() && 1 == ih264d_decode_terminate(&cabEnv, &bitstrm)) {
+        numMatching++;
+    }
+    return numMatching;
+}
+
+// Decision bins of skewed probabilities mixed with bypass codes as in mvd and coefficient levels
+static std::vector<Symbol> getRandomSymbols(std::mt19937& rng, uint32_t numSymbols) {
+    std::uniform_int_distribution<int> type(0, 9);
+    std::uniform_int_distribution<uint32_t> ctx(0, kNumContexts - 1);
+    std::uniform_int_distribution<uint32_t> numBins(1, 16);
+    std::uniform_int_distribution<uint32_t> unary(0, 32);
+    std::vector<double> lpsProbs(kNumContexts);
+    std::vector<Symbol> symbols;
+
+    for (double& p : lpsProbs) {
+        p = std::uniform_real_distribution<double>(0.01, 0.5)(rng);
+    }
+    for (uint32_t n = 0; n < numSymbols; n++) {
+        Symbol symbol = {kDecision, ctx(rng), 1, 0};
+        int t = type(rng);
+        if (t < 7) {
+            symbol.value = std::bernoulli_distribution(lpsProbs[symbol.ctx])(rng);
+        } else if (t < 9) {
+            symbol.type = kBypass;
+            symbol.numBins = numBins(rng);
+            symbol.value = rng() & ((1u << symbol.numBins) - 1);
+        } else {
+            symbol.type = kBypassUnary;
+            symbol.value = std::min(unary(rng), unary(rng));
+        }
+        symbols.push_back(symbol);
+    }
+    return symbols;
+}
+
+TEST(AvcDecCabacTest, DecodesEncodedSymbols) {
+    std::mt19937 rng(1);
+
+    for (int n = 0; n < 20; n++) {
+        std::vector<UWORD8> states = getInitialStates(rng);
+        std::vector<Symbol> symbols = getRandomSymbols(rng, kNumRandomSymbols);
+        size_t numBits;
+        std::vector<UWORD32> words = encode(symbols, states, &numBits);
+
+        ASSERT_EQ(symbols.size() + 1, decode(symbols, states, words, numBits)) << "stream " << n;
+    }
+}
+
+static void benchmark(const char* name, const std::vector<Symbol>& symbols,
+                      const std::vector<UWORD8>& states, uint32_t numBins) {
+    size_t numBits;
+    std::vector<UWORD32> words = encode(symbols, states, &numBits);
+    double seconds = 0;
+
+    for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+        auto start = std::chrono::steady_clock::now();
+        uint32_t numDecoded = decode(symbols, states, words, numBits);
+        auto end = std::chrono::steady_clock::now();
+        seconds += std::chrono::duration<double>(end - start).count();
+        ASSERT_EQ(symbols.size() + 1, numDecoded) << name;
+    }
+    printf("%-10s %8.1f Mbins/s %6.2f bits/bin\n", name,
+           kBenchmarkIterations * numBins / seconds / 1e6, (double)numBits / numBins);
+}
+
+// Decision bins of the LPS probabilities typical of significance maps and levels
+TEST(AvcDecCabacTest, DecisionBenchmark) {
+    std::mt19937 rng(2);
+    std::vector<UWORD8> states = getInitialStates(rng);
+    std::vector<double> lpsProbs(kNumContexts);
+    std::uniform_int_distribution<uint32_t> ctx(0, kNumContexts - 1);
+    std::vector<Symbol> symbols;
+
+    for (double& p : lpsProbs) {
+        p = std::uniform_real_distribution<double>(0.05, 0.45)(rng);
+    }
+    for (uint32_t n = 0; n < kNumBenchmarkBins; n++) {
+        Symbol symbol = {kDecision, ctx(rng), 1, 0};
+        symbol.value = std::bernoulli_distribution(lpsProbs[symbol.ctx])(rng);
+        symbols.push_back(symbol);
+    }
+    benchmark("decision", symbols, states, kNumBenchmarkBins);
+}
+
+// Bypass bins of the lengths of exp-Golomb suffixes of mvd and coefficient levels
+TEST(AvcDecCabacTest, BypassBenchmark) {
+    std::mt19937 rng(3);
+    std::vector<UWORD8> states = getInitialStates(rng);
+    std::uniform_int_distribution<uint32_t> numBins(1, 16);
+    std::vector<Symbol> symbols;
+    uint32_t totalBins = 0;
+
+    while (totalBins < kNumBenchmarkBins) {
+        Symbol symbol = {kBypass, 0, numBins(rng), 0};
+        symbol.value = rng() & ((1u << symbol.numBins) - 1);
+        symbols.push_back(symbol);
+        totalBins += symbol.numBins;
+    }
+    benchmark("bypass", symbols, states, totalBins);
+}
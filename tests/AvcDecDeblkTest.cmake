@@ -0,0 +1,14 @@
+list(
+  APPEND
+  AVCDECDEBLKTEST_SRCS
+  "${AVC_ROOT}/tests/AvcDecDeblkTest.cpp")
+
+libavc_add_executable(AvcDecDeblkTest libavcdec
+    SOURCES ${AVCDECDEBLKTEST_SRCS}
+    INCLUDES "${AVC_ROOT}/third_party/googletest/googletest/include")
+
+target_link_libraries(AvcDecDeblkTest
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest.a
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest_main.a)
+
+add_dependencies(AvcDecDeblkTest googletest)
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264d_tables.h"
+}
+
+constexpr uint32_t kNumRandomMbs = 100000;
+constexpr uint32_t kBenchmarkIterations = 2000000;
+
+// Plane around the MB, so that writes outside of it are caught
+constexpr int kStride = 32;
+constexpr int kMbOffset = 8 * kStride + 8;
+
+// Largest tc0 of the clip table of the standard
+constexpr int kMaxTc0 = 25;
+
+struct Kernel {
+    const char* name;
+    ih264_deblk_luma_inner_bslt4_ft* function;
+    ih264_deblk_edge_bslt4_ft* edge;
+};
+
+static bool avx2Supported() {
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(DISABLE_AVX2)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Kernels available on the build target, the generic one first
+static std::vector<Kernel> getKernels(int isHorz) {
+    std::vector<Kernel> kernels = {
+            {"generic",
+             isHorz ? ih264_deblk_luma_horz_inner_bslt4 : ih264_deblk_luma_vert_inner_bslt4,
+             isHorz ? ih264_deblk_luma_horz_bslt4 : ih264_deblk_luma_vert_bslt4}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back(
+            {"ssse3",
+             isHorz ? ih264_deblk_luma_horz_inner_bslt4 : ih264_deblk_luma_vert_inner_bslt4,
+             isHorz ? ih264_deblk_luma_horz_bslt4_ssse3 : ih264_deblk_luma_vert_bslt4_ssse3});
+#if !defined(DISABLE_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2",
+                           isHorz ? ih264_deblk_luma_horz_inner_bslt4_avx2
+                                  : ih264_deblk_luma_vert_inner_bslt4_avx2,
+                           nullptr});
+    }
+#endif
+#endif
+    return kernels;
+}
+
+// Pixels, filter parameters and boundary strengths of the inner edges of a random MB. Half of
+// the MBs take alpha, beta and tc0 from the tables of the decoder, the others take any value.
+// The pixels are mostly smooth, so that the edges pass the alpha and beta checks, with some
+// saturated runs to exercise the clipping.
+struct Mb {
+    std::vector<UWORD8> plane;
+    WORD32 alpha;
+    WORD32 beta;
+    UWORD32 bs[3];
+    UWORD8 cliptab[4];
+
+    explicit Mb(std::mt19937& rng) : plane(kStride * kStride) {
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_int_distribution<int> index(0, 51);
+        std::uniform_int_distribution<int> tc0(0, kMaxTc0);
+        std::uniform_int_distribution<int> kind(0, 7);
+        std::uniform_int_distribution<int> bsValue(0, 5);
+
+        if (kind(rng) < 4) {
+            int indexA = index(rng);
+            alpha = gau1_ih264d_alpha_table[12 + indexA];
+            beta = gau1_ih264d_beta_table[12 + index(rng)];
+            memcpy(cliptab, gau1_ih264d_clip_table[12 + indexA], sizeof(cliptab));
+        } else {
+            alpha = byte(rng);
+            beta = byte(rng);
+            cliptab[0] = 0;
+            for (int i = 1; i < 4; i++) cliptab[i] = (UWORD8)tc0(rng);
+        }
+
+        // Zero edges, edges with some samples at bs 0, and edges with bs 1 to 3 only
+        for (UWORD32& edgeBs : bs) {
+            int edgeKind = kind(rng);
+            edgeBs = 0;
+            for (int i = 0; i < 4 && edgeKind > 1; i++) {
+                int value = bsValue(rng);
+                if (edgeKind > 4) value = 1 + value % 3;
+                edgeBs = (edgeBs << 8) | (UWORD32)(value > 3 ? 0 : value);
+            }
+        }
+
+        int level = byte(rng);
+        int noise = 1 + kind(rng) * kind(rng);
+        std::uniform_int_distribution<int> delta(-noise, noise);
+        for (size_t i = 0; i < plane.size(); i++) {
+            if (0 == (i & 7)) {
+                int run = kind(rng);
+                if (run == 0) level = 0;
+                if (run == 1) level = 255;
+                if (run == 2) level = byte(rng);
+            }
+            plane[i] = (UWORD8)CLIP3(0, 255, level + delta(rng));
+        }
+    }
+
+    void filter(const Kernel& kernel, UWORD8* pu1_plane) {
+        memcpy(pu1_plane, plane.data(), plane.size());
+        kernel.function(pu1_plane + kMbOffset, kStride, alpha, beta, bs, cliptab, kernel.edge);
+    }
+};
+
+static void expectSameOutput(int isHorz, uint32_t seed) {
+    if (!avx2Supported()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    std::mt19937 rng(seed);
+    auto kernels = getKernels(isHorz);
+    std::vector<UWORD8> expected(kStride * kStride);
+    std::vector<UWORD8> actual(kStride * kStride);
+
+    for (uint32_t n = 0; n < kNumRandomMbs; n++) {
+        Mb mb(rng);
+
+        mb.filter(kernels[0], expected.data());
+        for (size_t k = 1; k < kernels.size(); k++) {
+            mb.filter(kernels[k], actual.data());
+            ASSERT_EQ(0, memcmp(expected.data(), actual.data(), expected.size()))
+                    << kernels[k].name << " mb " << n;
+        }
+    }
+}
+
+TEST(AvcDecDeblkTest, VertInnerMatchesGeneric) {
+    expectSameOutput(0, 1);
+}
+
+TEST(AvcDecDeblkTest, HorzInnerMatchesGeneric) {
+    expectSameOutput(1, 2);
+}
+
+TEST(AvcDecDeblkTest, Benchmark) {
+    std::mt19937 rng(3);
+    std::vector<UWORD8> plane(kStride * kStride);
+    Mb mb(rng);
+
+    // A smooth MB, with all the samples of the inner edges filtered
+    mb.alpha = 255;
+    mb.beta = 18;
+    for (UWORD32& edgeBs : mb.bs) edgeBs = 0x02020202;
+    for (size_t i = 0; i < mb.plane.size(); i++) mb.plane[i] = (UWORD8)(120 + i % 7);
+
+    for (int isHorz = 0; isHorz < 2; isHorz++) {
+        for (const Kernel& kernel : getKernels(isHorz)) {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+                mb.filter(kernel, plane.data());
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+
+            printf("%s %-8s %8.2f Mmbs/s\n", isHorz ? "horz" : "vert", kernel.name,
+                   kBenchmarkIterations / seconds / 1e6);
+        }
+    }
+}
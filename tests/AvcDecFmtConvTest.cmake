@@ -0,0 +1,14 @@
+list(
+  APPEND
+  AVCDECFMTCONVTEST_SRCS
+  "${AVC_ROOT}/tests/AvcDecFmtConvTest.cpp")
+
+libavc_add_executable(AvcDecFmtConvTest libavcdec
+    SOURCES ${AVCDECFMTCONVTEST_SRCS}
+    INCLUDES "${AVC_ROOT}/third_party/googletest/googletest/include")
+
+target_link_libraries(AvcDecFmtConvTest
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest.a
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest_main.a)
+
+add_dependencies(AvcDecFmtConvTest googletest)
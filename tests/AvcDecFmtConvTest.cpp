@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d_format_conv.h"
+}
+
+constexpr uint32_t kNumRandomFrames = 500;
+constexpr WORD32 kMaxRandomWidth = 200;
+constexpr WORD32 kMaxRandomHeight = 24;
+constexpr WORD32 kMaxStridePadding = 40;
+constexpr WORD32 kMaxScaleLog2 = 3;
+constexpr WORD32 kBenchmarkWidth = 1920;
+constexpr WORD32 kBenchmarkHeight = 1088;
+constexpr uint32_t kBenchmarkIterations = 20;
+
+template <typename T>
+struct Kernel {
+    const char* name;
+    T* function;
+};
+
+// Kernels available on the build target, the generic one first
+static std::vector<Kernel<ih264d_fmt_conv_420sp_to_420p_ft>> get420pKernels() {
+    std::vector<Kernel<ih264d_fmt_conv_420sp_to_420p_ft>> kernels = {
+            {"generic", ih264d_fmt_conv_420sp_to_420p}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", ih264d_fmt_conv_420sp_to_420p_ssse3});
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", ih264d_fmt_conv_420sp_to_420p_avx2});
+    }
+#endif
+    return kernels;
+}
+
+static std::vector<Kernel<ih264d_fmt_conv_420sp_to_420sp_ft>> getSwapUvKernels() {
+    std::vector<Kernel<ih264d_fmt_conv_420sp_to_420sp_ft>> kernels = {
+            {"generic", ih264d_fmt_conv_420sp_to_420sp_swap_uv}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3});
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2});
+    }
+#endif
+    return kernels;
+}
+
+static std::vector<Kernel<ih264d_fmt_conv_420sp_to_rgb565_ft>> getRgb565Kernels() {
+    std::vector<Kernel<ih264d_fmt_conv_420sp_to_rgb565_ft>> kernels = {
+            {"generic", ih264d_fmt_conv_420sp_to_rgb565}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", ih264d_fmt_conv_420sp_to_rgb565_ssse3});
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", ih264d_fmt_conv_420sp_to_rgb565_avx2});
+    }
+#endif
+    return kernels;
+}
+
+static std::vector<Kernel<ih264d_fmt_conv_420sp_to_rgba8888_ft>> getRgba8888Kernels() {
+    std::vector<Kernel<ih264d_fmt_conv_420sp_to_rgba8888_ft>> kernels = {
+            {"generic", ih264d_fmt_conv_420sp_to_rgba8888}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", ih264d_fmt_conv_420sp_to_rgba8888_ssse3});
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", ih264d_fmt_conv_420sp_to_rgba8888_avx2});
+    }
+#endif
+    return kernels;
+}
+
+static std::vector<Kernel<ih264d_fmt_conv_downscale_ft>> getDownscaleKernels() {
+    std::vector<Kernel<ih264d_fmt_conv_downscale_ft>> kernels = {
+            {"generic", ih264d_fmt_conv_downscale}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", ih264d_fmt_conv_downscale_ssse3});
+#endif
+    return kernels;
+}
+
+// A 420SP frame with random samples, extreme values included to exercise the clipping
+struct Frame {
+    WORD32 width;
+    WORD32 height;
+    WORD32 yStride;
+    WORD32 uvStride;
+    std::vector<UWORD8> y;
+    std::vector<UWORD8> uv;
+
+    Frame(std::mt19937& rng, WORD32 wd, WORD32 ht, WORD32 padding)
+        : width(wd), height(ht), yStride(wd + padding), uvStride(wd + padding) {
+        std::uniform_int_distribution<int> sample(0, 255);
+        std::uniform_int_distribution<int> extreme(0, 7);
+
+        y.resize(yStride * height);
+        uv.resize(uvStride * height / 2);
+        for (UWORD8& value : y) {
+            int kind = extreme(rng);
+            value = kind == 0 ? 0 : kind == 1 ? 255 : sample(rng);
+        }
+        for (UWORD8& value : uv) {
+            int kind = extreme(rng);
+            value = kind == 0 ? 0 : kind == 1 ? 255 : sample(rng);
+        }
+    }
+};
+
+static Frame randomFrame(std::mt19937& rng) {
+    std::uniform_int_distribution<WORD32> halfWidth(1, kMaxRandomWidth / 2);
+    std::uniform_int_distribution<WORD32> halfHeight(1, kMaxRandomHeight / 2);
+    std::uniform_int_distribution<WORD32> padding(0, kMaxStridePadding);
+
+    WORD32 wd = 2 * halfWidth(rng);
+    WORD32 ht = 2 * halfHeight(rng);
+    return Frame(rng, wd, ht, padding(rng));
+}
+
+// Runs the conversion of each kernel into a buffer of the same initial contents, so that
+// samples outside the picture are compared as well
+template <typename T>
+static void expectSameOutput(const std::vector<Kernel<T>>& kernels, size_t outSize,
+                             const std::function<void(T*, std::vector<UWORD8>&)>& convert,
+                             const Frame& frame, int isUFirst) {
+    std::vector<UWORD8> expected(outSize, 0x5a);
+    convert(kernels[0].function, expected);
+    for (size_t k = 1; k < kernels.size(); k++) {
+        std::vector<UWORD8> actual(outSize, 0x5a);
+        convert(kernels[k].function, actual);
+        ASSERT_EQ(expected, actual) << kernels[k].name << " " << frame.width << "x"
+                                    << frame.height << " stride " << frame.yStride
+                                    << " u first " << isUFirst;
+    }
+}
+
+static void convert420p(ih264d_fmt_conv_420sp_to_420p_ft* function, Frame& frame,
+                        std::vector<UWORD8>& out, WORD32 dstStride, int isUFirst,
+                        int disableLumaCopy) {
+    WORD32 uvStride = dstStride / 2;
+    UWORD8* dstY = out.data();
+    UWORD8* dstU = dstY + dstStride * frame.height;
+    UWORD8* dstV = dstU + uvStride * frame.height / 2;
+    function(frame.y.data(), frame.uv.data(), dstY, dstU, dstV, frame.width, frame.height,
+             frame.yStride, frame.uvStride, dstStride, uvStride, isUFirst, disableLumaCopy);
+}
+
+static void convertSwapUv(ih264d_fmt_conv_420sp_to_420sp_ft* function, Frame& frame,
+                          std::vector<UWORD8>& out, WORD32 dstStride) {
+    UWORD8* dstY = out.data();
+    UWORD8* dstUv = dstY + dstStride * frame.height;
+    function(frame.y.data(), frame.uv.data(), dstY, dstUv, frame.width, frame.height,
+             frame.yStride, frame.uvStride, dstStride, dstStride);
+}
+
+static void convertRgb565(ih264d_fmt_conv_420sp_to_rgb565_ft* function, Frame& frame,
+                          std::vector<UWORD8>& out, WORD32 dstStride, int isUFirst) {
+    function(frame.y.data(), frame.uv.data(), (UWORD16*)out.data(), frame.width, frame.height,
+             frame.yStride, frame.uvStride, dstStride, isUFirst);
+}
+
+static void convertRgba8888(ih264d_fmt_conv_420sp_to_rgba8888_ft* function, Frame& frame,
+                            std::vector<UWORD8>& out, WORD32 dstStride, int isUFirst) {
+    function(frame.y.data(), frame.uv.data(), (UWORD32*)out.data(), frame.width, frame.height,
+             frame.yStride, frame.uvStride, dstStride, isUFirst);
+}
+
+TEST(AvcDecFmtConvTest, To420pMatchesGeneric) {
+    std::mt19937 rng(1);
+    auto kernels = get420pKernels();
+
+    for (uint32_t n = 0; n < kNumRandomFrames; n++) {
+        Frame frame = randomFrame(rng);
+        WORD32 dstStride = frame.width + 2 * (n % 8);
+        size_t outSize = dstStride * frame.height * 3 / 2;
+
+        for (int isUFirst = 0; isUFirst < 2; isUFirst++) {
+            for (int disableLumaCopy = 0; disableLumaCopy < 2; disableLumaCopy++) {
+                expectSameOutput<ih264d_fmt_conv_420sp_to_420p_ft>(
+                        kernels, outSize,
+                        [&](ih264d_fmt_conv_420sp_to_420p_ft* function,
+                            std::vector<UWORD8>& out) {
+                            convert420p(function, frame, out, dstStride, isUFirst,
+                                        disableLumaCopy);
+                        },
+                        frame, isUFirst);
+            }
+        }
+    }
+}
+
+TEST(AvcDecFmtConvTest, To420spSwapUvMatchesGeneric) {
+    std::mt19937 rng(2);
+    auto kernels = getSwapUvKernels();
+
+    for (uint32_t n = 0; n < kNumRandomFrames; n++) {
+        Frame frame = randomFrame(rng);
+        WORD32 dstStride = frame.width + 2 * (n % 8);
+        size_t outSize = dstStride * frame.height * 3 / 2;
+
+        expectSameOutput<ih264d_fmt_conv_420sp_to_420sp_ft>(
+                kernels, outSize,
+                [&](ih264d_fmt_conv_420sp_to_420sp_ft* function, std::vector<UWORD8>& out) {
+                    convertSwapUv(function, frame, out, dstStride);
+                },
+                frame, 1);
+    }
+}
+
+TEST(AvcDecFmtConvTest, ToRgb565MatchesGeneric) {
+    std::mt19937 rng(3);
+    auto kernels = getRgb565Kernels();
+
+    for (uint32_t n = 0; n < kNumRandomFrames; n++) {
+        Frame frame = randomFrame(rng);
+        WORD32 dstStride = frame.width + (n % 8);
+        size_t outSize = dstStride * frame.height * 2;
+
+        for (int isUFirst = 0; isUFirst < 2; isUFirst++) {
+            expectSameOutput<ih264d_fmt_conv_420sp_to_rgb565_ft>(
+                    kernels, outSize,
+                    [&](ih264d_fmt_conv_420sp_to_rgb565_ft* function, std::vector<UWORD8>& out) {
+                        convertRgb565(function, frame, out, dstStride, isUFirst);
+                    },
+                    frame, isUFirst);
+        }
+    }
+}
+
+TEST(AvcDecFmtConvTest, ToRgba8888MatchesGeneric) {
+    std::mt19937 rng(4);
+    auto kernels = getRgba8888Kernels();
+
+    for (uint32_t n = 0; n < kNumRandomFrames; n++) {
+        Frame frame = randomFrame(rng);
+        WORD32 dstStride = frame.width + (n % 8);
+        size_t outSize = dstStride * frame.height * 4;
+
+        for (int isUFirst = 0; isUFirst < 2; isUFirst++) {
+            expectSameOutput<ih264d_fmt_conv_420sp_to_rgba8888_ft>(
+                    kernels, outSize,
+                    [&](ih264d_fmt_conv_420sp_to_rgba8888_ft* function,
+                        std::vector<UWORD8>& out) {
+                        convertRgba8888(function, frame, out, dstStride, isUFirst);
+                    },
+                    frame, isUFirst);
+        }
+    }
+}
+
+TEST(AvcDecFmtConvTest, DownscaleMatchesGeneric) {
+    std::mt19937 rng(6);
+    auto kernels = getDownscaleKernels();
+
+    for (uint32_t n = 0; n < kNumRandomFrames; n++) {
+        Frame frame = randomFrame(rng);
+
+        for (WORD32 scaleLog2 = 1; scaleLog2 <= kMaxScaleLog2; scaleLog2++) {
+            for (WORD32 isChroma = 0; isChroma < 2; isChroma++) {
+                // Chroma is interleaved, so each output sample pair covers twice the width
+                WORD32 wd = (frame.width >> scaleLog2) & ~1;
+                WORD32 ht = frame.height >> (scaleLog2 + isChroma);
+                WORD32 dstStride = wd + 2 * (n % 8);
+                const std::vector<UWORD8>& src = isChroma ? frame.uv : frame.y;
+
+                expectSameOutput<ih264d_fmt_conv_downscale_ft>(
+                        kernels, dstStride * ht + 1,
+                        [&](ih264d_fmt_conv_downscale_ft* function, std::vector<UWORD8>& out) {
+                            function((UWORD8*)src.data(), out.data(), wd, ht, frame.yStride,
+                                     dstStride, scaleLog2, isChroma);
+                        },
+                        frame, isChroma);
+            }
+        }
+    }
+}
+
+// Converts a 1080p frame, reporting the throughput of each kernel
+template <typename T>
+static void benchmark(const char* format, const std::vector<Kernel<T>>& kernels,
+                      size_t outSize,
+                      const std::function<void(T*, std::vector<UWORD8>&)>& convert) {
+    std::vector<UWORD8> out(outSize);
+
+    for (const Kernel<T>& kernel : kernels) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+            convert(kernel.function, out);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        printf("%-10s %-8s %8.1f Mpixels/s\n", format, kernel.name,
+               (double)kBenchmarkWidth * kBenchmarkHeight * kBenchmarkIterations / seconds /
+                       1e6);
+    }
+}
+
+TEST(AvcDecFmtConvTest, Benchmark) {
+    std::mt19937 rng(5);
+    Frame frame(rng, kBenchmarkWidth, kBenchmarkHeight, 64);
+    size_t numPixels = (size_t)kBenchmarkWidth * kBenchmarkHeight;
+
+    benchmark<ih264d_fmt_conv_420sp_to_420p_ft>(
+            "420P", get420pKernels(), numPixels * 3 / 2,
+            [&](ih264d_fmt_conv_420sp_to_420p_ft* function, std::vector<UWORD8>& out) {
+                convert420p(function, frame, out, kBenchmarkWidth, 1, 0);
+            });
+    benchmark<ih264d_fmt_conv_420sp_to_420sp_ft>(
+            "420SP_VU", getSwapUvKernels(), numPixels * 3 / 2,
+            [&](ih264d_fmt_conv_420sp_to_420sp_ft* function, std::vector<UWORD8>& out) {
+                convertSwapUv(function, frame, out, kBenchmarkWidth);
+            });
+    benchmark<ih264d_fmt_conv_420sp_to_rgb565_ft>(
+            "RGB565", getRgb565Kernels(), numPixels * 2,
+            [&](ih264d_fmt_conv_420sp_to_rgb565_ft* function, std::vector<UWORD8>& out) {
+                convertRgb565(function, frame, out, kBenchmarkWidth, 1);
+            });
+    benchmark<ih264d_fmt_conv_420sp_to_rgba8888_ft>(
+            "RGBA8888", getRgba8888Kernels(), numPixels * 4,
+            [&](ih264d_fmt_conv_420sp_to_rgba8888_ft* function, std::vector<UWORD8>& out) {
+                convertRgba8888(function, frame, out, kBenchmarkWidth, 1);
+            });
+}
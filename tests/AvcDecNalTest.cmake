@@ -0,0 +1,14 @@
+list(
+  APPEND
+  AVCDECNALTEST_SRCS
+  "${AVC_ROOT}/tests/AvcDecNalTest.cpp")
+
+libavc_add_executable(AvcDecNalTest libavcdec
+    SOURCES ${AVCDECNALTEST_SRCS}
+    INCLUDES "${AVC_ROOT}/third_party/googletest/googletest/include")
+
+target_link_libraries(AvcDecNalTest
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest.a
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest_main.a)
+
+add_dependencies(AvcDecNalTest googletest)
@@ -0,0 +1,552 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "ih264_typedefs.h"
+#include "ih264d_nal.h"
+#include "ih264d_parse_cavlc.h"
+}
+
+constexpr size_t kMaxRandomBufSize = 300;
+constexpr uint32_t kNumRandomBufs = 2000;
+constexpr size_t kBenchmarkBufSize = 8 * 1024 * 1024;
+constexpr uint32_t kBenchmarkIterations = 8;
+constexpr size_t kNalPadding = 8;
+constexpr uint32_t kNumExpGolombCodes = 1 << 20;
+constexpr size_t kBitstreamPadding = 8;
+
+struct StartCode {
+    WORD32 length;
+    UWORD32 startCodeEnd;
+    UWORD32 nextIsAud;
+};
+
+struct ZeroRunKernel {
+    const char* name;
+    ih264d_find_zero_run_ft* function;
+};
+
+// Kernels available on the build target, the generic one first
+static std::vector<ZeroRunKernel> getKernels() {
+    std::vector<ZeroRunKernel> kernels = {{"generic", ih264d_find_zero_run}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"sse42", ih264d_find_zero_run_sse42});
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", ih264d_find_zero_run_avx2});
+    }
+#endif
+    return kernels;
+}
+
+// Byte by byte search the decoder used before the zero run kernels
+static StartCode findStartCodeReference(UWORD8* buf, UWORD32 curPos, UWORD32 maxOfst) {
+    StartCode startCode = {0, 0, 0};
+    WORD32 zeroByteCnt = 0;
+    UWORD32 nalStart;
+
+    while (curPos < maxOfst) {
+        if (buf[curPos] == 0) {
+            zeroByteCnt++;
+        } else if (buf[curPos] == 0x01 && zeroByteCnt >= 2) {
+            curPos++;
+            break;
+        } else {
+            zeroByteCnt = 0;
+        }
+        curPos++;
+    }
+    startCode.startCodeEnd = curPos;
+    zeroByteCnt = 0;
+    nalStart = curPos;
+    while (curPos < maxOfst) {
+        if (buf[curPos] == 0) {
+            zeroByteCnt++;
+        } else if (buf[curPos] == 0x01 && zeroByteCnt >= 2) {
+            if (curPos + 1 < maxOfst && (buf[curPos + 1] & 0x1f) == 9) {
+                startCode.nextIsAud = 1;
+            }
+            break;
+        } else {
+            zeroByteCnt = 0;
+        }
+        curPos++;
+    }
+    startCode.length = curPos - zeroByteCnt - nalStart;
+    return startCode;
+}
+
+static StartCode findStartCode(UWORD8* buf, UWORD32 curPos, UWORD32 maxOfst,
+                               ih264d_find_zero_run_ft* findZeroRun) {
+    StartCode startCode = {0, 0, 0};
+
+    startCode.length = ih264d_find_start_code(buf, curPos, maxOfst, &startCode.startCodeEnd,
+                                              &startCode.nextIsAud, findZeroRun);
+    return startCode;
+}
+
+// Two word per read exp-Golomb parsing the decoder used before the 64 bits reads
+static UWORD32 uevReference(UWORD32* offset, UWORD32* buf) {
+    UWORD32 wordOff = *offset >> 5;
+    UWORD32 bitOff = *offset & 0x1f;
+    UWORD32 word = buf[wordOff] << bitOff;
+    UWORD32 ldz;
+    UWORD32 suffix = 0;
+
+    if (bitOff) {
+        word |= buf[wordOff + 1] >> (32 - bitOff);
+    }
+    ldz = word ? __builtin_clz(word) : 31;
+    *offset += ldz + 1;
+    if (ldz) {
+        wordOff = *offset >> 5;
+        bitOff = *offset & 0x1f;
+        suffix = buf[wordOff] << bitOff;
+        if (bitOff) {
+            suffix |= buf[wordOff + 1] >> (32 - bitOff);
+        }
+        suffix >>= 32 - ldz;
+        *offset += ldz;
+    }
+    return (1u << ldz) + suffix - 1;
+}
+
+static WORD32 sevReference(UWORD32* offset, UWORD32* buf) {
+    UWORD32 codeNum = uevReference(offset, buf);
+    WORD32 absVal = (codeNum + 1) >> 1;
+    return (codeNum & 1) ? absVal : -absVal;
+}
+
+// Exp-Golomb codes of values spread over all code lengths, packed into words as
+// ih264d_process_nal_unit() does
+static std::vector<UWORD32> getExpGolombWords(std::mt19937& rng, uint32_t numCodes,
+                                              uint32_t maxLeadingZeros, size_t* numBits) {
+    std::uniform_int_distribution<uint32_t> leadingZeros(0, maxLeadingZeros);
+    std::vector<UWORD32> words(kBitstreamPadding, 0);
+    size_t bitPos = 0;
+
+    for (uint32_t n = 0; n < numCodes; n++) {
+        uint32_t ldz = leadingZeros(rng);
+        uint64_t code = ((uint64_t)1 << ldz) | (rng() & (((uint64_t)1 << ldz) - 1));
+        uint32_t len = 2 * ldz + 1;
+
+        words.resize((bitPos + len) / 32 + kBitstreamPadding, 0);
+        for (uint32_t i = 0; i < len; i++, bitPos++) {
+            if ((code >> (len - 1 - i)) & 1) {
+                words[bitPos / 32] |= 1u << (31 - bitPos % 32);
+            }
+        }
+    }
+    *numBits = bitPos;
+    return words;
+}
+
+// Random bytes, with zero bytes, start code prefixes and emulation prevention bytes more
+// frequent than in a bitstream
+static void fillRandom(std::mt19937& rng, std::vector<UWORD8>& buf) {
+    std::uniform_int_distribution<int> kind(0, 15);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    for (size_t i = 0; i < buf.size(); i++) {
+        int k = kind(rng);
+        if (k < 2) {
+            buf[i] = 0;
+        } else if (k < 4 && i + 3 <= buf.size()) {
+            buf[i++] = 0;
+            buf[i++] = 0;
+            buf[i] = (k == 2) ? 1 : 3;
+        } else {
+            buf[i] = byte(rng);
+        }
+    }
+}
+
+// RBSP of a NAL unit as in 7.3.1, packed into big endian words
+static std::vector<UWORD32> getRbspWords(const std::vector<UWORD8>& nal, UWORD32* numBytes) {
+    std::vector<UWORD8> rbsp(nal.begin(), nal.begin() + 1);
+    int zeroByteCnt = 0;
+
+    for (size_t i = 1; i < nal.size(); i++) {
+        if (zeroByteCnt == 2 && nal[i] == 3) {
+            zeroByteCnt = 0;
+            continue;
+        }
+        rbsp.push_back(nal[i]);
+        zeroByteCnt = nal[i] ? 0 : zeroByteCnt + 1;
+    }
+    // The header and the two bytes after it are always read
+    while (rbsp.size() < 3) {
+        rbsp.push_back(0);
+    }
+    *numBytes = rbsp.size();
+
+    std::vector<UWORD32> words((rbsp.size() + 3) / 4 + 1, 0);
+    for (size_t i = 0; i < rbsp.size(); i++) {
+        words[i / 4] |= (UWORD32)rbsp[i] << (24 - 8 * (i % 4));
+    }
+    return words;
+}
+
+TEST(AvcDecNalTest, FindZeroRunMatchesGeneric) {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> size(0, kMaxRandomBufSize);
+    std::vector<ZeroRunKernel> kernels = getKernels();
+
+    for (uint32_t n = 0; n < kNumRandomBufs; n++) {
+        std::vector<UWORD8> buf(size(rng));
+        fillRandom(rng, buf);
+        UWORD32 maxOfst = buf.size();
+
+        for (UWORD32 pos = 0; pos <= maxOfst; pos++) {
+            UWORD32 expected = ih264d_find_zero_run(buf.data(), pos, maxOfst);
+            for (const ZeroRunKernel& kernel : kernels) {
+                ASSERT_EQ(expected, kernel.function(buf.data(), pos, maxOfst))
+                        << kernel.name << " size " << maxOfst << " pos " << pos;
+            }
+        }
+    }
+}
+
+TEST(AvcDecNalTest, FindStartCodeMatchesReference) {
+    std::mt19937 rng(2);
+    std::uniform_int_distribution<size_t> size(0, kMaxRandomBufSize);
+    std::vector<ZeroRunKernel> kernels = getKernels();
+
+    for (uint32_t n = 0; n < kNumRandomBufs; n++) {
+        std::vector<UWORD8> buf(size(rng));
+        fillRandom(rng, buf);
+        UWORD32 maxOfst = buf.size();
+
+        for (UWORD32 pos = 0; pos <= maxOfst; pos++) {
+            StartCode expected = findStartCodeReference(buf.data(), pos, maxOfst);
+            for (const ZeroRunKernel& kernel : kernels) {
+                StartCode actual = findStartCode(buf.data(), pos, maxOfst, kernel.function);
+                ASSERT_EQ(expected.length, actual.length)
+                        << kernel.name << " size " << maxOfst << " pos " << pos;
+                ASSERT_EQ(expected.startCodeEnd, actual.startCodeEnd)
+                        << kernel.name << " size " << maxOfst << " pos " << pos;
+                ASSERT_EQ(expected.nextIsAud, actual.nextIsAud)
+                        << kernel.name << " size " << maxOfst << " pos " << pos;
+            }
+        }
+    }
+}
+
+TEST(AvcDecNalTest, ProcessNalUnitMatchesReference) {
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<size_t> size(1, kMaxRandomBufSize);
+    std::vector<ZeroRunKernel> kernels = getKernels();
+
+    for (uint32_t n = 0; n < kNumRandomBufs; n++) {
+        std::vector<UWORD8> nal(size(rng));
+        fillRandom(rng, nal);
+        UWORD32 numBytes;
+        std::vector<UWORD32> expected = getRbspWords(nal, &numBytes);
+
+        for (const ZeroRunKernel& kernel : kernels) {
+            std::vector<UWORD32> buf((nal.size() + kNalPadding + 3) / 4, 0);
+            dec_bit_stream_t bitstrm;
+
+            memcpy(buf.data(), nal.data(), nal.size());
+            WORD32 numRbspBytes = ih264d_process_nal_unit(&bitstrm, (UWORD8*)buf.data(),
+                                                          nal.size(), kernel.function);
+            ASSERT_EQ(numBytes - 1, (UWORD32)numRbspBytes) << kernel.name << " nal " << n;
+            ASSERT_EQ(numBytes * 8, bitstrm.u4_max_ofst) << kernel.name << " nal " << n;
+            for (size_t i = 0; i < expected.size(); i++) {
+                ASSERT_EQ(expected[i], buf[i]) << kernel.name << " nal " << n << " word " << i;
+            }
+        }
+    }
+}
+
+TEST(AvcDecNalTest, ExpGolombMatchesReference) {
+    std::mt19937 rng(6);
+    size_t numBits;
+    std::vector<UWORD32> words = getExpGolombWords(rng, kNumRandomBufs, 31, &numBits);
+
+    // Valid codes, then random data with runs of zero words for escape sized codes
+    for (size_t i = numBits / 32 + 1; i < words.size() - 2; i++) {
+        words[i] = (rng() & 1) ? rng() : 0;
+    }
+    numBits = (words.size() - 2) * 32;
+
+    for (int sign = 0; sign < 2; sign++) {
+        UWORD32 expectedOffset = 0;
+        UWORD32 offset = 0;
+        while (expectedOffset < numBits) {
+            if (sign) {
+                WORD32 expected = sevReference(&expectedOffset, words.data());
+                ASSERT_EQ(expected, ih264d_sev(&offset, words.data())) << "offset " << offset;
+            } else {
+                UWORD32 expected = uevReference(&expectedOffset, words.data());
+                ASSERT_EQ(expected, ih264d_uev(&offset, words.data())) << "offset " << offset;
+            }
+            ASSERT_EQ(expectedOffset, offset);
+        }
+    }
+}
+
+// A stream of access units with random framing, and the offsets of those decoding can
+// start from
+struct RapStream {
+    std::vector<UWORD8> buf;
+    std::vector<UWORD32> idrOffsets;
+    std::vector<UWORD32> intraOffsets;
+};
+
+static void appendUev(std::vector<int>& bits, UWORD32 value) {
+    int numBits = 0;
+    while ((value + 1) >> (numBits + 1)) {
+        numBits++;
+    }
+    for (int i = 0; i < numBits; i++) {
+        bits.push_back(0);
+    }
+    for (int i = numBits; i >= 0; i--) {
+        bits.push_back(((value + 1) >> i) & 1);
+    }
+}
+
+// Payload bytes are never zero, so that they do not form start codes
+static void appendNal(std::mt19937& rng, std::vector<UWORD8>& buf, UWORD32 nalLengthSize,
+                      UWORD8 header, const std::vector<int>& bits) {
+    std::uniform_int_distribution<int> payloadByte(1, 255);
+    std::uniform_int_distribution<size_t> payloadSize(0, 40);
+    std::vector<UWORD8> nal = {header};
+
+    for (size_t i = 0; i < bits.size(); i += 8) {
+        UWORD8 byte = 0;
+        for (size_t j = 0; j < 8; j++) {
+            byte |= (i + j < bits.size() ? bits[i + j] : (j == 7)) << (7 - j);
+        }
+        nal.push_back(byte);
+    }
+    for (size_t i = payloadSize(rng); i > 0; i--) {
+        nal.push_back(payloadByte(rng));
+    }
+
+    if (nalLengthSize) {
+        for (UWORD32 i = nalLengthSize; i > 0; i--) {
+            buf.push_back((nal.size() >> (8 * (i - 1))) & 0xff);
+        }
+    } else {
+        if (rng() & 1) {
+            buf.push_back(0);
+        }
+        buf.insert(buf.end(), {0, 0, 1});
+    }
+    buf.insert(buf.end(), nal.begin(), nal.end());
+}
+
+static RapStream getRapStream(std::mt19937& rng, UWORD32 nalLengthSize, uint32_t numAus) {
+    std::uniform_int_distribution<int> picType(0, 3);
+    std::uniform_int_distribution<int> numSlices(1, 3);
+    RapStream stream;
+
+    for (uint32_t n = 0; n < numAus; n++) {
+        UWORD32 auStart = stream.buf.size();
+        // IDR, I, P or B picture
+        int type = picType(rng);
+        UWORD32 sliceType = (type == 0 || type == 1) ? 2 : (type == 2) ? 0 : 1;
+
+        if (rng() & 1) {
+            appendNal(rng, stream.buf, nalLengthSize, 0x09, {1, 1, 1});
+        }
+        if (type == 0 && (rng() & 1)) {
+            appendNal(rng, stream.buf, nalLengthSize, 0x67, {});
+            appendNal(rng, stream.buf, nalLengthSize, 0x68, {});
+        }
+        if (rng() & 1) {
+            appendNal(rng, stream.buf, nalLengthSize, 0x06, {});
+        }
+        for (int i = 0, num = numSlices(rng); i < num; i++) {
+            std::vector<int> bits;
+            // first_mb_in_slice, then slice_type, 5 to 9 for some pictures
+            appendUev(bits, i == 0 ? 0 : 1 + (rng() % 300));
+            appendUev(bits, sliceType + ((rng() & 1) ? 5 : 0));
+            appendUev(bits, rng() % 4);
+            appendNal(rng, stream.buf, nalLengthSize, type == 0 ? 0x65 : 0x41, bits);
+        }
+        // Filler data and end of sequence belong to the access unit before the next one
+        if ((rng() & 3) == 0) {
+            appendNal(rng, stream.buf, nalLengthSize, 0x0c, {});
+        }
+
+        if (type == 0) {
+            stream.idrOffsets.push_back(auStart);
+        }
+        if (type <= 1) {
+            stream.intraOffsets.push_back(auStart);
+        }
+    }
+    return stream;
+}
+
+TEST(AvcDecNalTest, FindRapOffsetsMatchesReference) {
+    std::mt19937 rng(7);
+    std::vector<ZeroRunKernel> kernels = getKernels();
+    const UWORD32 nalLengthSizes[] = {0, 1, 2, 4};
+
+    for (uint32_t n = 0; n < kNumRandomBufs / 10; n++) {
+        for (UWORD32 nalLengthSize : nalLengthSizes) {
+            RapStream stream = getRapStream(rng, nalLengthSize, 1 + rng() % 20);
+            UWORD32 maxOfst = stream.buf.size();
+
+            for (int includeI = 0; includeI < 2; includeI++) {
+                const std::vector<UWORD32>& expected =
+                        includeI ? stream.intraOffsets : stream.idrOffsets;
+
+                for (const ZeroRunKernel& kernel : kernels) {
+                    std::vector<UWORD32> offsets(expected.size() + 1, 0xffffffff);
+                    UWORD32 numOffsets;
+                    UWORD32 scanned = ih264d_find_rap_offsets(
+                            stream.buf.data(), maxOfst, nalLengthSize, includeI,
+                            offsets.data(), offsets.size(), &numOffsets, kernel.function);
+                    ASSERT_EQ(maxOfst, scanned) << kernel.name;
+                    ASSERT_EQ(expected,
+                              std::vector<UWORD32>(offsets.begin(), offsets.begin() + numOffsets))
+                            << kernel.name << " nal length size " << nalLengthSize;
+
+                    // With the offsets array filled up, the scan stops at the next one
+                    if (expected.size() > 1) {
+                        scanned = ih264d_find_rap_offsets(
+                                stream.buf.data(), maxOfst, nalLengthSize, includeI,
+                                offsets.data(), 1, &numOffsets, kernel.function);
+                        ASSERT_EQ(1u, numOffsets);
+                        ASSERT_EQ(expected[1], scanned);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Splits a buffer of slice data into NAL units, as the decoder does for each access unit
+TEST(AvcDecNalTest, FindStartCodeBenchmark) {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<UWORD8> buf(kBenchmarkBufSize);
+
+    // Entropy coded data with a start code every 256 KB, as in a high bit rate intra stream
+    for (size_t i = 0; i < buf.size(); i++) {
+        buf[i] = byte(rng);
+        if (i >= 2 && buf[i - 2] == 0 && buf[i - 1] == 0 && buf[i] <= 3) {
+            buf[i] = 3;
+        }
+    }
+    for (size_t i = 0; i + 4 <= buf.size(); i += 256 * 1024) {
+        buf[i] = 0;
+        buf[i + 1] = 0;
+        buf[i + 2] = 1;
+        buf[i + 3] = 0x65;
+    }
+
+    uint32_t numNalsGeneric = 0;
+    for (const ZeroRunKernel& kernel : getKernels()) {
+        uint32_t numNals = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+            UWORD32 pos = 0;
+            while (pos < buf.size()) {
+                StartCode startCode = findStartCode(buf.data(), pos, buf.size(), kernel.function);
+                pos = startCode.startCodeEnd + startCode.length;
+                numNals++;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        if (kernel.function == ih264d_find_zero_run) {
+            numNalsGeneric = numNals;
+        }
+        EXPECT_EQ(numNalsGeneric, numNals) << kernel.name;
+        printf("%-8s %8.1f MB/s\n", kernel.name,
+               kBenchmarkIterations * (buf.size() / (1024.0 * 1024.0)) / seconds);
+    }
+}
+
+// Converts a large slice NAL unit to RBSP, as the decoder does before parsing it
+TEST(AvcDecNalTest, ProcessNalUnitBenchmark) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<UWORD8> nal(kBenchmarkBufSize);
+
+    // Entropy coded data, with emulation prevention bytes where the encoder inserts them
+    nal[0] = 0x65;
+    for (size_t i = 1; i < nal.size(); i++) {
+        nal[i] = byte(rng);
+        if (i >= 3 && nal[i - 2] == 0 && nal[i - 1] == 0 && nal[i] <= 3) {
+            nal[i] = 3;
+        }
+    }
+
+    for (const ZeroRunKernel& kernel : getKernels()) {
+        std::vector<UWORD32> buf((nal.size() + kNalPadding + 3) / 4, 0);
+        dec_bit_stream_t bitstrm;
+        double seconds = 0;
+
+        for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+            memcpy(buf.data(), nal.data(), nal.size());
+            auto start = std::chrono::steady_clock::now();
+            ih264d_process_nal_unit(&bitstrm, (UWORD8*)buf.data(), nal.size(), kernel.function);
+            auto end = std::chrono::steady_clock::now();
+            seconds += std::chrono::duration<double>(end - start).count();
+        }
+        printf("%-8s %8.1f MB/s\n", kernel.name,
+               kBenchmarkIterations * (nal.size() / (1024.0 * 1024.0)) / seconds);
+    }
+}
+
+// Parses exp-Golomb codes of the lengths found in slice data, as the CAVLC macroblock
+// layer parsing does for mb_type, ref_idx, mvd and mb_qp_delta. This times the reader
+// alone; the slice parsers around it are not part of the benchmark
+TEST(AvcDecNalTest, ExpGolombBenchmark) {
+    std::mt19937 rng(7);
+    size_t numBits;
+    std::vector<UWORD32> words = getExpGolombWords(rng, kNumExpGolombCodes, 8, &numBits);
+    double referenceSeconds = 0;
+    double seconds = 0;
+    UWORD32 referenceSum = 0;
+    UWORD32 sum = 0;
+
+    for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+        UWORD32 offset = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < kNumExpGolombCodes; i++) {
+            referenceSum += uevReference(&offset, words.data());
+        }
+        auto end = std::chrono::steady_clock::now();
+        referenceSeconds += std::chrono::duration<double>(end - start).count();
+
+        offset = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < kNumExpGolombCodes; i++) {
+            sum += ih264d_uev(&offset, words.data());
+        }
+        end = std::chrono::steady_clock::now();
+        seconds += std::chrono::duration<double>(end - start).count();
+    }
+    EXPECT_EQ(referenceSum, sum);
+    printf("%-10s %8.1f Mcodes/s\n", "reference",
+           kBenchmarkIterations * kNumExpGolombCodes / referenceSeconds / 1e6);
+    printf("%-10s %8.1f Mcodes/s\n", "uev", kBenchmarkIterations * kNumExpGolombCodes / seconds / 1e6);
+}
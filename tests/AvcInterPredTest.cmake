@@ -0,0 +1,14 @@
+list(
+  APPEND
+  AVCINTERPREDTEST_SRCS
+  "${AVC_ROOT}/tests/AvcInterPredTest.cpp")
+
+libavc_add_executable(AvcInterPredTest libavcenc
+    SOURCES ${AVCINTERPREDTEST_SRCS}
+    INCLUDES "${AVC_ROOT}/third_party/googletest/googletest/include")
+
+target_link_libraries(AvcInterPredTest
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest.a
+    ${AVC_ROOT}/third_party/build/googletest/src/googletest-build/lib/libgtest_main.a)
+
+add_dependencies(AvcInterPredTest googletest)
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264e_half_pel.h"
+}
+
+constexpr uint32_t kNumRandomBlocks = 1000;
+constexpr uint32_t kBenchmarkIterations = 100000;
+
+// Source and destination planes, with the block in the middle, so that the filters can read
+// their margins and writes outside of the block are caught
+constexpr int kStride = 64;
+constexpr int kPlaneHt = 48;
+constexpr int kBlockOffset = 16 * kStride + 16;
+
+// Intermediate buffer of the encoder half-pel filters, as in the encoder
+constexpr int kHpelBufWd = 24;
+constexpr int kHpelBufHt = 18;
+
+// Block sizes (wd, ht) of the decoder's luma partitions
+static const int kBlockSizes[][2] = {{16, 16}, {16, 8}, {8, 16}, {8, 8}, {8, 4}, {4, 8}, {4, 4}};
+
+template <typename Function>
+struct Kernel {
+    const char* name;
+    Function* function;
+};
+
+typedef Kernel<ih264_inter_pred_luma_ft> LumaKernel;
+typedef Kernel<ih264e_sixtapfilter_horz_ft> HorzKernel;
+typedef Kernel<ih264e_sixtap_filter_2dvh_vert_ft> VertKernel;
+
+static bool avx2Supported() {
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(DISABLE_AVX2)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Luma kernels of a dydx, in the order of apf_inter_pred_luma of the decoder
+static ih264_inter_pred_luma_ft* const kLumaGeneric[16] = {
+        ih264_inter_pred_luma_copy,
+        ih264_inter_pred_luma_horz_qpel,
+        ih264_inter_pred_luma_horz,
+        ih264_inter_pred_luma_horz_qpel,
+        ih264_inter_pred_luma_vert_qpel,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel,
+        ih264_inter_pred_luma_horz_hpel_vert_qpel,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel,
+        ih264_inter_pred_luma_vert,
+        ih264_inter_pred_luma_horz_qpel_vert_hpel,
+        ih264_inter_pred_luma_horz_hpel_vert_hpel,
+        ih264_inter_pred_luma_horz_qpel_vert_hpel,
+        ih264_inter_pred_luma_vert_qpel,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel,
+        ih264_inter_pred_luma_horz_hpel_vert_qpel,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel};
+
+#if defined(__x86_64__) || defined(__i386__)
+static ih264_inter_pred_luma_ft* const kLumaSsse3[16] = {
+        ih264_inter_pred_luma_copy_ssse3,
+        ih264_inter_pred_luma_horz_qpel_ssse3,
+        ih264_inter_pred_luma_horz_ssse3,
+        ih264_inter_pred_luma_horz_qpel_ssse3,
+        ih264_inter_pred_luma_vert_qpel_ssse3,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3,
+        ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3,
+        ih264_inter_pred_luma_vert_ssse3,
+        ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3,
+        ih264_inter_pred_luma_horz_hpel_vert_hpel_ssse3,
+        ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3,
+        ih264_inter_pred_luma_vert_qpel_ssse3,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3,
+        ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3};
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(DISABLE_AVX2)
+// There is no AVX2 copy, the decoder keeps the SSSE3 one
+static ih264_inter_pred_luma_ft* const kLumaAvx2[16] = {
+        ih264_inter_pred_luma_copy_ssse3,
+        ih264_inter_pred_luma_horz_qpel_avx2,
+        ih264_inter_pred_luma_horz_avx2,
+        ih264_inter_pred_luma_horz_qpel_avx2,
+        ih264_inter_pred_luma_vert_qpel_avx2,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2,
+        ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2,
+        ih264_inter_pred_luma_vert_avx2,
+        ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2,
+        ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2,
+        ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2,
+        ih264_inter_pred_luma_vert_qpel_avx2,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2,
+        ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2,
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2};
+#endif
+
+// Kernels available on the build target, the generic one first
+static std::vector<LumaKernel> getLumaKernels(int dydx) {
+    std::vector<LumaKernel> kernels = {{"generic", kLumaGeneric[dydx]}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", kLumaSsse3[dydx]});
+#if !defined(DISABLE_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", kLumaAvx2[dydx]});
+    }
+#endif
+#endif
+    return kernels;
+}
+
+static std::vector<HorzKernel> getHorzKernels() {
+    std::vector<HorzKernel> kernels = {{"generic", ih264e_sixtapfilter_horz}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", ih264e_sixtapfilter_horz_ssse3});
+#if !defined(DISABLE_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", ih264e_sixtapfilter_horz_avx2});
+    }
+#endif
+#endif
+    return kernels;
+}
+
+static std::vector<VertKernel> getVertKernels() {
+    std::vector<VertKernel> kernels = {{"generic", ih264e_sixtap_filter_2dvh_vert}};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back({"ssse3", ih264e_sixtap_filter_2dvh_vert_ssse3});
+#if !defined(DISABLE_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", ih264e_sixtap_filter_2dvh_vert_avx2});
+    }
+#endif
+#endif
+    return kernels;
+}
+
+// Random pixels, with runs of 0 and 255 to saturate the filters
+static void fillRandom(std::mt19937& rng, std::vector<UWORD8>& buf) {
+    std::uniform_int_distribution<int> pixel(0, 255);
+    std::uniform_int_distribution<int> kind(0, 7);
+
+    int fill = kind(rng);
+    for (size_t i = 0; i < buf.size(); i++) {
+        if (0 == (i & 15)) fill = kind(rng);
+        buf[i] = (UWORD8)(fill == 0 ? 0 : fill == 1 ? 255 : pixel(rng));
+    }
+}
+
+TEST(AvcInterPredTest, LumaMatchesGeneric) {
+    if (!avx2Supported()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    std::mt19937 rng(1);
+    std::vector<UWORD8> src(kStride * kPlaneHt);
+    std::vector<UWORD8> init(kStride * kPlaneHt);
+    std::vector<UWORD8> expected(kStride * kPlaneHt);
+    std::vector<UWORD8> actual(kStride * kPlaneHt);
+    std::vector<UWORD8> tmp(kStride * kPlaneHt * sizeof(WORD16));
+
+    for (int dydx = 1; dydx < 16; dydx++) {
+        auto kernels = getLumaKernels(dydx);
+        for (const auto& size : kBlockSizes) {
+            int wd = size[0];
+            int ht = size[1];
+
+            for (uint32_t n = 0; n < kNumRandomBlocks; n++) {
+                fillRandom(rng, src);
+                fillRandom(rng, init);
+
+                expected = init;
+                kernels[0].function(src.data() + kBlockOffset, expected.data() + kBlockOffset,
+                                    kStride, kStride, ht, wd, tmp.data(), dydx);
+                for (size_t k = 1; k < kernels.size(); k++) {
+                    actual = init;
+                    kernels[k].function(src.data() + kBlockOffset, actual.data() + kBlockOffset,
+                                        kStride, kStride, ht, wd, tmp.data(), dydx);
+                    ASSERT_EQ(0, memcmp(expected.data(), actual.data(), expected.size()))
+                            << kernels[k].name << " dydx " << dydx << " " << wd << "x" << ht
+                            << " block " << n;
+                }
+            }
+        }
+    }
+}
+
+TEST(AvcInterPredTest, HalfPelMatchesGeneric) {
+    if (!avx2Supported()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    std::mt19937 rng(2);
+    std::vector<UWORD8> src(kStride * kPlaneHt);
+    std::vector<UWORD8> init(kHpelBufWd * kHpelBufHt * 2);
+    std::vector<UWORD8> expected(kHpelBufWd * kHpelBufHt * 2);
+    std::vector<UWORD8> actual(kHpelBufWd * kHpelBufHt * 2);
+    std::vector<WORD32> pred(kHpelBufWd * kHpelBufHt);
+    auto horzKernels = getHorzKernels();
+    auto vertKernels = getVertKernels();
+
+    for (uint32_t n = 0; n < kNumRandomBlocks; n++) {
+        fillRandom(rng, src);
+        fillRandom(rng, init);
+
+        // Half x, from the left half pel of the block as in the encoder
+        expected = init;
+        horzKernels[0].function(src.data() + kBlockOffset - 1, expected.data(), kStride,
+                                kHpelBufWd);
+        for (size_t k = 1; k < horzKernels.size(); k++) {
+            actual = init;
+            horzKernels[k].function(src.data() + kBlockOffset - 1, actual.data(), kStride,
+                                    kHpelBufWd);
+            ASSERT_EQ(0, memcmp(expected.data(), actual.data(), expected.size()))
+                    << horzKernels[k].name << " horz block " << n;
+        }
+
+        // Half y and half xy, from the top left half pel of the block
+        UWORD8* pu1_src = src.data() + kBlockOffset - kStride - 1;
+        int dst2 = kHpelBufWd * kHpelBufHt;
+
+        expected = init;
+        vertKernels[0].function(pu1_src, expected.data(), expected.data() + dst2, kStride,
+                                kHpelBufWd, pred.data() + 3, kHpelBufWd);
+        for (size_t k = 1; k < vertKernels.size(); k++) {
+            actual = init;
+            vertKernels[k].function(pu1_src, actual.data(), actual.data() + dst2, kStride,
+                                    kHpelBufWd, pred.data() + 3, kHpelBufWd);
+            ASSERT_EQ(0, memcmp(expected.data(), actual.data(), expected.size()))
+                    << vertKernels[k].name << " 2dvh block " << n;
+        }
+    }
+}
+
+TEST(AvcInterPredTest, Benchmark) {
+    std::mt19937 rng(3);
+    std::vector<UWORD8> src(kStride * kPlaneHt);
+    std::vector<UWORD8> dst(kStride * kPlaneHt);
+    std::vector<UWORD8> tmp(kStride * kPlaneHt * sizeof(WORD16));
+
+    fillRandom(rng, src);
+    for (int dydx = 1; dydx < 16; dydx++) {
+        for (const LumaKernel& kernel : getLumaKernels(dydx)) {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t n = 0; n < kBenchmarkIterations; n++) {
+                kernel.function(src.data() + kBlockOffset, dst.data() + kBlockOffset, kStride,
+                                kStride, 16, 16, tmp.data(), dydx);
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+
+            printf("dydx %2d %-8s %8.2f M16x16/s\n", dydx, kernel.name,
+                   kBenchmarkIterations / seconds / 1e6);
+        }
+    }
+}